@@ -0,0 +1,89 @@
+//=========================================================
+// Debug view resolve
+// - Fullscreen pass mapping the counts accumulated by debug_views.wgsl
+//   (overdraw, triangle density) to a heatmap
+//=========================================================
+
+//=========================================================
+// Uniforms & Bind Group Declarations
+//=========================================================
+
+struct DebugViewUniforms {
+    mode: u32,       // Matches Renderer::DebugView
+    tileSize: u32,   // Averaging tile size in pixels
+    maxValue: f32,   // Value mapped to the hot end of the heatmap
+    _pad: f32,
+};
+
+@group(0) @binding(0) var accumulationTexture: texture_2d<f32>;
+@group(0) @binding(1) var<uniform> viewUniforms: DebugViewUniforms;
+
+
+//=========================================================
+// Constants & Types
+//=========================================================
+
+struct VertexOutput {
+    @builtin(position) position: vec4<f32>,
+};
+
+
+//=========================================================
+// Utility Functions
+//=========================================================
+
+// Blue -> cyan -> green -> yellow -> red
+fn heatmap(t: f32) -> vec3f {
+    let x = clamp(t, 0.0, 1.0);
+    let r = clamp(2.0 * x - 0.5, 0.0, 1.0);
+    let g = clamp(select(2.0 * x, 2.0 - 2.0 * x, x > 0.5) * 1.2, 0.0, 1.0);
+    let b = clamp(1.0 - 2.0 * x, 0.0, 1.0);
+    return vec3f(r, g, b);
+}
+
+
+//=========================================================
+// Vertex Shader
+//=========================================================
+
+@vertex
+fn vs_main(@builtin(vertex_index) vertexIndex: u32) -> VertexOutput {
+    // Fullscreen triangle
+    let uv = vec2f(f32((vertexIndex << 1u) & 2u), f32(vertexIndex & 2u));
+
+    var output: VertexOutput;
+    output.position = vec4f(uv * 2.0 - 1.0, 0.0, 1.0);
+    return output;
+}
+
+
+//=========================================================
+// Fragment Shader
+//=========================================================
+
+@fragment
+fn fs_main(in: VertexOutput) -> @location(0) vec4f {
+    let size = vec2i(textureDimensions(accumulationTexture));
+    let tileSize = i32(max(viewUniforms.tileSize, 1u));
+    let tileOrigin = (vec2i(in.position.xy) / tileSize) * tileSize;
+
+    // Average the accumulated value over the tile containing this pixel
+    var sum = 0.0;
+    var count = 0.0;
+    for (var y = 0; y < tileSize; y++) {
+        for (var x = 0; x < tileSize; x++) {
+            let p = tileOrigin + vec2i(x, y);
+            if (all(p < size)) {
+                sum += textureLoad(accumulationTexture, p, 0).r;
+                count += 1.0;
+            }
+        }
+    }
+    let value = sum / max(count, 1.0);
+
+    // Leave pixels without any coverage black
+    if (value <= 0.0) {
+        return vec4f(0.0, 0.0, 0.0, 1.0);
+    }
+    return vec4f(heatmap(value / viewUniforms.maxValue), 1.0);
+}
@@ -0,0 +1,152 @@
+//=========================================================
+// Debug views
+// - Overdraw: every fragment adds 1 to an R16Float accumulation target
+// - Triangle density: every index is splatted as a point adding 1/3, so the
+//   accumulation target holds triangles per pixel (averaged per tile on resolve)
+// - Texture fetches: material textures bound per fragment (material feature mask)
+// - Submesh / material IDs: hashed ID colors
+// The accumulated counts are mapped to a heatmap by debug_view_resolve.wgsl.
+//=========================================================
+
+//=========================================================
+// Uniforms & Bind Group Declarations
+//=========================================================
+
+struct GlobalUniforms {
+    viewMatrix: mat4x4<f32>,
+    projectionMatrix: mat4x4<f32>,
+    inverseViewMatrix: mat4x4<f32>,
+    inverseProjectionMatrix: mat4x4<f32>,
+    cameraPositionWorld: vec3<f32>
+};
+
+struct ModelUniforms {
+    modelMatrix: mat4x4<f32>,
+    normalMatrix: mat4x4<f32>
+};
+
+struct MaterialUniforms {
+    baseColorFactor: vec4<f32>,
+    emissiveFactor: vec3<f32>,
+    metallicFactor: f32,
+    roughnessFactor: f32,
+    normalScale: f32,
+    occlusionStrength: f32,
+    alphaCutoff: f32,
+    alphaMode: i32,
+    textureMask: u32, // Bit 0 = base color, 1 = metallic-roughness, 2 = normal, 3 = occlusion, 4 = emissive
+    materialIndex: u32,
+};
+
+struct DebugDrawUniforms {
+    subMeshIndex: u32,
+    materialIndex: u32,
+    _pad0: u32,
+    _pad1: u32,
+};
+
+struct DebugViewUniforms {
+    mode: u32,       // Matches Renderer::DebugView
+    tileSize: u32,   // Resolve: averaging tile size in pixels
+    maxValue: f32,   // Resolve: value mapped to the hot end of the heatmap
+    _pad: f32,
+};
+
+@group(0) @binding(0) var<uniform> globalUniforms: GlobalUniforms;
+
+@group(1) @binding(0) var<uniform> modelUniforms: ModelUniforms;
+@group(1) @binding(1) var<uniform> materialUniforms: MaterialUniforms;
+
+@group(2) @binding(0) var<uniform> drawUniforms: DebugDrawUniforms;
+@group(2) @binding(1) var<uniform> viewUniforms: DebugViewUniforms;
+
+
+//=========================================================
+// Constants & Types
+//=========================================================
+
+const kModeTextureFetches = 3u;
+const kModeSubMeshIds = 4u;
+const kModeMaterialIds = 5u;
+const kMaxMaterialTextures = 5.0;
+
+struct VertexInput {
+    @location(0) position: vec3<f32>,
+    @location(6) geometryTransform0: vec4<f32>, // Per-instance geometry transform (columns)
+    @location(7) geometryTransform1: vec4<f32>,
+    @location(8) geometryTransform2: vec4<f32>,
+    @location(9) geometryTransform3: vec4<f32>,
+};
+
+struct VertexOutput {
+    @builtin(position) position: vec4<f32>,
+};
+
+
+//=========================================================
+// Utility Functions
+//=========================================================
+
+// Blue -> cyan -> green -> yellow -> red
+fn heatmap(t: f32) -> vec3f {
+    let x = clamp(t, 0.0, 1.0);
+    let r = clamp(2.0 * x - 0.5, 0.0, 1.0);
+    let g = clamp(select(2.0 * x, 2.0 - 2.0 * x, x > 0.5) * 1.2, 0.0, 1.0);
+    let b = clamp(1.0 - 2.0 * x, 0.0, 1.0);
+    return vec3f(r, g, b);
+}
+
+fn hashColor(id: u32) -> vec3f {
+    var h = id * 747796405u + 2891336453u;
+    h = ((h >> ((h >> 28u) + 4u)) ^ h) * 277803737u;
+    h = (h >> 22u) ^ h;
+    return vec3f(f32(h & 0xFFu), f32((h >> 8u) & 0xFFu), f32((h >> 16u) & 0xFFu)) / 255.0;
+}
+
+
+//=========================================================
+// Vertex Shader
+//=========================================================
+
+@vertex
+fn vs_main(in: VertexInput) -> VertexOutput {
+    let geometryTransform = mat4x4<f32>(in.geometryTransform0, in.geometryTransform1,
+                                        in.geometryTransform2, in.geometryTransform3);
+    let worldPosition = modelUniforms.modelMatrix * geometryTransform * vec4<f32>(in.position, 1.0);
+
+    var output: VertexOutput;
+    output.position = globalUniforms.projectionMatrix * globalUniforms.viewMatrix * worldPosition;
+    return output;
+}
+
+
+//=========================================================
+// Fragment Shaders
+//=========================================================
+
+@fragment
+fn fs_overdraw() -> @location(0) vec4f {
+    return vec4f(1.0, 0.0, 0.0, 0.0);
+}
+
+@fragment
+fn fs_triangle_density() -> @location(0) vec4f {
+    // Each triangle contributes three points
+    return vec4f(1.0 / 3.0, 0.0, 0.0, 0.0);
+}
+
+@fragment
+fn fs_surface() -> @location(0) vec4f {
+    var color = vec3f(0.0);
+
+    if (viewUniforms.mode == kModeTextureFetches) {
+        let textureCount = f32(countOneBits(materialUniforms.textureMask & 0x1Fu));
+        color = heatmap(textureCount / kMaxMaterialTextures);
+    } else if (viewUniforms.mode == kModeSubMeshIds) {
+        color = hashColor(drawUniforms.subMeshIndex);
+    } else if (viewUniforms.mode == kModeMaterialIds) {
+        color = hashColor(drawUniforms.materialIndex);
+    }
+
+    return vec4f(color, 1.0);
+}
@@ -1,6 +1,6 @@
 //=========================================================
 // Environment background rendering
-// - Fullscreen quad sampling an environment cubemap
+// - Fullscreen quad sampling an environment cubemap (or its octahedral 2D encoding)
 // - Uses inverse view/projection to orient sky to camera
 // - Output: tone-mapped sRGB color
 //=========================================================
@@ -25,6 +25,7 @@ struct GlobalUniforms {
 @group(0) @binding(4) var iblSpecularTexture: texture_cube<f32>;
 @group(0) @binding(5) var iblBRDFIntegrationLUTTexture: texture_2d<f32>;
 @group(0) @binding(6) var iblBRDFIntegrationLUTSampler: sampler;
+@group(0) @binding(8) var environmentOctahedralTexture: texture_2d<f32>;
 
 
 //=========================================================
@@ -33,6 +34,9 @@ struct GlobalUniforms {
 
 const pi = 3.141592653589793;
 
+// Set per quality tier when creating the pipeline
+override useOctahedralEnvironment: bool = false;
+
 struct VertexOutput {
     @builtin(position) position: vec4f,
     @location(0) uv: vec2f
@@ -81,6 +85,64 @@ fn toneMap(colorIn: vec3f) -> vec3f {
 }
 
 
+//=========================================================
+// Octahedral Environment Sampling
+//=========================================================
+
+// Octahedral mapping between unit directions and [-1, 1]^2 (+Y at the center). Must match
+// octahedralEncode() in gltf_pbr.wgsl.
+fn octahedralFold(n: vec3f) -> vec3f {
+    if (n.z >= 0.0) {
+        return n;
+    }
+    return vec3f((1.0 - abs(n.yx)) * select(vec2f(-1.0), vec2f(1.0), n.xy >= vec2f(0.0)), n.z);
+}
+
+fn octahedralEncode(d: vec3f) -> vec2f {
+    return octahedralFold(d.xzy / (abs(d.x) + abs(d.y) + abs(d.z))).xy;
+}
+
+// Maps a texel outside the map to its neighbor across the mirrored outer edges
+fn octahedralWrap(texel: vec2i, size: i32) -> vec2i {
+    var t = texel;
+    if (t.x < 0 || t.x >= size) {
+        t = vec2i(clamp(t.x, 0, size - 1), size - 1 - t.y);
+    }
+    if (t.y < 0 || t.y >= size) {
+        t = vec2i(size - 1 - t.x, clamp(t.y, 0, size - 1));
+    }
+    return t;
+}
+
+fn sampleOctahedralLevel(direction: vec3f, level: i32) -> vec3f {
+    let size = i32(textureDimensions(environmentOctahedralTexture, level).x);
+    let texel = (octahedralEncode(direction) * 0.5 + 0.5) * f32(size) - 0.5;
+    let base = vec2i(floor(texel));
+    let f = fract(texel);
+    let c00 = textureLoad(environmentOctahedralTexture, octahedralWrap(base, size), level);
+    let c10 = textureLoad(environmentOctahedralTexture,
+                          octahedralWrap(base + vec2i(1, 0), size), level);
+    let c01 = textureLoad(environmentOctahedralTexture,
+                          octahedralWrap(base + vec2i(0, 1), size), level);
+    let c11 = textureLoad(environmentOctahedralTexture,
+                          octahedralWrap(base + vec2i(1, 1), size), level);
+    return mix(mix(c00, c10, f.x), mix(c01, c11, f.x), f.y).rgb;
+}
+
+// Seam-aware trilinear sample. The LOD follows the angular footprint of the pixel, since the
+// derivatives of the map coordinates jump across the folds.
+fn sampleOctahedralEnvironment(direction: vec3f, footprint: f32) -> vec3f {
+    let size = f32(textureDimensions(environmentOctahedralTexture).x);
+    let texelAngle = sqrt(4.0 * pi) / size; // 4pi steradians over size^2 texels
+    let maxLevel = f32(textureNumLevels(environmentOctahedralTexture) - 1u);
+    let level = clamp(log2(max(footprint / texelAngle, 1e-6)), 0.0, maxLevel);
+    let level0 = i32(floor(level));
+    let level1 = min(level0 + 1, i32(maxLevel));
+    return mix(sampleOctahedralLevel(direction, level0), sampleOctahedralLevel(direction, level1),
+               fract(level));
+}
+
+
 //=========================================================
 // Vertex Shader
 //=========================================================
@@ -130,8 +192,12 @@ fn fs_main(input: VertexOutput) -> @location(0) vec4f {
     // Transform the direction vector from world space to camera space
     dir = normalize(invRotMatrix * dir);
 
-    // Sample the environment texture
-    let iblSample = textureSample(environmentTexture, environmentCubeSampler, dir).rgb;
+    // Sample the environment texture (derivatives in uniform control flow)
+    let footprint = max(length(dpdx(dir)), length(dpdy(dir)));
+    var iblSample = textureSample(environmentTexture, environmentCubeSampler, dir).rgb;
+    if (useOctahedralEnvironment) {
+        iblSample = sampleOctahedralEnvironment(dir, footprint);
+    }
 
     // Tonemapping and gamma correction
     let color = toneMap(iblSample);
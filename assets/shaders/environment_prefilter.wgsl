@@ -1,7 +1,8 @@
 //=========================================================
 // This WGSL file implements three separate compute passes for IBL:
 // 1) computeIrradiance: Generates diffuse irradiance for a cube map (Lambertian).
-// 2) computePrefilteredSpecular: Generates specular prefiltered environment map using GGX.
+// 2) computePrefilteredSpecular: Generates specular prefiltered environment map using GGX
+//    (computePrefilteredSpecularOctahedral writes an octahedral map instead of cube faces).
 // 3) computeLUT: Computes the BRDF integration LUT for specular IBL (A and B channels).
 //=========================================================
 
@@ -116,6 +117,20 @@ fn uvToDirection(uv: vec2<f32>, face: u32) -> vec3<f32> {
     return normalize(faceDirs[face] + (u * rightVectors[face]) + (v * upVectors[face]));
 }
 
+// Octahedral mapping of [-1, 1]^2 to unit directions (+Y at the center). Must match
+// octahedralDecode() in gltf_pbr.wgsl.
+fn octahedralFold(n: vec3<f32>) -> vec3<f32> {
+    if (n.z >= 0.0) {
+        return n;
+    }
+    let signs = select(vec2<f32>(-1.0), vec2<f32>(1.0), n.xy >= vec2<f32>(0.0));
+    return vec3<f32>((1.0 - abs(n.yx)) * signs, n.z);
+}
+
+fn octahedralDecode(e: vec2<f32>) -> vec3<f32> {
+    return normalize(octahedralFold(vec3<f32>(e, 1.0 - abs(e.x) - abs(e.y))).xzy);
+}
+
 
 //=========================================================
 // Sampling Functions
@@ -282,6 +297,33 @@ fn computePrefilteredSpecular(@builtin(global_invocation_id) id: vec3<u32>) {
     let uv = vec2<f32>(f32(id.x) / f32(outputSize.x), f32(id.y) / f32(outputSize.y));
     let N = normalize(uvToDirection(uv, faceIndex));
 
+    // Store the result in the output cubemap, at the appropriate face.
+    let specular = prefilterSpecular(N, f32(outputSize.x));
+    textureStore(prefilteredSpecularCube, id.xy, faceIndex, vec4<f32>(specular, 1.0));
+}
+
+/// Generates the prefiltered specular map as a single octahedral layer (one dispatch per mip
+/// level instead of six).
+@compute @workgroup_size(8, 8)
+fn computePrefilteredSpecularOctahedral(@builtin(global_invocation_id) id: vec3<u32>) {
+
+    let outputSize = textureDimensions(prefilteredSpecularCube).xy;
+    if (id.x >= outputSize.x || id.y >= outputSize.y) {
+        return;
+    }
+
+    // Texel centers, so the mirrored outer edges line up for seam-aware filtering
+    let uv = (vec2<f32>(id.xy) + 0.5) / vec2<f32>(outputSize);
+    let N = octahedralDecode(uv * 2.0 - 1.0);
+
+    // The octahedral map is twice the size of the equivalent cube face
+    let specular = prefilterSpecular(N, 0.5 * f32(outputSize.x));
+    textureStore(prefilteredSpecularCube, id.xy, 0u, vec4<f32>(specular, 1.0));
+}
+
+/// GGX prefiltered radiance around N (N = V = R), for an output of the given cube face size.
+fn prefilterSpecular(N: vec3<f32>, faceSize: f32) -> vec3<f32> {
+
     var accumSpecular = vec3<f32>(0.0);
     var weightSum = 0.0;
     
@@ -298,7 +340,7 @@ fn computePrefilteredSpecular(@builtin(global_invocation_id) id: vec3<u32>) {
 
         if (NdotL > 0.0) {
             // Convert the PDF to a suitable mip level in the environment map.
-            let lod: f32 = computeLOD(pdf, f32(outputSize.x));
+            let lod: f32 = computeLOD(pdf, faceSize);
 
             // Fetch environment map color at this direction + LOD.
             let sampleColor = textureSampleLevel(environmentTexture, environmentSampler, L, lod).rgb;
@@ -314,8 +356,7 @@ fn computePrefilteredSpecular(@builtin(global_invocation_id) id: vec3<u32>) {
         accumSpecular /= weightSum;
     }
 
-    // Store the result in the output cubemap, at the appropriate face.
-    textureStore(prefilteredSpecularCube, id.xy, faceIndex, vec4<f32>(accumSpecular, 1.0));
+    return accumSpecular;
 }
 
 /// Computes the BRDF integration LUT for specular IBL
@@ -1,8 +1,15 @@
 //=========================================================
 // glTF PBR (metallic-roughness) shading
 // - Vertex + fragment with IBL (irradiance, prefiltered specular, BRDF LUT)
+// - Quality tiers select between the BRDF LUT and an analytic approximation,
+//   and between the irradiance cube and spherical harmonics (pipeline overrides)
+// - The prefiltered specular map is a cube or an octahedral 2D map (seam-aware filtering)
 // - Inputs: GlobalUniforms, ModelUniforms, MaterialUniforms, PBR textures
 // - Output: tone-mapped sRGB color
+// - Impostors: bakes an octahedral view atlas of one instance and shades distant
+//   instances as camera-facing quads with the same IBL
+// - Texture LOD feedback: records the finest mip level of every material texture seen
+//   on screen (reduced resolution pass, see TextureFeedback)
 //=========================================================
 
 //=========================================================
@@ -31,6 +38,8 @@ struct MaterialUniforms {
     occlusionStrength: f32,
     alphaCutoff: f32, 
     alphaMode: i32,   // 0 = Opaque, 1 = Mask, 2 = Blend
+    textureMask: u32, // Bitmask of bound material textures (see Renderer::MaterialUniforms)
+    materialIndex: u32, // Texture LOD feedback entry
 };
 
 @group(0) @binding(0) var<uniform> globalUniforms: GlobalUniforms;
@@ -40,6 +49,9 @@ struct MaterialUniforms {
 @group(0) @binding(4) var iblSpecularTexture: texture_cube<f32>;
 @group(0) @binding(5) var iblBRDFIntegrationLUTTexture: texture_2d<f32>;
 @group(0) @binding(6) var iblBRDFIntegrationLUTSampler: sampler;
+@group(0) @binding(7) var<uniform> iblIrradianceSH: array<vec4<f32>, 9>; // L0, L1, L2 bands (rgb)
+@group(0) @binding(8) var environmentOctahedralTexture: texture_2d<f32>;
+@group(0) @binding(9) var iblSpecularOctahedralTexture: texture_2d<f32>;
 
 @group(1) @binding(0) var<uniform> modelUniforms: ModelUniforms;
 @group(1) @binding(1) var<uniform> materialUniforms: MaterialUniforms;
@@ -50,6 +62,23 @@ struct MaterialUniforms {
 @group(1) @binding(6) var occlusionTexture: texture_2d<f32>;
 @group(1) @binding(7) var emissiveTexture: texture_2d<f32>;
 
+struct ImpostorViewUniforms {
+    viewProjectionMatrix: mat4x4<f32>
+};
+
+// Impostor atlas baking (per-view uniforms use a dynamic offset)
+@group(2) @binding(0) var<uniform> impostorView: ImpostorViewUniforms;
+
+// Impostor rendering
+@group(2) @binding(1) var impostorSampler: sampler;
+@group(2) @binding(2) var impostorAlbedoTexture: texture_2d<f32>;      // Base color, coverage
+@group(2) @binding(3) var impostorNormalDepthTexture: texture_2d<f32>; // Normal, depth
+@group(2) @binding(4) var impostorMaterialTexture: texture_2d<f32>;    // Occlusion, roughness, metallic
+@group(2) @binding(5) var impostorEmissiveTexture: texture_2d<f32>;
+
+// Texture LOD feedback (one entry per material texture slot)
+@group(2) @binding(6) var<storage, read_write> textureFeedback: array<atomic<u32>>;
+
 
 //=========================================================
 // Constants & Types
@@ -57,6 +86,22 @@ struct MaterialUniforms {
 
 const pi = 3.141592653589793;
 
+// Set per quality tier when creating the pipelines
+override useBRDFLUT: bool = true;
+override useSphericalHarmonics: bool = false;
+override useOctahedralEnvironment: bool = false;
+
+// Views along each axis of the impostor atlas (Renderer kImpostorGridSize)
+override impostorGridSize: u32 = 8;
+
+// Size divisor of the texture LOD feedback target (TextureFeedback::kResolutionScale)
+override textureFeedbackScale: f32 = 4.0;
+
+// Texture LOD feedback entries hold kFeedbackMaxMipLevels - mip (0 = not sampled), must match
+// kMaxMipLevels in texture_feedback.cpp
+const kFeedbackSlotCount = 5u;
+const kFeedbackMaxMipLevels = 16u;
+
 struct MaterialInfo {
     baseColor: vec4f,
     metallic: f32,
@@ -75,7 +120,11 @@ struct VertexInput {
     @location(2) tangent: vec4<f32>,
     @location(3) texCoord0: vec2<f32>,
     @location(4) texCoord1: vec2<f32>,
-    @location(5) color: vec4<f32>
+    @location(5) color: vec4<f32>,
+    @location(6) geometryTransform0: vec4<f32>, // Per-instance geometry transform (columns),
+    @location(7) geometryTransform1: vec4<f32>, // identity unless the geometry is shared with
+    @location(8) geometryTransform2: vec4<f32>, // another mesh (Model::GetGeometryTransforms)
+    @location(9) geometryTransform3: vec4<f32>
 };
 
 struct VertexOutput {
@@ -88,6 +137,45 @@ struct VertexOutput {
     @location(5) viewDirectionWorld: vec3<f32>  // View direction (in World Space)
 };
 
+struct ImpostorBakeOutput {
+    @location(0) albedo: vec4<f32>,      // Base color and coverage
+    @location(1) normalDepth: vec4<f32>, // Atlas space normal, offset towards the viewer (in radii)
+    @location(2) material: vec4<f32>,    // Occlusion, roughness, metallic
+    @location(3) emissive: vec4<f32>
+};
+
+struct ImpostorInstanceInput {
+    @builtin(vertex_index) vertexIndex: u32,
+    @location(0) centerRadius: vec4<f32>, // Bounding sphere (in World Space)
+    @location(1) tint: vec4<f32>,         // Base color tint of the instance
+    @location(2) rotation0: vec4<f32>,    // Atlas space to World Space rotation (columns)
+    @location(3) rotation1: vec4<f32>,
+    @location(4) rotation2: vec4<f32>
+};
+
+struct ImpostorVertexOutput {
+    @builtin(position) position: vec4<f32>,
+    @location(0) offset: vec3<f32>,                           // Quad position (atlas space, radii)
+    @location(1) @interpolate(flat) viewDirection: vec3<f32>, // Towards the camera (atlas space)
+    @location(2) @interpolate(flat) centerRadius: vec4<f32>,
+    @location(3) @interpolate(flat) tint: vec4<f32>,
+    @location(4) @interpolate(flat) rotation0: vec3<f32>,
+    @location(5) @interpolate(flat) rotation1: vec3<f32>,
+    @location(6) @interpolate(flat) rotation2: vec3<f32>
+};
+
+struct ImpostorFragmentOutput {
+    @location(0) color: vec4<f32>,
+    @builtin(frag_depth) depth: f32
+};
+
+struct ImpostorSample {
+    albedo: vec4f,
+    normalDepth: vec4f,
+    material: vec4f,
+    emissive: vec4f
+};
+
 
 //=========================================================
 // Utility Functions
@@ -123,6 +211,9 @@ fn BRDFLambertian(f0: vec3f, f90: vec3f, diffuseColor: vec3f, specularWeight: f3
 
 // A helper function for sampling the environment map at a given LOD
 fn samplePrefilteredSpecularIBL(reflection: vec3<f32>, lod: f32) -> vec4<f32> {
+    if (useOctahedralEnvironment) {
+        return sampleOctahedral(iblSpecularOctahedralTexture, reflection, lod);
+    }
     let sampleColor = textureSampleLevel(iblSpecularTexture, iblSampler, reflection, lod);
     return sampleColor;
 }
@@ -134,7 +225,11 @@ fn getIBLRadianceGGX(n: vec3<f32>, v: vec3<f32>, roughness: f32) -> vec3<f32> {
     let NdotV = max(dot(n, v), 0.0);
 
     // Derive the LOD based on roughness and total mip count
-    let lod = roughness * (f32(10) - 1.0);
+    var levelCount = textureNumLevels(iblSpecularTexture);
+    if (useOctahedralEnvironment) {
+        levelCount = textureNumLevels(iblSpecularOctahedralTexture);
+    }
+    let lod = roughness * f32(levelCount - 1u);
 
     // Reflect the view vector around the normal
     let reflection = normalize(reflect(-v, n));
@@ -146,6 +241,29 @@ fn getIBLRadianceGGX(n: vec3<f32>, v: vec3<f32>, roughness: f32) -> vec3<f32> {
     return specularSample.rgb;
 }
 
+// Analytic fit of the GGX BRDF integration LUT (Karis, "Physically Based Shading on Mobile")
+fn envBRDFApprox(NdotV: f32, roughness: f32) -> vec2<f32> {
+    let c0 = vec4<f32>(-1.0, -0.0275, -0.572, 0.022);
+    let c1 = vec4<f32>(1.0, 0.0425, 1.04, -0.04);
+    let r = roughness * c0 + c1;
+    let a004 = min(r.x * r.x, exp2(-9.28 * NdotV)) * r.x + r.y;
+    return vec2<f32>(-1.04, 1.04) * a004 + r.zw;
+}
+
+// Evaluates the diffuse irradiance (divided by pi) from the 9 SH coefficients
+fn irradianceSH(n: vec3<f32>) -> vec3<f32> {
+    var result = iblIrradianceSH[0].rgb * 0.282095;
+    result += iblIrradianceSH[1].rgb * 0.488603 * n.y;
+    result += iblIrradianceSH[2].rgb * 0.488603 * n.z;
+    result += iblIrradianceSH[3].rgb * 0.488603 * n.x;
+    result += iblIrradianceSH[4].rgb * 1.092548 * n.x * n.y;
+    result += iblIrradianceSH[5].rgb * 1.092548 * n.y * n.z;
+    result += iblIrradianceSH[6].rgb * 0.315392 * (3.0 * n.z * n.z - 1.0);
+    result += iblIrradianceSH[7].rgb * 1.092548 * n.x * n.z;
+    result += iblIrradianceSH[8].rgb * 0.546274 * (n.x * n.x - n.y * n.y);
+    return max(result, vec3<f32>(0.0));
+}
+
 // Computes the environment Fresnel reflectance using a GGX BRDF LUT, accounting for single and multiple scattering.
 fn getIBLGGXFresnel(n: vec3<f32>, v: vec3<f32>, roughness: f32, F0: vec3<f32>, specularWeight: f32) -> vec3<f32> 
 {
@@ -156,8 +274,12 @@ fn getIBLGGXFresnel(n: vec3<f32>, v: vec3<f32>, roughness: f32, F0: vec3<f32>, s
     let brdfLUTCoords = vec2<f32>(NdotV, roughness);
 
     // Sample the precomputed GGX LUT (stores scale and bias for Fresnel-Schlick approximation)
-    let brdfLUTSample = textureSample(iblBRDFIntegrationLUTTexture, iblBRDFIntegrationLUTSampler, brdfLUTCoords);
-    let brdfLUT = brdfLUTSample.rg; // .x = scale factor, .y = bias term
+    var brdfLUT: vec2<f32>; // .x = scale factor, .y = bias term
+    if (useBRDFLUT) {
+        brdfLUT = textureSample(iblBRDFIntegrationLUTTexture, iblBRDFIntegrationLUTSampler, brdfLUTCoords).rg;
+    } else {
+        brdfLUT = envBRDFApprox(NdotV, roughness);
+    }
 
     // Single-scattering Fresnel component (Fdez-Aguera approximation)
     // "fresnelPivot" adjusts F0 based on roughness to account for microfacet distribution
@@ -205,6 +327,27 @@ fn BRDFSpecularGGX(f0: vec3f, f90: vec3f, alphaRoughness: f32, specularWeight: f
     return specularWeight * F * V * D;
 }
 
+// Environment lighting; the diffuse term uses the geometric normal
+fn getIBLColor(materialInfo: MaterialInfo, n: vec3f, v: vec3f, geometricNormal: vec3f) -> vec3f {
+    // Sample the irradiance texture (or evaluate the spherical harmonics)
+    var diffuseEnv: vec3f;
+    if (useSphericalHarmonics) {
+        diffuseEnv = irradianceSH(normalize(geometricNormal));
+    } else {
+        diffuseEnv = textureSample(iblIrradianceTexture, iblSampler, geometricNormal).rgb;
+    }
+    let iblDiffuse = diffuseEnv * materialInfo.baseColor.rgb;
+
+    // Sample the specular texture
+    let iblSpecular         = getIBLRadianceGGX(n, v, materialInfo.perceptualRoughness);
+    let fresnelDielectric   = getIBLGGXFresnel(n, v, materialInfo.perceptualRoughness, materialInfo.f0_dielectric, materialInfo.specularWeight);
+    let iblDielectric       = mix(iblDiffuse, iblSpecular, fresnelDielectric);
+    let fresnelMetal        = getIBLGGXFresnel(n, v, materialInfo.perceptualRoughness, materialInfo.baseColor.rgb, 1.0);
+    let iblMetal            = fresnelMetal * iblSpecular;
+
+    return mix(iblDielectric, iblMetal, materialInfo.metallic);
+}
+
 fn toneMapPBRNeutral(colorIn: vec3f) -> vec3f {
     let startCompression: f32 = 0.8 - 0.04;
     let desaturation: f32 = 0.15;
@@ -242,6 +385,115 @@ fn toneMap(colorIn: vec3f) -> vec3f {
   return color;
 }
 
+// Octahedral mapping between unit directions and [-1, 1]^2 (+Y at the center). Must match
+// OctahedralDecode() in renderer.cpp, which places the atlas views, and the octahedral
+// environment maps written by panorama_to_cubemap.wgsl and environment_prefilter.wgsl.
+fn octahedralFold(n: vec3f) -> vec3f {
+    if (n.z >= 0.0) {
+        return n;
+    }
+    return vec3f((1.0 - abs(n.yx)) * select(vec2f(-1.0), vec2f(1.0), n.xy >= vec2f(0.0)), n.z);
+}
+
+fn octahedralEncode(d: vec3f) -> vec2f {
+    return octahedralFold(d.xzy / (abs(d.x) + abs(d.y) + abs(d.z))).xy;
+}
+
+fn octahedralDecode(e: vec2f) -> vec3f {
+    return normalize(octahedralFold(vec3f(e, 1.0 - abs(e.x) - abs(e.y))).xzy);
+}
+
+// Maps a texel outside an octahedral map to its neighbor across the seam. The outer edges fold
+// onto themselves mirrored, so (x, -1) continues at (size - 1 - x, 0).
+fn octahedralWrap(texel: vec2i, size: i32) -> vec2i {
+    var t = texel;
+    if (t.x < 0 || t.x >= size) {
+        t = vec2i(clamp(t.x, 0, size - 1), size - 1 - t.y);
+    }
+    if (t.y < 0 || t.y >= size) {
+        t = vec2i(size - 1 - t.x, clamp(t.y, 0, size - 1));
+    }
+    return t;
+}
+
+// Bilinear sample of one level, filtering across the seams (a sampler would clamp or repeat)
+fn sampleOctahedralLevel(octahedralMap: texture_2d<f32>, direction: vec3f,
+                         level: i32) -> vec4f {
+    let size = i32(textureDimensions(octahedralMap, level).x);
+    let texel = (octahedralEncode(direction) * 0.5 + 0.5) * f32(size) - 0.5;
+    let base = vec2i(floor(texel));
+    let f = fract(texel);
+    let c00 = textureLoad(octahedralMap, octahedralWrap(base, size), level);
+    let c10 = textureLoad(octahedralMap, octahedralWrap(base + vec2i(1, 0), size), level);
+    let c01 = textureLoad(octahedralMap, octahedralWrap(base + vec2i(0, 1), size), level);
+    let c11 = textureLoad(octahedralMap, octahedralWrap(base + vec2i(1, 1), size), level);
+    return mix(mix(c00, c10, f.x), mix(c01, c11, f.x), f.y);
+}
+
+// Trilinear sample of an octahedral octahedralMap (textureSampleLevel() for a cube)
+fn sampleOctahedral(octahedralMap: texture_2d<f32>, direction: vec3f, lod: f32) -> vec4f {
+    let maxLevel = f32(textureNumLevels(octahedralMap) - 1u);
+    let level = clamp(lod, 0.0, maxLevel);
+    let level0 = i32(floor(level));
+    let level1 = min(level0 + 1, i32(maxLevel));
+    return mix(sampleOctahedralLevel(octahedralMap, direction, level0),
+               sampleOctahedralLevel(octahedralMap, direction, level1), fract(level));
+}
+
+// Image plane x axis of the impostor view looking along -d (glm::lookAt() with the same up vector)
+fn impostorRight(d: vec3f) -> vec3f {
+    let up = select(vec3f(0.0, 1.0, 0.0), vec3f(0.0, 0.0, 1.0), abs(d.y) > 0.999);
+    return normalize(cross(up, d));
+}
+
+// Samples one atlas view at the projection of an atlas space offset onto its image plane
+fn sampleImpostorView(cell: vec2f, offset: vec3f) -> ImpostorSample {
+    let gridSize = f32(impostorGridSize);
+    let direction = octahedralDecode((cell + 0.5) / gridSize * 2.0 - 1.0);
+    let right = impostorRight(direction);
+    let up = cross(direction, right);
+
+    // Stay half a texel inside the tile so filtering does not pick up the neighboring view
+    let tileSize = f32(textureDimensions(impostorAlbedoTexture).x) / gridSize;
+    let inset = 1.0 - 1.0 / tileSize;
+    let local = clamp(vec2f(dot(offset, right), -dot(offset, up)), vec2f(-inset), vec2f(inset));
+    let uv = (cell + local * 0.5 + 0.5) / gridSize;
+
+    var result: ImpostorSample;
+    result.albedo = textureSampleLevel(impostorAlbedoTexture, impostorSampler, uv, 0.0);
+    result.normalDepth = textureSampleLevel(impostorNormalDepthTexture, impostorSampler, uv, 0.0);
+    result.material = textureSampleLevel(impostorMaterialTexture, impostorSampler, uv, 0.0);
+    result.emissive = textureSampleLevel(impostorEmissiveTexture, impostorSampler, uv, 0.0);
+    return result;
+}
+
+
+//=========================================================
+// Geometry Transform
+//=========================================================
+
+struct GeometryVertex {
+    position: vec3<f32>,
+    normal: vec3<f32>,
+    tangent: vec4<f32>,
+};
+
+// Applies the geometry transform of shared geometry. Normals use the cofactor matrix, which is
+// the inverse transpose up to a scale that the normalization removes.
+fn applyGeometryTransform(in: VertexInput) -> GeometryVertex {
+    let m = mat4x4<f32>(in.geometryTransform0, in.geometryTransform1, in.geometryTransform2,
+                        in.geometryTransform3);
+    let m3 = mat3x3<f32>(m[0].xyz, m[1].xyz, m[2].xyz);
+    let cofactor = mat3x3<f32>(cross(m3[1], m3[2]), cross(m3[2], m3[0]), cross(m3[0], m3[1]));
+    let handedness = select(1.0, -1.0, determinant(m3) < 0.0);
+
+    var result: GeometryVertex;
+    result.position = (m * vec4<f32>(in.position, 1.0)).xyz;
+    result.normal = normalize(cofactor * in.normal) * handedness;
+    result.tangent = vec4<f32>(normalize(m3 * in.tangent.xyz), in.tangent.w);
+    return result;
+}
+
 
 //=========================================================
 // Vertex Shader
@@ -249,15 +501,17 @@ fn toneMap(colorIn: vec3f) -> vec3f {
 
 @vertex
 fn vs_main(in: VertexInput) -> VertexOutput {
+    let geometry = applyGeometryTransform(in);
 
     // Transform position and normal to world space
-    let worldPosition = modelUniforms.modelMatrix * vec4<f32>(in.position, 1.0);
-    let worldNormal = normalize((modelUniforms.normalMatrix * vec4<f32>(in.normal, 0.0)).xyz);
+    let worldPosition = modelUniforms.modelMatrix * vec4<f32>(geometry.position, 1.0);
+    let worldNormal =
+        normalize((modelUniforms.normalMatrix * vec4<f32>(geometry.normal, 0.0)).xyz);
 
     // Transform tangent to world space (preserving handedness in .w)
     let worldTangent = vec4<f32>(
-        normalize((modelUniforms.normalMatrix * vec4<f32>(in.tangent.xyz, 0.0)).xyz),
-        in.tangent.w
+        normalize((modelUniforms.normalMatrix * vec4<f32>(geometry.tangent.xyz, 0.0)).xyz),
+        geometry.tangent.w
     );
 
     var output: VertexOutput;
@@ -301,20 +555,7 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
     var color = vec3f(0.0);
 
     // Environment lighting
-    {
-        // Sample the irradiance texture
-        let diffuseEnv = textureSample(iblIrradianceTexture, iblSampler, in.normalWorld).rgb;
-        let iblDiffuse = diffuseEnv * materialInfo.baseColor.rgb;
-
-        // Sample the specular texture
-        let iblSpecular         = getIBLRadianceGGX(n, v, materialInfo.perceptualRoughness);
-        let fresnelDielectric   = getIBLGGXFresnel(n, v, materialInfo.perceptualRoughness, materialInfo.f0_dielectric, materialInfo.specularWeight);
-        let iblDielectric       = mix(iblDiffuse, iblSpecular, fresnelDielectric);
-        let fresnelMetal        = getIBLGGXFresnel(n, v, materialInfo.perceptualRoughness, materialInfo.baseColor.rgb, 1.0);
-        let iblMetal            = fresnelMetal * iblSpecular;
-
-        color += mix(iblDielectric, iblMetal, materialInfo.metallic);
-    }
+    color += getIBLColor(materialInfo, n, v, in.normalWorld);
 
     let ao = textureSample(occlusionTexture, textureSampler, in.texCoord0).r * materialUniforms.occlusionStrength;
     color *= vec3f(ao);
@@ -360,3 +601,192 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4f {
     var alpha = select(materialInfo.baseColor.a, 1.0, materialUniforms.alphaMode == 0); 
     return vec4f(color, alpha);
 }
+
+
+//=========================================================
+// Texture LOD Feedback
+//=========================================================
+
+// Finest mip level trilinear filtering fetches from a texture of the given size, at the full
+// resolution (the feedback target is textureFeedbackScale times smaller)
+fn requiredMipLevel(dx: vec2f, dy: vec2f, size: vec2<u32>) -> u32 {
+    let texelSize = vec2f(size);
+    let footprint = max(length(dx * texelSize), length(dy * texelSize)) / textureFeedbackScale;
+    let level = floor(log2(max(footprint, 1.0)));
+    return u32(min(level, f32(kFeedbackMaxMipLevels - 1u)));
+}
+
+fn recordTextureFeedback(slot: u32, mipLevel: u32) {
+    let index = materialUniforms.materialIndex * kFeedbackSlotCount + slot;
+    let value = kFeedbackMaxMipLevels - mipLevel;
+
+    // Most fragments of a material agree, so test before the contended atomic
+    if (atomicLoad(&textureFeedback[index]) < value) {
+        atomicMax(&textureFeedback[index], value);
+    }
+}
+
+@fragment
+fn fs_texture_feedback(in: VertexOutput) {
+    let dx = dpdx(in.texCoord0);
+    let dy = dpdy(in.texCoord0);
+    let mask = materialUniforms.textureMask;
+
+    if ((mask & 1u) != 0u) {
+        recordTextureFeedback(0u, requiredMipLevel(dx, dy, textureDimensions(baseColorTexture)));
+    }
+    if ((mask & 2u) != 0u) {
+        recordTextureFeedback(1u, requiredMipLevel(dx, dy,
+                                                   textureDimensions(metallicRoughnessTexture)));
+    }
+    if ((mask & 4u) != 0u) {
+        recordTextureFeedback(2u, requiredMipLevel(dx, dy, textureDimensions(normalTexture)));
+    }
+    if ((mask & 8u) != 0u) {
+        recordTextureFeedback(3u, requiredMipLevel(dx, dy, textureDimensions(occlusionTexture)));
+    }
+    if ((mask & 16u) != 0u) {
+        recordTextureFeedback(4u, requiredMipLevel(dx, dy, textureDimensions(emissiveTexture)));
+    }
+}
+
+
+//=========================================================
+// Impostor Baking
+//=========================================================
+
+// Renders the first instance of a replicated model into one atlas view (orthographic)
+@vertex
+fn vs_impostor_bake(in: VertexInput) -> VertexOutput {
+    let geometry = applyGeometryTransform(in);
+
+    var output: VertexOutput;
+    output.position = impostorView.viewProjectionMatrix * vec4<f32>(geometry.position, 1.0);
+    output.color = in.color;
+    output.texCoord0 = in.texCoord0;
+    output.texCoord1 = in.texCoord1;
+    output.normalWorld = geometry.normal;
+    output.tangentWorld = geometry.tangent;
+    output.viewDirectionWorld = vec3<f32>(0.0);
+    return output;
+}
+
+@fragment
+fn fs_impostor_bake(in: VertexOutput) -> ImpostorBakeOutput {
+    let baseColor = textureSample(baseColorTexture, textureSampler, in.texCoord0) * in.color * materialUniforms.baseColorFactor;
+    let metallicRoughness = textureSample(metallicRoughnessTexture, textureSampler, in.texCoord0).rgb;
+    let ao = textureSample(occlusionTexture, textureSampler, in.texCoord0).r * materialUniforms.occlusionStrength;
+    let emissive = textureSample(emissiveTexture, textureSampler, in.texCoord0).rgb * materialUniforms.emissiveFactor;
+    let n = getNormal(in);
+
+    if (materialUniforms.alphaMode == 1) { // Mask mode
+        if (baseColor.a < materialUniforms.alphaCutoff) {
+            discard;
+        }
+    }
+
+    // Depth 0 (near plane) is one radius in front of the center, depth 1 one radius behind it
+    var output: ImpostorBakeOutput;
+    output.albedo = vec4f(baseColor.rgb, select(1.0, baseColor.a, materialUniforms.alphaMode == 2));
+    output.normalDepth = vec4f(n, 1.0 - 2.0 * in.position.z);
+    output.material = vec4f(ao,
+                            metallicRoughness.g * materialUniforms.roughnessFactor,
+                            metallicRoughness.b * materialUniforms.metallicFactor,
+                            1.0);
+    output.emissive = vec4f(emissive, 1.0);
+    return output;
+}
+
+
+//=========================================================
+// Impostor Rendering
+//=========================================================
+
+@vertex
+fn vs_impostor(in: ImpostorInstanceInput) -> ImpostorVertexOutput {
+    var corners = array<vec2f, 6>(vec2f(-1.0, -1.0), vec2f(1.0, -1.0), vec2f(1.0, 1.0),
+                                  vec2f(-1.0, -1.0), vec2f(1.0, 1.0), vec2f(-1.0, 1.0));
+    let corner = corners[in.vertexIndex];
+    let rotation = mat3x3f(in.rotation0.xyz, in.rotation1.xyz, in.rotation2.xyz);
+
+    // Quad facing the camera, built in atlas space (the rotation is orthonormal)
+    let center = in.centerRadius.xyz;
+    let viewDirection = normalize(transpose(rotation) * (globalUniforms.cameraPositionWorld - center));
+    let right = impostorRight(viewDirection);
+    let up = cross(viewDirection, right);
+    let offset = right * corner.x + up * corner.y;
+    let worldPosition = center + rotation * offset * in.centerRadius.w;
+
+    var output: ImpostorVertexOutput;
+    output.position = globalUniforms.projectionMatrix * globalUniforms.viewMatrix * vec4<f32>(worldPosition, 1.0);
+    output.offset = offset;
+    output.viewDirection = viewDirection;
+    output.centerRadius = in.centerRadius;
+    output.tint = in.tint;
+    output.rotation0 = in.rotation0.xyz;
+    output.rotation1 = in.rotation1.xyz;
+    output.rotation2 = in.rotation2.xyz;
+    return output;
+}
+
+@fragment
+fn fs_impostor(in: ImpostorVertexOutput) -> ImpostorFragmentOutput {
+
+    // Blend the four atlas views surrounding the view direction, weighted by coverage
+    let gridSize = f32(impostorGridSize);
+    let grid = (octahedralEncode(in.viewDirection) * 0.5 + 0.5) * gridSize - 0.5;
+    let base = clamp(floor(grid), vec2f(0.0), vec2f(gridSize - 2.0));
+    let blend = clamp(grid - base, vec2f(0.0), vec2f(1.0));
+
+    var coverage = 0.0;
+    var albedo = vec3f(0.0);
+    var normalDepth = vec4f(0.0);
+    var material = vec3f(0.0);
+    var emissive = vec3f(0.0);
+    for (var i = 0u; i < 4u; i++) {
+        let cell = vec2f(f32(i & 1u), f32(i >> 1u));
+        let cellWeights = mix(1.0 - blend, blend, cell);
+        let viewSample = sampleImpostorView(base + cell, in.offset);
+        let weight = cellWeights.x * cellWeights.y * viewSample.albedo.a;
+
+        coverage += weight;
+        albedo += viewSample.albedo.rgb * weight;
+        normalDepth += viewSample.normalDepth * weight;
+        material += viewSample.material.rgb * weight;
+        emissive += viewSample.emissive.rgb * weight;
+    }
+
+    if (coverage < 0.5) {
+        discard;
+    }
+    albedo /= coverage;
+    normalDepth /= coverage;
+    material /= coverage;
+    emissive /= coverage;
+
+    // Reconstruct the surface position from the baked depth
+    let rotation = mat3x3f(in.rotation0, in.rotation1, in.rotation2);
+    let localPosition = in.offset + in.viewDirection * normalDepth.w;
+    let worldPosition = in.centerRadius.xyz + rotation * localPosition * in.centerRadius.w;
+
+    var materialInfo: MaterialInfo;
+    materialInfo.baseColor = vec4f(albedo * in.tint.rgb, 1.0);
+    materialInfo.metallic = material.b;
+    materialInfo.perceptualRoughness = material.g;
+    materialInfo.f0_dielectric = vec3f(0.04);
+    materialInfo.specularWeight = 1.0;
+
+    let n = normalize(rotation * normalDepth.xyz);
+    let v = normalize(globalUniforms.cameraPositionWorld - worldPosition);
+
+    var color = getIBLColor(materialInfo, n, v, n);
+    color *= vec3f(material.r);
+    color += emissive;
+
+    let clipPosition = globalUniforms.projectionMatrix * globalUniforms.viewMatrix * vec4<f32>(worldPosition, 1.0);
+
+    var output: ImpostorFragmentOutput;
+    output.color = vec4f(toneMap(color), 1.0);
+    output.depth = clamp(clipPosition.z / clipPosition.w, 0.0, 1.0);
+    return output;
+}
@@ -0,0 +1,178 @@
+//=========================================================
+// Mesh processor (compute path)
+// - rawData: raw accessor bytes of one primitive (see Model::RawPrimitive)
+// - vertices: the model vertex buffer viewed as floats (Model::Vertex, 18 floats)
+// - Converts the attribute component types to floats, bakes the node transform into
+//   positions, normals and tangents, and writes the final vertex layout
+// - Must match ConvertVertices() in model.cpp, which is the CPU fallback
+//=========================================================
+
+
+//=========================================================
+// Constants
+//=========================================================
+
+const kWorkgroupSize = 64u;
+const kFloatsPerVertex = 18u;
+
+// glTF component types
+const kByte = 5120u;
+const kUnsignedByte = 5121u;
+const kShort = 5122u;
+const kUnsignedShort = 5123u;
+const kUnsignedInt = 5125u;
+
+// Attribute slots (same order as the Model::Vertex members)
+const kPosition = 0u;
+const kNormal = 1u;
+const kTangent = 2u;
+const kTexCoord0 = 3u;
+const kTexCoord1 = 4u;
+const kColor = 5u;
+
+
+//=========================================================
+// Structs
+//=========================================================
+
+// Attributes: x = byte offset, y = byte stride, z = component type,
+// w = component count | normalized << 8 (0 if the attribute is absent)
+struct MeshParams {
+    transform: mat4x4<f32>,
+    normalMatrix: mat3x3<f32>,
+    vertexCount: u32,
+    outputOffset: u32, // First float of the primitive in the bound vertex range
+    _pad0: u32,
+    _pad1: u32,
+    attributes: array<vec4<u32>, 6>,
+};
+
+
+//=========================================================
+// Bind Group Declarations
+//=========================================================
+
+@group(0) @binding(0) var<uniform> params: MeshParams;
+@group(0) @binding(1) var<storage, read> rawData: array<u32>;
+@group(0) @binding(2) var<storage, read_write> vertices: array<f32>;
+
+
+//=========================================================
+// Attribute Decoding
+//=========================================================
+
+fn loadBits(byteAddress: u32, bitCount: u32) -> u32 {
+    return extractBits(rawData[byteAddress / 4u], (byteAddress % 4u) * 8u, bitCount);
+}
+
+fn loadSignedBits(byteAddress: u32, bitCount: u32) -> i32 {
+    return extractBits(bitcast<i32>(rawData[byteAddress / 4u]), (byteAddress % 4u) * 8u,
+                       bitCount);
+}
+
+// Must match NormalizeComponent() in model.cpp
+fn normalizeComponent(value: f32, componentType: u32, normalized: bool) -> f32 {
+    if (!normalized) {
+        return value;
+    }
+
+    switch componentType {
+        case kByte: { return max(value / 127.0, -1.0); }
+        case kUnsignedByte: { return value / 255.0; }
+        case kShort: { return max(value / 32767.0, -1.0); }
+        case kUnsignedShort: { return value / 65535.0; }
+        default: { return value; }
+    }
+}
+
+fn readComponent(byteAddress: u32, componentType: u32, normalized: bool) -> f32 {
+    var value: f32;
+    switch componentType {
+        case kByte: { value = f32(loadSignedBits(byteAddress, 8u)); }
+        case kUnsignedByte: { value = f32(loadBits(byteAddress, 8u)); }
+        case kShort: { value = f32(loadSignedBits(byteAddress, 16u)); }
+        case kUnsignedShort: { value = f32(loadBits(byteAddress, 16u)); }
+        case kUnsignedInt: { value = f32(rawData[byteAddress / 4u]); }
+        default: { value = bitcast<f32>(rawData[byteAddress / 4u]); }
+    }
+    return normalizeComponent(value, componentType, normalized);
+}
+
+// Reads element 'index' of an attribute; missing components are taken from 'fallback'
+fn readAttribute(slot: u32, index: u32, fallback: vec4<f32>) -> vec4<f32> {
+    let attribute = params.attributes[slot];
+    let componentType = attribute.z;
+    let componentCount = min(attribute.w & 0xffu, 4u);
+    let normalized = (attribute.w >> 8u) != 0u;
+
+    var componentSize = 4u;
+    if (componentType == kByte || componentType == kUnsignedByte) {
+        componentSize = 1u;
+    } else if (componentType == kShort || componentType == kUnsignedShort) {
+        componentSize = 2u;
+    }
+
+    var result = fallback;
+    let element = attribute.x + index * attribute.y;
+    for (var c = 0u; c < componentCount; c++) {
+        result[c] = readComponent(element + c * componentSize, componentType, normalized);
+    }
+    return result;
+}
+
+fn hasAttribute(slot: u32) -> bool {
+    return params.attributes[slot].w != 0u;
+}
+
+
+//=========================================================
+// Compute Shader Entry Point
+//=========================================================
+
+@compute @workgroup_size(kWorkgroupSize)
+fn processVertices(@builtin(global_invocation_id) id: vec3<u32>,
+                   @builtin(num_workgroups) workgroupCount: vec3<u32>) {
+    // Large primitives need more invocations than one dispatch dimension allows
+    let invocationCount = workgroupCount.x * kWorkgroupSize;
+    let tangentMatrix = mat3x3<f32>(params.transform[0].xyz, params.transform[1].xyz,
+                                    params.transform[2].xyz);
+
+    for (var i = id.x; i < params.vertexCount; i += invocationCount) {
+        // Position
+        let position = readAttribute(kPosition, i, vec4<f32>(0.0));
+        let transformedPosition = (params.transform * vec4<f32>(position.xyz, 1.0)).xyz;
+
+        // Normal (default to 0, 0, 1 if not provided)
+        var normal = vec4<f32>(0.0, 0.0, 1.0, 0.0);
+        if (hasAttribute(kNormal)) {
+            normal = readAttribute(kNormal, i, vec4<f32>(0.0));
+        }
+        let transformedNormal = normalize(params.normalMatrix * normal.xyz);
+
+        // Tangent (default to 0, 0, 0, 1 if not provided), preserving handedness (w)
+        var tangent = vec4<f32>(0.0, 0.0, 0.0, 1.0);
+        if (hasAttribute(kTangent)) {
+            let t = readAttribute(kTangent, i, vec4<f32>(0.0, 0.0, 0.0, 1.0));
+            tangent = vec4<f32>(normalize(tangentMatrix * t.xyz), t.w);
+        }
+
+        // Texture coordinates and color (alpha 1 for RGB colors)
+        let texCoord0 = readAttribute(kTexCoord0, i, vec4<f32>(0.0));
+        let texCoord1 = readAttribute(kTexCoord1, i, vec4<f32>(0.0));
+        let color = readAttribute(kColor, i, vec4<f32>(1.0));
+
+        let base = params.outputOffset + i * kFloatsPerVertex;
+        for (var c = 0u; c < 3u; c++) {
+            vertices[base + c] = transformedPosition[c];
+            vertices[base + 3u + c] = transformedNormal[c];
+        }
+        for (var c = 0u; c < 4u; c++) {
+            vertices[base + 6u + c] = tangent[c];
+            vertices[base + 14u + c] = color[c];
+        }
+        for (var c = 0u; c < 2u; c++) {
+            vertices[base + 10u + c] = texCoord0[c];
+            vertices[base + 12u + c] = texCoord1[c];
+        }
+    }
+}
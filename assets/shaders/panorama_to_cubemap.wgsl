@@ -1,7 +1,7 @@
 //=========================================================
 // Panorama (equirectangular) to cubemap conversion
 // - Input: 2D equirectangular texture (texture_2d<f32>)
-// - Output: RGBA16F cubemap as 2D-array storage (6 layers)
+// - Output: RGBA16F cubemap as 2D-array storage (6 layers), or an octahedral map (1 layer)
 // - Per-face selection via group(1) faceIndex; manual bilinear sampling
 //=========================================================
 
@@ -75,29 +75,26 @@ fn uvToDirection(uv: vec2<f32>, face: u32) -> vec3<f32> {
     return normalize(faceDirs[face] + (u * rightVectors[face]) + (v * upVectors[face]));
 }
 
-
-//=========================================================
-// Compute Shader Entry Point
-//=========================================================
-
-@compute @workgroup_size(8, 8)
-fn panoramaToCubemap(@builtin(global_invocation_id) id: vec3<u32>) {
-
-    // Get the dimensions of the output texture (assumed to be square)
-    let outputSize = textureDimensions(outputTexture).xy;
-    if (id.x >= outputSize.x || id.y >= outputSize.y) { 
-        return; 
+// Octahedral mapping of [-1, 1]^2 to unit directions (+Y at the center). Must match
+// octahedralDecode() in gltf_pbr.wgsl.
+fn octahedralFold(n: vec3<f32>) -> vec3<f32> {
+    if (n.z >= 0.0) {
+        return n;
     }
+    let signs = select(vec2<f32>(-1.0), vec2<f32>(1.0), n.xy >= vec2<f32>(0.0));
+    return vec3<f32>((1.0 - abs(n.yx)) * signs, n.z);
+}
 
-    // Convert pixel coordinates (id.xy) to normalized [0,1] UV coordinates.
-    let uvDst = vec2<f32>(f32(id.x) / f32(outputSize.x), f32(id.y) / f32(outputSize.y));
-    let dir = uvToDirection(uvDst, faceIndex);
+fn octahedralDecode(e: vec2<f32>) -> vec3<f32> {
+    return normalize(octahedralFold(vec3<f32>(e, 1.0 - abs(e.x) - abs(e.y))).xzy);
+}
+
+// Samples the panorama in the given direction with manual bilinear filtering
+fn samplePanorama(dir: vec3<f32>) -> vec4<f32> {
 
     // Convert the direction to equirectangular UV coordinates.
     let uvSrc = clamp(dirToUV(dir), vec2<f32>(0.0), vec2<f32>(1.0));
 
-    // --- Manual Bilinear Filtering ---
-    
     // Obtain the dimensions of the input (panorama) texture.
     let dims = vec2<i32>(textureDimensions(inputTexture));
     let width = f32(dims.x);
@@ -130,10 +127,43 @@ fn panoramaToCubemap(@builtin(global_invocation_id) id: vec3<u32>) {
     // Interpolate horizontally, then vertically.
     let top = mix(c00, c10, fx);
     let bottom = mix(c01, c11, fx);
-    let color = mix(top, bottom, fy);
+    return mix(top, bottom, fy);
+}
+
+
+//=========================================================
+// Compute Shader Entry Point
+//=========================================================
+
+@compute @workgroup_size(8, 8)
+fn panoramaToCubemap(@builtin(global_invocation_id) id: vec3<u32>) {
+
+    // Get the dimensions of the output texture (assumed to be square)
+    let outputSize = textureDimensions(outputTexture).xy;
+    if (id.x >= outputSize.x || id.y >= outputSize.y) { 
+        return; 
+    }
 
-    // --- End Manual Filtering ---
+    // Convert pixel coordinates (id.xy) to normalized [0,1] UV coordinates.
+    let uvDst = vec2<f32>(f32(id.x) / f32(outputSize.x), f32(id.y) / f32(outputSize.y));
+    let dir = uvToDirection(uvDst, faceIndex);
 
     // Write the color to the output cubemap face.
-    textureStore(outputTexture, id.xy, faceIndex, color);
+    textureStore(outputTexture, id.xy, faceIndex, samplePanorama(dir));
+}
+
+// Writes the whole sphere into layer 0 in a single dispatch (texel centers, so the mirrored
+// outer edges line up for seam-aware filtering)
+@compute @workgroup_size(8, 8)
+fn panoramaToOctahedral(@builtin(global_invocation_id) id: vec3<u32>) {
+
+    let outputSize = textureDimensions(outputTexture).xy;
+    if (id.x >= outputSize.x || id.y >= outputSize.y) {
+        return;
+    }
+
+    let uvDst = (vec2<f32>(id.xy) + 0.5) / vec2<f32>(outputSize);
+    let dir = octahedralDecode(uvDst * 2.0 - 1.0);
+
+    textureStore(outputTexture, id.xy, 0u, samplePanorama(dir));
 }
@@ -3,6 +3,7 @@
 #include <cctype>
 #include <chrono>
 #include <iostream>
+#include <utility>
 
 // Third-Party Library Headers
 #include <GLFW/glfw3.h>
@@ -13,6 +14,8 @@
 
 // Project Headers
 #include "application.h"
+#include "asset_archive.h"
+#include "frame_time_recorder.h"
 
 // Static Application Instance
 Application *Application::s_instance = nullptr;
@@ -22,9 +25,20 @@ Application *Application::s_instance = nullptr;
 
 #if defined(__EMSCRIPTEN__)
 
-extern "C" void wasm_OnDropFile(const char *filename, uint8_t *data, int length) {
-    std::string filenameStr(filename);
-    Application::GetInstance()->OnFileDropped(filenameStr, data, length);
+extern "C" void wasm_OnDropFileBegin(const char *filename, double size) {
+    Application::GetInstance()->OnFileStreamBegin(filename, static_cast<uint64_t>(size));
+}
+
+extern "C" void wasm_OnDropFileData(uint8_t *data, int length) {
+    Application::GetInstance()->OnFileStreamData(data, length);
+}
+
+extern "C" void wasm_OnDropFileEnd() {
+    Application::GetInstance()->OnFileStreamEnd();
+}
+
+extern "C" void wasm_OnDropFileAbort() {
+    Application::GetInstance()->OnFileStreamAbort();
 }
 
 void EmscriptenSetDropCallback() {
@@ -66,6 +80,16 @@ void EmscriptenSetDropCallback() {
             event.preventDefault();
         };
 
+        // Reader of the file being streamed; a new drop cancels it
+        let activeReader = null;
+        const abortActiveDrop = () => {
+            if (activeReader) {
+                activeReader.cancel();
+                activeReader = null;
+                Module.ccall('wasm_OnDropFileAbort', 'void', [], []);
+            }
+        };
+
         canvas.ondrop = async (event) => {
             event.preventDefault();
 
@@ -75,10 +99,10 @@ void EmscriptenSetDropCallback() {
             }
 
             const extension = file.name.slice(file.name.lastIndexOf('.') + 1).toLowerCase();
-            if (extension !== 'glb' && extension !== 'hdr') {
+            if (extension !== 'glb' && extension !== 'hdr' && extension !== 'exr') {
                 showErrorPopup(
                     'Unsupported file type: ' + file.name +
-                        '. Only .glb and .hdr files are supported.'
+                        '. Only .glb, .hdr and .exr files are supported.'
                 );
                 return;
             }
@@ -87,40 +111,55 @@ void EmscriptenSetDropCallback() {
                 'Dropped file: ' + file.name + ' (Size: ' + file.size + ' bytes)'
             );
 
-            const reader = new FileReader();
-            reader.onload = (e) => {
-                const data = new Uint8Array(e.target.result);
+            abortActiveDrop();
 
-                const dataPtr = Module._malloc(data.length);
-                if (!dataPtr) {
-                    showErrorPopup('Memory allocation failed for file data!');
+            const nameLength = Module.lengthBytesUTF8(file.name) + 1;
+            const filenamePtr = Module._malloc(nameLength);
+            if (!filenamePtr) {
+                showErrorPopup('Memory allocation failed for filename!');
+                return;
+            }
+            Module.stringToUTF8(file.name, filenamePtr, nameLength);
+            Module.ccall('wasm_OnDropFileBegin', 'void', ['number', 'number'],
+                         [filenamePtr, file.size]);
+            Module._free(filenamePtr);
+
+            // Hand the file over chunk by chunk so it is processed while it is still being read.
+            // Chunks of a drop that was replaced by a newer one are dropped.
+            const reader = file.stream().getReader();
+            activeReader = reader;
+            for (;;) {
+                let chunk;
+                try {
+                    chunk = await reader.read();
+                } catch (error) {
+                    if (activeReader === reader) {
+                        showErrorPopup('Failed to read ' + file.name + ': ' + error);
+                        abortActiveDrop();
+                    }
                     return;
                 }
-                Module.HEAPU8.set(data, dataPtr);
-
-                const nameLength = Module.lengthBytesUTF8(file.name) + 1;
-                const filenamePtr = Module._malloc(nameLength);
-                if (!filenamePtr) {
-                    showErrorPopup('Memory allocation failed for filename!');
-                    Module._free(dataPtr);
+                if (activeReader !== reader) {
                     return;
                 }
-                Module.stringToUTF8(file.name, filenamePtr, nameLength);
-
-                console.log(
-                    "Sending file '" + file.name + "' (Size: " + data.length + ' bytes) to C++'
-                );
-                Module.ccall(
-                    'wasm_OnDropFile',
-                    'void',
-                    ['number', 'number', 'number'],
-                    [filenamePtr, dataPtr, data.length]
-                );
+                if (chunk.done) {
+                    break;
+                }
 
+                const dataPtr = Module._malloc(chunk.value.length);
+                if (!dataPtr) {
+                    showErrorPopup('Memory allocation failed for file data!');
+                    abortActiveDrop();
+                    return;
+                }
+                Module.HEAPU8.set(chunk.value, dataPtr);
+                Module.ccall('wasm_OnDropFileData', 'void', ['number', 'number'],
+                             [dataPtr, chunk.value.length]);
                 Module._free(dataPtr);
-                Module._free(filenamePtr);
-            };
-            reader.readAsArrayBuffer(file);
+            }
+
+            activeReader = null;
+            Module.ccall('wasm_OnDropFileEnd', 'void', [], []);
         };
     );
     // clang-format on
@@ -133,6 +172,28 @@ void EmscriptenSetDropCallback() {
 
 namespace {
 
+// Fixed camera orbit speed while a stress test is running, so every step sees the same views
+constexpr int kStressTestOrbitPixelsPerFrame = 4;
+
+// Maximum time the main thread waits for input before publishing a new snapshot (~250 Hz)
+constexpr double kInputWaitTimeout = 0.004;
+
+// Packed archive (see tools/asset_packer.cpp); loose files under ./assets are used if it is absent
+constexpr const char *kAssetArchiveFile = "./assets.pak";
+constexpr const char *kDefaultEnvironmentFile = "./assets/environments/helipad.hdr";
+constexpr const char *kDefaultModelFile = "./assets/models/DamagedHelmet.glb";
+
+// Merge submeshes and materials at load time to reduce draw calls, leave vertex conversion and
+// transforms to the GPU where possible, and decode images straight into GPU staging memory
+constexpr Model::LoadOptions kModelLoadOptions = {.m_mergeSubMeshes = true,
+                                                  .m_deduplicateMaterials = true,
+                                                  .m_gpuVertexProcessing = true,
+                                                  .m_deduplicateGeometry = true,
+                                                  .m_deferImageDecoding = true};
+
+// Material texture memory budget for the texture residency report
+constexpr uint64_t kTextureResidencyBudget = 256ull * 1024ull * 1024ull;
+
 void KeyCallback([[maybe_unused]] GLFWwindow *window, int key, [[maybe_unused]] int scancode,
                  int action, int mods) {
     static bool keyState[GLFW_KEY_LAST] = {false};
@@ -174,6 +235,9 @@ Application::Application(uint32_t width, uint32_t height) : m_width(width), m_he
 }
 
 Application::~Application() {
+    // The render thread uses the window surface, so stop it first
+    m_renderThread.reset();
+
     if (m_window) {
         glfwDestroyWindow(m_window);
     }
@@ -213,9 +277,17 @@ void Application::Run() {
                         });
 #endif
 
-    // Load the default environment and model
-    m_environment.Load("./assets/environments/helipad.hdr");
-    m_model.Load("./assets/models/DamagedHelmet.glb");
+    m_model.SetLoadOptions(kModelLoadOptions);
+
+    // Serve shaders and default assets from the packed archive when one is deployed
+    AssetArchive& archive = AssetArchive::GetMounted();
+    archive.Open(kAssetArchiveFile);
+
+    // Load the default environment and model (zero-copy views if they are in the archive)
+    const auto environmentData = archive.Find(kDefaultEnvironmentFile);
+    m_environment.Load(kDefaultEnvironmentFile, environmentData.data(), environmentData.size());
+    const auto modelData = archive.Find(kDefaultModelFile);
+    m_model.Load(kDefaultModelFile, modelData.data(), modelData.size());
 
     RepositionCamera(m_camera, m_model);
 
@@ -224,16 +296,25 @@ void Application::Run() {
 }
 
 void Application::MainLoop() {
+    // Startup work is not part of any frame
+    FrameTimeRecorder::GetInstance().Reset();
+
 #if defined(__EMSCRIPTEN__)
     // Pass a pointer to ProcessFrame via the Emscripten main loop
     emscripten_set_main_loop_arg([](void *arg) { static_cast<Application *>(arg)->ProcessFrame(); },
                                  this, 0, false);
 #else
+    // Frames are submitted from a dedicated thread; this thread handles input and window events
+    m_renderThread = std::make_unique<RenderThread>(m_renderer);
+    m_renderThread->Start();
+
     while (!glfwWindowShouldClose(m_window) && !m_quitApp) {
-        glfwPollEvents();
+        glfwWaitEventsTimeout(kInputWaitTimeout);
 
         ProcessFrame();
     }
+
+    m_renderThread->Stop();
 #endif
 }
 
@@ -242,12 +323,16 @@ void Application::ProcessFrame() {
     auto currentTime = std::chrono::high_resolution_clock::now();
     float deltaTime = 16.67f; // Default to ~60 FPS (16.67ms)
 
+    float frameTime = 0.0f;
+
     if (m_hasLastTime) {
         auto delta =
             std::chrono::duration_cast<std::chrono::microseconds>(currentTime - m_lastTime);
         deltaTime = delta.count() / 1000.0f; // Convert microseconds to milliseconds
+        frameTime = deltaTime;
 
-        // Clamp deltaTime to reasonable bounds (0-100ms) to handle frame drops
+        // Clamp deltaTime to reasonable bounds (0-100ms) to handle frame drops; the spike itself
+        // is recorded (and reported as a hitch) by the frame time recorder
         if (deltaTime <= 0.0f || deltaTime > 100.0f) {
             deltaTime = 16.67f;
         }
@@ -255,19 +340,58 @@ void Application::ProcessFrame() {
     m_lastTime = currentTime;
     m_hasLastTime = true;
 
+    // Feed the unclamped frame times to the stress test (if running). The render thread records
+    // its own frames; rendering inline, the previous frame ended when this one started.
+    if (m_renderThread) {
+        ProcessRenderedFrames();
+    } else {
+        if (frameTime > 0.0f) {
+            FrameTimeRecorder::GetInstance().RecordFrame(frameTime);
+        }
+        if (m_stressTest) {
+            UpdateStressTest(frameTime);
+        } else if (m_soakTest) {
+            UpdateSoakTest();
+        }
+    }
+
     // Convert milliseconds to seconds for model update
     float deltaTimeSeconds = deltaTime * 0.001f;
 
-    // Animate the model (if enabled)
-    m_model.Update(deltaTimeSeconds, m_animateModel);
+    // Animate the model (if enabled and no stress test is running)
+    m_model.Update(deltaTimeSeconds, m_animateModel && !m_stressTest);
 
-    // Render a frame
+    // Render a frame (or hand the state to the render thread)
     Renderer::CameraUniformsInput cameraInput{
         .viewMatrix = m_camera.GetViewMatrix(),
         .projectionMatrix = m_camera.GetProjectionMatrix(),
         .cameraPosition = m_camera.GetWorldPosition(),
     };
-    m_renderer.Render(m_model.GetTransform(), cameraInput);
+    if (m_renderThread) {
+        m_renderThread->PublishSnapshot(
+            {.m_modelMatrix = m_model.GetTransform(), .m_camera = cameraInput});
+    } else {
+        m_renderer.Render(m_model.GetTransform(), cameraInput);
+    }
+}
+
+void Application::ProcessRenderedFrames() {
+    // The stress and soak tests measure the frames submitted by the render thread
+    for (float frameTime : m_renderThread->TakeFrameTimes()) {
+        if (m_stressTest) {
+            UpdateStressTest(frameTime);
+        } else if (!m_soakTest || !UpdateSoakTest()) {
+            break; // The remaining frames were completed before the soak test switched assets
+        }
+    }
+}
+
+void Application::RunOnRenderer(std::function<void()> command) {
+    if (m_renderThread) {
+        m_renderThread->Execute(std::move(command));
+    } else {
+        command();
+    }
 }
 
 void Application::OnKeyPressed(int key, int mods) {
@@ -282,9 +406,95 @@ void Application::OnKeyPressed(int key, int mods) {
     } else if (key == GLFW_KEY_ESCAPE) {
         m_quitApp = true;
     } else if (key == GLFW_KEY_R) {
-        m_renderer.ReloadShaders();
+        RunOnRenderer([this]() { m_renderer.ReloadShaders(); });
     } else if (key == GLFW_KEY_HOME) {
         RepositionCamera(m_camera, m_model);
+    } else if (key >= GLFW_KEY_1 && key <= GLFW_KEY_5) {
+        // '1'-'5' toggle the debug views (overdraw, triangle density, texture fetches, submesh
+        // IDs, material IDs)
+        static const char *kDebugViewNames[] = {"None",           "Overdraw",
+                                                "Triangle density", "Texture fetches",
+                                                "Submesh IDs",    "Material IDs"};
+        auto debugView = static_cast<Renderer::DebugView>(key - GLFW_KEY_1 + 1);
+        RunOnRenderer([this, &debugView]() {
+            if (m_renderer.GetDebugView() == debugView) {
+                debugView = Renderer::DebugView::None;
+            }
+            m_renderer.SetDebugView(debugView);
+        });
+        std::cout << "Debug view: " << kDebugViewNames[static_cast<int>(debugView)] << std::endl;
+    } else if (key == GLFW_KEY_Q) {
+        // 'q' cycles the shading quality tiers (low, medium, high)
+        static const char *kQualityTierNames[] = {"Low", "Medium", "High"};
+        int tier = 0;
+        RunOnRenderer([this, &tier]() {
+            tier = (static_cast<int>(m_renderer.GetQualityTier()) + 1) % 3;
+            m_renderer.SetQualityTier(static_cast<Renderer::QualityTier>(tier), m_environment);
+        });
+        std::cout << "Quality tier: " << kQualityTierNames[tier] << std::endl;
+
+        // Frames measured before the rebuild belong to the previous tier
+        if (m_renderThread) {
+            m_renderThread->TakeFrameTimes();
+        }
+        FrameTimeRecorder::GetInstance().Reset();
+        if (m_stressTest) {
+            m_stressTest->RestartStep();
+        }
+    } else if (key == GLFW_KEY_I) {
+        // 'i' toggles impostors for distant instances (stress test scenes)
+        bool enabled = false;
+        RunOnRenderer([this, &enabled]() {
+            enabled = !m_renderer.GetImpostorsEnabled();
+            m_renderer.SetImpostorsEnabled(enabled);
+        });
+        std::cout << "Impostors: " << (enabled ? "On" : "Off") << std::endl;
+    } else if (key == GLFW_KEY_B) {
+        // 'b' switches the IBL map baking between the GPU and the CPU preprocessor
+        bool enabled = false;
+        RunOnRenderer([this, &enabled]() {
+            enabled = !m_renderer.GetCpuEnvironmentPreprocessing();
+            m_renderer.SetCpuEnvironmentPreprocessing(enabled, m_environment);
+        });
+        std::cout << "IBL preprocessing: " << (enabled ? "CPU" : "GPU") << std::endl;
+    } else if (key == GLFW_KEY_P) {
+        // 'p' prints frame-time percentiles and hitch attribution since the last report
+        FrameTimeRecorder::GetInstance().PrintSummary();
+        FrameTimeRecorder::GetInstance().Reset();
+    } else if (key == GLFW_KEY_L) {
+        // 'l' prints the material texture memory the visible mip levels need (texture LOD
+        // feedback) and a residency plan within kTextureResidencyBudget
+        Renderer::TextureResidency residency;
+        RunOnRenderer([this, &residency]() {
+            residency = m_renderer.GetTextureResidency(kTextureResidencyBudget);
+        });
+        constexpr double kMB = 1024.0 * 1024.0;
+        std::cout << "Texture residency: " << residency.m_sampledCount << " of "
+                  << residency.m_textureCount << " textures visible, "
+                  << residency.m_allMipsBytes / kMB << " MB all mips, "
+                  << residency.m_requiredBytes / kMB << " MB required, "
+                  << residency.m_plannedBytes / kMB << " MB planned (budget "
+                  << kTextureResidencyBudget / kMB << " MB, " << residency.m_readbackCount
+                  << " feedback readbacks)" << std::endl;
+    } else if (key == GLFW_KEY_T) {
+        // 't' runs a grid stress test, Shift-T a random scatter; pressing again aborts it
+        if (m_stressTest) {
+            std::cout << "Stress test aborted" << std::endl;
+            StopStressTest();
+        } else {
+            StartStressTest((mods & GLFW_MOD_SHIFT) ? StressTest::Layout::Scatter
+                                                    : StressTest::Layout::Grid);
+        }
+    } else if (key == GLFW_KEY_K) {
+        // 'k' runs a soak test over the default assets and the files dropped so far; pressing
+        // again aborts it
+        if (m_soakTest) {
+            std::cout << "Soak test aborted" << std::endl;
+            m_soakTest->PrintSummary();
+            StopSoakTest();
+        } else {
+            StartSoakTest();
+        }
     }
 }
 
@@ -292,24 +502,196 @@ void Application::OnResize(int width, int height) {
     m_width = width;
     m_height = height;
     m_camera.ResizeViewport(width, height);
-    m_renderer.Resize(width, height);
+
+    // Resizing must not wait for the render thread (presenting may need this thread to pump
+    // window messages)
+    if (m_renderThread) {
+        m_renderThread->Post([this, width, height]() { m_renderer.Resize(width, height); });
+    } else {
+        m_renderer.Resize(width, height);
+    }
 }
 
-void Application::OnFileDropped(const std::string& filename, uint8_t *data, int length) {
+void Application::OnFileDropped(const std::string& filename, const uint8_t *data,
+                                size_t length) {
     std::string extension = filename.substr(filename.find_last_of(".") + 1);
     std::transform(extension.begin(), extension.end(), extension.begin(),
                    [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
 
+    // Remember files dropped from disk for the soak test
+    const bool supported =
+        extension == "glb" || extension == "gltf" || extension == "hdr" || extension == "exr";
+    if (supported && !data && !m_soakTest &&
+        std::find(m_droppedFiles.begin(), m_droppedFiles.end(), filename) ==
+            m_droppedFiles.end()) {
+        m_droppedFiles.push_back(filename);
+    }
+
     if (extension == "glb" || extension == "gltf") {
+        if (m_stressTest) {
+            StopStressTest();
+        }
         std::cout << "Loading model: " << filename << std::endl;
-        m_model.Load(filename, data, length);
+        {
+            FrameTimeRecorder::ScopedPhase phase(FrameTimeRecorder::Phase::Loading);
+            m_model.Load(filename, data, length);
+        }
         RepositionCamera(m_camera, m_model);
-        m_renderer.UpdateModel(m_model);
-    } else if (extension == "hdr") {
+        RunOnRenderer([this]() { m_renderer.UpdateModel(m_model); });
+    } else if (extension == "hdr" || extension == "exr") {
         std::cout << "Loading environment: " << filename << std::endl;
-        m_environment.Load(filename, data, length);
-        m_renderer.UpdateEnvironment(m_environment);
+        {
+            FrameTimeRecorder::ScopedPhase phase(FrameTimeRecorder::Phase::Loading);
+            m_environment.Load(filename, data, length);
+        }
+        RunOnRenderer([this]() { m_renderer.UpdateEnvironment(m_environment); });
     } else {
         std::cerr << "Unsupported file type: " << filename << std::endl;
     }
+}
+
+void Application::OnFileStreamBegin(const std::string& filename, uint64_t size) {
+    m_streamFilename = filename;
+    m_streamData.clear();
+    m_modelStream.reset();
+
+    // Binary glTF files are processed as they arrive; anything else is collected first
+    std::string extension = filename.substr(filename.find_last_of(".") + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == "glb") {
+        std::cout << "Streaming model: " << filename << " (" << size << " bytes)" << std::endl;
+        m_streamedModel = std::make_unique<Model>();
+        m_streamedModel->SetLoadOptions(kModelLoadOptions);
+        m_modelStream = std::make_unique<Model::StreamLoader>(*m_streamedModel, filename);
+    } else {
+        m_streamData.reserve(static_cast<size_t>(size));
+    }
+}
+
+void Application::OnFileStreamData(const uint8_t *data, int length) {
+    FrameTimeRecorder::ScopedPhase phase(FrameTimeRecorder::Phase::Loading);
+    if (m_modelStream) {
+        m_modelStream->Append(data, static_cast<size_t>(length));
+    } else {
+        m_streamData.insert(m_streamData.end(), data, data + length);
+    }
+}
+
+void Application::OnFileStreamAbort() {
+    // Discard the partially streamed file
+    m_modelStream.reset();
+    m_streamedModel.reset();
+    std::vector<uint8_t>().swap(m_streamData);
+}
+
+void Application::OnFileStreamEnd() {
+    if (!m_modelStream) {
+        OnFileDropped(m_streamFilename, m_streamData.data(), m_streamData.size());
+        std::vector<uint8_t>().swap(m_streamData);
+        return;
+    }
+
+    bool loaded = false;
+    {
+        FrameTimeRecorder::ScopedPhase phase(FrameTimeRecorder::Phase::Loading);
+        loaded = m_modelStream->Finish();
+    }
+    m_modelStream.reset();
+
+    if (loaded) {
+        if (m_stressTest) {
+            StopStressTest();
+        }
+        m_model = std::move(*m_streamedModel);
+        RepositionCamera(m_camera, m_model);
+        RunOnRenderer([this]() { m_renderer.UpdateModel(m_model); });
+    }
+    m_streamedModel.reset();
+}
+
+void Application::StartStressTest(StressTest::Layout layout) {
+    if (m_soakTest) {
+        StopSoakTest();
+    }
+
+    StressTest::Config config;
+    config.m_layout = layout;
+
+    std::cout << "Starting stress test" << std::endl;
+    m_model.ResetOrientation();
+    m_stressTest = std::make_unique<StressTest>(m_model, config);
+}
+
+void Application::UpdateStressTest(float frameTimeMs) {
+    switch (m_stressTest->Advance(frameTimeMs)) {
+    case StressTest::Action::RebuildScene:
+        m_stressTest->BuildScene(m_model);
+        RepositionCamera(m_camera, m_model);
+        RunOnRenderer([this]() { m_renderer.UpdateModel(m_model); });
+        break;
+    case StressTest::Action::Finished:
+        m_stressTest->PrintSummary();
+        StopStressTest();
+        return;
+    case StressTest::Action::None:
+        break;
+    }
+
+    // Orbit at a fixed rate so every step renders the same sequence of views
+    m_camera.Tumble(kStressTestOrbitPixelsPerFrame, 0);
+}
+
+void Application::StopStressTest() {
+    // Restore the original model
+    m_model = m_stressTest->GetSourceModel();
+    m_stressTest.reset();
+
+    RepositionCamera(m_camera, m_model);
+    RunOnRenderer([this]() { m_renderer.UpdateModel(m_model); });
+}
+
+void Application::StartSoakTest() {
+    if (m_stressTest) {
+        StopStressTest();
+    }
+
+    SoakTest::Config config;
+    config.m_files = {kDefaultModelFile, kDefaultEnvironmentFile};
+    config.m_files.insert(config.m_files.end(), m_droppedFiles.begin(), m_droppedFiles.end());
+
+    std::cout << "Starting soak test (" << config.m_files.size() << " files)" << std::endl;
+    m_soakTest = std::make_unique<SoakTest>(config);
+}
+
+bool Application::UpdateSoakTest() {
+    const SoakTest::Action action = m_soakTest->Advance();
+    if (action == SoakTest::Action::None) {
+        return true;
+    }
+
+    Renderer::ResourceStats resources;
+    RunOnRenderer([this, &resources]() { resources = m_renderer.GetResourceStats(); });
+    m_soakTest->RecordCycle(resources);
+
+    if (action == SoakTest::Action::Finished) {
+        m_soakTest->PrintSummary();
+        StopSoakTest();
+        return false;
+    }
+
+    // Switch through the same path as a dropped file (zero-copy views of archived defaults)
+    const std::string filename = m_soakTest->BeginSwitch();
+    const auto data = AssetArchive::GetMounted().Find(filename);
+    OnFileDropped(filename, data.data(), data.size());
+
+    // Frames the render thread completed before the switch do not show the new asset
+    if (m_renderThread) {
+        m_renderThread->TakeFrameTimes();
+    }
+    return false;
+}
+
+void Application::StopSoakTest() {
+    m_soakTest.reset();
 }
\ No newline at end of file
@@ -3,14 +3,20 @@
 // Standard Library Headers
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 // Project Headers
 #include "camera.h"
 #include "environment.h"
 #include "model.h"
 #include "orbit_controls.h"
+#include "render_thread.h"
 #include "renderer.h"
+#include "soak_test.h"
+#include "stress_test.h"
 
 // Forward Declarations
 struct GLFWwindow;
@@ -35,12 +41,24 @@ class Application {
     void Run();
     void OnKeyPressed(int key, int mods);
     void OnResize(int width, int height);
-    void OnFileDropped(const std::string& filename, uint8_t *data = 0, int length = 0);
+    void OnFileDropped(const std::string& filename, const uint8_t *data = 0, size_t length = 0);
+    void OnFileStreamBegin(const std::string& filename, uint64_t size);
+    void OnFileStreamData(const uint8_t *data, int length);
+    void OnFileStreamEnd();
+    void OnFileStreamAbort();
 
   private:
     // Private Member Functions
     void MainLoop();
     void ProcessFrame();
+    void ProcessRenderedFrames();
+    void RunOnRenderer(std::function<void()> command);
+    void StartStressTest(StressTest::Layout layout);
+    void UpdateStressTest(float frameTimeMs);
+    void StopStressTest();
+    void StartSoakTest();
+    bool UpdateSoakTest();
+    void StopSoakTest();
 
     // Static Instance
     static Application *s_instance;
@@ -58,6 +76,16 @@ class Application {
     Renderer m_renderer;
 
     std::unique_ptr<OrbitControls> m_controls;
+    std::unique_ptr<StressTest> m_stressTest;
+    std::unique_ptr<SoakTest> m_soakTest;
+    std::vector<std::string> m_droppedFiles; // Files dropped from disk, cycled by the soak test
+    std::unique_ptr<RenderThread> m_renderThread; // Native only; Emscripten renders inline
+
+    // File being streamed in (e.g. dropped in the browser)
+    std::string m_streamFilename;
+    std::vector<uint8_t> m_streamData; // Collected non-GLB files
+    std::unique_ptr<Model> m_streamedModel;
+    std::unique_ptr<Model::StreamLoader> m_modelStream;
 
     // Frame timing
     std::chrono::high_resolution_clock::time_point m_lastTime;
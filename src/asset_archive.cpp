@@ -0,0 +1,312 @@
+// Standard Library Headers
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+// Platform Headers
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Third-Party Library Headers
+#include <stb_image.h> // stbi_zlib_decode_* (implementation is compiled in model.cpp)
+
+// Project Headers
+#include "asset_archive.h"
+
+//----------------------------------------------------------------------
+// Internal Utility Functions
+
+namespace {
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool ReadFile(const std::string& filename, std::vector<uint8_t>& data) {
+    std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    return static_cast<bool>(file.read(reinterpret_cast<char *>(data.data()),
+                                       static_cast<std::streamsize>(data.size())));
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// AssetArchive Class Implementation
+
+AssetArchive::~AssetArchive() {
+    Close();
+}
+
+bool AssetArchive::Open(const std::string& filename) {
+    Close();
+
+    if (!MapFile(filename)) {
+        return false;
+    }
+
+    if (!ReadTableOfContents()) {
+        std::cerr << "Invalid asset archive: " << filename << std::endl;
+        Close();
+        return false;
+    }
+
+    std::cout << "Mounted asset archive " << filename << " (" << m_entries.size() << " entries)"
+              << std::endl;
+    return true;
+}
+
+void AssetArchive::Close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_decompressed.clear();
+    UnmapFile();
+}
+
+std::span<const uint8_t> AssetArchive::Find(const std::string& name) {
+    const auto it = m_entries.find(NormalizeName(name));
+    if (it == m_entries.end()) {
+        return {};
+    }
+
+    const Entry& entry = it->second;
+    const uint8_t *stored = m_data + entry.m_offset;
+    if (entry.m_compression == Compression::None) {
+        return {stored, static_cast<size_t>(entry.m_size)};
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& decompressed = m_decompressed[it->first];
+    if (!decompressed) {
+        int length = 0;
+        char *inflated = stbi_zlib_decode_malloc_guesssize_headerflag(
+            reinterpret_cast<const char *>(stored), static_cast<int>(entry.m_storedSize),
+            static_cast<int>(entry.m_size), &length, 1);
+        if (!inflated || static_cast<uint64_t>(length) != entry.m_size) {
+            std::cerr << "Failed to decompress archive entry: " << it->first << std::endl;
+            std::free(inflated);
+            m_decompressed.erase(it->first);
+            return {};
+        }
+
+        decompressed = std::make_unique<std::vector<uint8_t>>(inflated, inflated + length);
+        std::free(inflated);
+    }
+    return {decompressed->data(), decompressed->size()};
+}
+
+bool AssetArchive::IsOpen() const noexcept {
+    return m_data != nullptr;
+}
+
+size_t AssetArchive::GetEntryCount() const noexcept {
+    return m_entries.size();
+}
+
+AssetArchive& AssetArchive::GetMounted() {
+    static AssetArchive archive;
+    return archive;
+}
+
+std::string AssetArchive::NormalizeName(const std::string& path) {
+    std::string name = path;
+    for (char& c : name) {
+        if (c == '\\') {
+            c = '/';
+        }
+    }
+    while (name.starts_with("./")) {
+        name.erase(0, 2);
+    }
+    return name;
+}
+
+//----------------------------------------------------------------------
+// Private Member Functions
+
+bool AssetArchive::MapFile(const std::string& filename) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize{};
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    const void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<const uint8_t *>(view);
+    m_size = static_cast<uint64_t>(fileSize.QuadPart);
+    return true;
+#elif defined(__EMSCRIPTEN__)
+    // The preloaded file system lives in memory already; read the archive in one go
+    if (!ReadFile(filename, m_fallbackData) || m_fallbackData.empty()) {
+        m_fallbackData.clear();
+        return false;
+    }
+    m_data = m_fallbackData.data();
+    m_size = m_fallbackData.size();
+    return true;
+#else
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat status{};
+    void *view = MAP_FAILED;
+    if (fstat(fd, &status) == 0 && status.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd); // The mapping keeps the file alive
+
+    if (view == MAP_FAILED) {
+        // Fall back to reading the whole file (e.g. file systems without mmap support)
+        if (!ReadFile(filename, m_fallbackData) || m_fallbackData.empty()) {
+            m_fallbackData.clear();
+            return false;
+        }
+        m_data = m_fallbackData.data();
+        m_size = m_fallbackData.size();
+        return true;
+    }
+
+    m_data = static_cast<const uint8_t *>(view);
+    m_size = static_cast<uint64_t>(status.st_size);
+    return true;
+#endif
+}
+
+void AssetArchive::UnmapFile() {
+    if (!m_data) {
+        return;
+    }
+
+    if (!m_fallbackData.empty()) {
+        m_fallbackData = {};
+    } else {
+#if defined(_WIN32)
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+        m_mappingHandle = nullptr;
+        m_fileHandle = nullptr;
+#elif !defined(__EMSCRIPTEN__)
+        munmap(const_cast<uint8_t *>(m_data), static_cast<size_t>(m_size));
+#endif
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool AssetArchive::ReadTableOfContents() {
+    if (m_size < sizeof(Header)) {
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, m_data, sizeof(Header));
+    if (std::memcmp(header.m_magic, kMagic, sizeof(kMagic)) != 0 || header.m_version != kVersion) {
+        return false;
+    }
+    if (header.m_tocOffset > m_size || header.m_tocSize > m_size - header.m_tocOffset) {
+        return false;
+    }
+
+    uint64_t cursor = header.m_tocOffset;
+    const uint64_t tocEnd = header.m_tocOffset + header.m_tocSize;
+    for (uint32_t i = 0; i < header.m_entryCount; ++i) {
+        if (tocEnd - cursor < sizeof(TocEntry)) {
+            return false;
+        }
+
+        TocEntry tocEntry;
+        std::memcpy(&tocEntry, m_data + cursor, sizeof(TocEntry));
+        cursor += sizeof(TocEntry);
+        if (tocEnd - cursor < tocEntry.m_nameLength) {
+            return false;
+        }
+
+        std::string name(reinterpret_cast<const char *>(m_data + cursor), tocEntry.m_nameLength);
+        cursor = std::min(AlignUp(cursor + tocEntry.m_nameLength, kTocAlignment), tocEnd);
+
+        // Reject entries pointing outside of the archive or with an unknown compression
+        if (tocEntry.m_offset > m_size || tocEntry.m_storedSize > m_size - tocEntry.m_offset) {
+            return false;
+        }
+        const auto compression = static_cast<Compression>(tocEntry.m_compression);
+        if (compression == Compression::None && tocEntry.m_size != tocEntry.m_storedSize) {
+            return false;
+        }
+        if (compression != Compression::None &&
+            (compression != Compression::Zlib ||
+             tocEntry.m_storedSize > std::numeric_limits<int>::max() ||
+             tocEntry.m_size > std::numeric_limits<int>::max())) {
+            return false;
+        }
+
+        m_entries[std::move(name)] = {tocEntry.m_offset, tocEntry.m_storedSize, tocEntry.m_size,
+                                      compression};
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------
+// Asset Loading
+
+std::string LoadTextAsset(const std::string& path, bool preferFiles) {
+    std::ifstream file;
+    if (preferFiles) {
+        file.open(path, std::ios::in | std::ios::binary);
+    }
+
+    if (!file.is_open()) {
+        const std::span<const uint8_t> data = AssetArchive::GetMounted().Find(path);
+        if (!data.empty()) {
+            return {reinterpret_cast<const char *>(data.data()), data.size()};
+        }
+        file.open(path, std::ios::in | std::ios::binary);
+    }
+
+    if (!file.is_open()) {
+        std::cerr << "Failed to open asset file: " + path + "\n";
+        return "";
+    }
+
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+// Standard Library Headers
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// AssetArchive Class
+//
+// Read-only view of a packed asset archive (shaders, default assets, baked caches). The archive is
+// memory-mapped and stored entries are served as zero-copy views into the mapping; compressed
+// entries are inflated once on first access and kept for the lifetime of the archive. Entry names
+// are relative paths such as "assets/shaders/gltf_pbr.wgsl".
+//
+// File layout (little-endian):
+//   Header    magic, version, entry count, table of contents offset and size
+//   Entries   entry data, each aligned to kEntryAlignment
+//   TOC       one TocEntry per entry, each followed by its name and padded to 8 bytes
+class AssetArchive {
+  public:
+    // Types
+    enum class Compression : uint32_t {
+        None = 0,
+        Zlib = 1,
+    };
+
+    struct Header {
+        char m_magic[8];
+        uint32_t m_version;
+        uint32_t m_entryCount;
+        uint64_t m_tocOffset;
+        uint64_t m_tocSize;
+    };
+
+    struct TocEntry {
+        uint64_t m_offset;     // Offset of the stored data from the start of the archive
+        uint64_t m_storedSize; // Size of the stored (possibly compressed) data
+        uint64_t m_size;       // Size of the data once decompressed
+        uint32_t m_compression;
+        uint32_t m_nameLength; // Length of the name following the entry (not null-terminated)
+    };
+
+    // Constants
+    static constexpr char kMagic[8] = {'G', 'L', 'T', 'F', 'V', 'P', 'A', 'K'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint64_t kEntryAlignment = 64;
+    static constexpr uint64_t kTocAlignment = 8;
+
+    // Constructor
+    AssetArchive() = default;
+
+    // Destructor
+    ~AssetArchive();
+
+    // Rule of 5
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+    AssetArchive(AssetArchive&&) = delete;
+    AssetArchive& operator=(AssetArchive&&) = delete;
+
+    // Public Interface
+    bool Open(const std::string& filename);
+    void Close();
+    std::span<const uint8_t> Find(const std::string& name); // Empty if the entry does not exist
+
+    // Accessors
+    bool IsOpen() const noexcept;
+    size_t GetEntryCount() const noexcept;
+
+    // Archive mounted by the application; Find() on it is safe from any thread
+    static AssetArchive& GetMounted();
+
+    // Normalizes a path to an entry name (strips "./" and converts backslashes)
+    static std::string NormalizeName(const std::string& path);
+
+  private:
+    // Types
+    struct Entry {
+        uint64_t m_offset = 0;
+        uint64_t m_storedSize = 0;
+        uint64_t m_size = 0;
+        Compression m_compression = Compression::None;
+    };
+
+    // Private Member Functions
+    bool MapFile(const std::string& filename);
+    void UnmapFile();
+    bool ReadTableOfContents();
+
+    // Private Member Variables
+    const uint8_t *m_data = nullptr;
+    uint64_t m_size = 0;
+    std::vector<uint8_t> m_fallbackData; // Whole file, on platforms without memory mapping
+#if defined(_WIN32)
+    void *m_fileHandle = nullptr;
+    void *m_mappingHandle = nullptr;
+#endif
+
+    std::unordered_map<std::string, Entry> m_entries;
+
+    std::mutex m_mutex; // Guards the decompressed entries
+    std::unordered_map<std::string, std::unique_ptr<std::vector<uint8_t>>> m_decompressed;
+};
+
+// Reads a text asset (e.g. a shader) from the mounted archive, falling back to the file system.
+// preferFiles reverses the order, so edited files on disk win (shader hot reload).
+std::string LoadTextAsset(const std::string& path, bool preferFiles = false);
@@ -0,0 +1,396 @@
+// Standard Library Headers
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <thread>
+
+// Platform Headers
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Project Headers
+#include "batched_file_reader.h"
+
+//----------------------------------------------------------------------
+// Internal Constants and Utility Functions
+
+namespace {
+
+#if defined(_WIN32) || defined(__EMSCRIPTEN__)
+
+bool ReadFile(batched_file_reader::File& file) {
+    std::ifstream stream(file.m_path, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!stream.is_open()) {
+        return false;
+    }
+
+    file.m_data.resize(static_cast<size_t>(stream.tellg()));
+    stream.seekg(0);
+    return static_cast<bool>(stream.read(reinterpret_cast<char *>(file.m_data.data()),
+                                         static_cast<std::streamsize>(file.m_data.size())));
+}
+
+#else
+
+// Opens the file and sizes its buffer; -1 if it cannot be read
+int OpenFile(batched_file_reader::File& file) {
+    const int fd = open(file.m_path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat status{};
+    if (fd < 0 || fstat(fd, &status) != 0 || !S_ISREG(status.st_mode)) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+
+    file.m_data.resize(static_cast<size_t>(status.st_size));
+    return fd;
+}
+
+bool ReadFile(int fd, batched_file_reader::File& file) {
+    size_t offset = 0;
+    while (offset < file.m_data.size()) {
+        const ssize_t result = pread(fd, file.m_data.data() + offset, file.m_data.size() - offset,
+                                     static_cast<off_t>(offset));
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            return false;
+        }
+        offset += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+#endif
+
+#if defined(__linux__)
+
+// Submission queue depth; longer batches are fed into the ring as reads complete
+constexpr uint32_t kRingEntries = 256;
+
+// Single reads are capped below the 2 GB limit of read()
+constexpr uint64_t kMaxReadSize = 1ull << 30;
+
+// Minimal io_uring instance driven through io_uring_setup/io_uring_enter
+class IoUring {
+  public:
+    ~IoUring() {
+        if (m_sqes) {
+            munmap(m_sqes, m_sqesSize);
+        }
+        if (m_cqRing && m_cqRing != m_sqRing) {
+            munmap(m_cqRing, m_cqRingSize);
+        }
+        if (m_sqRing) {
+            munmap(m_sqRing, m_sqRingSize);
+        }
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+    }
+
+    bool Init(uint32_t entries) {
+        io_uring_params params{};
+        m_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (m_fd < 0) {
+            return false;
+        }
+
+        m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap) {
+            m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+        }
+
+        m_sqRing = Map(m_sqRingSize, IORING_OFF_SQ_RING);
+        m_cqRing = singleMap ? m_sqRing : Map(m_cqRingSize, IORING_OFF_CQ_RING);
+        m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        m_sqes = static_cast<io_uring_sqe *>(Map(m_sqesSize, IORING_OFF_SQES));
+        if (!m_sqRing || !m_cqRing || !m_sqes) {
+            return false;
+        }
+
+        auto *sq = static_cast<uint8_t *>(m_sqRing);
+        auto *cq = static_cast<uint8_t *>(m_cqRing);
+        m_sqHead = reinterpret_cast<uint32_t *>(sq + params.sq_off.head);
+        m_sqTail = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+        m_sqMask = *reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+        m_sqArray = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+        m_cqHead = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+        m_cqTail = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+        m_cqMask = *reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        m_sqEntries = params.sq_entries;
+        m_cqEntries = params.cq_entries;
+        return true;
+    }
+
+    uint32_t GetFreeEntries() const {
+        const uint32_t head = std::atomic_ref<uint32_t>(*m_sqHead).load(std::memory_order_acquire);
+        return m_sqEntries - (m_sqTail[0] - head);
+    }
+
+    uint32_t GetCompletionCapacity() const {
+        return m_cqEntries;
+    }
+
+    void QueueRead(int fd, uint8_t *destination, uint32_t size, uint64_t offset,
+                   uint64_t userData) {
+        const uint32_t tail = *m_sqTail;
+        const uint32_t index = tail & m_sqMask;
+        io_uring_sqe& sqe = m_sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<uint64_t>(destination);
+        sqe.len = size;
+        sqe.off = offset;
+        sqe.user_data = userData;
+        m_sqArray[index] = index;
+        std::atomic_ref<uint32_t>(*m_sqTail).store(tail + 1, std::memory_order_release);
+    }
+
+    // Submits the queued reads and waits for at least one completion; returns the number of
+    // submitted entries or -errno
+    int SubmitAndWait(uint32_t submitCount) {
+        const long result =
+            syscall(__NR_io_uring_enter, m_fd, submitCount, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        return result < 0 ? -errno : static_cast<int>(result);
+    }
+
+    template <typename Handler> void ReapCompletions(const Handler& handler) {
+        uint32_t head = *m_cqHead;
+        const uint32_t tail = std::atomic_ref<uint32_t>(*m_cqTail).load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+            handler(cqe.user_data, cqe.res);
+        }
+        std::atomic_ref<uint32_t>(*m_cqHead).store(head, std::memory_order_release);
+    }
+
+  private:
+    void *Map(size_t size, off_t offset) const {
+        void *pointer =
+            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, offset);
+        return pointer == MAP_FAILED ? nullptr : pointer;
+    }
+
+    int m_fd = -1;
+    void *m_sqRing = nullptr;
+    void *m_cqRing = nullptr;
+    io_uring_sqe *m_sqes = nullptr;
+    size_t m_sqRingSize = 0;
+    size_t m_cqRingSize = 0;
+    size_t m_sqesSize = 0;
+    uint32_t *m_sqHead = nullptr;
+    uint32_t *m_sqTail = nullptr;
+    uint32_t *m_sqArray = nullptr;
+    uint32_t m_sqMask = 0;
+    uint32_t *m_cqHead = nullptr;
+    uint32_t *m_cqTail = nullptr;
+    io_uring_cqe *m_cqes = nullptr;
+    uint32_t m_cqMask = 0;
+    uint32_t m_sqEntries = 0;
+    uint32_t m_cqEntries = 0;
+};
+
+// Reads the opened files through io_uring. Returns false if the ring cannot be used; files whose
+// reads completed are marked as loaded, the others are left for the fallback.
+bool ReadWithIoUring(std::vector<batched_file_reader::File>& files, const std::vector<int>& fds,
+                     const std::function<void(batched_file_reader::File&)>& onLoaded) {
+    struct Read {
+        size_t m_file;
+        uint64_t m_offset;
+        uint64_t m_size;
+    };
+
+    std::deque<Read> pending;
+    std::vector<uint64_t> remaining(files.size(), 0);
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (fds[i] < 0 || files[i].m_loaded) {
+            continue;
+        }
+        remaining[i] = files[i].m_data.size();
+        for (uint64_t offset = 0; offset < remaining[i]; offset += kMaxReadSize) {
+            pending.push_back({i, offset, std::min(kMaxReadSize, remaining[i] - offset)});
+        }
+        if (remaining[i] == 0) {
+            files[i].m_loaded = true;
+            if (onLoaded) {
+                onLoaded(files[i]);
+            }
+        }
+    }
+    if (pending.empty()) {
+        return true;
+    }
+
+    IoUring ring;
+    if (!ring.Init(std::min<uint32_t>(static_cast<uint32_t>(pending.size()), kRingEntries))) {
+        return false;
+    }
+
+    // Reads in flight are identified by their slot; short reads are queued again for the rest
+    std::vector<Read> slots;
+    std::vector<size_t> freeSlots;
+    std::vector<bool> failed(files.size(), false);
+    uint32_t inFlight = 0;
+    uint32_t unsubmitted = 0;
+    while (!pending.empty() || inFlight > 0) {
+        while (!pending.empty() && ring.GetFreeEntries() > 0 &&
+               inFlight + unsubmitted < ring.GetCompletionCapacity()) {
+            const Read read = pending.front();
+            pending.pop_front();
+            if (failed[read.m_file]) {
+                continue;
+            }
+
+            size_t slot = slots.size();
+            if (freeSlots.empty()) {
+                slots.push_back(read);
+            } else {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+                slots[slot] = read;
+            }
+            ring.QueueRead(fds[read.m_file], files[read.m_file].m_data.data() + read.m_offset,
+                           static_cast<uint32_t>(read.m_size), read.m_offset, slot);
+            ++unsubmitted;
+        }
+        if (inFlight + unsubmitted == 0) {
+            break;
+        }
+
+        const int submitted = ring.SubmitAndWait(unsubmitted);
+        if (submitted < 0 && submitted != -EINTR && submitted != -EAGAIN) {
+            // Reads already handed to the kernel still complete into the buffers, so drop the
+            // ring only when nothing is in flight
+            if (inFlight == 0) {
+                return false;
+            }
+        } else if (submitted > 0) {
+            unsubmitted -= static_cast<uint32_t>(submitted);
+            inFlight += static_cast<uint32_t>(submitted);
+        }
+
+        ring.ReapCompletions([&](uint64_t slot, int32_t result) {
+            const Read read = slots[slot];
+            freeSlots.push_back(slot);
+            --inFlight;
+
+            batched_file_reader::File& file = files[read.m_file];
+            if (result == -EINTR || result == -EAGAIN) {
+                pending.push_back(read);
+                return;
+            }
+            if (result <= 0) {
+                // Errors and unexpected ends of file are left to the fallback
+                failed[read.m_file] = true;
+                return;
+            }
+
+            const uint64_t size = static_cast<uint64_t>(result);
+            if (size < read.m_size) {
+                pending.push_back({read.m_file, read.m_offset + size, read.m_size - size});
+            }
+            remaining[read.m_file] -= size;
+            if (remaining[read.m_file] == 0 && !failed[read.m_file]) {
+                file.m_loaded = true;
+                if (onLoaded) {
+                    onLoaded(file);
+                }
+            }
+        });
+    }
+    return true;
+}
+
+#endif
+
+} // namespace
+
+//----------------------------------------------------------------------
+// Batched File Reader Implementation
+
+namespace batched_file_reader {
+
+void Read(std::vector<File>& files, const std::function<void(File&)>& onLoaded) {
+    for (File& file : files) {
+        file.m_loaded = false;
+    }
+
+#if defined(_WIN32) || defined(__EMSCRIPTEN__)
+    auto readFile = [&](size_t i) { return ReadFile(files[i]); };
+#else
+    std::vector<int> fds(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        fds[i] = OpenFile(files[i]);
+    }
+
+#if defined(__linux__)
+    ReadWithIoUring(files, fds, onLoaded);
+#endif
+
+    auto readFile = [&](size_t i) { return fds[i] >= 0 && ReadFile(fds[i], files[i]); };
+#endif
+
+    // Fallback: the files that are not loaded yet are read on a thread pool
+    std::vector<size_t> unread;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!files[i].m_loaded) {
+            unread.push_back(i);
+        }
+    }
+
+#if defined(__EMSCRIPTEN__)
+    const size_t threadCount = 1;
+#else
+    const size_t threadCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1,
+                                                  std::max<size_t>(unread.size(), 1));
+#endif
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < unread.size(); i = next++) {
+            File& file = files[unread[i]];
+            file.m_loaded = readFile(unread[i]);
+            if (file.m_loaded && onLoaded) {
+                onLoaded(file);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    for (int fd : fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+} // namespace batched_file_reader
@@ -0,0 +1,25 @@
+#pragma once
+
+// Standard Library Headers
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace batched_file_reader {
+
+struct File {
+    std::string m_path;
+    std::vector<uint8_t> m_data;
+    bool m_loaded = false; // False if the file could not be opened or read
+};
+
+// Reads all files at once, so the latency of slow storage (network filesystems, cold NVMe) is
+// overlapped instead of paid per file. On Linux the reads are submitted to io_uring in one batch,
+// through the raw system calls so liburing is not needed. Where io_uring is unavailable (old
+// kernels, containers that block it) and on other platforms the files are read with pread on a
+// thread pool. onLoaded runs for each file as soon as its data is complete: on the calling thread
+// with io_uring, on the reading worker otherwise.
+void Read(std::vector<File>& files, const std::function<void(File&)>& onLoaded = {});
+
+} // namespace batched_file_reader
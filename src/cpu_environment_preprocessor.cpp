@@ -0,0 +1,698 @@
+// Standard Library Headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Third-Party Library Headers
+#include <glm/glm.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define IBL_USE_SSE 1
+#include <immintrin.h>
+#endif
+
+// Project Headers
+#include "cpu_environment_preprocessor.h"
+#include "exr_loader.h"
+
+//----------------------------------------------------------------------
+// Internal Constants and Types
+
+namespace {
+
+constexpr float kPi = 3.14159265359f; // Same value as PI in the shaders
+constexpr uint32_t kNumFaces = 6;
+constexpr uint32_t kSimdWidth = 4;
+
+// One RGBA texel
+struct Rgba {
+#if defined(IBL_USE_SSE)
+    __m128 m_value;
+#else
+    float m_value[4];
+#endif
+};
+
+// Importance sampling direction around +Z with the environment mip levels it reads
+struct SampleDirection {
+    glm::vec3 m_direction;
+    float m_weight = 0.0f; // NdotL
+    uint32_t m_level0 = 0;
+    uint32_t m_level1 = 0;
+    float m_levelBlend = 0.0f;
+};
+
+// GGX half vectors of one roughness for the BRDF LUT (structure of arrays, padded to kSimdWidth)
+struct HalfVectorTable {
+    std::vector<float> m_x;
+    std::vector<float> m_z;
+};
+
+} // namespace
+
+//----------------------------------------------------------------------
+// Internal Utility Functions
+
+namespace {
+
+inline Rgba LoadRgba(const float *texel) {
+#if defined(IBL_USE_SSE)
+    return {_mm_loadu_ps(texel)};
+#else
+    return {{texel[0], texel[1], texel[2], texel[3]}};
+#endif
+}
+
+inline void StoreRgba(float *texel, Rgba value) {
+#if defined(IBL_USE_SSE)
+    _mm_storeu_ps(texel, value.m_value);
+#else
+    std::copy(value.m_value, value.m_value + 4, texel);
+#endif
+}
+
+inline Rgba ZeroRgba() {
+#if defined(IBL_USE_SSE)
+    return {_mm_setzero_ps()};
+#else
+    return {{0.0f, 0.0f, 0.0f, 0.0f}};
+#endif
+}
+
+inline Rgba Add(Rgba a, Rgba b) {
+#if defined(IBL_USE_SSE)
+    return {_mm_add_ps(a.m_value, b.m_value)};
+#else
+    return {{a.m_value[0] + b.m_value[0], a.m_value[1] + b.m_value[1],
+             a.m_value[2] + b.m_value[2], a.m_value[3] + b.m_value[3]}};
+#endif
+}
+
+inline Rgba Scale(Rgba a, float s) {
+#if defined(IBL_USE_SSE)
+    return {_mm_mul_ps(a.m_value, _mm_set1_ps(s))};
+#else
+    return {{a.m_value[0] * s, a.m_value[1] * s, a.m_value[2] * s, a.m_value[3] * s}};
+#endif
+}
+
+// a + (b - a) * t, like mix() in WGSL
+inline Rgba Lerp(Rgba a, Rgba b, float t) {
+#if defined(IBL_USE_SSE)
+    return {_mm_add_ps(a.m_value, _mm_mul_ps(_mm_sub_ps(b.m_value, a.m_value), _mm_set1_ps(t)))};
+#else
+    Rgba result;
+    for (int c = 0; c < 4; ++c) {
+        result.m_value[c] = a.m_value[c] + (b.m_value[c] - a.m_value[c]) * t;
+    }
+    return result;
+#endif
+}
+
+// Replaces the alpha channel (the shaders store 1.0)
+inline Rgba WithOpaqueAlpha(Rgba value) {
+    alignas(16) float texel[4];
+    StoreRgba(texel, value);
+    texel[3] = 1.0f;
+    return LoadRgba(texel);
+}
+
+uint32_t MipLevelCount(uint32_t size) {
+    return static_cast<uint32_t>(std::log2(std::max(size, 1u))) + 1;
+}
+
+uint32_t MipSize(uint32_t size, uint32_t level) {
+    return std::max(size >> level, 1u);
+}
+
+// Bilinear filtering with clamp to edge; texels points at one layer of one mip level
+Rgba SampleBilinear(const float *texels, uint32_t size, float u, float v) {
+    const float x = u * static_cast<float>(size) - 0.5f;
+    const float y = v * static_cast<float>(size) - 0.5f;
+    const float fx0 = std::floor(x);
+    const float fy0 = std::floor(y);
+    const float fx = x - fx0;
+    const float fy = y - fy0;
+
+    const int last = static_cast<int>(size) - 1;
+    const int x0 = std::clamp(static_cast<int>(fx0), 0, last);
+    const int x1 = std::clamp(static_cast<int>(fx0) + 1, 0, last);
+    const int y0 = std::clamp(static_cast<int>(fy0), 0, last);
+    const int y1 = std::clamp(static_cast<int>(fy0) + 1, 0, last);
+    const float *row0 = texels + static_cast<size_t>(y0) * size * 4;
+    const float *row1 = texels + static_cast<size_t>(y1) * size * 4;
+
+#if defined(__AVX__)
+    // Both texels of a row in one register, blended vertically at once
+    const __m256 top = _mm256_set_m128(_mm_loadu_ps(row0 + x1 * 4), _mm_loadu_ps(row0 + x0 * 4));
+    const __m256 bottom =
+        _mm256_set_m128(_mm_loadu_ps(row1 + x1 * 4), _mm_loadu_ps(row1 + x0 * 4));
+    const __m256 rows =
+        _mm256_add_ps(top, _mm256_mul_ps(_mm256_sub_ps(bottom, top), _mm256_set1_ps(fy)));
+    return Lerp({_mm256_castps256_ps128(rows)}, {_mm256_extractf128_ps(rows, 1)}, fx);
+#else
+    const Rgba top = Lerp(LoadRgba(row0 + x0 * 4), LoadRgba(row0 + x1 * 4), fx);
+    const Rgba bottom = Lerp(LoadRgba(row1 + x0 * 4), LoadRgba(row1 + x1 * 4), fx);
+    return Lerp(top, bottom, fy);
+#endif
+}
+
+// Cube face and face coordinates of a direction (WebGPU cube map conventions, matching
+// uvToDirection below)
+void DirectionToFace(const glm::vec3& direction, uint32_t& face, float& u, float& v) {
+    const glm::vec3 a = glm::abs(direction);
+    float major = 0.0f;
+    float s = 0.0f;
+    float t = 0.0f;
+    if (a.x >= a.y && a.x >= a.z) {
+        face = direction.x >= 0.0f ? 0 : 1;
+        major = a.x;
+        s = direction.x >= 0.0f ? -direction.z : direction.z;
+        t = -direction.y;
+    } else if (a.y >= a.z) {
+        face = direction.y >= 0.0f ? 2 : 3;
+        major = a.y;
+        s = direction.x;
+        t = direction.y >= 0.0f ? direction.z : -direction.z;
+    } else {
+        face = direction.z >= 0.0f ? 4 : 5;
+        major = a.z;
+        s = direction.z >= 0.0f ? direction.x : -direction.x;
+        t = -direction.y;
+    }
+    u = 0.5f * (s / major + 1.0f);
+    v = 0.5f * (t / major + 1.0f);
+}
+
+// Trilinear cube map lookup at the mip levels precomputed for the sample
+Rgba SampleCube(const CpuEnvironmentPreprocessor::Image& cube, const glm::vec3& direction,
+                const SampleDirection& sample) {
+    uint32_t face = 0;
+    float u = 0.0f;
+    float v = 0.0f;
+    DirectionToFace(direction, face, u, v);
+
+    const uint32_t size0 = MipSize(cube.m_size, sample.m_level0);
+    const Rgba color0 = SampleBilinear(cube.m_mipLevels[sample.m_level0].data() +
+                                           static_cast<size_t>(face) * size0 * size0 * 4,
+                                       size0, u, v);
+    if (sample.m_levelBlend <= 0.0f) {
+        return color0;
+    }
+
+    const uint32_t size1 = MipSize(cube.m_size, sample.m_level1);
+    const Rgba color1 = SampleBilinear(cube.m_mipLevels[sample.m_level1].data() +
+                                           static_cast<size_t>(face) * size1 * size1 * 4,
+                                       size1, u, v);
+    return Lerp(color0, color1, sample.m_levelBlend);
+}
+
+// uvToDirection() in panorama_to_cubemap.wgsl and environment_prefilter.wgsl
+glm::vec3 UvToDirection(float u, float v, uint32_t face) {
+    static const glm::vec3 kFaceDirs[kNumFaces] = {{1.0f, 0.0f, 0.0f},  {-1.0f, 0.0f, 0.0f},
+                                                   {0.0f, 1.0f, 0.0f},  {0.0f, -1.0f, 0.0f},
+                                                   {0.0f, 0.0f, 1.0f},  {0.0f, 0.0f, -1.0f}};
+    static const glm::vec3 kUpVectors[kNumFaces] = {{0.0f, -1.0f, 0.0f}, {0.0f, -1.0f, 0.0f},
+                                                    {0.0f, 0.0f, 1.0f},  {0.0f, 0.0f, -1.0f},
+                                                    {0.0f, -1.0f, 0.0f}, {0.0f, -1.0f, 0.0f}};
+    static const glm::vec3 kRightVectors[kNumFaces] = {{0.0f, 0.0f, -1.0f}, {0.0f, 0.0f, 1.0f},
+                                                       {1.0f, 0.0f, 0.0f},  {1.0f, 0.0f, 0.0f},
+                                                       {1.0f, 0.0f, 0.0f},  {-1.0f, 0.0f, 0.0f}};
+
+    return glm::normalize(kFaceDirs[face] + (u * 2.0f - 1.0f) * kRightVectors[face] +
+                          (v * 2.0f - 1.0f) * kUpVectors[face]);
+}
+
+// octahedralDecode() in the shaders (+Y at the center)
+glm::vec3 OctahedralDecode(float ex, float ey) {
+    glm::vec3 n(ex, ey, 1.0f - std::abs(ex) - std::abs(ey));
+    if (n.z < 0.0f) {
+        const float x = (1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+        const float y = (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+        n.x = x;
+        n.y = y;
+    }
+    return glm::normalize(glm::vec3(n.x, n.z, n.y));
+}
+
+// Output texel direction of a cube face texel (texel corners, like the shaders) or an octahedral
+// map texel (texel centers)
+glm::vec3 TexelDirection(uint32_t x, uint32_t y, uint32_t size, uint32_t layer,
+                         uint32_t layerCount) {
+    const float fs = static_cast<float>(size);
+    if (layerCount == 1) {
+        return OctahedralDecode((static_cast<float>(x) + 0.5f) / fs * 2.0f - 1.0f,
+                                (static_cast<float>(y) + 0.5f) / fs * 2.0f - 1.0f);
+    }
+    return UvToDirection(static_cast<float>(x) / fs, static_cast<float>(y) / fs, layer);
+}
+
+// generateTBN() in environment_prefilter.wgsl
+glm::mat3 GenerateTBN(const glm::vec3& normal) {
+    glm::vec3 bitangent(0.0f, 1.0f, 0.0f);
+    const float NdotUp = glm::dot(normal, bitangent);
+    if (1.0f - std::abs(NdotUp) <= 1e-7f) {
+        bitangent = NdotUp > 0.0f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 0.0f, -1.0f);
+    }
+    const glm::vec3 tangent = glm::normalize(glm::cross(bitangent, normal));
+    bitangent = glm::cross(normal, tangent);
+    return glm::mat3(tangent, bitangent, normal);
+}
+
+float RadicalInverseVdC(uint32_t bits) {
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return static_cast<float>(bits) * 2.3283064365386963e-10f;
+}
+
+glm::vec2 Hammersley2D(uint32_t i, uint32_t count) {
+    return {static_cast<float>(i) / static_cast<float>(count), RadicalInverseVdC(i)};
+}
+
+float DGGX(float NdotH, float alpha) {
+    const float a = NdotH * alpha;
+    const float k = alpha / (1.0f - NdotH * NdotH + a * a);
+    return (k * k) / kPi;
+}
+
+// GGX half vector around +Z and its pdf (importanceSampleGGX())
+glm::vec4 ImportanceSampleGGX(uint32_t i, uint32_t count, float roughness) {
+    const glm::vec2 xi = Hammersley2D(i, count);
+    const float alpha = roughness * roughness;
+    const float cosTheta = std::clamp(
+        std::sqrt((1.0f - xi.y) / (1.0f + ((alpha * alpha) - 1.0f) * xi.y)), 0.0f, 1.0f);
+    const float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+    const float phi = 2.0f * kPi * xi.x;
+    return {sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta,
+            DGGX(cosTheta, alpha) / 4.0f};
+}
+
+// Splits computeLOD() into the two environment mip levels the trilinear lookup blends
+void SetSampleLevel(SampleDirection& sample, float pdf, float faceSize, uint32_t sampleCount,
+                    uint32_t levelCount) {
+    float lod = 0.5f * std::log2((6.0f * faceSize * faceSize) /
+                                 (static_cast<float>(sampleCount) * pdf));
+    if (!std::isfinite(lod)) {
+        lod = lod > 0.0f ? static_cast<float>(levelCount - 1) : 0.0f;
+    }
+    lod = std::clamp(lod, 0.0f, static_cast<float>(levelCount - 1));
+    sample.m_level0 = static_cast<uint32_t>(lod);
+    sample.m_level1 = std::min(sample.m_level0 + 1, levelCount - 1);
+    sample.m_levelBlend = lod - static_cast<float>(sample.m_level0);
+}
+
+std::vector<SampleDirection> BuildLambertianTable(uint32_t sampleCount, float faceSize,
+                                                  uint32_t levelCount) {
+    std::vector<SampleDirection> samples(sampleCount);
+    for (uint32_t i = 0; i < sampleCount; ++i) {
+        const glm::vec2 xi = Hammersley2D(i, sampleCount);
+        const float phi = 2.0f * kPi * xi.x;
+        const float cosTheta = std::sqrt(1.0f - xi.y);
+        const float sinTheta = std::sqrt(xi.y);
+
+        SampleDirection& sample = samples[i];
+        sample.m_direction = {sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta};
+        sample.m_weight = cosTheta;
+        SetSampleLevel(sample, cosTheta / kPi, faceSize, sampleCount, levelCount);
+    }
+    return samples;
+}
+
+// Reflected directions for N = V (prefilterSpecular()); samples below the horizon are dropped
+std::vector<SampleDirection> BuildSpecularTable(uint32_t sampleCount, float roughness,
+                                                float faceSize, uint32_t levelCount) {
+    std::vector<SampleDirection> samples;
+    samples.reserve(sampleCount);
+    for (uint32_t i = 0; i < sampleCount; ++i) {
+        const glm::vec4 h = ImportanceSampleGGX(i, sampleCount, roughness);
+        const glm::vec3 L = glm::normalize(2.0f * h.z * glm::vec3(h) - glm::vec3(0.0f, 0.0f, 1.0f));
+        if (L.z <= 0.0f) {
+            continue;
+        }
+
+        SampleDirection& sample = samples.emplace_back();
+        sample.m_direction = L;
+        sample.m_weight = L.z;
+        SetSampleLevel(sample, h.w, faceSize, sampleCount, levelCount);
+    }
+    return samples;
+}
+
+// Weighted average of the environment over the sample directions around the normal
+Rgba Integrate(const CpuEnvironmentPreprocessor::Image& environment,
+               const std::vector<SampleDirection>& samples, const glm::vec3& normal) {
+    const glm::mat3 tbn = GenerateTBN(normal);
+    Rgba sum = ZeroRgba();
+    float weightSum = 0.0f;
+    for (const SampleDirection& sample : samples) {
+        const glm::vec3 direction = tbn * sample.m_direction;
+        sum = Add(sum, Scale(SampleCube(environment, direction, sample), sample.m_weight));
+        weightSum += sample.m_weight;
+    }
+    return WithOpaqueAlpha(weightSum > 0.0f ? Scale(sum, 1.0f / weightSum) : sum);
+}
+
+// samplePanorama() in panorama_to_cubemap.wgsl
+Rgba LoadPanoramaTexel(const Environment::Texture& panorama, int x, int y) {
+    const size_t offset = (static_cast<size_t>(y) * panorama.m_width + x) * 4;
+    if (panorama.m_halfData.empty()) {
+        return LoadRgba(panorama.m_data.data() + offset);
+    }
+    const float texel[4] = {exr_loader::HalfToFloat(panorama.m_halfData[offset]),
+                            exr_loader::HalfToFloat(panorama.m_halfData[offset + 1]),
+                            exr_loader::HalfToFloat(panorama.m_halfData[offset + 2]),
+                            exr_loader::HalfToFloat(panorama.m_halfData[offset + 3])};
+    return LoadRgba(texel);
+}
+
+Rgba SamplePanorama(const Environment::Texture& panorama, const glm::vec3& direction) {
+    const float u =
+        std::clamp(0.5f + 0.5f * std::atan2(direction.z, direction.x) / kPi, 0.0f, 1.0f);
+    const float v = std::clamp(std::acos(std::clamp(direction.y, -1.0f, 1.0f)) / kPi, 0.0f, 1.0f);
+
+    const int width = static_cast<int>(panorama.m_width);
+    const int height = static_cast<int>(panorama.m_height);
+    const float srcX = u * static_cast<float>(width - 1);
+    const float srcY = v * static_cast<float>(height - 1);
+    const int x0 = static_cast<int>(std::floor(srcX));
+    const int y0 = static_cast<int>(std::floor(srcY));
+    const int x1 = (x0 + 1) % width;
+    const int y1 = std::min(y0 + 1, height - 1);
+    const float fx = srcX - std::floor(srcX);
+    const float fy = srcY - std::floor(srcY);
+
+    const Rgba top =
+        Lerp(LoadPanoramaTexel(panorama, x0, y0), LoadPanoramaTexel(panorama, x1, y0), fx);
+    const Rgba bottom =
+        Lerp(LoadPanoramaTexel(panorama, x0, y1), LoadPanoramaTexel(panorama, x1, y1), fx);
+    return Lerp(top, bottom, fy);
+}
+
+// The split-sum integral over the precomputed half vectors (computeLUT()), four at a time
+glm::vec2 IntegrateBRDF(const HalfVectorTable& table, float NdotV, float roughness,
+                        uint32_t sampleCount) {
+    const float vx = std::sqrt(1.0f - NdotV * NdotV);
+    const float vz = NdotV;
+    const float a = roughness * roughness;
+    const float a2 = a * a;
+
+#if defined(IBL_USE_SSE)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 vxs = _mm_set1_ps(vx);
+    const __m128 vzs = _mm_set1_ps(vz);
+    const __m128 a2s = _mm_set1_ps(a2);
+    const __m128 oneMinusA2 = _mm_set1_ps(1.0f - a2);
+    const __m128 NdotVs = _mm_set1_ps(NdotV);
+    const __m128 NdotV2Term = _mm_set1_ps(std::sqrt(NdotV * NdotV * (1.0f - a2) + a2));
+    const auto saturate = [&](__m128 x) { return _mm_min_ps(_mm_max_ps(x, zero), one); };
+
+    __m128 sumA = zero;
+    __m128 sumB = zero;
+    for (size_t i = 0; i < table.m_x.size(); i += kSimdWidth) {
+        const __m128 hx = _mm_loadu_ps(table.m_x.data() + i);
+        const __m128 hz = _mm_loadu_ps(table.m_z.data() + i);
+
+        // V.y = 0 and |L| = 1, so L.z = 2 VdotH H.z - V.z
+        const __m128 VdotHRaw = _mm_add_ps(_mm_mul_ps(vxs, hx), _mm_mul_ps(vzs, hz));
+        const __m128 NdotL = saturate(
+            _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.0f), VdotHRaw), hz), vzs));
+        const __m128 NdotH = saturate(hz);
+        const __m128 VdotH = saturate(VdotHRaw);
+        const __m128 mask = _mm_cmpgt_ps(NdotL, zero);
+
+        // vSmithGGXCorrelated()
+        const __m128 ggxV = _mm_mul_ps(NdotL, NdotV2Term);
+        const __m128 ggxL = _mm_mul_ps(
+            NdotVs, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(NdotL, NdotL), oneMinusA2), a2s)));
+        const __m128 G = _mm_div_ps(_mm_set1_ps(0.5f), _mm_add_ps(ggxV, ggxL));
+        const __m128 Gv = _mm_div_ps(_mm_mul_ps(_mm_mul_ps(G, VdotH), NdotL), NdotH);
+
+        const __m128 f1 = _mm_sub_ps(one, VdotH);
+        const __m128 f2 = _mm_mul_ps(f1, f1);
+        const __m128 Fc = _mm_mul_ps(_mm_mul_ps(f2, f2), f1);
+
+        sumA = _mm_add_ps(sumA, _mm_and_ps(mask, _mm_mul_ps(_mm_sub_ps(one, Fc), Gv)));
+        sumB = _mm_add_ps(sumB, _mm_and_ps(mask, _mm_mul_ps(Fc, Gv)));
+    }
+
+    alignas(16) float lanesA[kSimdWidth];
+    alignas(16) float lanesB[kSimdWidth];
+    _mm_store_ps(lanesA, sumA);
+    _mm_store_ps(lanesB, sumB);
+    float A = lanesA[0] + lanesA[1] + lanesA[2] + lanesA[3];
+    float B = lanesB[0] + lanesB[1] + lanesB[2] + lanesB[3];
+#else
+    float A = 0.0f;
+    float B = 0.0f;
+    for (size_t i = 0; i < table.m_x.size(); ++i) {
+        const float VdotHRaw = vx * table.m_x[i] + vz * table.m_z[i];
+        const float NdotL = std::clamp(2.0f * VdotHRaw * table.m_z[i] - vz, 0.0f, 1.0f);
+        if (NdotL <= 0.0f) {
+            continue;
+        }
+        const float NdotH = std::clamp(table.m_z[i], 0.0f, 1.0f);
+        const float VdotH = std::clamp(VdotHRaw, 0.0f, 1.0f);
+
+        const float ggxV = NdotL * std::sqrt(NdotV * NdotV * (1.0f - a2) + a2);
+        const float ggxL = NdotV * std::sqrt(NdotL * NdotL * (1.0f - a2) + a2);
+        const float G = 0.5f / (ggxV + ggxL);
+        const float Gv = (G * VdotH * NdotL) / NdotH;
+        const float Fc = std::pow(1.0f - VdotH, 5.0f);
+
+        A += (1.0f - Fc) * Gv;
+        B += Fc * Gv;
+    }
+#endif
+
+    constexpr float kScale = 4.0f;
+    const float scale = kScale / static_cast<float>(sampleCount);
+    return {A * scale, B * scale};
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// CpuEnvironmentPreprocessor Class implementation
+
+CpuEnvironmentPreprocessor::CpuEnvironmentPreprocessor(uint32_t threadCount) {
+#if defined(__EMSCRIPTEN__)
+    (void)threadCount; // No worker threads without pthreads
+    m_threadCount = 1;
+#else
+    m_threadCount =
+        threadCount > 0 ? threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+#endif
+}
+
+CpuEnvironmentPreprocessor::Image CpuEnvironmentPreprocessor::CreateImage(uint32_t size,
+                                                                          uint32_t layerCount,
+                                                                          bool mipmapped) {
+    Image image;
+    image.m_size = size;
+    image.m_layerCount = layerCount;
+    image.m_mipLevels.resize(mipmapped ? MipLevelCount(size) : 1);
+    for (uint32_t level = 0; level < image.m_mipLevels.size(); ++level) {
+        const size_t mipSize = MipSize(size, level);
+        image.m_mipLevels[level].assign(mipSize * mipSize * layerCount * 4, 0.0f);
+    }
+    return image;
+}
+
+void CpuEnvironmentPreprocessor::ConvertPanorama(const Environment::Texture& panorama,
+                                                 Image& environment) const {
+    if (panorama.m_width == 0 || (panorama.m_data.empty() && panorama.m_halfData.empty())) {
+        return;
+    }
+
+    const uint32_t size = environment.m_size;
+    std::vector<float>& texels = environment.m_mipLevels[0];
+    ParallelFor(size * environment.m_layerCount, [&](uint32_t row) {
+        const uint32_t layer = row / size;
+        const uint32_t y = row % size;
+        float *out = texels.data() + static_cast<size_t>(row) * size * 4;
+        for (uint32_t x = 0; x < size; ++x) {
+            const glm::vec3 direction = TexelDirection(x, y, size, layer, environment.m_layerCount);
+            StoreRgba(out + x * 4, SamplePanorama(panorama, direction));
+        }
+    });
+}
+
+void CpuEnvironmentPreprocessor::GenerateMipmaps(Image& image) const {
+    // 2x2 box filter per layer (mipmap_generator_cube.wgsl)
+    for (uint32_t level = 1; level < image.m_mipLevels.size(); ++level) {
+        const uint32_t sourceSize = MipSize(image.m_size, level - 1);
+        const uint32_t size = MipSize(image.m_size, level);
+        const std::vector<float>& source = image.m_mipLevels[level - 1];
+        std::vector<float>& destination = image.m_mipLevels[level];
+
+        ParallelFor(size * image.m_layerCount, [&](uint32_t row) {
+            const uint32_t layer = row / size;
+            const uint32_t y = row % size;
+            const uint32_t y0 = std::min(2 * y, sourceSize - 1);
+            const uint32_t y1 = std::min(2 * y + 1, sourceSize - 1);
+            const float *layerTexels =
+                source.data() + static_cast<size_t>(layer) * sourceSize * sourceSize * 4;
+            const float *row0 = layerTexels + static_cast<size_t>(y0) * sourceSize * 4;
+            const float *row1 = layerTexels + static_cast<size_t>(y1) * sourceSize * 4;
+            float *out = destination.data() + static_cast<size_t>(row) * size * 4;
+
+            for (uint32_t x = 0; x < size; ++x) {
+                const uint32_t x0 = std::min(2 * x, sourceSize - 1);
+                const uint32_t x1 = std::min(2 * x + 1, sourceSize - 1);
+                const Rgba sum = Add(Add(LoadRgba(row0 + x0 * 4), LoadRgba(row0 + x1 * 4)),
+                                     Add(LoadRgba(row1 + x0 * 4), LoadRgba(row1 + x1 * 4)));
+                StoreRgba(out + x * 4, Scale(sum, 0.25f));
+            }
+        });
+    }
+}
+
+void CpuEnvironmentPreprocessor::GenerateMaps(const Image& environment, Image& irradiance,
+                                              Image& prefilteredSpecular,
+                                              Image& brdfIntegrationLUT,
+                                              uint32_t sampleCount) const {
+    ComputeIrradiance(environment, irradiance, sampleCount);
+    ComputePrefilteredSpecular(environment, prefilteredSpecular, sampleCount);
+    ComputeBRDFIntegrationLUT(brdfIntegrationLUT, sampleCount);
+}
+
+void CpuEnvironmentPreprocessor::GenerateStage(Stage stage, const Image& environment,
+                                               Image& irradiance, Image& prefilteredSpecular,
+                                               Image& brdfIntegrationLUT,
+                                               uint32_t sampleCount) const {
+    switch (stage) {
+    case Stage::Irradiance:
+        ComputeIrradiance(environment, irradiance, sampleCount);
+        break;
+    case Stage::PrefilteredSpecular:
+        ComputePrefilteredSpecular(environment, prefilteredSpecular, sampleCount);
+        break;
+    case Stage::BRDFIntegrationLUT:
+        ComputeBRDFIntegrationLUT(brdfIntegrationLUT, sampleCount);
+        break;
+    }
+}
+
+uint32_t CpuEnvironmentPreprocessor::GetThreadCount() const noexcept {
+    return m_threadCount;
+}
+
+void CpuEnvironmentPreprocessor::ParallelFor(uint32_t count,
+                                             const std::function<void(uint32_t)>& body) const {
+    // Workers take the next index until all are done, which balances rows of different cost
+    std::atomic<uint32_t> next{0};
+    auto worker = [&]() {
+        for (uint32_t i = next++; i < count; i = next++) {
+            body(i);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32_t i = 1; i < std::min(m_threadCount, count); ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+}
+
+void CpuEnvironmentPreprocessor::ComputeIrradiance(const Image& environment, Image& irradiance,
+                                                   uint32_t sampleCount) const {
+    // The shader derives the sample mip levels from the output size
+    const uint32_t size = irradiance.m_size;
+    const std::vector<SampleDirection> samples =
+        BuildLambertianTable(sampleCount, static_cast<float>(size),
+                             static_cast<uint32_t>(environment.m_mipLevels.size()));
+
+    std::vector<float>& texels = irradiance.m_mipLevels[0];
+    ParallelFor(size * irradiance.m_layerCount, [&](uint32_t row) {
+        const uint32_t face = row / size;
+        const uint32_t y = row % size;
+        float *out = texels.data() + static_cast<size_t>(row) * size * 4;
+        for (uint32_t x = 0; x < size; ++x) {
+            const glm::vec3 normal = TexelDirection(x, y, size, face, kNumFaces);
+            StoreRgba(out + x * 4, Integrate(environment, samples, normal));
+        }
+    });
+}
+
+void CpuEnvironmentPreprocessor::ComputePrefilteredSpecular(const Image& environment,
+                                                            Image& prefilteredSpecular,
+                                                            uint32_t sampleCount) const {
+    const uint32_t levelCount = static_cast<uint32_t>(prefilteredSpecular.m_mipLevels.size());
+    const uint32_t layerCount = prefilteredSpecular.m_layerCount;
+
+    // One table per mip level (roughness); the octahedral map is twice the equivalent face size
+    std::vector<std::vector<SampleDirection>> tables(levelCount);
+    std::vector<uint32_t> firstRows(levelCount + 1, 0);
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        const uint32_t size = MipSize(prefilteredSpecular.m_size, level);
+        const float roughness =
+            levelCount > 1 ? static_cast<float>(level) / static_cast<float>(levelCount - 1) : 0.0f;
+        const float faceSize = static_cast<float>(size) * (layerCount == 1 ? 0.5f : 1.0f);
+        tables[level] = BuildSpecularTable(sampleCount, roughness, faceSize,
+                                           static_cast<uint32_t>(environment.m_mipLevels.size()));
+        firstRows[level + 1] = firstRows[level] + size * layerCount;
+    }
+
+    // Rows of all mip levels in one pass, so the small levels do not serialize
+    ParallelFor(firstRows[levelCount], [&](uint32_t index) {
+        const uint32_t level = static_cast<uint32_t>(
+            std::upper_bound(firstRows.begin(), firstRows.end(), index) - firstRows.begin() - 1);
+        const uint32_t size = MipSize(prefilteredSpecular.m_size, level);
+        const uint32_t row = index - firstRows[level];
+        const uint32_t layer = row / size;
+        const uint32_t y = row % size;
+        float *out =
+            prefilteredSpecular.m_mipLevels[level].data() + static_cast<size_t>(row) * size * 4;
+        for (uint32_t x = 0; x < size; ++x) {
+            const glm::vec3 normal = TexelDirection(x, y, size, layer, layerCount);
+            StoreRgba(out + x * 4, Integrate(environment, tables[level], normal));
+        }
+    });
+}
+
+void CpuEnvironmentPreprocessor::ComputeBRDFIntegrationLUT(Image& brdfIntegrationLUT,
+                                                           uint32_t sampleCount) const {
+    constexpr float kEpsilon = 1e-5f;
+    constexpr float kMinRoughness = 0.001f;
+    const uint32_t size = brdfIntegrationLUT.m_size;
+    std::vector<float>& texels = brdfIntegrationLUT.m_mipLevels[0];
+
+    // Every row has its own roughness and therefore its own half vectors
+    ParallelFor(size, [&](uint32_t y) {
+        const float roughness =
+            std::clamp((static_cast<float>(y) + 0.5f) / static_cast<float>(size), kMinRoughness,
+                       1.0f - kEpsilon);
+
+        // Padding entries point away from the view (NdotL = 0) and are masked out
+        const size_t paddedCount = (sampleCount + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+        HalfVectorTable table;
+        table.m_x.assign(paddedCount, 0.0f);
+        table.m_z.assign(paddedCount, 0.0f);
+        for (uint32_t i = 0; i < sampleCount; ++i) {
+            const glm::vec4 h = ImportanceSampleGGX(i, sampleCount, roughness);
+            table.m_x[i] = h.x;
+            table.m_z[i] = h.z;
+        }
+
+        float *out = texels.data() + static_cast<size_t>(y) * size * 4;
+        for (uint32_t x = 0; x < size; ++x) {
+            const float NdotV =
+                std::clamp((static_cast<float>(x) + 0.5f) / static_cast<float>(size), kEpsilon,
+                           1.0f - kEpsilon);
+            const glm::vec2 AB = IntegrateBRDF(table, NdotV, roughness, sampleCount);
+            const float texel[4] = {AB.x, AB.y, 0.0f, 1.0f};
+            std::copy(texel, texel + 4, out + x * 4);
+        }
+    });
+}
@@ -0,0 +1,70 @@
+/// @file   cpu_environment_preprocessor.h
+/// @brief  CPU implementation of the panorama conversion and IBL map generation (irradiance,
+///         specular, BRDF LUT) for machines without a GPU.
+
+#pragma once
+
+// Standard Library Headers
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Project Headers
+#include "environment.h"
+
+/// Produces the same maps as PanoramaToCubemapConverter, MipmapGenerator (Float16Cube) and
+/// EnvironmentPreprocessor, following panorama_to_cubemap.wgsl and environment_prefilter.wgsl.
+/// Rows of all faces and mip levels are spread over worker threads, the importance sampling
+/// directions and their mip levels are precomputed once per stage and mip level, and texel
+/// filtering uses SSE (AVX when enabled at compile time). Results match the GPU path within the
+/// precision of the RGBA16Float targets and the GPU's texture filtering. Does not depend on
+/// WebGPU, so it also runs on bake servers without a GPU.
+class CpuEnvironmentPreprocessor {
+  public:
+    // Types
+    enum class Stage {
+        Irradiance,          // Diffuse irradiance cubemap
+        PrefilteredSpecular, // Prefiltered specular cubemap or octahedral map (all mip levels)
+        BRDFIntegrationLUT   // Split-sum BRDF integration LUT
+    };
+
+    /// RGBA float image with 6 cube faces or a single layer (octahedral map or 2D LUT)
+    struct Image {
+        uint32_t m_size = 0;                          // Width and height of mip level 0
+        uint32_t m_layerCount = 1;                    // 6 for cube maps
+        std::vector<std::vector<float>> m_mipLevels;  // Layers stored one after another
+    };
+
+    // Constructor
+    explicit CpuEnvironmentPreprocessor(uint32_t threadCount = 0); // 0: all hardware threads
+
+    // Rule of 5
+    CpuEnvironmentPreprocessor(const CpuEnvironmentPreprocessor&) = delete;
+    CpuEnvironmentPreprocessor& operator=(const CpuEnvironmentPreprocessor&) = delete;
+    CpuEnvironmentPreprocessor(CpuEnvironmentPreprocessor&&) = delete;
+    CpuEnvironmentPreprocessor& operator=(CpuEnvironmentPreprocessor&&) = delete;
+
+    // Public Interface
+    static Image CreateImage(uint32_t size, uint32_t layerCount, bool mipmapped);
+
+    void ConvertPanorama(const Environment::Texture& panorama, Image& environment) const;
+    void GenerateMipmaps(Image& image) const;
+    void GenerateMaps(const Image& environment, Image& irradiance, Image& prefilteredSpecular,
+                      Image& brdfIntegrationLUT, uint32_t sampleCount) const;
+    void GenerateStage(Stage stage, const Image& environment, Image& irradiance,
+                       Image& prefilteredSpecular, Image& brdfIntegrationLUT,
+                       uint32_t sampleCount) const;
+
+    // Accessors
+    uint32_t GetThreadCount() const noexcept;
+
+  private:
+    void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& body) const;
+    void ComputeIrradiance(const Image& environment, Image& irradiance,
+                           uint32_t sampleCount) const;
+    void ComputePrefilteredSpecular(const Image& environment, Image& prefilteredSpecular,
+                                    uint32_t sampleCount) const;
+    void ComputeBRDFIntegrationLUT(Image& brdfIntegrationLUT, uint32_t sampleCount) const;
+
+    uint32_t m_threadCount = 1;
+};
@@ -1,9 +1,16 @@
 // Standard Library Headers
+#include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <string>
+#include <type_traits>
 
 // Third-Party Library Headers
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -14,13 +21,66 @@
 
 // Project Headers
 #include "environment.h"
+#include "exr_loader.h"
 
 //----------------------------------------------------------------------
 // Internal Utility Functions
 
 namespace {
 
-void DownsampleTexture(Environment::Texture& texture, int origWidth, int origHeight) {
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+// FNV-1a over 64-bit words
+uint64_t HashWords(const void *data, size_t size, uint64_t hash) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + offset, sizeof(word));
+        hash = (hash ^ word) * kFnvPrime;
+    }
+    for (; offset < size; ++offset) {
+        hash = (hash ^ bytes[offset]) * kFnvPrime;
+    }
+    return hash;
+}
+
+// Hashes kHashSampleCount evenly spaced runs of kHashRunSize values instead of every pixel, so
+// identifying a 4096x2048 float panorama costs ~256 KB of reads rather than 134 MB
+constexpr size_t kHashSampleCount = 4096;
+constexpr size_t kHashRunSize = 16;
+
+template <typename T> uint64_t HashSampled(const std::vector<T>& values, uint64_t hash) {
+    if (values.size() <= kHashSampleCount * kHashRunSize) {
+        return HashWords(values.data(), values.size() * sizeof(T), hash);
+    }
+    const size_t stride = (values.size() - kHashRunSize) / (kHashSampleCount - 1);
+    for (size_t sample = 0; sample < kHashSampleCount; ++sample) {
+        hash = HashWords(values.data() + sample * stride, kHashRunSize * sizeof(T), hash);
+    }
+    return hash;
+}
+
+uint64_t HashTexture(const Environment::Texture& texture) {
+    const uint32_t header[] = {texture.m_width, texture.m_height, texture.m_components};
+    uint64_t hash = HashWords(header, sizeof(header), kFnvOffsetBasis);
+    hash = HashSampled(texture.m_data, hash);
+    return HashSampled(texture.m_halfData, hash);
+}
+
+float ToFloat(float value) {
+    return value;
+}
+
+float ToFloat(uint16_t value) {
+    return exr_loader::HalfToFloat(value);
+}
+
+// Resamples float or half float (Texture::m_halfData) RGBA pixels
+template <typename T>
+void DownsampleTexture(Environment::Texture& texture, std::vector<T>& pixels, int origWidth,
+                       int origHeight) {
     std::cout << "Downsampling texture from " << origWidth << "x" << origHeight << " to 4096x2048."
               << std::endl;
     auto start = std::chrono::high_resolution_clock::now();
@@ -28,7 +88,7 @@ void DownsampleTexture(Environment::Texture& texture, int origWidth, int origHei
     // Define target resolution (fixed 4096x2048; maintains 2:1 aspect ratio).
     const uint32_t newWidth = 4096;
     const uint32_t newHeight = 2048;
-    std::vector<float> downsampled(newWidth * newHeight * 4, 0.0f);
+    std::vector<T> downsampled(newWidth * newHeight * 4, T{});
 
     // Compute scale factors from destination to source.
     // Subtracting 1 ensures the last pixel maps correctly.
@@ -48,15 +108,19 @@ void DownsampleTexture(Environment::Texture& texture, int origWidth, int origHei
             float dx = origX - x0;
             // Process each channel (RGBA).
             for (int c = 0; c < 4; ++c) {
-                float c00 = texture.m_data[(y0 * origWidth + x0) * 4 + c];
-                float c10 = texture.m_data[(y0 * origWidth + x1) * 4 + c];
-                float c01 = texture.m_data[(y1 * origWidth + x0) * 4 + c];
-                float c11 = texture.m_data[(y1 * origWidth + x1) * 4 + c];
+                float c00 = ToFloat(pixels[(y0 * origWidth + x0) * 4 + c]);
+                float c10 = ToFloat(pixels[(y0 * origWidth + x1) * 4 + c]);
+                float c01 = ToFloat(pixels[(y1 * origWidth + x0) * 4 + c]);
+                float c11 = ToFloat(pixels[(y1 * origWidth + x1) * 4 + c]);
                 // Bilinear interpolation: horizontal then vertical.
                 float top = c00 + dx * (c10 - c00);
                 float bottom = c01 + dx * (c11 - c01);
                 float value = top + dy * (bottom - top);
-                downsampled[(j * newWidth + i) * 4 + c] = value;
+                if constexpr (std::is_same_v<T, uint16_t>) {
+                    downsampled[(j * newWidth + i) * 4 + c] = exr_loader::FloatToHalf(value);
+                } else {
+                    downsampled[(j * newWidth + i) * 4 + c] = value;
+                }
             }
         }
     }
@@ -68,7 +132,7 @@ void DownsampleTexture(Environment::Texture& texture, int origWidth, int origHei
     // Update the texture with downsampled data.
     texture.m_width = newWidth;
     texture.m_height = newHeight;
-    texture.m_data = std::move(downsampled);
+    pixels = std::move(downsampled);
 }
 
 template <typename LoaderFunc, typename... Args>
@@ -99,6 +163,7 @@ bool LoadFromSource(Environment::Texture& texture, LoaderFunc loader, Args&&...a
     texture.m_width = width;
     texture.m_height = height;
     texture.m_components = 4; // Assuming RGBA
+    texture.m_halfData.clear();
     texture.m_data.resize(width * height * 4);
     std::copy(data, data + (width * height * 4), texture.m_data.begin());
 
@@ -112,7 +177,48 @@ bool LoadFromSource(Environment::Texture& texture, LoaderFunc loader, Args&&...a
     // If the texture is larger than 4096x2048, downsample it to that resolution to make it more
     // portable.
     if (width > 4096) {
-        DownsampleTexture(texture, width, height);
+        DownsampleTexture(texture, texture.m_data, width, height);
+    }
+
+    return true;
+}
+
+// OpenEXR panoramas keep their half float pixels, which are uploaded as RGBA16Float
+bool LoadExr(Environment::Texture& texture, const std::string& filename, const uint8_t *data,
+             size_t size) {
+    std::vector<uint8_t> fileData;
+    if (!data) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return false;
+        }
+        fileData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data = fileData.data();
+        size = fileData.size();
+    }
+
+    exr_loader::Image image;
+    if (!exr_loader::Load(data, size, image)) {
+        std::cerr << "Failed to load OpenEXR image." << std::endl;
+        return false;
+    }
+
+    if (image.m_width != 2 * image.m_height) {
+        std::cerr << "Error: Texture must have a 2:1 aspect ratio. Received: " << image.m_width
+                  << "x" << image.m_height << std::endl;
+        return false;
+    }
+
+    texture.m_width = image.m_width;
+    texture.m_height = image.m_height;
+    texture.m_components = 4;
+    texture.m_data.clear();
+    texture.m_halfData = std::move(image.m_pixels);
+
+    if (texture.m_width > 4096) {
+        DownsampleTexture(texture, texture.m_halfData, static_cast<int>(image.m_width),
+                          static_cast<int>(image.m_height));
     }
 
     return true;
@@ -123,17 +229,26 @@ bool LoadFromSource(Environment::Texture& texture, LoaderFunc loader, Args&&...a
 //----------------------------------------------------------------------
 // Environment Class Implementation
 
-bool Environment::Load(const std::string& filename, const uint8_t *data, uint32_t size) {
+bool Environment::Load(const std::string& filename, const uint8_t *data, size_t size) {
     bool success = false;
 
-    if (data) {
-        success = LoadFromSource(m_texture, stbi_loadf_from_memory, data, size);
+    std::string extension = std::filesystem::path(filename).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (exr_loader::IsExr(data, size) || (!data && extension == ".exr")) {
+        success = LoadExr(m_texture, filename, data, size);
+    } else if (data && size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        std::cerr << "Image data exceeds the 2 GB stb_image limit: " << filename << std::endl;
+    } else if (data) {
+        success = LoadFromSource(m_texture, stbi_loadf_from_memory, data, static_cast<int>(size));
     } else {
         success = LoadFromSource(m_texture, stbi_loadf, filename.c_str());
     }
 
     if (success) {
         m_texture.m_name = filename;
+        m_texture.m_contentHash = HashTexture(m_texture);
         m_transform = glm::mat4(1.0f);
     }
 
@@ -20,6 +20,8 @@ class Environment {
         uint32_t m_height = 0;     // Height of the texture
         uint32_t m_components = 0; // Components per pixel (e.g., 3 = RGB, 4 = RGBA)
         std::vector<float> m_data; // Raw pixel data
+        std::vector<uint16_t> m_halfData; // RGBA half float pixels (OpenEXR), used over m_data
+        uint64_t m_contentHash = 0;       // Hash of the size and sampled pixels
     };
 
     // Constructor
@@ -32,7 +34,7 @@ class Environment {
     Environment& operator=(Environment&&) = default;
 
     // Public Interface
-    bool Load(const std::string& filename, const uint8_t *data = 0, uint32_t size = 0);
+    bool Load(const std::string& filename, const uint8_t *data = 0, size_t size = 0);
     void UpdateRotation(float rotationAngle);
 
     // Accessors
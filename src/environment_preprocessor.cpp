@@ -1,30 +1,19 @@
 // Standard Library Headers
-#include <fstream>
-#include <iostream>
-#include <sstream>
+#include <algorithm>
 #include <string>
 #include <vector>
 
 // Project Headers
+#include "asset_archive.h"
 #include "environment_preprocessor.h"
 
 //----------------------------------------------------------------------
-// Internal Utility Functions
+// Internal Constants
 
 namespace {
 
-// TODO: Move to helper class for managing resources
-std::string LoadShaderFile(const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::in | std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open shader file: " + filepath + "\n";
-        return "";
-    }
-
-    std::ostringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
-}
+constexpr uint32_t kNumFaces = 6;
+constexpr uint32_t kWorkgroupSize = 8;
 
 } // namespace
 
@@ -43,7 +32,31 @@ EnvironmentPreprocessor::EnvironmentPreprocessor(const wgpu::Device& device) {
 void EnvironmentPreprocessor::GenerateMaps(const wgpu::Texture& environmentCubemap,
                                            wgpu::Texture& irradianceCubemap,
                                            wgpu::Texture& prefilteredSpecularCubemap,
-                                           wgpu::Texture& brdfIntegrationLUT) {
+                                           wgpu::Texture& brdfIntegrationLUT,
+                                           uint32_t sampleCount) {
+    constexpr Stage stages[] = {Stage::Irradiance, Stage::PrefilteredSpecular,
+                                Stage::BRDFIntegrationLUT};
+    generate(environmentCubemap, irradianceCubemap, prefilteredSpecularCubemap,
+             brdfIntegrationLUT, sampleCount, stages);
+}
+
+void EnvironmentPreprocessor::GenerateStage(Stage stage, const wgpu::Texture& environmentCubemap,
+                                            wgpu::Texture& irradianceCubemap,
+                                            wgpu::Texture& prefilteredSpecularCubemap,
+                                            wgpu::Texture& brdfIntegrationLUT,
+                                            uint32_t sampleCount) {
+    generate(environmentCubemap, irradianceCubemap, prefilteredSpecularCubemap,
+             brdfIntegrationLUT, sampleCount, std::span<const Stage>(&stage, 1));
+}
+
+void EnvironmentPreprocessor::generate(const wgpu::Texture& environmentCubemap,
+                                       wgpu::Texture& irradianceCubemap,
+                                       wgpu::Texture& prefilteredSpecularCubemap,
+                                       wgpu::Texture& brdfIntegrationLUT, uint32_t sampleCount,
+                                       std::span<const Stage> stages) {
+    // Number of samples per texel (quality vs. preprocessing time)
+    m_device.GetQueue().WriteBuffer(m_uniformBuffer, 0, &sampleCount, sizeof(uint32_t));
+
     // Create views for the input cubemap and output cubemap.
     wgpu::TextureViewDescriptor inputViewDesc{};
     inputViewDesc.format = wgpu::TextureFormat::RGBA16Float;
@@ -99,38 +112,62 @@ void EnvironmentPreprocessor::GenerateMaps(const wgpu::Texture& environmentCubem
     wgpu::CommandEncoder encoder = m_device.CreateCommandEncoder();
     wgpu::ComputePassEncoder computePass = encoder.BeginComputePass();
 
-    // ---- Pass 1: Generate Irradiance Map (Diffuse IBL) ----
+    // All pipelines share one layout, so make every bind group valid up front
+    computePass.SetBindGroup(0, bindGroup0, 0, nullptr);
+    computePass.SetBindGroup(1, m_perFaceBindGroups[0], 0, nullptr);
+    computePass.SetBindGroup(2, m_perMipBindGroups[0], 0, nullptr);
+
+    for (Stage stage : stages) {
+        switch (stage) {
+        case Stage::Irradiance:
+            encodeIrradiance(computePass, irradianceCubemap);
+            break;
+        case Stage::PrefilteredSpecular:
+            encodePrefilteredSpecular(computePass, prefilteredSpecularCubemap);
+            break;
+        case Stage::BRDFIntegrationLUT:
+            encodeBRDFIntegrationLUT(computePass, brdfIntegrationLUT);
+            break;
+        }
+    }
+
+    // Finish the compute pass and submit the command buffer.
+    computePass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+}
 
+void EnvironmentPreprocessor::encodeIrradiance(const wgpu::ComputePassEncoder& computePass,
+                                               const wgpu::Texture& irradianceCubemap) {
     // Set the pipeline for irradiance cubemap generation.
     computePass.SetPipeline(m_pipelineIrradiance);
 
-    // Set bind groups common to all faces.
-    computePass.SetBindGroup(0, bindGroup0, 0, nullptr);
-    computePass.SetBindGroup(2, m_perMipBindGroups[0], 0, nullptr); // Make sure BG2 is valid
-
     // Dispatch a compute shader for each face of the cubemap.
-    constexpr uint32_t numFaces = 6;
-    for (uint32_t face = 0; face < numFaces; ++face) {
+    for (uint32_t face = 0; face < kNumFaces; ++face) {
         // For each face, update the per-face uniform (bind group 1).
         computePass.SetBindGroup(1, m_perFaceBindGroups[face], 0, nullptr);
 
-        constexpr uint32_t workgroupSize = 8;
         uint32_t workgroupCountX =
-            (irradianceCubemap.GetWidth() + workgroupSize - 1) / workgroupSize;
+            (irradianceCubemap.GetWidth() + kWorkgroupSize - 1) / kWorkgroupSize;
         uint32_t workgroupCountY =
-            (irradianceCubemap.GetHeight() + workgroupSize - 1) / workgroupSize;
+            (irradianceCubemap.GetHeight() + kWorkgroupSize - 1) / kWorkgroupSize;
         computePass.DispatchWorkgroups(workgroupCountX, workgroupCountY, 1);
     }
+}
 
-    // ---- Pass 2: Generate Prefiltered Specular Map (Specular IBL) ----
-
+void EnvironmentPreprocessor::encodePrefilteredSpecular(
+    const wgpu::ComputePassEncoder& computePass, const wgpu::Texture& prefilteredSpecularCubemap) {
     const uint32_t mipLevelCount = prefilteredSpecularCubemap.GetMipLevelCount();
+    const bool octahedral = prefilteredSpecularCubemap.GetDepthOrArrayLayers() == 1;
 
-    // Set the pipeline for prefiltered specular cubemap generation.
-    computePass.SetPipeline(m_pipelinePrefilteredSpecular);
+    // Set the pipeline for prefiltered specular cubemap (or octahedral map) generation.
+    computePass.SetPipeline(octahedral ? m_pipelinePrefilteredSpecularOctahedral
+                                       : m_pipelinePrefilteredSpecular);
 
-    // Dispatch a compute shader for each mip level of each face of the cubemap.
-    for (uint32_t face = 0; face < numFaces; ++face) {
+    // Dispatch a compute shader for each mip level of each face of the cubemap. The octahedral
+    // map covers the whole sphere, so it needs one dispatch per mip level.
+    const uint32_t faceCount = octahedral ? 1 : kNumFaces;
+    for (uint32_t face = 0; face < faceCount; ++face) {
         // Bind per-face uniform (bind group 1).
         computePass.SetBindGroup(1, m_perFaceBindGroups[face], 0, nullptr);
 
@@ -141,31 +178,25 @@ void EnvironmentPreprocessor::GenerateMaps(const wgpu::Texture& environmentCubem
             uint32_t mipWidth = std::max(1u, prefilteredSpecularCubemap.GetWidth() >> mipLevel);
             uint32_t mipHeight = std::max(1u, prefilteredSpecularCubemap.GetHeight() >> mipLevel);
 
-            constexpr uint32_t workgroupSize = 8;
-            uint32_t workgroupCountX = (mipWidth + workgroupSize - 1) / workgroupSize;
-            uint32_t workgroupCountY = (mipHeight + workgroupSize - 1) / workgroupSize;
+            uint32_t workgroupCountX = (mipWidth + kWorkgroupSize - 1) / kWorkgroupSize;
+            uint32_t workgroupCountY = (mipHeight + kWorkgroupSize - 1) / kWorkgroupSize;
 
             computePass.DispatchWorkgroups(workgroupCountX, workgroupCountY, 1);
         }
     }
+}
 
-    // ---- Pass 3: Generate BRDF Integration LUT ----
-
+void EnvironmentPreprocessor::encodeBRDFIntegrationLUT(const wgpu::ComputePassEncoder& computePass,
+                                                       const wgpu::Texture& brdfIntegrationLUT) {
     // Set the pipeline for BRDF integration LUT generation.
     computePass.SetPipeline(m_pipelineBRDFIntegrationLUT);
 
     // Dispatch a compute shader for the output texture.
     uint32_t width = brdfIntegrationLUT.GetWidth();
     uint32_t height = brdfIntegrationLUT.GetHeight();
-    constexpr uint32_t workgroupSize = 8;
-    uint32_t workgroupCountX = (width + workgroupSize - 1) / workgroupSize;
-    uint32_t workgroupCountY = (height + workgroupSize - 1) / workgroupSize;
+    uint32_t workgroupCountX = (width + kWorkgroupSize - 1) / kWorkgroupSize;
+    uint32_t workgroupCountY = (height + kWorkgroupSize - 1) / kWorkgroupSize;
     computePass.DispatchWorkgroups(workgroupCountX, workgroupCountY, 1);
-
-    // Finish the compute pass and submit the command buffer.
-    computePass.End();
-    wgpu::CommandBuffer commands = encoder.Finish();
-    queue.Submit(1, &commands);
 }
 
 void EnvironmentPreprocessor::initUniformBuffers() {
@@ -174,9 +205,7 @@ void EnvironmentPreprocessor::initUniformBuffers() {
     bufferDescriptor.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
     bufferDescriptor.size = sizeof(uint32_t);
 
-    m_uniformBuffer = m_device.CreateBuffer(&bufferDescriptor);
-    uint32_t numSamples = 1024; // FIXME: Hardcoded number of samples
-    m_device.GetQueue().WriteBuffer(m_uniformBuffer, 0, &numSamples, sizeof(uint32_t));
+    m_uniformBuffer = m_device.CreateBuffer(&bufferDescriptor); // Written by GenerateMaps
 
     // Update descriptor for per-face uniform buffers
     bufferDescriptor.size = sizeof(uint32_t); // Face id
@@ -289,7 +318,7 @@ void EnvironmentPreprocessor::initBindGroups() {
 }
 
 void EnvironmentPreprocessor::initComputePipelines() {
-    std::string shaderCode = LoadShaderFile("./assets/shaders/environment_prefilter.wgsl");
+    std::string shaderCode = LoadTextAsset("./assets/shaders/environment_prefilter.wgsl");
 
     wgpu::ShaderSourceWGSL wgsl{{.nextInChain = nullptr, .code = shaderCode.c_str()}};
     wgpu::ShaderModuleDescriptor shaderModuleDescriptor{.nextInChain = &wgsl};
@@ -316,6 +345,9 @@ void EnvironmentPreprocessor::initComputePipelines() {
     descriptor.compute.entryPoint = "computePrefilteredSpecular";
     m_pipelinePrefilteredSpecular = m_device.CreateComputePipeline(&descriptor);
 
+    descriptor.compute.entryPoint = "computePrefilteredSpecularOctahedral";
+    m_pipelinePrefilteredSpecularOctahedral = m_device.CreateComputePipeline(&descriptor);
+
     descriptor.compute.entryPoint = "computeLUT";
     m_pipelineBRDFIntegrationLUT = m_device.CreateComputePipeline(&descriptor);
 }
@@ -338,14 +370,14 @@ void EnvironmentPreprocessor::createPerMipBindGroups(
                                         sizeof(roughness));
     }
 
-    // Create a texture view descriptor for the output cubemap
+    // Create a texture view descriptor for the output cubemap (or octahedral map)
     wgpu::TextureViewDescriptor outputCubeViewDesc{};
     outputCubeViewDesc.format = wgpu::TextureFormat::RGBA16Float;
     outputCubeViewDesc.dimension = wgpu::TextureViewDimension::e2DArray;
     outputCubeViewDesc.baseMipLevel = 0;
     outputCubeViewDesc.mipLevelCount = 1;
     outputCubeViewDesc.baseArrayLayer = 0;
-    outputCubeViewDesc.arrayLayerCount = 6;
+    outputCubeViewDesc.arrayLayerCount = prefilteredSpecularCubemap.GetDepthOrArrayLayers();
 
     // Create bind group descriptor
     wgpu::BindGroupEntry bindGroup2Entries[2]{};
@@ -6,6 +6,7 @@
 
 // Standard Library Headers
 #include <cstdint>
+#include <span>
 #include <string>
 
 // Third-Party Library Headers
@@ -13,9 +14,17 @@
 
 /// This class encapsulates WebGPU pipelines and resources to generate
 /// various IBL maps (irradiance, prefiltered specular, and BRDF LUT)
-/// from a given environment cube map.
+/// from a given environment cube map. A single layer specular texture
+/// receives an octahedral encoding instead of six cube faces.
 class EnvironmentPreprocessor {
   public:
+    // Types
+    enum class Stage {
+        Irradiance,          // Diffuse irradiance cubemap
+        PrefilteredSpecular, // Prefiltered specular cubemap or octahedral map (all mip levels)
+        BRDFIntegrationLUT   // Split-sum BRDF integration LUT
+    };
+
     // Constructor
     explicit EnvironmentPreprocessor(const wgpu::Device& device);
 
@@ -30,7 +39,11 @@ class EnvironmentPreprocessor {
 
     // Public Interface
     void GenerateMaps(const wgpu::Texture& environmentCubemap, wgpu::Texture& irradianceCubemap,
-                      wgpu::Texture& prefilteredSpecularCubemap, wgpu::Texture& brdfIntegrationLUT);
+                      wgpu::Texture& prefilteredSpecularCubemap, wgpu::Texture& brdfIntegrationLUT,
+                      uint32_t sampleCount);
+    void GenerateStage(Stage stage, const wgpu::Texture& environmentCubemap,
+                       wgpu::Texture& irradianceCubemap, wgpu::Texture& prefilteredSpecularCubemap,
+                       wgpu::Texture& brdfIntegrationLUT, uint32_t sampleCount);
 
   private:
     // Pipeline initialization
@@ -45,6 +58,15 @@ class EnvironmentPreprocessor {
     createComputePipeline(const std::string& entryPoint,
                           const wgpu::PipelineLayoutDescriptor& layoutDescriptor);
     void createPerMipBindGroups(const wgpu::Texture& prefilteredSpecularCubemap);
+    void generate(const wgpu::Texture& environmentCubemap, wgpu::Texture& irradianceCubemap,
+                  wgpu::Texture& prefilteredSpecularCubemap, wgpu::Texture& brdfIntegrationLUT,
+                  uint32_t sampleCount, std::span<const Stage> stages);
+    void encodeIrradiance(const wgpu::ComputePassEncoder& computePass,
+                          const wgpu::Texture& irradianceCubemap);
+    void encodePrefilteredSpecular(const wgpu::ComputePassEncoder& computePass,
+                                   const wgpu::Texture& prefilteredSpecularCubemap);
+    void encodeBRDFIntegrationLUT(const wgpu::ComputePassEncoder& computePass,
+                                  const wgpu::Texture& brdfIntegrationLUT);
 
     // WebGPU objects (initialized by constructor)
     wgpu::Device m_device;
@@ -55,6 +77,7 @@ class EnvironmentPreprocessor {
     // Compute pipelines
     wgpu::ComputePipeline m_pipelineIrradiance;
     wgpu::ComputePipeline m_pipelinePrefilteredSpecular;
+    wgpu::ComputePipeline m_pipelinePrefilteredSpecularOctahedral;
     wgpu::ComputePipeline m_pipelineBRDFIntegrationLUT;
 
     // Buffers
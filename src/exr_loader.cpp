@@ -0,0 +1,931 @@
+// Standard Library Headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Third-Party Library Headers
+#include <stb_image.h>
+
+// Project Headers
+#include "exr_loader.h"
+
+//----------------------------------------------------------------------
+// Internal Constants and Types
+
+namespace {
+
+constexpr uint32_t kMagic = 20000630;
+constexpr uint32_t kTiledFlag = 0x200;
+constexpr uint32_t kNonImageFlag = 0x800;
+constexpr uint32_t kMultipartFlag = 0x1000;
+
+constexpr uint16_t kHalfOne = 0x3c00;
+constexpr uint32_t kMaxDimension = 1u << 15;
+
+enum class Compression : uint8_t { None = 0, Rle = 1, Zips = 2, Zip = 3, Piz = 4 };
+enum class PixelType : int32_t { UInt = 0, Half = 1, Float = 2 };
+
+struct Channel {
+    std::string m_name;
+    PixelType m_pixelType = PixelType::Half;
+    uint32_t m_byteSize = 2;  // Bytes per sample
+    size_t m_lineOffset = 0;  // First byte of the channel in a scanline, per pixel of width
+    int m_target = -1;        // RGBA component, -1 if the channel is not used
+};
+
+struct Header {
+    std::vector<Channel> m_channels; // Sorted by name, as stored in the file
+    Compression m_compression = Compression::None;
+    int32_t m_xMin = 0;
+    int32_t m_yMin = 0;
+    int32_t m_xMax = -1;
+    int32_t m_yMax = -1;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_linesPerChunk = 1;
+    size_t m_bytesPerLine = 0;
+};
+
+// Huffman decoding (PIZ). Codes are stored as length | code << 6, see OpenEXR ImfHuf.cpp.
+constexpr uint32_t kHufEncBits = 16;
+constexpr uint32_t kHufDecBits = 14;
+constexpr uint32_t kHufEncSize = (1u << kHufEncBits) + 1;
+constexpr uint32_t kHufDecSize = 1u << kHufDecBits;
+constexpr uint32_t kHufDecMask = kHufDecSize - 1;
+constexpr uint32_t kShortZeroCodeRun = 59;
+constexpr uint32_t kLongZeroCodeRun = 63;
+constexpr uint32_t kShortestLongRun = 2 + kLongZeroCodeRun - kShortZeroCodeRun;
+
+// PIZ value range bitmap
+constexpr uint32_t kUShortRange = 1u << 16;
+constexpr uint32_t kBitmapSize = kUShortRange >> 3;
+
+struct HufDec {
+    uint32_t m_len = 0;      // Code length (short codes)
+    uint32_t m_lit = 0;      // Symbol (short codes) or number of long codes
+    std::vector<uint32_t> m_long; // Symbols of the long codes sharing this prefix
+};
+
+// Decoding buffers, one set per worker thread
+struct Scratch {
+    std::vector<uint8_t> m_uncompressed;
+    std::vector<uint8_t> m_bytes;
+    std::vector<uint16_t> m_words;
+    std::vector<uint64_t> m_hufCodes;
+    std::vector<HufDec> m_hufDecodeTable;
+    std::vector<uint8_t> m_bitmap;
+    std::vector<uint16_t> m_lut;
+};
+
+class ByteReader {
+  public:
+    ByteReader(const uint8_t *data, size_t size) : m_data(data), m_size(size) {}
+
+    template <typename T> bool Read(T& value) {
+        if (m_size - m_offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, m_data + m_offset, sizeof(T)); // OpenEXR is little-endian
+        m_offset += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string& value) {
+        const uint8_t *begin = m_data + m_offset;
+        const uint8_t *end = static_cast<const uint8_t *>(std::memchr(begin, 0, m_size - m_offset));
+        if (!end) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char *>(begin), end - begin);
+        m_offset += (end - begin) + 1;
+        return true;
+    }
+
+    bool Skip(size_t size) {
+        if (m_size - m_offset < size) {
+            return false;
+        }
+        m_offset += size;
+        return true;
+    }
+
+    const uint8_t *GetPointer() const noexcept { return m_data + m_offset; }
+    size_t GetRemaining() const noexcept { return m_size - m_offset; }
+
+  private:
+    const uint8_t *m_data;
+    size_t m_size;
+    size_t m_offset = 0;
+};
+
+} // namespace
+
+//----------------------------------------------------------------------
+// Internal Utility Functions
+
+namespace {
+
+bool ParseChannels(const uint8_t *data, size_t size, std::vector<Channel>& channels) {
+    ByteReader reader(data, size);
+    while (true) {
+        Channel channel;
+        if (!reader.ReadString(channel.m_name)) {
+            return false;
+        }
+        if (channel.m_name.empty()) {
+            return true;
+        }
+
+        int32_t pixelType = 0;
+        int32_t xSampling = 0;
+        int32_t ySampling = 0;
+        if (!reader.Read(pixelType) || !reader.Skip(4) || !reader.Read(xSampling) ||
+            !reader.Read(ySampling)) {
+            return false;
+        }
+        if (pixelType < 0 || pixelType > 2 || xSampling != 1 || ySampling != 1) {
+            std::cerr << "Error: Unsupported EXR channel " << channel.m_name << std::endl;
+            return false;
+        }
+
+        channel.m_pixelType = static_cast<PixelType>(pixelType);
+        channel.m_byteSize = channel.m_pixelType == PixelType::Half ? 2 : 4;
+
+        const char *kComponents[] = {"R", "G", "B", "A"};
+        for (int c = 0; c < 4; ++c) {
+            if (channel.m_name == kComponents[c]) {
+                channel.m_target = c;
+            }
+        }
+        channels.push_back(channel);
+    }
+}
+
+bool ParseHeader(ByteReader& reader, Header& header) {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    if (!reader.Read(magic) || !reader.Read(version) || magic != kMagic) {
+        std::cerr << "Error: Not an OpenEXR file" << std::endl;
+        return false;
+    }
+    if (version & (kTiledFlag | kNonImageFlag | kMultipartFlag)) {
+        std::cerr << "Error: Only single-part scanline EXR files are supported" << std::endl;
+        return false;
+    }
+
+    bool hasChannels = false;
+    bool hasDataWindow = false;
+    while (true) {
+        std::string name;
+        std::string type;
+        int32_t size = 0;
+        if (!reader.ReadString(name)) {
+            return false;
+        }
+        if (name.empty()) {
+            break; // End of the header
+        }
+        if (!reader.ReadString(type) || !reader.Read(size) || size < 0 ||
+            reader.GetRemaining() < static_cast<size_t>(size)) {
+            return false;
+        }
+
+        const uint8_t *value = reader.GetPointer();
+        if (name == "channels" && type == "chlist") {
+            hasChannels = ParseChannels(value, size, header.m_channels);
+            if (!hasChannels) {
+                return false;
+            }
+        } else if (name == "compression" && size >= 1) {
+            header.m_compression = static_cast<Compression>(value[0]);
+        } else if (name == "dataWindow" && size >= 16) {
+            std::memcpy(&header.m_xMin, value, 4);
+            std::memcpy(&header.m_yMin, value + 4, 4);
+            std::memcpy(&header.m_xMax, value + 8, 4);
+            std::memcpy(&header.m_yMax, value + 12, 4);
+            hasDataWindow = true;
+        }
+        reader.Skip(size);
+    }
+
+    if (!hasChannels || !hasDataWindow || header.m_xMax < header.m_xMin ||
+        header.m_yMax < header.m_yMin ||
+        int64_t{header.m_xMax} - header.m_xMin >= kMaxDimension ||
+        int64_t{header.m_yMax} - header.m_yMin >= kMaxDimension) {
+        std::cerr << "Error: Invalid EXR header" << std::endl;
+        return false;
+    }
+
+    switch (header.m_compression) {
+    case Compression::None:
+    case Compression::Rle:
+    case Compression::Zips:
+        header.m_linesPerChunk = 1;
+        break;
+    case Compression::Zip:
+        header.m_linesPerChunk = 16;
+        break;
+    case Compression::Piz:
+        header.m_linesPerChunk = 32;
+        break;
+    default:
+        std::cerr << "Error: Unsupported EXR compression "
+                  << static_cast<int>(header.m_compression) << std::endl;
+        return false;
+    }
+
+    header.m_width = static_cast<uint32_t>(int64_t{header.m_xMax} - header.m_xMin + 1);
+    header.m_height = static_cast<uint32_t>(int64_t{header.m_yMax} - header.m_yMin + 1);
+
+    size_t pixelSize = 0;
+    for (Channel& channel : header.m_channels) {
+        channel.m_lineOffset = pixelSize;
+        pixelSize += channel.m_byteSize;
+    }
+    header.m_bytesPerLine = pixelSize * header.m_width;
+    return true;
+}
+
+// Undoes the byte delta predictor and splits the interleaved halves (RLE and ZIP)
+void ReconstructBytes(const uint8_t *source, uint8_t *destination, size_t size,
+                      std::vector<uint8_t>& buffer) {
+    buffer.assign(source, source + size);
+    for (size_t i = 1; i < size; ++i) {
+        buffer[i] = static_cast<uint8_t>(buffer[i - 1] + buffer[i] - 128);
+    }
+
+    const uint8_t *first = buffer.data();
+    const uint8_t *second = buffer.data() + (size + 1) / 2;
+    for (size_t i = 0; i < size; ++i) {
+        destination[i] = (i & 1) ? *second++ : *first++;
+    }
+}
+
+bool RleUncompress(const uint8_t *source, size_t sourceSize, uint8_t *destination,
+                   size_t size) {
+    const uint8_t *end = source + sourceSize;
+    size_t written = 0;
+    while (source < end) {
+        const int count = static_cast<int8_t>(*source++);
+        if (count < 0) {
+            const size_t literals = static_cast<size_t>(-count);
+            if (static_cast<size_t>(end - source) < literals || size - written < literals) {
+                return false;
+            }
+            std::memcpy(destination + written, source, literals);
+            source += literals;
+            written += literals;
+        } else {
+            const size_t repeats = static_cast<size_t>(count) + 1;
+            if (source == end || size - written < repeats) {
+                return false;
+            }
+            std::memset(destination + written, *source++, repeats);
+            written += repeats;
+        }
+    }
+    return written == size;
+}
+
+// Reads nBits bits, most significant first
+bool GetBits(uint32_t bitCount, uint64_t& c, uint32_t& lc, const uint8_t *& in,
+             const uint8_t *end, uint32_t& value) {
+    while (lc < bitCount) {
+        if (in == end) {
+            return false;
+        }
+        c = (c << 8) | *in++;
+        lc += 8;
+    }
+    lc -= bitCount;
+    value = static_cast<uint32_t>((c >> lc) & ((1u << bitCount) - 1));
+    return true;
+}
+
+// Assigns canonical codes to the code lengths (longest codes first, smallest values)
+void HufCanonicalCodeTable(std::vector<uint64_t>& hcode) {
+    uint64_t n[59] = {};
+    for (uint32_t i = 0; i < kHufEncSize; ++i) {
+        n[hcode[i]] += 1;
+    }
+
+    uint64_t c = 0;
+    for (int i = 58; i > 0; --i) {
+        const uint64_t nc = (c + n[i]) >> 1;
+        n[i] = c;
+        c = nc;
+    }
+
+    for (uint32_t i = 0; i < kHufEncSize; ++i) {
+        const uint64_t l = hcode[i];
+        if (l > 0) {
+            hcode[i] = l | (n[l]++ << 6);
+        }
+    }
+}
+
+bool HufUnpackEncTable(const uint8_t *& in, const uint8_t *end, uint32_t im, uint32_t iM,
+                       std::vector<uint64_t>& hcode) {
+    hcode.assign(kHufEncSize, 0);
+
+    uint64_t c = 0;
+    uint32_t lc = 0;
+    for (; im <= iM; im++) {
+        uint32_t l = 0;
+        if (!GetBits(6, c, lc, in, end, l)) {
+            return false;
+        }
+        hcode[im] = l;
+
+        if (l == kLongZeroCodeRun) {
+            uint32_t run = 0;
+            if (!GetBits(8, c, lc, in, end, run)) {
+                return false;
+            }
+            run += kShortestLongRun;
+            if (im + run > iM + 1) {
+                return false;
+            }
+            std::fill_n(hcode.begin() + im, run, 0);
+            im += run - 1;
+        } else if (l >= kShortZeroCodeRun) {
+            const uint32_t run = l - kShortZeroCodeRun + 2;
+            if (im + run > iM + 1) {
+                return false;
+            }
+            std::fill_n(hcode.begin() + im, run, 0);
+            im += run - 1;
+        }
+    }
+
+    HufCanonicalCodeTable(hcode);
+    return true;
+}
+
+bool HufBuildDecTable(const std::vector<uint64_t>& hcode, uint32_t im, uint32_t iM,
+                      std::vector<HufDec>& table) {
+    table.resize(kHufDecSize);
+    for (HufDec& entry : table) {
+        entry.m_len = 0;
+        entry.m_lit = 0;
+        entry.m_long.clear();
+    }
+
+    for (; im <= iM; im++) {
+        const uint64_t c = hcode[im] >> 6;
+        const uint32_t l = static_cast<uint32_t>(hcode[im] & 63);
+        if (c >> l) {
+            return false; // Code longer than its length
+        }
+
+        if (l > kHufDecBits) {
+            // Long code: all codes sharing the first kHufDecBits bits are searched linearly
+            HufDec& entry = table[c >> (l - kHufDecBits)];
+            if (entry.m_len) {
+                return false;
+            }
+            entry.m_lit++;
+            entry.m_long.push_back(im);
+        } else if (l) {
+            // Short code: fill all table entries starting with the code
+            const uint64_t first = c << (kHufDecBits - l);
+            for (uint64_t i = 0; i < (uint64_t{1} << (kHufDecBits - l)); ++i) {
+                HufDec& entry = table[first + i];
+                if (entry.m_len || !entry.m_long.empty()) {
+                    return false;
+                }
+                entry.m_len = l;
+                entry.m_lit = im;
+            }
+        }
+    }
+    return true;
+}
+
+// Emits a decoded symbol; the run length code repeats the previous value
+bool HufGetCode(uint32_t symbol, uint32_t rlc, uint64_t& c, uint32_t& lc, const uint8_t *& in,
+                const uint8_t *end, uint16_t *& out, uint16_t *outBegin, uint16_t *outEnd) {
+    if (symbol == rlc) {
+        if (lc < 8) {
+            if (in == end) {
+                return false;
+            }
+            c = (c << 8) | *in++;
+            lc += 8;
+        }
+        lc -= 8;
+        const uint32_t count = static_cast<uint8_t>(c >> lc);
+        if (out == outBegin || static_cast<uint32_t>(outEnd - out) < count) {
+            return false;
+        }
+        const uint16_t value = out[-1];
+        std::fill_n(out, count, value);
+        out += count;
+    } else {
+        if (out == outEnd) {
+            return false;
+        }
+        *out++ = static_cast<uint16_t>(symbol);
+    }
+    return true;
+}
+
+bool HufDecode(const std::vector<uint64_t>& hcode, const std::vector<HufDec>& table,
+               const uint8_t *in, uint32_t bitCount, uint32_t rlc, uint16_t *out, size_t count) {
+    uint64_t c = 0;
+    uint32_t lc = 0;
+    uint16_t *outBegin = out;
+    uint16_t *outEnd = out + count;
+    const uint8_t *end = in + (uint64_t{bitCount} + 7) / 8;
+
+    while (in < end) {
+        c = (c << 8) | *in++;
+        lc += 8;
+
+        while (lc >= kHufDecBits) {
+            const HufDec& entry = table[(c >> (lc - kHufDecBits)) & kHufDecMask];
+            if (entry.m_len) {
+                lc -= entry.m_len;
+                if (!HufGetCode(entry.m_lit, rlc, c, lc, in, end, out, outBegin, outEnd)) {
+                    return false;
+                }
+                continue;
+            }
+
+            // Search the long codes with this prefix
+            bool found = false;
+            for (uint32_t symbol : entry.m_long) {
+                const uint32_t l = static_cast<uint32_t>(hcode[symbol] & 63);
+                while (lc < l && in < end) {
+                    c = (c << 8) | *in++;
+                    lc += 8;
+                }
+                if (lc >= l &&
+                    (hcode[symbol] >> 6) == ((c >> (lc - l)) & ((uint64_t{1} << l) - 1))) {
+                    lc -= l;
+                    if (!HufGetCode(symbol, rlc, c, lc, in, end, out, outBegin, outEnd)) {
+                        return false;
+                    }
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                return false;
+            }
+        }
+    }
+
+    // The last byte may hold fewer than 8 valid bits
+    const uint32_t padding = (8 - bitCount) & 7;
+    c >>= padding;
+    lc -= std::min(lc, padding);
+
+    while (lc > 0) {
+        const HufDec& entry = table[(c << (kHufDecBits - lc)) & kHufDecMask];
+        if (!entry.m_len || entry.m_len > lc) {
+            return false;
+        }
+        lc -= entry.m_len;
+        if (!HufGetCode(entry.m_lit, rlc, c, lc, in, end, out, outBegin, outEnd)) {
+            return false;
+        }
+    }
+
+    return out == outEnd;
+}
+
+bool HufUncompress(const uint8_t *compressed, size_t size, uint16_t *raw, size_t count,
+                   Scratch& scratch) {
+    if (size == 0) {
+        return count == 0;
+    }
+
+    ByteReader reader(compressed, size);
+    uint32_t im = 0;
+    uint32_t iM = 0;
+    uint32_t tableLength = 0;
+    uint32_t bitCount = 0;
+    if (!reader.Read(im) || !reader.Read(iM) || !reader.Read(tableLength) ||
+        !reader.Read(bitCount) || !reader.Skip(4) || im >= kHufEncSize || iM >= kHufEncSize ||
+        im > iM) {
+        return false;
+    }
+
+    const uint8_t *in = reader.GetPointer();
+    const uint8_t *end = compressed + size;
+    if (!HufUnpackEncTable(in, end, im, iM, scratch.m_hufCodes) ||
+        uint64_t{bitCount} > 8 * static_cast<uint64_t>(end - in) ||
+        !HufBuildDecTable(scratch.m_hufCodes, im, iM, scratch.m_hufDecodeTable)) {
+        return false;
+    }
+
+    // The largest symbol is the run length code
+    return HufDecode(scratch.m_hufCodes, scratch.m_hufDecodeTable, in, bitCount, iM, raw, count);
+}
+
+// Inverse 2D Haar wavelet, see OpenEXR ImfWav.cpp (14-bit variant for small value ranges)
+void Wdec14(uint16_t l, uint16_t h, uint16_t& a, uint16_t& b) {
+    const int16_t ls = static_cast<int16_t>(l);
+    const int16_t hs = static_cast<int16_t>(h);
+    const int ai = ls + (hs & 1) + (hs >> 1);
+    a = static_cast<uint16_t>(static_cast<int16_t>(ai));
+    b = static_cast<uint16_t>(static_cast<int16_t>(ai - hs));
+}
+
+void Wdec16(uint16_t l, uint16_t h, uint16_t& a, uint16_t& b) {
+    constexpr int kOffset = 1 << 15;
+    constexpr int kModMask = (1 << 16) - 1;
+    const int m = l;
+    const int d = h;
+    const int bb = (m - (d >> 1)) & kModMask;
+    const int aa = (d + bb - kOffset) & kModMask;
+    a = static_cast<uint16_t>(aa);
+    b = static_cast<uint16_t>(bb);
+}
+
+void Wav2Decode(uint16_t *in, int nx, int ox, int ny, int oy, uint16_t mx) {
+    const bool w14 = mx < (1 << 14);
+    auto decode = [w14](uint16_t l, uint16_t h, uint16_t& a, uint16_t& b) {
+        w14 ? Wdec14(l, h, a, b) : Wdec16(l, h, a, b);
+    };
+
+    const int n = std::min(nx, ny);
+    int p = 1;
+    while (p <= n) {
+        p <<= 1;
+    }
+    p >>= 1;
+    int p2 = p;
+    p >>= 1;
+
+    while (p >= 1) {
+        uint16_t *py = in;
+        uint16_t *ey = in + oy * (ny - p2);
+        const int oy1 = oy * p;
+        const int oy2 = oy * p2;
+        const int ox1 = ox * p;
+        const int ox2 = ox * p2;
+        uint16_t i00, i01, i10, i11;
+
+        for (; py <= ey; py += oy2) {
+            uint16_t *px = py;
+            uint16_t *ex = py + ox * (nx - p2);
+
+            for (; px <= ex; px += ox2) {
+                uint16_t *p01 = px + ox1;
+                uint16_t *p10 = px + oy1;
+                uint16_t *p11 = p10 + ox1;
+                decode(*px, *p10, i00, i10);
+                decode(*p01, *p11, i01, i11);
+                decode(i00, i01, *px, *p01);
+                decode(i10, i11, *p10, *p11);
+            }
+
+            // Odd column
+            if (nx & p) {
+                uint16_t *p10 = px + oy1;
+                decode(*px, *p10, i00, *p10);
+                *px = i00;
+            }
+        }
+
+        // Odd line
+        if (ny & p) {
+            uint16_t *px = py;
+            uint16_t *ex = py + ox * (nx - p2);
+            for (; px <= ex; px += ox2) {
+                uint16_t *p01 = px + ox1;
+                decode(*px, *p01, i00, *p01);
+                *px = i00;
+            }
+        }
+
+        p2 = p;
+        p >>= 1;
+    }
+}
+
+bool PizUncompress(const uint8_t *source, size_t sourceSize, const Header& header,
+                   uint32_t lineCount, uint8_t *destination, size_t size, Scratch& scratch) {
+    ByteReader reader(source, sourceSize);
+    uint16_t minNonZero = 0;
+    uint16_t maxNonZero = 0;
+    if (!reader.Read(minNonZero) || !reader.Read(maxNonZero) || maxNonZero >= kBitmapSize) {
+        return false;
+    }
+
+    // Values present in the data; the lookup table maps the dense codes back to them
+    scratch.m_bitmap.assign(kBitmapSize, 0);
+    if (minNonZero <= maxNonZero) {
+        const size_t bitmapBytes = size_t{maxNonZero} - minNonZero + 1;
+        if (reader.GetRemaining() < bitmapBytes) {
+            return false;
+        }
+        std::memcpy(scratch.m_bitmap.data() + minNonZero, reader.GetPointer(), bitmapBytes);
+        reader.Skip(bitmapBytes);
+    }
+
+    scratch.m_lut.assign(kUShortRange, 0);
+    uint32_t lutSize = 0;
+    for (uint32_t i = 0; i < kUShortRange; ++i) {
+        if (i == 0 || (scratch.m_bitmap[i >> 3] & (1u << (i & 7)))) {
+            scratch.m_lut[lutSize++] = static_cast<uint16_t>(i);
+        }
+    }
+    const uint16_t maxValue = static_cast<uint16_t>(lutSize - 1);
+
+    int32_t length = 0;
+    if (!reader.Read(length) || length < 0 ||
+        reader.GetRemaining() < static_cast<size_t>(length)) {
+        return false;
+    }
+
+    std::vector<uint16_t>& words = scratch.m_words;
+    words.resize(size / 2);
+    if (!HufUncompress(reader.GetPointer(), length, words.data(), words.size(), scratch)) {
+        return false;
+    }
+
+    // Every channel is stored as a separate plane of 16-bit words
+    const int nx = static_cast<int>(header.m_width);
+    const int ny = static_cast<int>(lineCount);
+    size_t start = 0;
+    for (const Channel& channel : header.m_channels) {
+        const int wordCount = static_cast<int>(channel.m_byteSize / 2);
+        for (int j = 0; j < wordCount; ++j) {
+            Wav2Decode(words.data() + start + j, nx, wordCount, ny, nx * wordCount, maxValue);
+        }
+        start += size_t{header.m_width} * lineCount * wordCount;
+    }
+
+    for (uint16_t& word : words) {
+        word = scratch.m_lut[word];
+    }
+
+    // Interleave the channel planes into scanlines
+    std::vector<size_t> cursors;
+    start = 0;
+    for (const Channel& channel : header.m_channels) {
+        cursors.push_back(start);
+        start += size_t{header.m_width} * lineCount * (channel.m_byteSize / 2);
+    }
+    uint8_t *out = destination;
+    for (uint32_t y = 0; y < lineCount; ++y) {
+        for (size_t c = 0; c < header.m_channels.size(); ++c) {
+            const size_t wordCount = size_t{header.m_width} * (header.m_channels[c].m_byteSize / 2);
+            std::memcpy(out, words.data() + cursors[c], wordCount * 2);
+            cursors[c] += wordCount;
+            out += wordCount * 2;
+        }
+    }
+    return true;
+}
+
+bool Uncompress(const uint8_t *source, size_t sourceSize, const Header& header,
+                uint32_t lineCount, uint8_t *destination, size_t size, Scratch& scratch) {
+    switch (header.m_compression) {
+    case Compression::Rle:
+        scratch.m_bytes.resize(size);
+        if (!RleUncompress(source, sourceSize, scratch.m_bytes.data(), size)) {
+            return false;
+        }
+        ReconstructBytes(scratch.m_bytes.data(), destination, size, scratch.m_bytes);
+        return true;
+    case Compression::Zips:
+    case Compression::Zip: {
+        scratch.m_bytes.resize(size);
+        const int decoded = stbi_zlib_decode_buffer(
+            reinterpret_cast<char *>(scratch.m_bytes.data()), static_cast<int>(size),
+            reinterpret_cast<const char *>(source), static_cast<int>(sourceSize));
+        if (decoded != static_cast<int>(size)) {
+            return false;
+        }
+        ReconstructBytes(scratch.m_bytes.data(), destination, size, scratch.m_bytes);
+        return true;
+    }
+    case Compression::Piz:
+        return PizUncompress(source, sourceSize, header, lineCount, destination, size, scratch);
+    default:
+        return false;
+    }
+}
+
+bool DecodeChunk(const uint8_t *data, size_t size, uint64_t offset, const Header& header,
+                 Scratch& scratch, exr_loader::Image& image) {
+    if (offset >= size) {
+        return false;
+    }
+
+    ByteReader reader(data + offset, size - offset);
+    int32_t y = 0;
+    int32_t dataSize = 0;
+    if (!reader.Read(y) || !reader.Read(dataSize) || dataSize < 0 ||
+        reader.GetRemaining() < static_cast<size_t>(dataSize) || y < header.m_yMin ||
+        y > header.m_yMax) {
+        return false;
+    }
+
+    const uint32_t firstLine = static_cast<uint32_t>(int64_t{y} - header.m_yMin);
+    const uint32_t lineCount = std::min(header.m_linesPerChunk, header.m_height - firstLine);
+    const size_t expectedSize = header.m_bytesPerLine * lineCount;
+
+    // Chunks that would not shrink are stored uncompressed
+    const uint8_t *pixels = reader.GetPointer();
+    if (static_cast<size_t>(dataSize) < expectedSize) {
+        scratch.m_uncompressed.resize(expectedSize);
+        if (!Uncompress(pixels, dataSize, header, lineCount, scratch.m_uncompressed.data(),
+                        expectedSize, scratch)) {
+            return false;
+        }
+        pixels = scratch.m_uncompressed.data();
+    } else if (static_cast<size_t>(dataSize) != expectedSize) {
+        return false;
+    }
+
+    // Scanlines hold each channel in turn for the whole line
+    const uint32_t width = header.m_width;
+    for (uint32_t line = 0; line < lineCount; ++line) {
+        const uint8_t *source = pixels + line * header.m_bytesPerLine;
+        uint16_t *destination = image.m_pixels.data() + size_t{firstLine + line} * width * 4;
+
+        for (const Channel& channel : header.m_channels) {
+            if (channel.m_target < 0) {
+                continue;
+            }
+            const uint8_t *samples = source + channel.m_lineOffset * width;
+            for (uint32_t x = 0; x < width; ++x) {
+                uint16_t value = 0;
+                if (channel.m_pixelType == PixelType::Half) {
+                    std::memcpy(&value, samples + x * 2, 2);
+                } else if (channel.m_pixelType == PixelType::Float) {
+                    float sample = 0.0f;
+                    std::memcpy(&sample, samples + x * 4, 4);
+                    value = exr_loader::FloatToHalf(sample);
+                } else {
+                    uint32_t sample = 0;
+                    std::memcpy(&sample, samples + x * 4, 4);
+                    value = exr_loader::FloatToHalf(static_cast<float>(sample));
+                }
+                destination[x * 4 + channel.m_target] = value;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// EXR Loader Implementation
+
+namespace exr_loader {
+
+bool IsExr(const uint8_t *data, size_t size) {
+    uint32_t magic = 0;
+    if (!data || size < sizeof(magic)) {
+        return false;
+    }
+    std::memcpy(&magic, data, sizeof(magic));
+    return magic == kMagic;
+}
+
+bool Load(const uint8_t *data, size_t size, Image& image) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    ByteReader reader(data, size);
+    Header header;
+    if (!ParseHeader(reader, header)) {
+        return false;
+    }
+    if (std::none_of(header.m_channels.begin(), header.m_channels.end(),
+                     [](const Channel& channel) { return channel.m_target >= 0; })) {
+        std::cerr << "Error: EXR file has no R, G, B or A channel" << std::endl;
+        return false;
+    }
+
+    const uint32_t chunkCount =
+        (header.m_height + header.m_linesPerChunk - 1) / header.m_linesPerChunk;
+    std::vector<uint64_t> offsets(chunkCount);
+    for (uint64_t& offset : offsets) {
+        if (!reader.Read(offset)) {
+            std::cerr << "Error: Truncated EXR offset table" << std::endl;
+            return false;
+        }
+    }
+
+    // Missing color channels are black, a missing alpha channel is opaque
+    image.m_width = header.m_width;
+    image.m_height = header.m_height;
+    image.m_pixels.assign(size_t{header.m_width} * header.m_height * 4, 0);
+    for (size_t i = 3; i < image.m_pixels.size(); i += 4) {
+        image.m_pixels[i] = kHalfOne;
+    }
+
+    // Chunks cover disjoint scanlines, so workers take the next chunk until all are decoded
+    std::atomic<uint32_t> nextChunk{0};
+    std::atomic<bool> failed{false};
+    auto decodeChunks = [&]() {
+        Scratch scratch;
+        for (uint32_t chunk = nextChunk++; chunk < chunkCount && !failed; chunk = nextChunk++) {
+            if (!DecodeChunk(data, size, offsets[chunk], header, scratch, image)) {
+                failed = true;
+            }
+        }
+    };
+
+#if defined(__EMSCRIPTEN__)
+    const uint32_t threadCount = 1;
+#else
+    const uint32_t threadCount =
+        std::clamp(std::thread::hardware_concurrency(), 1u, std::max(chunkCount, 1u));
+#endif
+    std::vector<std::thread> workers;
+    for (uint32_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back(decodeChunks);
+    }
+    decodeChunks();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    if (failed) {
+        std::cerr << "Error: Failed to decode EXR pixel data" << std::endl;
+        return false;
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double durationMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    std::cout << "Decoded EXR image (" << header.m_width << "x" << header.m_height << ", "
+              << chunkCount << " chunks, " << threadCount << " threads) in " << durationMs
+              << "ms" << std::endl;
+    return true;
+}
+
+float HalfToFloat(uint16_t value) {
+    const uint32_t sign = (value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1fu;
+    const uint32_t mantissa = value & 0x3ffu;
+
+    if (exponent == 0) {
+        // Zero or subnormal
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+
+    uint32_t bits = sign | (mantissa << 13);
+    if (exponent == 31) {
+        bits |= 0x7f800000u; // Infinity or NaN
+    } else {
+        bits |= (exponent + 112) << 23;
+    }
+    float result = 0.0f;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+uint16_t FloatToHalf(float value) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t magnitude = bits & 0x7fffffffu;
+
+    if (magnitude >= 0x7f800000u) {
+        return sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x200u : 0u); // Infinity or NaN
+    }
+    if (magnitude >= 0x477ff000u) {
+        return sign | 0x7c00u; // Rounds above the largest half
+    }
+
+    // Round to nearest even
+    if (magnitude < 0x38800000u) {
+        // Subnormal half
+        if (magnitude < 0x33000000u) {
+            return sign;
+        }
+        const uint32_t shift = 126 - (magnitude >> 23);
+        const uint32_t mantissa = (magnitude & 0x7fffffu) | 0x800000u;
+        uint32_t result = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (result & 1))) {
+            ++result;
+        }
+        return static_cast<uint16_t>(sign | result);
+    }
+
+    uint32_t result = (magnitude - 0x38000000u) >> 13;
+    const uint32_t remainder = magnitude & 0x1fffu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (result & 1))) {
+        ++result;
+    }
+    return static_cast<uint16_t>(sign | result);
+}
+
+} // namespace exr_loader
@@ -0,0 +1,27 @@
+#pragma once
+
+// Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace exr_loader {
+
+struct Image {
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    std::vector<uint16_t> m_pixels; // RGBA half floats, top row first
+};
+
+// True if the data starts with the OpenEXR magic number
+bool IsExr(const uint8_t *data, size_t size);
+
+// Decodes a single-part scanline OpenEXR image with half or float R, G, B (and optionally A)
+// channels. Supports NONE, RLE, ZIPS, ZIP and PIZ compression; the chunks are decompressed in
+// parallel. Missing color channels are black, a missing alpha channel is opaque.
+bool Load(const uint8_t *data, size_t size, Image& image);
+
+float HalfToFloat(uint16_t value);
+uint16_t FloatToHalf(float value);
+
+} // namespace exr_loader
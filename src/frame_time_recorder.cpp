@@ -0,0 +1,259 @@
+// Standard Library Headers
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+// Project Headers
+#include "frame_time_recorder.h"
+
+//----------------------------------------------------------------------
+// Internal Utility Functions
+
+namespace {
+
+uint64_t ToMicroseconds(float timeMs) {
+    return timeMs > 0.0f ? static_cast<uint64_t>(std::llround(timeMs * 1000.0)) : 0;
+}
+
+float ToMilliseconds(uint64_t timeUs) {
+    return static_cast<float>(timeUs) / 1000.0f;
+}
+
+// 1-based nearest rank of a percentile (0-1) among count samples
+uint64_t GetNearestRank(float percentile, uint64_t count) {
+    return std::clamp<uint64_t>(
+        static_cast<uint64_t>(std::ceil(percentile * static_cast<double>(count))), 1, count);
+}
+
+// Innermost active phase of the calling thread
+thread_local FrameTimeRecorder::ScopedPhase *t_activePhase = nullptr;
+
+} // namespace
+
+//----------------------------------------------------------------------
+// ScopedPhase Implementation
+
+FrameTimeRecorder::ScopedPhase::ScopedPhase(Phase phase)
+    : m_phase(phase), m_start(std::chrono::high_resolution_clock::now()), m_parent(t_activePhase) {
+    // Pause the enclosing phase
+    if (m_parent) {
+        m_parent->m_elapsed += m_start - m_parent->m_start;
+    }
+    t_activePhase = this;
+}
+
+FrameTimeRecorder::ScopedPhase::~ScopedPhase() {
+    const auto end = std::chrono::high_resolution_clock::now();
+    m_elapsed += end - m_start;
+    GetInstance().AddPhaseTime(m_phase,
+                               std::chrono::duration<float, std::milli>(m_elapsed).count());
+
+    // Resume the enclosing phase
+    if (m_parent) {
+        m_parent->m_start = end;
+    }
+    t_activePhase = m_parent;
+}
+
+//----------------------------------------------------------------------
+// FrameTimeRecorder Class Implementation
+
+void FrameTimeRecorder::RecordFrame(float frameTimeMs) {
+    // Collect the phase time accumulated since the previous frame
+    Hitch frame;
+    float attributedMs = 0.0f;
+    for (size_t i = 0; i < kPhaseCount; ++i) {
+        frame.m_phaseMs[i] = ToMilliseconds(m_pendingPhaseUs[i].exchange(0));
+        attributedMs += frame.m_phaseMs[i];
+    }
+
+    const uint64_t frameTimeUs = ToMicroseconds(frameTimeMs);
+    const bool isHitch = frameTimeMs > m_hitchBudgetMs.load();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_buckets[GetBucketIndex(frameTimeUs)];
+    ++m_frameCount;
+    m_maxUs = std::max(m_maxUs, frameTimeUs);
+
+    if (!isHitch) {
+        return;
+    }
+
+    frame.m_frameIndex = m_frameCount - 1;
+    frame.m_frameTimeMs = frameTimeMs;
+
+    ++m_hitchCount;
+    for (size_t i = 0; i < kPhaseCount; ++i) {
+        m_hitchPhaseMs[i] += frame.m_phaseMs[i];
+    }
+    m_hitchUnattributedMs += std::max(frameTimeMs - attributedMs, 0.0f);
+
+    if (m_hitches.size() == kMaxHitchRecords) {
+        m_hitches.pop_front();
+    }
+    m_hitches.push_back(frame);
+
+    PrintHitch(frame);
+}
+
+void FrameTimeRecorder::AddPhaseTime(Phase phase, float timeMs) {
+    m_pendingPhaseUs[static_cast<size_t>(phase)].fetch_add(ToMicroseconds(timeMs));
+}
+
+void FrameTimeRecorder::Reset() {
+    for (auto& pending : m_pendingPhaseUs) {
+        pending.store(0);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buckets.fill(0);
+    m_frameCount = 0;
+    m_maxUs = 0;
+    m_hitchCount = 0;
+    m_hitchPhaseMs.fill(0.0);
+    m_hitchUnattributedMs = 0.0;
+    m_hitches.clear();
+}
+
+void FrameTimeRecorder::PrintSummary() const {
+    const Summary summary = GetSummary();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Frame times (" << summary.m_frameCount << " frames): p50 " << summary.m_p50
+              << "ms, p95 " << summary.m_p95 << "ms, p99 " << summary.m_p99 << "ms, max "
+              << summary.m_max << "ms" << std::endl;
+    std::cout << "Hitches over " << GetHitchBudget() << "ms: " << summary.m_hitchCount
+              << std::endl;
+
+    if (summary.m_hitchCount > 0) {
+        std::cout << "  Time in hitches by phase:" << std::endl;
+        for (size_t i = 0; i < kPhaseCount; ++i) {
+            std::cout << "    " << std::left << std::setw(20)
+                      << GetPhaseName(static_cast<Phase>(i)) << std::right << std::setw(10)
+                      << summary.m_hitchPhaseMs[i] << "ms" << std::endl;
+        }
+        std::cout << "    " << std::left << std::setw(20) << "unattributed" << std::right
+                  << std::setw(10) << summary.m_hitchUnattributedMs << "ms" << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+void FrameTimeRecorder::SetHitchBudget(float budgetMs) noexcept {
+    m_hitchBudgetMs.store(budgetMs);
+}
+
+float FrameTimeRecorder::GetHitchBudget() const noexcept {
+    return m_hitchBudgetMs.load();
+}
+
+FrameTimeRecorder::Summary FrameTimeRecorder::GetSummary() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Summary summary;
+    summary.m_frameCount = m_frameCount;
+    summary.m_hitchCount = m_hitchCount;
+    summary.m_p50 = GetPercentile(0.50f);
+    summary.m_p95 = GetPercentile(0.95f);
+    summary.m_p99 = GetPercentile(0.99f);
+    summary.m_max = ToMilliseconds(m_maxUs);
+    for (size_t i = 0; i < kPhaseCount; ++i) {
+        summary.m_hitchPhaseMs[i] = static_cast<float>(m_hitchPhaseMs[i]);
+    }
+    summary.m_hitchUnattributedMs = static_cast<float>(m_hitchUnattributedMs);
+    return summary;
+}
+
+std::deque<FrameTimeRecorder::Hitch> FrameTimeRecorder::GetHitches() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hitches;
+}
+
+FrameTimeRecorder& FrameTimeRecorder::GetInstance() {
+    static FrameTimeRecorder recorder;
+    return recorder;
+}
+
+const char *FrameTimeRecorder::GetPhaseName(Phase phase) {
+    static const char *kPhaseNames[kPhaseCount] = {"loading", "pipeline creation", "uploads",
+                                                   "sorting", "encoding",          "present wait"};
+    return kPhaseNames[static_cast<size_t>(phase)];
+}
+
+float FrameTimeRecorder::GetSortedPercentile(const std::vector<float>& sortedValues,
+                                             float percentile) {
+    if (sortedValues.empty()) {
+        return 0.0f;
+    }
+    return sortedValues[GetNearestRank(percentile, sortedValues.size()) - 1];
+}
+
+//----------------------------------------------------------------------
+// Private Member Functions
+
+size_t FrameTimeRecorder::GetBucketIndex(uint64_t valueUs) {
+    if (valueUs < kSubBucketCount) {
+        return static_cast<size_t>(valueUs);
+    }
+
+    // Clamp to the largest value the histogram can represent
+    valueUs = std::min(valueUs, (uint64_t{1} << (kMaxMagnitude + 1)) - 1);
+
+    // Power of two range, then the linear sub-bucket within it
+    const uint32_t magnitude = static_cast<uint32_t>(std::bit_width(valueUs)) - 1;
+    const uint32_t shift = magnitude - kSubBucketBits;
+    const size_t subBucket = static_cast<size_t>(valueUs >> shift) - kSubBucketCount;
+    return kSubBucketCount * (shift + 1) + subBucket;
+}
+
+uint64_t FrameTimeRecorder::GetBucketUpperBound(size_t index) {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+
+    const uint32_t shift = static_cast<uint32_t>(index / kSubBucketCount) - 1;
+    const uint64_t lowerBound = (uint64_t{index % kSubBucketCount} + kSubBucketCount) << shift;
+    return lowerBound + (uint64_t{1} << shift) - 1;
+}
+
+float FrameTimeRecorder::GetPercentile(float percentile) const {
+    if (m_frameCount == 0) {
+        return 0.0f;
+    }
+
+    // Nearest-rank percentile; the bucket bound is capped by the exact maximum
+    const uint64_t rank = GetNearestRank(percentile, m_frameCount);
+    uint64_t count = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        count += m_buckets[i];
+        if (count >= rank) {
+            return ToMilliseconds(std::min(GetBucketUpperBound(i), m_maxUs));
+        }
+    }
+    return ToMilliseconds(m_maxUs);
+}
+
+void FrameTimeRecorder::PrintHitch(const Hitch& hitch) const {
+    // List the phases that ran during the frame, largest first
+    std::array<size_t, kPhaseCount> order{};
+    for (size_t i = 0; i < kPhaseCount; ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [&hitch](size_t a, size_t b) { return hitch.m_phaseMs[a] > hitch.m_phaseMs[b]; });
+
+    float attributedMs = 0.0f;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Hitch: frame " << hitch.m_frameIndex << " took " << hitch.m_frameTimeMs << "ms";
+    for (size_t i : order) {
+        if (hitch.m_phaseMs[i] >= 0.1f) {
+            std::cout << ", " << GetPhaseName(static_cast<Phase>(i)) << " " << hitch.m_phaseMs[i]
+                      << "ms";
+        }
+        attributedMs += hitch.m_phaseMs[i];
+    }
+    std::cout << ", unattributed " << std::max(hitch.m_frameTimeMs - attributedMs, 0.0f) << "ms"
+              << std::endl;
+    std::cout << std::defaultfloat;
+}
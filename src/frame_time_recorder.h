@@ -0,0 +1,134 @@
+#pragma once
+
+// Standard Library Headers
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// FrameTimeRecorder Class
+//
+// Records every frame time into a log-linear (HDR-style) histogram so percentiles stay accurate
+// from sub-millisecond frames to multi-second stalls without keeping the samples around. Work
+// that commonly causes spikes is timed with ScopedPhase; when a frame exceeds the hitch budget
+// the phase time accumulated since the previous frame is kept as a hitch record, so a spike can
+// be attributed to e.g. uploads or pipeline creation instead of just being counted.
+//
+// Phases may be timed on any thread (loading runs on the main thread, everything else on the
+// render thread); their time is attributed to the next recorded frame.
+class FrameTimeRecorder {
+  public:
+    // Types
+    enum class Phase {
+        Loading = 0,      // Parsing and decoding assets
+        PipelineCreation, // Shader module and pipeline creation
+        Uploads,          // GPU resource creation, uploads and IBL precomputation
+        Sorting,          // Transparent submesh sorting
+        Encoding,         // Command encoding and submission
+        PresentWait       // Acquiring and presenting the surface texture
+    };
+
+    static constexpr size_t kPhaseCount = 6;
+
+    struct Hitch {
+        uint64_t m_frameIndex = 0;
+        float m_frameTimeMs = 0.0f;
+        std::array<float, kPhaseCount> m_phaseMs{}; // Time per phase; the rest is unattributed
+    };
+
+    struct Summary {
+        uint64_t m_frameCount = 0;
+        uint64_t m_hitchCount = 0;
+        float m_p50 = 0.0f;
+        float m_p95 = 0.0f;
+        float m_p99 = 0.0f;
+        float m_max = 0.0f;
+        std::array<float, kPhaseCount> m_hitchPhaseMs{}; // Phase time summed over all hitches
+        float m_hitchUnattributedMs = 0.0f;
+    };
+
+    // Times a phase for the lifetime of the scope. Phases are exclusive: while a nested phase is
+    // active on the same thread (e.g. pipeline creation during uploads), the enclosing one is
+    // paused, so no time is attributed twice.
+    class ScopedPhase {
+      public:
+        explicit ScopedPhase(Phase phase);
+        ~ScopedPhase();
+
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+        ScopedPhase(ScopedPhase&&) = delete;
+        ScopedPhase& operator=(ScopedPhase&&) = delete;
+
+      private:
+        Phase m_phase;
+        std::chrono::high_resolution_clock::time_point m_start;   // Start of the running interval
+        std::chrono::high_resolution_clock::duration m_elapsed{}; // Time before nested phases
+        ScopedPhase *m_parent = nullptr;                          // Enclosing phase on this thread
+    };
+
+    // Constants
+    static constexpr float kDefaultHitchBudgetMs = 33.3f; // Two frames at 60 Hz
+    static constexpr size_t kMaxHitchRecords = 64;        // Most recent hitches kept
+
+    // Constructor
+    FrameTimeRecorder() = default;
+
+    // Rule of 5
+    FrameTimeRecorder(const FrameTimeRecorder&) = delete;
+    FrameTimeRecorder& operator=(const FrameTimeRecorder&) = delete;
+    FrameTimeRecorder(FrameTimeRecorder&&) = delete;
+    FrameTimeRecorder& operator=(FrameTimeRecorder&&) = delete;
+
+    // Public Interface
+    void RecordFrame(float frameTimeMs);
+    void AddPhaseTime(Phase phase, float timeMs);
+    void Reset();
+    void PrintSummary() const;
+
+    // Accessors
+    void SetHitchBudget(float budgetMs) noexcept;
+    float GetHitchBudget() const noexcept;
+    Summary GetSummary() const;
+    std::deque<Hitch> GetHitches() const;
+
+    // Recorder shared by the application and renderer; safe to use from any thread
+    static FrameTimeRecorder& GetInstance();
+
+    static const char *GetPhaseName(Phase phase);
+
+    // Nearest-rank percentile of ascending samples, matching the histogram percentiles; used by
+    // the stress and soak tests, which keep their samples
+    static float GetSortedPercentile(const std::vector<float>& sortedValues, float percentile);
+
+  private:
+    // Histogram layout: values (in microseconds) below kSubBucketCount are counted exactly,
+    // every further power of two is split into kSubBucketCount linear sub-buckets (<1% error)
+    static constexpr uint32_t kSubBucketBits = 7;
+    static constexpr uint32_t kSubBucketCount = 1u << kSubBucketBits;
+    static constexpr uint32_t kMaxMagnitude = 26; // Values up to ~67 s, larger ones are clamped
+    static constexpr size_t kBucketCount =
+        kSubBucketCount * (kMaxMagnitude - kSubBucketBits + 2);
+
+    // Private Member Functions
+    static size_t GetBucketIndex(uint64_t valueUs);
+    static uint64_t GetBucketUpperBound(size_t index);
+    float GetPercentile(float percentile) const;
+    void PrintHitch(const Hitch& hitch) const;
+
+    // Private Member Variables
+    std::array<std::atomic<uint64_t>, kPhaseCount> m_pendingPhaseUs{}; // Since the last frame
+    std::atomic<float> m_hitchBudgetMs{kDefaultHitchBudgetMs};
+
+    mutable std::mutex m_mutex; // Guards everything below
+    std::array<uint64_t, kBucketCount> m_buckets{};
+    uint64_t m_frameCount = 0;
+    uint64_t m_maxUs = 0;
+    uint64_t m_hitchCount = 0;
+    std::array<double, kPhaseCount> m_hitchPhaseMs{};
+    double m_hitchUnattributedMs = 0.0;
+    std::deque<Hitch> m_hitches;
+};
@@ -0,0 +1,288 @@
+// Standard Library Headers
+#include <algorithm>
+
+// Project Headers
+#include "gpu_resource_pool.h"
+
+//----------------------------------------------------------------------
+// Internal Constants and Utility Functions
+
+namespace {
+
+// Pooled resources idle for longer than this are destroyed (~5 seconds at 60 FPS)
+constexpr uint64_t kIdleTrimFrames = 300;
+
+// Upper bound for the memory held by idle resources
+constexpr uint64_t kMaxPooledBytes = 512ull * 1024ull * 1024ull;
+
+uint32_t BytesPerTexel(wgpu::TextureFormat format) {
+    switch (format) {
+    case wgpu::TextureFormat::R8Unorm:
+        return 1;
+    case wgpu::TextureFormat::R16Float:
+        return 2;
+    case wgpu::TextureFormat::RGBA16Float:
+    case wgpu::TextureFormat::RG32Float:
+        return 8;
+    case wgpu::TextureFormat::RGBA32Float:
+        return 16;
+    default:
+        return 4;
+    }
+}
+
+uint64_t EstimateTextureSize(const wgpu::TextureDescriptor& descriptor) {
+    uint64_t size = 0;
+    for (uint32_t level = 0; level < descriptor.mipLevelCount; ++level) {
+        const uint64_t width = std::max(descriptor.size.width >> level, 1u);
+        const uint64_t height = std::max(descriptor.size.height >> level, 1u);
+        size += width * height;
+    }
+    return size * descriptor.size.depthOrArrayLayers * descriptor.sampleCount *
+           BytesPerTexel(descriptor.format);
+}
+
+// Round buffer sizes up to 1/8th of their power of two, so buffers for similarly sized models can
+// be recycled (at most 12.5% waste)
+uint64_t BucketBufferSize(uint64_t size) {
+    uint64_t powerOfTwo = 256;
+    while (powerOfTwo < size) {
+        powerOfTwo <<= 1;
+    }
+    const uint64_t granularity = std::max<uint64_t>(powerOfTwo / 8, 256);
+    return (size + granularity - 1) / granularity * granularity;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// GpuResourcePool Class Implementation
+
+GpuResourcePool::GpuResourcePool(const wgpu::Device& device)
+    : m_device(device), m_completedSerial(std::make_shared<std::atomic<uint64_t>>(0)) {
+    wgpu::Limits limits{};
+    m_device.GetLimits(&limits);
+    m_maxBufferSize = limits.maxBufferSize;
+}
+
+GpuResourcePool::~GpuResourcePool() {
+    for (auto& entry : m_textures) {
+        entry.m_resource.Destroy();
+    }
+    for (auto& entry : m_buffers) {
+        entry.m_resource.Destroy();
+    }
+}
+
+wgpu::Texture GpuResourcePool::AcquireTexture(const wgpu::TextureDescriptor& descriptor) {
+    const TextureKey key{descriptor.dimension,   descriptor.size.width,
+                         descriptor.size.height, descriptor.size.depthOrArrayLayers,
+                         descriptor.format,      descriptor.mipLevelCount,
+                         descriptor.sampleCount, descriptor.usage};
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // View formats and labels are not part of the key, so only pool plain descriptors
+    if (descriptor.viewFormatCount == 0) {
+        for (auto it = m_textures.begin(); it != m_textures.end(); ++it) {
+            if (it->m_key == key && IsReusable(it->m_releaseSerial)) {
+                wgpu::Texture texture = std::move(it->m_resource);
+                m_stats.m_pooledBytes -= it->m_sizeInBytes;
+                m_textures.erase(it);
+                m_stats.m_pooledTextures = m_textures.size();
+                m_stats.m_textureHits++;
+                m_stats.m_liveTextures++;
+                m_stats.m_liveBytes += EstimateTextureSize(descriptor);
+                return texture;
+            }
+        }
+    }
+
+    m_stats.m_textureMisses++;
+    m_stats.m_liveTextures++;
+    m_stats.m_liveBytes += EstimateTextureSize(descriptor);
+    return m_device.CreateTexture(&descriptor);
+}
+
+wgpu::Buffer GpuResourcePool::AcquireBuffer(const wgpu::BufferDescriptor& descriptor) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Buffers mapped at creation cannot be recycled (pooled buffers are filled with WriteBuffer)
+    if (descriptor.mappedAtCreation) {
+        m_stats.m_bufferMisses++;
+        m_stats.m_liveBuffers++;
+        m_stats.m_liveBytes += descriptor.size;
+        return m_device.CreateBuffer(&descriptor);
+    }
+
+    // Buffers close to maxBufferSize are not rounded up past the limit
+    uint64_t bucketSize = BucketBufferSize(descriptor.size);
+    if (bucketSize > m_maxBufferSize) {
+        bucketSize = descriptor.size;
+    }
+    const BufferKey key{bucketSize, descriptor.usage};
+
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it) {
+        if (it->m_key == key && IsReusable(it->m_releaseSerial)) {
+            wgpu::Buffer buffer = std::move(it->m_resource);
+            m_stats.m_pooledBytes -= it->m_sizeInBytes;
+            m_buffers.erase(it);
+            m_stats.m_pooledBuffers = m_buffers.size();
+            m_stats.m_bufferHits++;
+            m_stats.m_liveBuffers++;
+            m_stats.m_liveBytes += key.m_size;
+            return buffer;
+        }
+    }
+
+    wgpu::BufferDescriptor bucketDescriptor = descriptor;
+    bucketDescriptor.size = key.m_size;
+
+    m_stats.m_bufferMisses++;
+    m_stats.m_liveBuffers++;
+    m_stats.m_liveBytes += key.m_size;
+    return m_device.CreateBuffer(&bucketDescriptor);
+}
+
+void GpuResourcePool::Release(wgpu::Texture& texture, ReleaseMode mode) {
+    if (!texture) {
+        return;
+    }
+
+    wgpu::TextureDescriptor descriptor{};
+    descriptor.dimension = texture.GetDimension();
+    descriptor.size = {texture.GetWidth(), texture.GetHeight(), texture.GetDepthOrArrayLayers()};
+    descriptor.format = texture.GetFormat();
+    descriptor.mipLevelCount = texture.GetMipLevelCount();
+    descriptor.sampleCount = texture.GetSampleCount();
+    descriptor.usage = texture.GetUsage();
+
+    const TextureKey key{descriptor.dimension,   descriptor.size.width,
+                         descriptor.size.height, descriptor.size.depthOrArrayLayers,
+                         descriptor.format,      descriptor.mipLevelCount,
+                         descriptor.sampleCount, descriptor.usage};
+    const uint64_t sizeInBytes = EstimateTextureSize(descriptor);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint64_t releaseSerial = mode == ReleaseMode::QueueOrdered ? 0 : m_frameSerial;
+    ReleaseLive(m_stats.m_liveTextures, sizeInBytes);
+
+    m_textures.push_back({key, std::move(texture), releaseSerial, m_frameSerial, sizeInBytes});
+    m_stats.m_pooledTextures = m_textures.size();
+    m_stats.m_pooledBytes += sizeInBytes;
+    texture = nullptr;
+
+    TrimToBudget();
+}
+
+void GpuResourcePool::Release(wgpu::Buffer& buffer, ReleaseMode mode) {
+    if (!buffer) {
+        return;
+    }
+
+    const BufferKey key{buffer.GetSize(), buffer.GetUsage()};
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ReleaseLive(m_stats.m_liveBuffers, key.m_size);
+
+    // Mapped buffers cannot be handed out again
+    if (buffer.GetMapState() != wgpu::BufferMapState::Unmapped) {
+        buffer = nullptr;
+        return;
+    }
+
+    const uint64_t releaseSerial = mode == ReleaseMode::QueueOrdered ? 0 : m_frameSerial;
+
+    m_buffers.push_back({key, std::move(buffer), releaseSerial, m_frameSerial, key.m_size});
+    m_stats.m_pooledBuffers = m_buffers.size();
+    m_stats.m_pooledBytes += key.m_size;
+    buffer = nullptr;
+
+    TrimToBudget();
+}
+
+void GpuResourcePool::EndFrame() {
+    // Signal completion of this frame's work to the pool
+    std::shared_ptr<std::atomic<uint64_t>> completedSerial = m_completedSerial;
+    uint64_t serial = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        serial = m_frameSerial++;
+    }
+    m_device.GetQueue().OnSubmittedWorkDone(
+        wgpu::CallbackMode::AllowSpontaneous,
+        [completedSerial, serial](wgpu::QueueWorkDoneStatus status, wgpu::StringView) {
+            if (status != wgpu::QueueWorkDoneStatus::Success) {
+                return;
+            }
+            uint64_t previous = completedSerial->load();
+            while (previous < serial && !completedSerial->compare_exchange_weak(previous, serial)) {
+            }
+        });
+
+    Trim(kIdleTrimFrames);
+}
+
+void GpuResourcePool::Trim(uint64_t maxIdleFrames) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto isIdle = [&](uint64_t releaseFrame) {
+        return m_frameSerial > maxIdleFrames && releaseFrame < m_frameSerial - maxIdleFrames;
+    };
+
+    for (auto it = m_textures.begin(); it != m_textures.end();) {
+        if (isIdle(it->m_releaseFrame) && IsReusable(it->m_releaseSerial)) {
+            m_stats.m_pooledBytes -= it->m_sizeInBytes;
+            it->m_resource.Destroy();
+            it = m_textures.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (auto it = m_buffers.begin(); it != m_buffers.end();) {
+        if (isIdle(it->m_releaseFrame) && IsReusable(it->m_releaseSerial)) {
+            m_stats.m_pooledBytes -= it->m_sizeInBytes;
+            it->m_resource.Destroy();
+            it = m_buffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    m_stats.m_pooledTextures = m_textures.size();
+    m_stats.m_pooledBuffers = m_buffers.size();
+}
+
+GpuResourcePool::Stats GpuResourcePool::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void GpuResourcePool::ReleaseLive(size_t& liveCount, uint64_t sizeInBytes) {
+    // Resources that did not come from the pool are not counted
+    if (liveCount > 0) {
+        liveCount--;
+        m_stats.m_liveBytes -= std::min(m_stats.m_liveBytes, sizeInBytes);
+    }
+}
+
+bool GpuResourcePool::IsReusable(uint64_t releaseSerial) const {
+    return releaseSerial <= m_completedSerial->load();
+}
+
+void GpuResourcePool::TrimToBudget() {
+    // Drop the oldest idle resources first. Dropping (rather than destroying) is safe even if the
+    // GPU still uses them; WebGPU keeps them alive until the work completes.
+    while (m_stats.m_pooledBytes > kMaxPooledBytes && (!m_textures.empty() || !m_buffers.empty())) {
+        const bool dropTexture = !m_textures.empty() &&
+                                 (m_buffers.empty() || m_textures.front().m_releaseFrame <=
+                                                           m_buffers.front().m_releaseFrame);
+        if (dropTexture) {
+            m_stats.m_pooledBytes -= m_textures.front().m_sizeInBytes;
+            m_textures.erase(m_textures.begin());
+        } else {
+            m_stats.m_pooledBytes -= m_buffers.front().m_sizeInBytes;
+            m_buffers.erase(m_buffers.begin());
+        }
+    }
+
+    m_stats.m_pooledTextures = m_textures.size();
+    m_stats.m_pooledBuffers = m_buffers.size();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+// Standard Library Headers
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Third-Party Library Headers
+#include <webgpu/webgpu_cpp.h>
+
+// GpuResourcePool Class
+//
+// Recycles textures and buffers across model and environment loads. Resources are keyed by their
+// descriptor (size, format, mip count, usage, ...) and become reusable once the GPU has finished
+// the frame in which they were released. Pooled resources that stay idle are trimmed. Acquiring
+// and releasing is thread-safe, so worker threads can create resources on a thread-safe device.
+class GpuResourcePool {
+  public:
+    // Types
+    enum class ReleaseMode {
+        FrameFenced, // Reusable once the work submitted in the current frame has completed
+        QueueOrdered // Reusable immediately; only ever accessed through queue-ordered operations
+    };
+
+    struct Stats {
+        uint64_t m_textureHits = 0;
+        uint64_t m_textureMisses = 0;
+        uint64_t m_bufferHits = 0;
+        uint64_t m_bufferMisses = 0;
+        uint64_t m_pooledBytes = 0; // Estimated size of the idle resources
+        size_t m_pooledTextures = 0;
+        size_t m_pooledBuffers = 0;
+        uint64_t m_liveBytes = 0; // Estimated size of the acquired, not yet released resources
+        size_t m_liveTextures = 0;
+        size_t m_liveBuffers = 0;
+    };
+
+    // Constructor
+    explicit GpuResourcePool(const wgpu::Device& device);
+
+    // Destructor
+    ~GpuResourcePool();
+
+    // Rule of 5
+    GpuResourcePool(const GpuResourcePool&) = delete;
+    GpuResourcePool& operator=(const GpuResourcePool&) = delete;
+    GpuResourcePool(GpuResourcePool&&) = delete;
+    GpuResourcePool& operator=(GpuResourcePool&&) = delete;
+
+    // Public Interface
+    wgpu::Texture AcquireTexture(const wgpu::TextureDescriptor& descriptor);
+    wgpu::Buffer AcquireBuffer(const wgpu::BufferDescriptor& descriptor);
+    void Release(wgpu::Texture& texture, ReleaseMode mode = ReleaseMode::FrameFenced);
+    void Release(wgpu::Buffer& buffer, ReleaseMode mode = ReleaseMode::FrameFenced);
+    void EndFrame();
+    void Trim(uint64_t maxIdleFrames);
+
+    // Accessors
+    Stats GetStats() const;
+
+  private:
+    // Types
+    struct TextureKey {
+        wgpu::TextureDimension m_dimension;
+        uint32_t m_width;
+        uint32_t m_height;
+        uint32_t m_depthOrArrayLayers;
+        wgpu::TextureFormat m_format;
+        uint32_t m_mipLevelCount;
+        uint32_t m_sampleCount;
+        wgpu::TextureUsage m_usage;
+
+        bool operator==(const TextureKey&) const = default;
+    };
+
+    struct BufferKey {
+        uint64_t m_size;
+        wgpu::BufferUsage m_usage;
+
+        bool operator==(const BufferKey&) const = default;
+    };
+
+    template <typename Key, typename Resource> struct Entry {
+        Key m_key;
+        Resource m_resource;
+        uint64_t m_releaseSerial; // Reusable once this frame completed (0 for queue-ordered)
+        uint64_t m_releaseFrame;  // Frame in which the resource was released, for idle trimming
+        uint64_t m_sizeInBytes;
+    };
+
+    // Private Member Functions
+    bool IsReusable(uint64_t releaseSerial) const;
+    void ReleaseLive(size_t& liveCount, uint64_t sizeInBytes); // Called with m_mutex held
+    void TrimToBudget();
+
+    // Private Member Variables
+    wgpu::Device m_device;
+    uint64_t m_maxBufferSize = 0; // Device limit, caps the buffer size buckets
+    uint64_t m_frameSerial = 1;
+    std::shared_ptr<std::atomic<uint64_t>> m_completedSerial; // Shared with queue callbacks
+    std::vector<Entry<TextureKey, wgpu::Texture>> m_textures;
+    std::vector<Entry<BufferKey, wgpu::Buffer>> m_buffers;
+    Stats m_stats;
+    mutable std::mutex m_mutex; // Guards the pooled entries and stats
+};
@@ -0,0 +1,277 @@
+// Standard Library Headers
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Project Headers
+#include "asset_archive.h"
+#include "mesh_processor.h"
+#include "model.h"
+
+//----------------------------------------------------------------------
+// Internal Constants
+
+namespace {
+
+constexpr uint32_t kWorkgroupSize = 64;     // Must match kWorkgroupSize in mesh_processor.wgsl
+constexpr uint64_t kBindingAlignment = 256; // minStorageBufferOffsetAlignment
+constexpr uint64_t kParamsStride = 256;     // minUniformBufferOffsetAlignment
+
+// The shader writes the vertices as 18 consecutive floats
+static_assert(sizeof(Model::Vertex) == 18 * sizeof(float));
+
+} // namespace
+
+//----------------------------------------------------------------------
+// MeshProcessor Class implementation
+
+MeshProcessor::MeshProcessor(const wgpu::Device& device) {
+    m_device = device;
+    initBindGroupLayout();
+    initComputePipeline();
+}
+
+void MeshProcessor::ProcessVertices(const Model& model, const wgpu::Buffer& vertexBuffer) {
+    ProcessVertices(model, {{vertexBuffer, 0, UINT32_MAX}});
+}
+
+void MeshProcessor::ProcessVertices(const Model& model,
+                                    const std::vector<VertexRange>& vertexRanges) {
+    const Model::RawVertexData& rawVertexData = model.GetRawVertexData();
+    if (rawVertexData.m_primitives.empty()) {
+        return;
+    }
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    wgpu::Limits limits{};
+    m_device.GetLimits(&limits);
+    const uint64_t maxBindingSize = limits.maxStorageBufferBindingSize;
+
+    // Primitives overlapping a range only partially (split geometry) are converted on the CPU
+    struct Dispatch {
+        const Model::RawPrimitive *m_primitive;
+        const VertexRange *m_range;
+        size_t m_rawChunk = 0; // Raw buffer holding the primitive's attribute block
+    };
+    std::vector<Dispatch> dispatches;
+    std::vector<Model::Vertex> cpuVertices;
+    for (const Model::RawPrimitive& primitive : rawVertexData.m_primitives) {
+        const uint64_t primitiveEnd = uint64_t{primitive.m_firstVertex} + primitive.m_vertexCount;
+        bool converted = false;
+        for (const VertexRange& range : vertexRanges) {
+            const uint64_t rangeEnd = uint64_t{range.m_firstVertex} + range.m_vertexCount;
+            const uint64_t first = std::max(primitive.m_firstVertex, range.m_firstVertex);
+            const uint64_t end = std::min(primitiveEnd, rangeEnd);
+            if (first >= end) {
+                continue;
+            }
+
+            // Storage bindings start at aligned offsets, so bind the aligned range around the
+            // output
+            const uint64_t outputOffset = (first - range.m_firstVertex) * sizeof(Model::Vertex);
+            const uint64_t outputSize = (end - first) * sizeof(Model::Vertex);
+            const uint64_t bindOffset = outputOffset / kBindingAlignment * kBindingAlignment;
+            const uint64_t bindSize = outputOffset + outputSize - bindOffset;
+            const bool whole = first == primitive.m_firstVertex && end == primitiveEnd;
+
+            if (whole && primitive.m_dataSize <= maxBindingSize && bindSize <= maxBindingSize) {
+                dispatches.push_back({&primitive, &range});
+                continue;
+            }
+
+            if (!converted) {
+                cpuVertices.resize(primitive.m_vertexCount);
+                model.ConvertRawPrimitive(primitive, cpuVertices.data());
+                converted = true;
+            }
+            m_device.GetQueue().WriteBuffer(range.m_buffer, outputOffset,
+                                            cpuVertices.data() + (first - primitive.m_firstVertex),
+                                            outputSize);
+        }
+    }
+
+    // Upload the raw attribute bytes as they are, split into buffers within maxBufferSize. The
+    // blocks start at kRawBlockAlignment-aligned offsets, so chunks starting at a block keep the
+    // binding offsets aligned. Only the blocks converted on the GPU are uploaded: a chunk grows
+    // over adjacent blocks and a new one starts after a block converted on the CPU.
+    struct RawChunk {
+        uint64_t m_begin = 0;
+        uint64_t m_end = 0;
+        wgpu::Buffer m_buffer;
+    };
+    static_assert(Model::kRawBlockAlignment % kBindingAlignment == 0);
+    constexpr uint64_t kBlockAlignment = Model::kRawBlockAlignment;
+    std::vector<RawChunk> rawChunks;
+    for (Dispatch& dispatch : dispatches) {
+        const Model::RawPrimitive& primitive = *dispatch.m_primitive;
+        const uint64_t blockBegin = primitive.m_dataOffset;
+        const uint64_t blockEnd = blockBegin + primitive.m_dataSize;
+
+        // Deduplicated primitives share a block that may already be uploaded
+        auto chunk = std::find_if(rawChunks.begin(), rawChunks.end(), [&](const RawChunk& c) {
+            return blockBegin >= c.m_begin && blockEnd <= c.m_end;
+        });
+        if (chunk != rawChunks.end()) {
+            dispatch.m_rawChunk = static_cast<size_t>(chunk - rawChunks.begin());
+            continue;
+        }
+
+        if (!rawChunks.empty()) {
+            RawChunk& last = rawChunks.back();
+            const uint64_t alignedEnd = (last.m_end + kBlockAlignment - 1) / kBlockAlignment *
+                                        kBlockAlignment;
+            if (blockBegin >= last.m_end && blockBegin <= alignedEnd &&
+                blockEnd - last.m_begin <= limits.maxBufferSize) {
+                last.m_end = blockEnd;
+                dispatch.m_rawChunk = rawChunks.size() - 1;
+                continue;
+            }
+        }
+        rawChunks.push_back({blockBegin, blockEnd, nullptr});
+        dispatch.m_rawChunk = rawChunks.size() - 1;
+    }
+
+    for (RawChunk& chunk : rawChunks) {
+        wgpu::BufferDescriptor rawBufferDescriptor{};
+        rawBufferDescriptor.size = chunk.m_end - chunk.m_begin;
+        rawBufferDescriptor.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst;
+        chunk.m_buffer = m_device.CreateBuffer(&rawBufferDescriptor);
+        m_device.GetQueue().WriteBuffer(chunk.m_buffer, 0,
+                                        rawVertexData.m_bytes.data() + chunk.m_begin,
+                                        rawBufferDescriptor.size);
+    }
+
+    // Per-dispatch parameters, one kParamsStride slot each
+    std::vector<uint8_t> paramsData(std::max<size_t>(dispatches.size(), 1) * kParamsStride, 0);
+
+    wgpu::BufferDescriptor paramsBufferDescriptor{};
+    paramsBufferDescriptor.size = paramsData.size();
+    paramsBufferDescriptor.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer paramsBuffer = m_device.CreateBuffer(&paramsBufferDescriptor);
+
+    wgpu::CommandEncoder encoder = m_device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder computePass = encoder.BeginComputePass();
+    computePass.SetPipeline(m_pipeline);
+
+    uint32_t gpuVertexCount = 0;
+    for (size_t i = 0; i < dispatches.size(); ++i) {
+        const Model::RawPrimitive& primitive = *dispatches[i].m_primitive;
+        const VertexRange& range = *dispatches[i].m_range;
+        const RawChunk& rawChunk = rawChunks[dispatches[i].m_rawChunk];
+        const uint64_t outputOffset =
+            uint64_t{primitive.m_firstVertex - range.m_firstVertex} * sizeof(Model::Vertex);
+        const uint64_t outputSize = uint64_t{primitive.m_vertexCount} * sizeof(Model::Vertex);
+        const uint64_t bindOffset = outputOffset / kBindingAlignment * kBindingAlignment;
+        const uint64_t bindSize = outputOffset + outputSize - bindOffset;
+
+        const glm::mat3 normalMatrix =
+            glm::transpose(glm::inverse(glm::mat3(primitive.m_transform)));
+
+        MeshParams params{};
+        params.transform = primitive.m_transform;
+        for (int c = 0; c < 3; ++c) {
+            params.normalMatrix[c] = glm::vec4(normalMatrix[c], 0.0f);
+        }
+        params.vertexCount = primitive.m_vertexCount;
+        params.outputOffset = static_cast<uint32_t>((outputOffset - bindOffset) / sizeof(float));
+        for (size_t a = 0; a < Model::RawPrimitive::kAttributeCount; ++a) {
+            const Model::RawAttribute& attribute = primitive.m_attributes[a];
+            params.attributes[a][0] = attribute.m_offset;
+            params.attributes[a][1] = attribute.m_stride;
+            params.attributes[a][2] = attribute.m_componentType;
+            if (attribute.m_componentType != 0) {
+                params.attributes[a][3] =
+                    attribute.m_components | (attribute.m_normalized ? 0x100u : 0u);
+            }
+        }
+        std::memcpy(paramsData.data() + i * kParamsStride, &params, sizeof(MeshParams));
+
+        wgpu::BindGroupEntry entries[3]{};
+        entries[0].binding = 0;
+        entries[0].buffer = paramsBuffer;
+        entries[0].offset = i * kParamsStride;
+        entries[0].size = sizeof(MeshParams);
+        entries[1].binding = 1;
+        entries[1].buffer = rawChunk.m_buffer;
+        entries[1].offset = primitive.m_dataOffset - rawChunk.m_begin;
+        entries[1].size = primitive.m_dataSize;
+        entries[2].binding = 2;
+        entries[2].buffer = range.m_buffer;
+        entries[2].offset = bindOffset;
+        entries[2].size = bindSize;
+
+        wgpu::BindGroupDescriptor bindGroupDescriptor{};
+        bindGroupDescriptor.layout = m_bindGroupLayout;
+        bindGroupDescriptor.entryCount = 3;
+        bindGroupDescriptor.entries = entries;
+        wgpu::BindGroup bindGroup = m_device.CreateBindGroup(&bindGroupDescriptor);
+
+        // The shader loops over the vertices when they exceed one dispatch dimension
+        const uint32_t workgroupCount =
+            std::min((primitive.m_vertexCount + kWorkgroupSize - 1) / kWorkgroupSize,
+                     limits.maxComputeWorkgroupsPerDimension);
+        computePass.SetBindGroup(0, bindGroup);
+        computePass.DispatchWorkgroups(workgroupCount, 1, 1);
+        gpuVertexCount += primitive.m_vertexCount;
+    }
+
+    computePass.End();
+    m_device.GetQueue().WriteBuffer(paramsBuffer, 0, paramsData.data(), paramsData.size());
+    wgpu::CommandBuffer commands = encoder.Finish();
+    m_device.GetQueue().Submit(1, &commands);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double totalMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    std::cout << "Submitted GPU vertex processing (" << gpuVertexCount << " vertices, "
+              << rawVertexData.m_bytes.size() / 1024 << " KB raw data in " << rawChunks.size()
+              << " buffers) in " << totalMs << "ms" << std::endl;
+}
+
+void MeshProcessor::initBindGroupLayout() {
+    wgpu::BindGroupLayoutEntry entries[3]{};
+
+    // Mesh parameters
+    entries[0].binding = 0;
+    entries[0].visibility = wgpu::ShaderStage::Compute;
+    entries[0].buffer.type = wgpu::BufferBindingType::Uniform;
+    entries[0].buffer.minBindingSize = sizeof(MeshParams);
+
+    // Raw attribute bytes
+    entries[1].binding = 1;
+    entries[1].visibility = wgpu::ShaderStage::Compute;
+    entries[1].buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+
+    // Output vertices
+    entries[2].binding = 2;
+    entries[2].visibility = wgpu::ShaderStage::Compute;
+    entries[2].buffer.type = wgpu::BufferBindingType::Storage;
+
+    wgpu::BindGroupLayoutDescriptor layoutDescriptor{};
+    layoutDescriptor.entryCount = 3;
+    layoutDescriptor.entries = entries;
+    m_bindGroupLayout = m_device.CreateBindGroupLayout(&layoutDescriptor);
+}
+
+void MeshProcessor::initComputePipeline() {
+    std::string shaderCode = LoadTextAsset("./assets/shaders/mesh_processor.wgsl");
+
+    wgpu::ShaderSourceWGSL wgsl{{.nextInChain = nullptr, .code = shaderCode.c_str()}};
+    wgpu::ShaderModuleDescriptor shaderModuleDescriptor{.nextInChain = &wgsl};
+    wgpu::ShaderModule shaderModule = m_device.CreateShaderModule(&shaderModuleDescriptor);
+
+    wgpu::PipelineLayoutDescriptor layoutDescriptor{};
+    layoutDescriptor.bindGroupLayoutCount = 1;
+    layoutDescriptor.bindGroupLayouts = &m_bindGroupLayout;
+    wgpu::PipelineLayout pipelineLayout = m_device.CreatePipelineLayout(&layoutDescriptor);
+
+    wgpu::ComputePipelineDescriptor descriptor{};
+    descriptor.layout = pipelineLayout;
+    descriptor.compute.module = shaderModule;
+    descriptor.compute.entryPoint = "processVertices";
+    m_pipeline = m_device.CreateComputePipeline(&descriptor);
+}
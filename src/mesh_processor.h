@@ -0,0 +1,66 @@
+#pragma once
+
+// Standard Library Headers
+#include <cstdint>
+#include <vector>
+
+// Third-Party Library Headers
+#include <glm/glm.hpp>
+#include <webgpu/webgpu_cpp.h>
+
+// Forward Declarations
+class Model;
+
+// MeshProcessor Class
+// Converts the raw primitives of a model (see Model::LoadOptions::m_gpuVertexProcessing) into the
+// final vertex layout, with one compute dispatch per primitive.
+class MeshProcessor {
+  public:
+    // Types
+    struct VertexRange {
+        wgpu::Buffer m_buffer;      // Vertex buffer with Storage usage
+        uint32_t m_firstVertex = 0; // Model vertex stored at the start of the buffer
+        uint32_t m_vertexCount = 0; // Number of model vertices in the buffer
+    };
+
+    // Constructor
+    explicit MeshProcessor(const wgpu::Device& device);
+
+    // Destructor
+    ~MeshProcessor() = default;
+
+    // Rule of 5
+    MeshProcessor(const MeshProcessor&) = delete;
+    MeshProcessor& operator=(const MeshProcessor&) = delete;
+    MeshProcessor(MeshProcessor&&) noexcept = default;
+    MeshProcessor& operator=(MeshProcessor&&) noexcept = default;
+
+    // Public Interface
+    // Writes the vertices of the raw primitives into the vertex buffer, which needs Storage usage.
+    // The raw data is uploaded in several buffers when it exceeds maxBufferSize; primitives
+    // exceeding the device's storage binding size are converted on the CPU.
+    void ProcessVertices(const Model& model, const wgpu::Buffer& vertexBuffer);
+    // Same for vertices split across several buffers (see Renderer::CreateGeometryBuffers)
+    void ProcessVertices(const Model& model, const std::vector<VertexRange>& vertexRanges);
+
+  private:
+    // Types
+    struct MeshParams {
+        alignas(16) glm::mat4 transform;
+        alignas(16) glm::vec4 normalMatrix[3]; // mat3x3 columns, padded to vec4
+        uint32_t vertexCount;
+        uint32_t outputOffset; // First float of the primitive in the bound vertex range
+        uint32_t _pad[2];
+        uint32_t attributes[6][4]; // Offset, stride, component type, count | normalized << 8
+    };
+    static_assert(sizeof(MeshParams) == 224, "MeshParams must match mesh_processor.wgsl");
+
+    // Pipeline initialization
+    void initBindGroupLayout();
+    void initComputePipeline();
+
+    // WebGPU objects (initialized by constructor)
+    wgpu::Device m_device;
+    wgpu::BindGroupLayout m_bindGroupLayout;
+    wgpu::ComputePipeline m_pipeline;
+};
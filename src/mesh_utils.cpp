@@ -1,4 +1,6 @@
 // Standard Library Headers
+#include <algorithm>
+#include <deque>
 #include <iostream>
 
 // Project Headers
@@ -120,4 +122,29 @@ void GenerateTangents(const Model::SubMesh& subMesh, std::vector<Model::Vertex>&
     }
 }
 
+float ComputeACMR(const std::vector<uint32_t>& indices, uint32_t firstIndex, uint32_t indexCount,
+                  uint32_t cacheSize) {
+    const uint32_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || cacheSize == 0) {
+        return 0.0f;
+    }
+
+    // Simulate a FIFO post-transform cache and count the vertices that need to be transformed
+    std::deque<uint32_t> cache;
+    uint32_t misses = 0;
+    for (uint32_t i = firstIndex; i < firstIndex + triangleCount * 3; ++i) {
+        if (std::find(cache.begin(), cache.end(), indices[i]) != cache.end()) {
+            continue;
+        }
+
+        ++misses;
+        cache.push_back(indices[i]);
+        if (cache.size() > cacheSize) {
+            cache.pop_front();
+        }
+    }
+
+    return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
+
 } // namespace mesh_utils
\ No newline at end of file
@@ -1,33 +1,11 @@
 // Standard Library Headers
-#include <fstream>
-#include <iostream>
-#include <sstream>
 #include <string>
 #include <vector>
 
 // Project Headers
+#include "asset_archive.h"
 #include "mipmap_generator.h"
 
-//----------------------------------------------------------------------
-// Internal Utility Functions
-
-namespace {
-
-// TODO: Move to helper class for managing resources
-std::string LoadShaderFile(const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::in | std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open shader file: " + filepath + "\n";
-        return "";
-    }
-
-    std::ostringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
-}
-
-} // namespace
-
 //----------------------------------------------------------------------
 // MipmapGenerator Class implementation
 
@@ -41,21 +19,31 @@ MipmapGenerator::MipmapGenerator(const wgpu::Device& device) {
 
 void MipmapGenerator::GenerateMipmaps(const wgpu::Texture& texture, wgpu::Extent3D size,
                                       MipKind kind) {
+    wgpu::CommandEncoder encoder = m_device.CreateCommandEncoder();
+    GenerateMipmaps(encoder, texture, size, kind);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    m_device.GetQueue().Submit(1, &commands);
+}
+
+void MipmapGenerator::GenerateMipmaps(const wgpu::CommandEncoder& encoder,
+                                      const wgpu::Texture& texture, wgpu::Extent3D size,
+                                      MipKind kind) const {
     switch (kind) {
     case MipKind::LinearUNorm2D:
-        generate2DCompute(texture, size, m_pipeline2D, m_bindGroupLayout2D);
+        generate2DCompute(encoder, texture, size, m_pipeline2D, m_bindGroupLayout2D);
         break;
     case MipKind::Normal2D:
-        generate2DCompute(texture, size, m_pipelineNormal2D, m_bindGroupLayout2D);
+        generate2DCompute(encoder, texture, size, m_pipelineNormal2D, m_bindGroupLayout2D);
         break;
     case MipKind::Float16Cube:
-        generateCubeCompute(texture, size);
+    case MipKind::Float16Octahedral:
+        generateCubeCompute(encoder, texture, size);
         break;
     case MipKind::SRGB2D:
-        generate2DRenderSRGB(texture, size);
+        generate2DRenderSRGB(encoder, texture, size);
         break;
     default:
-        generate2DCompute(texture, size, m_pipeline2D, m_bindGroupLayout2D);
+        generate2DCompute(encoder, texture, size, m_pipeline2D, m_bindGroupLayout2D);
         break;
     }
 }
@@ -152,7 +140,7 @@ void MipmapGenerator::initComputePipelines() {
 wgpu::ComputePipeline
 MipmapGenerator::createComputePipeline(const std::string& shaderPath,
                                        const std::vector<wgpu::BindGroupLayout>& layouts) {
-    std::string shaderCode = LoadShaderFile(shaderPath);
+    std::string shaderCode = LoadTextAsset(shaderPath);
 
     wgpu::ShaderSourceWGSL wgsl{{.nextInChain = nullptr, .code = shaderCode.c_str()}};
     wgpu::ShaderModuleDescriptor shaderModuleDescriptor{.nextInChain = &wgsl};
@@ -174,7 +162,7 @@ MipmapGenerator::createComputePipeline(const std::string& shaderPath,
 
 wgpu::RenderPipeline MipmapGenerator::createRenderPipeline(const std::string& shaderPath,
                                                            wgpu::TextureFormat colorFormat) {
-    std::string shaderCode = LoadShaderFile(shaderPath);
+    std::string shaderCode = LoadTextAsset(shaderPath);
 
     wgpu::ShaderSourceWGSL wgsl{{.nextInChain = nullptr, .code = shaderCode.c_str()}};
     wgpu::ShaderModuleDescriptor shaderModuleDescriptor{.nextInChain = &wgsl};
@@ -226,9 +214,10 @@ void MipmapGenerator::initRenderPipeline() {
                                                   m_renderColorFormatSRGB);
 }
 
-void MipmapGenerator::generate2DCompute(const wgpu::Texture& texture, wgpu::Extent3D size,
+void MipmapGenerator::generate2DCompute(const wgpu::CommandEncoder& encoder,
+                                        const wgpu::Texture& texture, wgpu::Extent3D size,
                                         const wgpu::ComputePipeline& pipeline,
-                                        const wgpu::BindGroupLayout& layout) {
+                                        const wgpu::BindGroupLayout& layout) const {
     uint32_t mipLevelCount =
         1 + static_cast<uint32_t>(std::log2(std::max(size.width, size.height)));
 
@@ -247,7 +236,6 @@ void MipmapGenerator::generate2DCompute(const wgpu::Texture& texture, wgpu::Exte
         mipLevelViews[i] = texture.CreateView(&viewDescriptor);
     }
 
-    wgpu::CommandEncoder encoder = m_device.CreateCommandEncoder();
     wgpu::ComputePassEncoder computePass = encoder.BeginComputePass();
     computePass.SetPipeline(pipeline);
 
@@ -276,22 +264,24 @@ void MipmapGenerator::generate2DCompute(const wgpu::Texture& texture, wgpu::Exte
     }
 
     computePass.End();
-    wgpu::CommandBuffer commands = encoder.Finish();
-    m_device.GetQueue().Submit(1, &commands);
 }
 
-void MipmapGenerator::generateCubeCompute(const wgpu::Texture& texture, wgpu::Extent3D size) {
+void MipmapGenerator::generateCubeCompute(const wgpu::CommandEncoder& encoder,
+                                          const wgpu::Texture& texture,
+                                          wgpu::Extent3D size) const {
     const uint32_t mipLevelCount =
         1 + static_cast<uint32_t>(std::log2(std::max(size.width, size.height)));
 
-    // Create views per mip level (2D array views over 6 faces)
+    // Create views per mip level (2D array views over 6 faces, or the single octahedral layer).
+    // The 2x2 box filter never reads across a face, so octahedral seams need no special care.
+    const uint32_t layerCount = size.depthOrArrayLayers;
     wgpu::TextureViewDescriptor viewDescriptor{};
     viewDescriptor.format = wgpu::TextureFormat::RGBA16Float;
     viewDescriptor.dimension = wgpu::TextureViewDimension::e2DArray;
     viewDescriptor.baseMipLevel = 0;
     viewDescriptor.mipLevelCount = 1;
     viewDescriptor.baseArrayLayer = 0;
-    viewDescriptor.arrayLayerCount = 6u;
+    viewDescriptor.arrayLayerCount = layerCount;
 
     std::vector<wgpu::TextureView> mipLevelViews(mipLevelCount);
     for (uint32_t i = 0; i < mipLevelCount; ++i) {
@@ -300,7 +290,6 @@ void MipmapGenerator::generateCubeCompute(const wgpu::Texture& texture, wgpu::Ex
     }
 
     // Command encoding
-    wgpu::CommandEncoder encoder = m_device.CreateCommandEncoder();
     wgpu::ComputePassEncoder computePass = encoder.BeginComputePass();
     computePass.SetPipeline(m_pipelineCube);
 
@@ -313,7 +302,7 @@ void MipmapGenerator::generateCubeCompute(const wgpu::Texture& texture, wgpu::Ex
     bindGroupEntries[1].binding = 1; // Next mip level
 
     // For each face and mip level
-    for (uint32_t face = 0; face < 6u; ++face) {
+    for (uint32_t face = 0; face < layerCount; ++face) {
         // Set per-face uniform (group 1)
         computePass.SetBindGroup(1, m_faceBindGroups[face], 0, nullptr);
 
@@ -336,17 +325,14 @@ void MipmapGenerator::generateCubeCompute(const wgpu::Texture& texture, wgpu::Ex
     }
 
     computePass.End();
-    wgpu::CommandBuffer cb = encoder.Finish();
-    m_device.GetQueue().Submit(1, &cb);
 }
 
-void MipmapGenerator::generate2DRenderSRGB(const wgpu::Texture& texture, wgpu::Extent3D size) {
+void MipmapGenerator::generate2DRenderSRGB(const wgpu::CommandEncoder& encoder,
+                                           const wgpu::Texture& texture,
+                                           wgpu::Extent3D size) const {
     const uint32_t mipLevelCount =
         1 + static_cast<uint32_t>(std::log2(std::max(size.width, size.height)));
 
-    // Create command encoder
-    wgpu::CommandEncoder encoder = m_device.CreateCommandEncoder();
-
     // Iterate over mip levels
     for (uint32_t nextLevel = 1; nextLevel < mipLevelCount; ++nextLevel) {
         // Views for prev (sampled) and next (render target) levels
@@ -391,8 +377,4 @@ void MipmapGenerator::generate2DRenderSRGB(const wgpu::Texture& texture, wgpu::E
         pass.Draw(3, 1, 0, 0); // Fullscreen triangle
         pass.End();
     }
-
-    // Submit
-    wgpu::CommandBuffer cb = encoder.Finish();
-    m_device.GetQueue().Submit(1, &cb);
 }
\ No newline at end of file
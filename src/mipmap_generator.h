@@ -13,10 +13,11 @@ class MipmapGenerator {
   public:
     // Types
     enum class MipKind {
-        LinearUNorm2D, // Generic linear UNORM 2D data (e.g., ORM/AO)
-        Normal2D,      // Normal maps (decode-average-renormalize-reencode)
-        Float16Cube,   // Float cube textures (HDR/environment)
-        SRGB2D         // sRGB color textures (albedo/emissive) via render downsample
+        LinearUNorm2D,     // Generic linear UNORM 2D data (e.g., ORM/AO)
+        Normal2D,          // Normal maps (decode-average-renormalize-reencode)
+        Float16Cube,       // Float cube textures (HDR/environment)
+        Float16Octahedral, // Float octahedral maps (one layer, filtered like a cube face)
+        SRGB2D             // sRGB color textures (albedo/emissive) via render downsample
     };
 
     // Constructor
@@ -33,6 +34,10 @@ class MipmapGenerator {
 
     // Public Interface
     void GenerateMipmaps(const wgpu::Texture& texture, wgpu::Extent3D size, MipKind kind);
+    // Records the passes into the given encoder instead of submitting them. Only reads the
+    // generator's state, so several threads may record with one generator on a thread-safe device.
+    void GenerateMipmaps(const wgpu::CommandEncoder& encoder, const wgpu::Texture& texture,
+                         wgpu::Extent3D size, MipKind kind) const;
 
   private:
     // Pipeline initialization
@@ -47,11 +52,13 @@ class MipmapGenerator {
     wgpu::RenderPipeline createRenderPipeline(const std::string& shaderPath,
                                               wgpu::TextureFormat colorFormat);
 
-    void generate2DCompute(const wgpu::Texture& texture, wgpu::Extent3D size,
-                           const wgpu::ComputePipeline& pipeline,
-                           const wgpu::BindGroupLayout& layout);
-    void generateCubeCompute(const wgpu::Texture& texture, wgpu::Extent3D size);
-    void generate2DRenderSRGB(const wgpu::Texture& texture, wgpu::Extent3D size);
+    void generate2DCompute(const wgpu::CommandEncoder& encoder, const wgpu::Texture& texture,
+                           wgpu::Extent3D size, const wgpu::ComputePipeline& pipeline,
+                           const wgpu::BindGroupLayout& layout) const;
+    void generateCubeCompute(const wgpu::CommandEncoder& encoder, const wgpu::Texture& texture,
+                             wgpu::Extent3D size) const;
+    void generate2DRenderSRGB(const wgpu::CommandEncoder& encoder, const wgpu::Texture& texture,
+                              wgpu::Extent3D size) const;
 
     // WebGPU objects (initialized by constructor)
     wgpu::Device m_device;
@@ -1,6 +1,13 @@
 // Standard Library Headers
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <optional>
+#include <unordered_map>
 
 // Third-Party Library Headers
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -14,6 +21,7 @@
 #include <tiny_gltf.h>
 
 // Project Headers
+#include "batched_file_reader.h"
 #include "mesh_utils.h"
 #include "model.h"
 
@@ -24,232 +32,578 @@ namespace {
 
 // Constants
 constexpr float PI = 3.14159265358979323846f;
+constexpr size_t kStreamChunkSize = 1 << 20; // Read size when streaming GLB files from disk
+constexpr uint32_t kGlbHeaderSize = 12;
+constexpr uint32_t kGlbChunkHeaderSize = 8;
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull; // 64-bit FNV-1a
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+// Tints applied to the base color of replicated material variants
+const glm::vec4 kVariantTints[] = {
+    {1.0f, 0.55f, 0.55f, 1.0f}, {0.55f, 1.0f, 0.55f, 1.0f}, {0.55f, 0.55f, 1.0f, 1.0f},
+    {1.0f, 1.0f, 0.5f, 1.0f},   {0.5f, 1.0f, 1.0f, 1.0f},   {1.0f, 0.5f, 1.0f, 1.0f},
+};
+
+// Primitive of a mesh node together with the node's world transform
+struct PrimitiveInstance {
+    const tinygltf::Primitive *m_primitive = nullptr;
+    glm::mat4 m_transform{1.0f};
+};
+
+void TransformBounds(const glm::mat4& transform, glm::vec3& minBounds, glm::vec3& maxBounds) {
+    const glm::vec3 srcMin = minBounds;
+    const glm::vec3 srcMax = maxBounds;
+
+    minBounds = glm::vec3(std::numeric_limits<float>::max());
+    maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
+
+    // Transform all eight corners of the box and take their extent
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 p((corner & 1) ? srcMax.x : srcMin.x, (corner & 2) ? srcMax.y : srcMin.y,
+                    (corner & 4) ? srcMax.z : srcMin.z);
+        p = glm::vec3(transform * glm::vec4(p, 1.0f));
+        minBounds = glm::min(minBounds, p);
+        maxBounds = glm::max(maxBounds, p);
+    }
+}
+
+glm::vec4 GetVariantTint(uint32_t variant) {
+    if (variant == 0) {
+        return glm::vec4(1.0f);
+    }
 
-void ProcessMesh(const tinygltf::Model& model, const tinygltf::Mesh& mesh,
-                 std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices,
-                 std::vector<Model::SubMesh>& subMeshes, const glm::mat4& transform) {
-    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
-    glm::mat3 tangentMatrix = glm::mat3(transform);
+    constexpr size_t kTintCount = sizeof(kVariantTints) / sizeof(kVariantTints[0]);
+    return kVariantTints[(variant - 1) % kTintCount];
+}
 
-    for (const auto& primitive : mesh.primitives) {
-        if (primitive.material < 0) {
-            // TODO: Handle this in another way? Assign 'default' material?
-            continue;
+Model::Material MakeMaterialVariant(const Model::Material& material, uint32_t variant) {
+    Model::Material result = material;
+    if (variant == 0) {
+        return result;
+    }
+
+    result.m_baseColorFactor *= GetVariantTint(variant);
+    result.m_roughnessFactor = glm::clamp(material.m_roughnessFactor * (0.4f + 0.3f * (variant % 3)),
+                                          0.05f, 1.0f);
+    return result;
+}
+
+// Accessor data of a vertex attribute
+struct AttributeSource {
+    const uint8_t *m_data = nullptr; // First element (nullptr if the attribute is absent)
+    size_t m_stride = 0;
+    int m_componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
+    int m_components = 0;
+    bool m_normalized = false;
+};
+
+// Vertex attributes in the order of the Model::Vertex members
+constexpr const char *kAttributeNames[Model::RawPrimitive::kAttributeCount] = {
+    "POSITION", "NORMAL", "TANGENT", "TEXCOORD_0", "TEXCOORD_1", "COLOR_0"};
+
+using AttributeSources = AttributeSource[Model::RawPrimitive::kAttributeCount];
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+AttributeSource GetAttributeSource(const tinygltf::Model& model,
+                                   const tinygltf::Primitive& primitive, const char *name) {
+    AttributeSource source;
+    const auto iter = primitive.attributes.find(name);
+    if (iter == primitive.attributes.end()) {
+        return source;
+    }
+
+    const auto& accessor = model.accessors[iter->second];
+    const auto& bufferView = model.bufferViews[accessor.bufferView];
+    const auto& buffer = model.buffers[bufferView.buffer];
+    source.m_data = buffer.data.data() + bufferView.byteOffset + accessor.byteOffset;
+    source.m_stride = accessor.ByteStride(bufferView);
+    source.m_componentType = accessor.componentType;
+    source.m_components = tinygltf::GetNumComponentsInType(accessor.type);
+    source.m_normalized = accessor.normalized;
+    return source;
+}
+
+// Maps normalized integer values to [0, 1] or [-1, 1]. Must match normalizeComponent() in
+// mesh_processor.wgsl.
+float NormalizeComponent(float value, int componentType, bool normalized) {
+    if (!normalized) {
+        return value;
+    }
+
+    switch (componentType) {
+    case TINYGLTF_COMPONENT_TYPE_BYTE:
+        return std::max(value / 127.0f, -1.0f);
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+        return value / 255.0f;
+    case TINYGLTF_COMPONENT_TYPE_SHORT:
+        return std::max(value / 32767.0f, -1.0f);
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+        return value / 65535.0f;
+    default:
+        return value;
+    }
+}
+
+template <typename T> float LoadComponent(const uint8_t *data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return static_cast<float>(value);
+}
+
+float ReadComponent(const uint8_t *data, int componentType, bool normalized) {
+    float value = 0.0f;
+    switch (componentType) {
+    case TINYGLTF_COMPONENT_TYPE_BYTE:
+        value = LoadComponent<int8_t>(data);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+        value = LoadComponent<uint8_t>(data);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_SHORT:
+        value = LoadComponent<int16_t>(data);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+        value = LoadComponent<uint16_t>(data);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+        value = LoadComponent<uint32_t>(data);
+        break;
+    default:
+        value = LoadComponent<float>(data);
+        break;
+    }
+    return NormalizeComponent(value, componentType, normalized);
+}
+
+// Reads element 'index' of an attribute; missing components are taken from 'fallback'
+glm::vec4 ReadAttribute(const AttributeSource& source, size_t index, const glm::vec4& fallback) {
+    glm::vec4 result = fallback;
+    const int componentSize =
+        tinygltf::GetComponentSizeInBytes(static_cast<uint32_t>(source.m_componentType));
+    const uint8_t *element = source.m_data + index * source.m_stride;
+    for (int c = 0; c < std::min(source.m_components, 4); ++c) {
+        result[c] = ReadComponent(element + c * componentSize, source.m_componentType,
+                                  source.m_normalized);
+    }
+    return result;
+}
+
+// Converts the attributes to the Vertex layout and bakes the node transform. Must match
+// processVertices() in mesh_processor.wgsl.
+void ConvertVertices(const AttributeSources& attributes, size_t count,
+                     const glm::mat4& transform, Model::Vertex *vertices) {
+    const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+    const glm::mat3 tangentMatrix = glm::mat3(transform);
+    const auto& [position, normal, tangent, texCoord0, texCoord1, color] = attributes;
+
+    for (size_t i = 0; i < count; ++i) {
+        Model::Vertex& vertex = vertices[i];
+
+        // Position
+        const glm::vec4 pos = ReadAttribute(position, i, glm::vec4(0.0f));
+        vertex.m_position = glm::vec3(transform * glm::vec4(pos.x, pos.y, pos.z, 1.0f));
+
+        // Normal (default to 0, 0, 1 if not provided)
+        const glm::vec4 n = normal.m_data ? ReadAttribute(normal, i, glm::vec4(0.0f))
+                                          : glm::vec4(0.0f, 0.0f, 1.0f, 0.0f);
+        vertex.m_normal = glm::normalize(normalMatrix * glm::vec3(n));
+
+        // Tangent (default to 0, 0, 0, 1 if not provided)
+        if (tangent.m_data) {
+            const glm::vec4 t = ReadAttribute(tangent, i, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+            vertex.m_tangent = glm::vec4(glm::normalize(tangentMatrix * glm::vec3(t)),
+                                         t.w); // Preserve handedness (w)
+        } else {
+            vertex.m_tangent = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
         }
 
-        Model::SubMesh subMesh;
-        subMesh.m_firstIndex = static_cast<uint32_t>(indices.size());
-        subMesh.m_materialIndex = primitive.material;
-        subMesh.m_minBounds = glm::vec3(std::numeric_limits<float>::max());
-        subMesh.m_maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
-
-        uint32_t vertexOffset = static_cast<uint32_t>(vertices.size());
-
-        // Access vertex positions
-        const auto& positionAccessor =
-            model.accessors[primitive.attributes.find("POSITION")->second];
-        const auto& positionBufferView = model.bufferViews[positionAccessor.bufferView];
-        const auto& positionBuffer = model.buffers[positionBufferView.buffer];
-        const float *positionData = reinterpret_cast<const float *>(positionBuffer.data.data() +
-                                                                    positionBufferView.byteOffset +
-                                                                    positionAccessor.byteOffset);
-        const size_t positionStride =
-            positionAccessor.ByteStride(positionBufferView) / sizeof(float);
-
-        // Optional: Access vertex normals
-        const auto normalIter = primitive.attributes.find("NORMAL");
-        const float *normalData = nullptr;
-        size_t normalStride = 0;
-        if (normalIter != primitive.attributes.end()) {
-            const auto& normalAccessor = model.accessors[normalIter->second];
-            const auto& normalBufferView = model.bufferViews[normalAccessor.bufferView];
-            const auto& normalBuffer = model.buffers[normalBufferView.buffer];
-            normalData = reinterpret_cast<const float *>(
-                normalBuffer.data.data() + normalBufferView.byteOffset + normalAccessor.byteOffset);
-            normalStride = normalAccessor.ByteStride(normalBufferView) / sizeof(float);
-        }
-
-        // Optional: Access tangents
-        const auto tangentIter = primitive.attributes.find("TANGENT");
-        const float *tangentData = nullptr;
-        size_t tangentStride = 0;
-        if (tangentIter != primitive.attributes.end()) {
-            const auto& tangentAccessor = model.accessors[tangentIter->second];
-            const auto& tangentBufferView = model.bufferViews[tangentAccessor.bufferView];
-            const auto& tangentBuffer = model.buffers[tangentBufferView.buffer];
-            tangentData = reinterpret_cast<const float *>(tangentBuffer.data.data() +
-                                                          tangentBufferView.byteOffset +
-                                                          tangentAccessor.byteOffset);
-            tangentStride = tangentAccessor.ByteStride(tangentBufferView) / sizeof(float);
-        }
-
-        // Optional: Access texture coordinates
-        const auto texCoord0Iter = primitive.attributes.find("TEXCOORD_0");
-        const float *texCoord0Data = nullptr;
-        size_t texCoord0Stride = 0;
-        if (texCoord0Iter != primitive.attributes.end()) {
-            const auto& texCoordAccessor = model.accessors[texCoord0Iter->second];
-            const auto& texCoordBufferView = model.bufferViews[texCoordAccessor.bufferView];
-            const auto& texCoordBuffer = model.buffers[texCoordBufferView.buffer];
-            texCoord0Data = reinterpret_cast<const float *>(texCoordBuffer.data.data() +
-                                                            texCoordBufferView.byteOffset +
-                                                            texCoordAccessor.byteOffset);
-            texCoord0Stride = texCoordAccessor.ByteStride(texCoordBufferView) / sizeof(float);
-        }
-
-        const auto texCoord1Iter = primitive.attributes.find("TEXCOORD_1");
-        const float *texCoord1Data = nullptr;
-        size_t texCoord1Stride = 0;
-        if (texCoord1Iter != primitive.attributes.end()) {
-            const auto& texCoordAccessor = model.accessors[texCoord1Iter->second];
-            const auto& texCoordBufferView = model.bufferViews[texCoordAccessor.bufferView];
-            const auto& texCoordBuffer = model.buffers[texCoordBufferView.buffer];
-            texCoord1Data = reinterpret_cast<const float *>(texCoordBuffer.data.data() +
-                                                            texCoordBufferView.byteOffset +
-                                                            texCoordAccessor.byteOffset);
-            texCoord1Stride = texCoordAccessor.ByteStride(texCoordBufferView) / sizeof(float);
-        }
-
-        // Optional: Access vertex colors
-        const auto colorIter = primitive.attributes.find("COLOR_0");
-        const float *colorData = nullptr;
-        size_t colorStride = 0;
-        if (colorIter != primitive.attributes.end()) {
-            const auto& colorAccessor = model.accessors[colorIter->second];
-            const auto& colorBufferView = model.bufferViews[colorAccessor.bufferView];
-            const auto& colorBuffer = model.buffers[colorBufferView.buffer];
-            colorData = reinterpret_cast<const float *>(
-                colorBuffer.data.data() + colorBufferView.byteOffset + colorAccessor.byteOffset);
-            colorStride = colorAccessor.ByteStride(colorBufferView) / sizeof(float);
-        }
-
-        // Copy vertex data into Vertex struct
-        for (size_t i = 0; i < positionAccessor.count; ++i) {
-            Model::Vertex vertex;
-
-            // Position
-            glm::vec4 pos = glm::vec4(positionData[i * positionStride + 0],
-                                      positionData[i * positionStride + 1],
-                                      positionData[i * positionStride + 2], 1.0f);
-            vertex.m_position = glm::vec3(transform * pos);
-
-            // Update bounds
-            subMesh.m_minBounds = glm::min(subMesh.m_minBounds, vertex.m_position);
-            subMesh.m_maxBounds = glm::max(subMesh.m_maxBounds, vertex.m_position);
-
-            // Normal (default to 0, 0, 1 if not provided)
-            if (normalData) {
-                vertex.m_normal =
-                    glm::normalize(normalMatrix * glm::vec3(normalData[i * normalStride + 0],
-                                                            normalData[i * normalStride + 1],
-                                                            normalData[i * normalStride + 2]));
-            } else {
-                vertex.m_normal = glm::normalize(normalMatrix * glm::vec3(0.0f, 0.0f, 1.0f));
-            }
+        // Texture coordinates (default to 0, 0 if not provided)
+        const glm::vec4 uv0 = ReadAttribute(texCoord0, i, glm::vec4(0.0f));
+        const glm::vec4 uv1 = ReadAttribute(texCoord1, i, glm::vec4(0.0f));
+        vertex.m_texCoord0 = glm::vec2(uv0.x, uv0.y);
+        vertex.m_texCoord1 = glm::vec2(uv1.x, uv1.y);
 
-            // Tangent (default to 0, 0, 0, 1 if not provided)
-            if (tangentData) {
-                glm::vec3 transformedTangent =
-                    tangentMatrix * glm::vec3(tangentData[i * tangentStride + 0],
-                                              tangentData[i * tangentStride + 1],
-                                              tangentData[i * tangentStride + 2]);
-
-                vertex.m_tangent =
-                    glm::vec4(glm::normalize(transformedTangent),
-                              tangentData[i * tangentStride + 3]); // Preserve handedness (w)
-            } else {
-                vertex.m_tangent = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-            }
+        // Color (default to white if not provided, alpha 1 for RGB colors)
+        vertex.m_color = ReadAttribute(color, i, glm::vec4(1.0f));
+    }
+}
 
-            // Texture coordinates (default to 0, 0 if not provided)
-            if (texCoord0Data) {
-                vertex.m_texCoord0 = glm::vec2(texCoord0Data[i * texCoord0Stride + 0],
-                                               texCoord0Data[i * texCoord0Stride + 1]);
-            } else {
-                vertex.m_texCoord0 = glm::vec2(0.0f, 0.0f);
-            }
+// Primitives stored so far, for load-time geometry deduplication
+struct GeometryCache {
+    struct Entry {
+        const tinygltf::Primitive *m_primitive = nullptr;
+        size_t m_subMeshIndex = 0;          // Submesh drawing the stored copy
+        glm::mat4 m_transform{1.0f};        // Transform baked into the stored copy
+        glm::mat4 m_inverseTransform{1.0f};
+    };
+
+    std::unordered_multimap<uint64_t, Entry> m_entries; // By primitive content hash
+    std::unordered_map<int, std::optional<uint64_t>> m_accessorHashes;
+};
+
+uint64_t HashBytes(const void *data, size_t size, uint64_t hash) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * kFnvPrime;
+    }
+    return hash;
+}
 
-            if (texCoord1Data) {
-                vertex.m_texCoord1 = glm::vec2(texCoord1Data[i * texCoord1Stride + 0],
-                                               texCoord1Data[i * texCoord1Stride + 1]);
-            } else {
-                vertex.m_texCoord1 = glm::vec2(0.0f, 0.0f);
-            }
+// Element layout of an accessor. False for sparse accessors and accessors without data, which
+// are never deduplicated.
+bool GetAccessorElements(const tinygltf::Model& model, int accessorIndex, const uint8_t *&data,
+                         size_t& stride, size_t& elementSize) {
+    const tinygltf::Accessor& accessor = model.accessors[accessorIndex];
+    if (accessor.sparse.isSparse || accessor.bufferView < 0) {
+        return false;
+    }
+
+    const auto& bufferView = model.bufferViews[accessor.bufferView];
+    const auto& buffer = model.buffers[bufferView.buffer];
+    const int byteStride = accessor.ByteStride(bufferView);
+    if (byteStride <= 0) {
+        return false;
+    }
+
+    data = buffer.data.data() + bufferView.byteOffset + accessor.byteOffset;
+    stride = static_cast<size_t>(byteStride);
+    elementSize =
+        static_cast<size_t>(tinygltf::GetComponentSizeInBytes(accessor.componentType) *
+                            tinygltf::GetNumComponentsInType(accessor.type));
+    return true;
+}
 
-            // Color (default to white if not provided)
-            if (colorData) {
-                vertex.m_color =
-                    glm::vec4(colorData[i * colorStride + 0], colorData[i * colorStride + 1],
-                              colorData[i * colorStride + 2], colorData[i * colorStride + 3]);
-            } else {
-                vertex.m_color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+// Hash of an accessor's definition and element bytes (cached, accessors are often shared)
+std::optional<uint64_t> HashAccessor(const tinygltf::Model& model, int accessorIndex,
+                                     GeometryCache& cache) {
+    auto cached = cache.m_accessorHashes.find(accessorIndex);
+    if (cached != cache.m_accessorHashes.end()) {
+        return cached->second;
+    }
+
+    std::optional<uint64_t> result;
+    const uint8_t *data = nullptr;
+    size_t stride = 0;
+    size_t elementSize = 0;
+    if (GetAccessorElements(model, accessorIndex, data, stride, elementSize)) {
+        const tinygltf::Accessor& accessor = model.accessors[accessorIndex];
+        const int64_t definition[] = {accessor.componentType, accessor.type,
+                                      static_cast<int64_t>(accessor.count), accessor.normalized};
+        uint64_t hash = HashBytes(definition, sizeof(definition), kFnvOffsetBasis);
+        if (stride == elementSize) {
+            hash = HashBytes(data, elementSize * accessor.count, hash);
+        } else {
+            for (size_t i = 0; i < accessor.count; ++i) {
+                hash = HashBytes(data + i * stride, elementSize, hash);
             }
+        }
+        result = hash;
+    }
+
+    cache.m_accessorHashes.emplace(accessorIndex, result);
+    return result;
+}
+
+bool AccessorsEqual(const tinygltf::Model& model, int a, int b) {
+    if (a == b) {
+        return true;
+    }
+    if (a < 0 || b < 0) {
+        return false;
+    }
+
+    const tinygltf::Accessor& accessorA = model.accessors[a];
+    const tinygltf::Accessor& accessorB = model.accessors[b];
+    if (accessorA.componentType != accessorB.componentType || accessorA.type != accessorB.type ||
+        accessorA.count != accessorB.count || accessorA.normalized != accessorB.normalized) {
+        return false;
+    }
+
+    const uint8_t *dataA = nullptr;
+    const uint8_t *dataB = nullptr;
+    size_t strideA = 0, strideB = 0, elementSize = 0;
+    if (!GetAccessorElements(model, a, dataA, strideA, elementSize) ||
+        !GetAccessorElements(model, b, dataB, strideB, elementSize)) {
+        return false;
+    }
 
-            vertices.push_back(vertex);
+    for (size_t i = 0; i < accessorA.count; ++i) {
+        if (std::memcmp(dataA + i * strideA, dataB + i * strideB, elementSize) != 0) {
+            return false;
         }
+    }
+    return true;
+}
 
-        // Access indices (if present)
-        if (primitive.indices >= 0) {
-            const auto& indexAccessor = model.accessors[primitive.indices];
-            const auto& indexBufferView = model.bufferViews[indexAccessor.bufferView];
-            const auto& indexBuffer = model.buffers[indexBufferView.buffer];
-            const void *indexData =
-                indexBuffer.data.data() + indexBufferView.byteOffset + indexAccessor.byteOffset;
+int FindAttributeAccessor(const tinygltf::Primitive& primitive, const char *name) {
+    const auto iter = primitive.attributes.find(name);
+    return iter != primitive.attributes.end() ? iter->second : -1;
+}
 
-            if (indexAccessor.count > std::numeric_limits<uint32_t>::max()) {
-                std::cerr << "Error: Index accessor count exceeds 32-bit limit: "
-                          << indexAccessor.count << std::endl;
-                subMesh.m_indexCount = std::numeric_limits<uint32_t>::max();
-            } else {
-                subMesh.m_indexCount = static_cast<uint32_t>(indexAccessor.count);
+// Hash of the attributes and indices the loader uses (nullopt if they cannot be deduplicated)
+std::optional<uint64_t> HashPrimitive(const tinygltf::Model& model,
+                                      const tinygltf::Primitive& primitive,
+                                      GeometryCache& cache) {
+    uint64_t hash = HashBytes(&primitive.mode, sizeof(primitive.mode), kFnvOffsetBasis);
+    for (const char *name : kAttributeNames) {
+        uint64_t accessorHash = 0;
+        const int accessor = FindAttributeAccessor(primitive, name);
+        if (accessor >= 0) {
+            const std::optional<uint64_t> result = HashAccessor(model, accessor, cache);
+            if (!result) {
+                return std::nullopt;
             }
+            accessorHash = *result;
+        }
+        hash = HashBytes(&accessorHash, sizeof(accessorHash), hash);
+    }
 
-            if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE) {
-                const uint8_t *data = reinterpret_cast<const uint8_t *>(indexData);
-                for (size_t i = 0; i < indexAccessor.count; ++i) {
-                    indices.push_back(vertexOffset + data[i]);
-                }
-            } else if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
-                const uint16_t *data = reinterpret_cast<const uint16_t *>(indexData);
-                for (size_t i = 0; i < indexAccessor.count; ++i) {
-                    indices.push_back(vertexOffset + static_cast<uint32_t>(data[i]));
-                }
-            } else if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) {
-                const uint32_t *data = reinterpret_cast<const uint32_t *>(indexData);
-                for (size_t i = 0; i < indexAccessor.count; ++i) {
-                    indices.push_back(vertexOffset + data[i]);
-                }
-            } else {
-                assert(false && "Invalid index accessor component type");
-            }
+    uint64_t indexHash = 0;
+    if (primitive.indices >= 0) {
+        const std::optional<uint64_t> result = HashAccessor(model, primitive.indices, cache);
+        if (!result) {
+            return std::nullopt;
+        }
+        indexHash = *result;
+    }
+    return HashBytes(&indexHash, sizeof(indexHash), hash);
+}
+
+bool PrimitivesEqual(const tinygltf::Model& model, const tinygltf::Primitive& a,
+                     const tinygltf::Primitive& b) {
+    if (a.mode != b.mode || !AccessorsEqual(model, a.indices, b.indices)) {
+        return false;
+    }
+    for (const char *name : kAttributeNames) {
+        const int accessorA = FindAttributeAccessor(a, name);
+        const int accessorB = FindAttributeAccessor(b, name);
+        if (!AccessorsEqual(model, accessorA, accessorB)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Adds a submesh drawing identical geometry stored earlier with a relative transform. Returns
+// false if no identical geometry has been stored.
+bool ReferenceStoredGeometry(const tinygltf::Model& model, const tinygltf::Primitive& primitive,
+                             uint64_t key, const glm::mat4& transform, const GeometryCache& cache,
+                             std::vector<Model::SubMesh>& subMeshes,
+                             std::vector<glm::mat4>& geometryTransforms) {
+    const auto [begin, end] = cache.m_entries.equal_range(key);
+    for (auto it = begin; it != end; ++it) {
+        const GeometryCache::Entry& entry = it->second;
+        if (!PrimitivesEqual(model, primitive, *entry.m_primitive)) {
+            continue;
+        }
+
+        Model::SubMesh subMesh = subMeshes[entry.m_subMeshIndex];
+        subMesh.m_materialIndex = primitive.material;
+        if (transform != entry.m_transform) {
+            const glm::mat4 relativeTransform = transform * entry.m_inverseTransform;
+            subMesh.m_transformIndex = static_cast<uint32_t>(geometryTransforms.size());
+            geometryTransforms.push_back(relativeTransform);
+            TransformBounds(relativeTransform, subMesh.m_minBounds, subMesh.m_maxBounds);
+        }
+        subMeshes.push_back(subMesh);
+        return true;
+    }
+    return false;
+}
+
+// Copies the attribute byte ranges of a primitive into the raw vertex data, leaving the
+// conversion to the GPU
+void AppendRawPrimitive(const AttributeSources& attributes, size_t count,
+                        const glm::mat4& transform, uint32_t firstVertex,
+                        Model::RawVertexData& rawVertexData) {
+    std::vector<uint8_t>& bytes = rawVertexData.m_bytes;
+
+    Model::RawPrimitive raw;
+    raw.m_transform = transform;
+    raw.m_firstVertex = firstVertex;
+    raw.m_vertexCount = static_cast<uint32_t>(count);
+    raw.m_dataOffset = AlignUp(bytes.size(), Model::kRawBlockAlignment);
+    bytes.resize(raw.m_dataOffset);
+
+    for (size_t a = 0; a < Model::RawPrimitive::kAttributeCount; ++a) {
+        const AttributeSource& source = attributes[a];
+        if (!source.m_data) {
+            continue;
+        }
+
+        // glTF aligns vertex attribute elements to 4 bytes, so the strides stay word aligned
+        const size_t componentSize =
+            tinygltf::GetComponentSizeInBytes(static_cast<uint32_t>(source.m_componentType));
+        const size_t elementSize = source.m_components * componentSize;
+        const size_t rangeSize = source.m_stride * (count - 1) + elementSize;
+        const uint64_t offset = AlignUp(bytes.size(), 4);
+        bytes.resize(offset);
+        bytes.insert(bytes.end(), source.m_data, source.m_data + rangeSize);
+
+        raw.m_attributes[a] = {.m_offset = static_cast<uint32_t>(offset - raw.m_dataOffset),
+                               .m_stride = static_cast<uint32_t>(source.m_stride),
+                               .m_componentType = static_cast<uint32_t>(source.m_componentType),
+                               .m_components = static_cast<uint32_t>(source.m_components),
+                               .m_normalized = source.m_normalized};
+    }
+
+    bytes.resize(AlignUp(bytes.size(), 4));
+    raw.m_dataSize = bytes.size() - raw.m_dataOffset;
+    rawVertexData.m_primitives.push_back(raw);
+}
+
+void ProcessPrimitive(const tinygltf::Model& model, const tinygltf::Primitive& primitive,
+                      std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices,
+                      std::vector<Model::SubMesh>& subMeshes, const glm::mat4& transform,
+                      Model::LoadStats& stats, Model::RawVertexData *rawVertexData,
+                      std::vector<glm::mat4>& geometryTransforms, GeometryCache *geometryCache) {
+    if (primitive.material < 0) {
+        // TODO: Handle this in another way? Assign 'default' material?
+        return;
+    }
+
+    // Draw byte-identical geometry stored for an earlier primitive instead of storing a copy.
+    // The stored copy has its own transform baked in, so duplicates use the relative transform.
+    std::optional<uint64_t> geometryKey;
+    if (geometryCache) {
+        geometryKey = HashPrimitive(model, primitive, *geometryCache);
+        if (geometryKey && ReferenceStoredGeometry(model, primitive, *geometryKey, transform,
+                                                   *geometryCache, subMeshes,
+                                                   geometryTransforms)) {
+            ++stats.m_primitiveCount;
+            ++stats.m_duplicateGeometryCount;
+            return;
+        }
+    }
+
+    Model::SubMesh subMesh;
+    subMesh.m_firstIndex = static_cast<uint32_t>(indices.size());
+    subMesh.m_materialIndex = primitive.material;
+    subMesh.m_minBounds = glm::vec3(std::numeric_limits<float>::max());
+    subMesh.m_maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
+
+    uint32_t vertexOffset = static_cast<uint32_t>(vertices.size());
+
+    const auto& positionAccessor =
+        model.accessors[primitive.attributes.find("POSITION")->second];
+    AttributeSources attributes;
+    for (size_t a = 0; a < Model::RawPrimitive::kAttributeCount; ++a) {
+        attributes[a] = GetAttributeSource(model, primitive, kAttributeNames[a]);
+    }
+    const AttributeSource& positions = attributes[0];
+    const bool hasNormals = attributes[1].m_data != nullptr;
+    const bool hasTangents = attributes[2].m_data != nullptr;
+
+    // Primitives that need MikkTSpace tangents are processed on the CPU, the others can leave
+    // conversion and transforms to the GPU. Their bounds come from the accessor min/max, which
+    // glTF requires for POSITION.
+    const bool deferToGpu = rawVertexData && hasTangents && positionAccessor.count > 0 &&
+                            positionAccessor.minValues.size() >= 3 &&
+                            positionAccessor.maxValues.size() >= 3;
+
+    vertices.resize(vertexOffset + positionAccessor.count);
+    if (deferToGpu) {
+        AppendRawPrimitive(attributes, positionAccessor.count, transform, vertexOffset,
+                           *rawVertexData);
+
+        for (int c = 0; c < 3; ++c) {
+            subMesh.m_minBounds[c] =
+                NormalizeComponent(static_cast<float>(positionAccessor.minValues[c]),
+                                   positions.m_componentType, positions.m_normalized);
+            subMesh.m_maxBounds[c] =
+                NormalizeComponent(static_cast<float>(positionAccessor.maxValues[c]),
+                                   positions.m_componentType, positions.m_normalized);
+        }
+        TransformBounds(transform, subMesh.m_minBounds, subMesh.m_maxBounds);
+    } else {
+        ConvertVertices(attributes, positionAccessor.count, transform,
+                        vertices.data() + vertexOffset);
+
+        for (size_t i = vertexOffset; i < vertices.size(); ++i) {
+            subMesh.m_minBounds = glm::min(subMesh.m_minBounds, vertices[i].m_position);
+            subMesh.m_maxBounds = glm::max(subMesh.m_maxBounds, vertices[i].m_position);
+        }
+    }
+
+    // Access indices (if present)
+    if (primitive.indices >= 0) {
+        const auto& indexAccessor = model.accessors[primitive.indices];
+        const auto& indexBufferView = model.bufferViews[indexAccessor.bufferView];
+        const auto& indexBuffer = model.buffers[indexBufferView.buffer];
+        const void *indexData =
+            indexBuffer.data.data() + indexBufferView.byteOffset + indexAccessor.byteOffset;
+
+        if (indexAccessor.count > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "Error: Index accessor count exceeds 32-bit limit: "
+                      << indexAccessor.count << std::endl;
+            subMesh.m_indexCount = std::numeric_limits<uint32_t>::max();
         } else {
-            // Non-indexed mesh: generate sequential indices
-            if (positionAccessor.count > std::numeric_limits<uint32_t>::max()) {
-                std::cerr << "Error: Position accessor count exceeds 32-bit limit: "
-                          << positionAccessor.count << std::endl;
-                subMesh.m_indexCount = std::numeric_limits<uint32_t>::max();
-            } else {
-                subMesh.m_indexCount = static_cast<uint32_t>(positionAccessor.count);
-            }
+            subMesh.m_indexCount = static_cast<uint32_t>(indexAccessor.count);
+        }
 
-            for (uint32_t i = 0; i < positionAccessor.count; ++i) {
-                indices.push_back(vertexOffset + i);
+        if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE) {
+            const uint8_t *data = reinterpret_cast<const uint8_t *>(indexData);
+            for (size_t i = 0; i < indexAccessor.count; ++i) {
+                indices.push_back(vertexOffset + data[i]);
+            }
+        } else if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
+            const uint16_t *data = reinterpret_cast<const uint16_t *>(indexData);
+            for (size_t i = 0; i < indexAccessor.count; ++i) {
+                indices.push_back(vertexOffset + static_cast<uint32_t>(data[i]));
             }
+        } else if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) {
+            const uint32_t *data = reinterpret_cast<const uint32_t *>(indexData);
+            for (size_t i = 0; i < indexAccessor.count; ++i) {
+                indices.push_back(vertexOffset + data[i]);
+            }
+        } else {
+            assert(false && "Invalid index accessor component type");
+        }
+    } else {
+        // Non-indexed mesh: generate sequential indices
+        if (positionAccessor.count > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "Error: Position accessor count exceeds 32-bit limit: "
+                      << positionAccessor.count << std::endl;
+            subMesh.m_indexCount = std::numeric_limits<uint32_t>::max();
+        } else {
+            subMesh.m_indexCount = static_cast<uint32_t>(positionAccessor.count);
         }
 
-        if (!tangentData) {
-            // Generate tangents if not provided
-            std::cout << "Generating tangents for submesh " << subMeshes.size() << std::endl;
-            mesh_utils::GenerateTangents(subMesh, vertices, indices);
+        for (uint32_t i = 0; i < positionAccessor.count; ++i) {
+            indices.push_back(vertexOffset + i);
         }
+    }
 
-        subMeshes.push_back(subMesh);
+    ++stats.m_primitiveCount;
+    stats.m_missingNormalCount += !hasNormals;
+
+    if (!hasTangents) {
+        // Generate tangents if not provided
+        ++stats.m_missingTangentCount;
+        std::cout << "Generating tangents for submesh " << subMeshes.size() << std::endl;
+        mesh_utils::GenerateTangents(subMesh, vertices, indices);
     }
+
+    // Only geometry with an invertible transform can be referenced with a relative transform
+    const glm::mat3 linear(transform);
+    if (geometryKey && std::abs(glm::determinant(linear)) > std::numeric_limits<float>::min()) {
+        geometryCache->m_entries.emplace(
+            *geometryKey, GeometryCache::Entry{.m_primitive = &primitive,
+                                               .m_subMeshIndex = subMeshes.size(),
+                                               .m_transform = transform,
+                                               .m_inverseTransform = glm::inverse(transform)});
+    }
+
+    subMeshes.push_back(subMesh);
 }
 
-void ProcessNode(const tinygltf::Model& model, int nodeIndex, const glm::mat4& parentTransform,
-                 std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices,
-                 std::vector<Model::SubMesh>& subMeshes) {
+// Flattens the node hierarchy into the primitives to process and their world transforms
+void CollectPrimitives(const tinygltf::Model& model, int nodeIndex,
+                       const glm::mat4& parentTransform,
+                       std::vector<PrimitiveInstance>& primitives) {
     const tinygltf::Node& node = model.nodes[nodeIndex];
 
     // Compute the local transformation matrix
@@ -280,18 +634,32 @@ void ProcessNode(const tinygltf::Model& model, int nodeIndex, const glm::mat4& p
     // Combine with parent transform
     glm::mat4 globalTransform = parentTransform * localTransform;
 
-    // If this node has a mesh, process it
+    // If this node has a mesh, add its primitives
     if (node.mesh >= 0) {
-        const tinygltf::Mesh& mesh = model.meshes[node.mesh];
-        ProcessMesh(model, mesh, vertices, indices, subMeshes, globalTransform);
+        for (const auto& primitive : model.meshes[node.mesh].primitives) {
+            primitives.push_back({&primitive, globalTransform});
+        }
     }
 
     // Recursively process children nodes
     for (int childIndex : node.children) {
-        ProcessNode(model, childIndex, globalTransform, vertices, indices, subMeshes);
+        CollectPrimitives(model, childIndex, globalTransform, primitives);
     }
 }
 
+std::vector<PrimitiveInstance> CollectScenePrimitives(const tinygltf::Model& model) {
+    std::vector<PrimitiveInstance> primitives;
+    if (model.scenes.size() > 0) {
+        const tinygltf::Scene& scene =
+            model.scenes[model.defaultScene > -1 ? model.defaultScene : 0];
+
+        for (int nodeIndex : scene.nodes) {
+            CollectPrimitives(model, nodeIndex, glm::mat4(1.0f), primitives);
+        }
+    }
+    return primitives;
+}
+
 void ProcessMaterial(const tinygltf::Material& material, std::vector<Model::Material>& materials) {
     Model::Material mat;
 
@@ -349,9 +717,7 @@ void ProcessMaterial(const tinygltf::Material& material, std::vector<Model::Mate
     std::cout << "--------------------------------" << std::endl;
 }
 
-void ProcessImage(const tinygltf::Image& image, const std::string& basePath,
-                  std::vector<Model::Texture>& textures) {
-
+Model::Texture ProcessImage(const tinygltf::Image& image, const std::string& basePath) {
     Model::Texture texture;
     texture.m_name = image.name;
     texture.m_width = image.width;
@@ -381,28 +747,295 @@ void ProcessImage(const tinygltf::Image& image, const std::string& basePath,
                   << std::endl;
     }
 
-    textures.push_back(texture);
+    return texture;
 }
 
-void ProcessModel(const tinygltf::Model& model, std::vector<Model::Vertex>& vertices,
-                  std::vector<uint32_t>& indices, std::vector<Model::Material>& materials,
-                  std::vector<Model::Texture>& textures, std::vector<Model::SubMesh>& subMeshes) {
-    if (model.scenes.size() > 0) {
-        const tinygltf::Scene& scene =
-            model.scenes[model.defaultScene > -1 ? model.defaultScene : 0];
+// Keeps an embedded image encoded and only reads its size. The pixels are decoded when the texture
+// is uploaded, straight into GPU staging memory.
+Model::Texture KeepEncodedImage(const tinygltf::Model& model, const tinygltf::Image& image) {
+    Model::Texture texture;
+    texture.m_name = image.name;
 
-        for (int nodeIndex : scene.nodes) {
-            ProcessNode(model, nodeIndex, glm::mat4(1.0f), vertices, indices, subMeshes);
+    const tinygltf::BufferView& bufferView = model.bufferViews[image.bufferView];
+    const tinygltf::Buffer& buffer = model.buffers[bufferView.buffer];
+    const unsigned char *bytes = buffer.data.data() + bufferView.byteOffset;
+    int width = 0;
+    int height = 0;
+    int components = 0;
+    if (bufferView.byteLength > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+        !stbi_info_from_memory(bytes, static_cast<int>(bufferView.byteLength), &width, &height,
+                               &components)) {
+        std::cerr << "Failed to read image header: " << image.name << std::endl;
+        return texture;
+    }
+
+    texture.m_width = width;
+    texture.m_height = height;
+    texture.m_components = 4; // Decoded as RGBA, like tinygltf does
+    texture.m_encodedData.assign(bytes, bytes + bufferView.byteLength);
+    return texture;
+}
+
+// Image loader that leaves images stored in buffer views to the caller
+bool LoadExternalImageData(tinygltf::Image *image, const int imageIndex, std::string *err,
+                           std::string *warn, int width, int height, const unsigned char *bytes,
+                           int size, void *) {
+    return image->bufferView >= 0 || tinygltf::LoadImageData(image, imageIndex, err, warn, width,
+                                                             height, bytes, size, nullptr);
+}
+
+// External buffers and images of a .gltf document, read in one batch before tinygltf parses the
+// document. tinygltf's file callbacks are served from here; anything missing falls back to disk.
+struct PrefetchedFiles {
+    struct DecodedImage {
+        std::vector<uint8_t> m_pixels; // RGBA8, empty if the file could not be decoded
+        int m_width = 0;
+        int m_height = 0;
+    };
+
+    std::vector<batched_file_reader::File> m_files;
+    std::unordered_map<std::string, size_t> m_indices; // Path as tinygltf requests it
+    std::vector<size_t> m_imageFiles;                  // File of each glTF image
+    std::vector<bool> m_isImage;
+    std::vector<DecodedImage> m_decodedImages; // Indexed like m_files
+    bool m_deferImageDecoding = false;
+};
+
+// Reads the buffer and image files referenced by the document. Images are decoded as soon as
+// their reads complete, while the remaining reads are still in flight.
+void PrefetchExternalFiles(const std::string& json, const std::string& baseDir,
+                           PrefetchedFiles& prefetched) {
+    const nlohmann::json document = nlohmann::json::parse(json, nullptr, false);
+    if (document.is_discarded() || !document.is_object()) {
+        return; // tinygltf reports the error
+    }
+
+    auto addFile = [&](const nlohmann::json& entry, bool isImage) {
+        if (!entry.is_object() || !entry.contains("uri") || !entry["uri"].is_string()) {
+            return std::numeric_limits<size_t>::max();
+        }
+        const std::string& uri = entry["uri"].get_ref<const std::string&>();
+        std::string decodedUri;
+        if (tinygltf::IsDataURI(uri) || !tinygltf::URIDecode(uri, &decodedUri, nullptr)) {
+            return std::numeric_limits<size_t>::max();
+        }
+
+        // Same path as tinygltf's FindFile builds
+        std::string path = baseDir.empty() || baseDir.back() == '/' ? baseDir + decodedUri
+                                                                    : baseDir + "/" + decodedUri;
+        path = tinygltf::ExpandFilePath(path, nullptr);
+        auto [it, inserted] = prefetched.m_indices.try_emplace(path, prefetched.m_files.size());
+        if (inserted) {
+            prefetched.m_files.push_back({path, {}, false});
+            prefetched.m_isImage.push_back(isImage);
+        }
+        return it->second;
+    };
+
+    if (document.contains("buffers") && document["buffers"].is_array()) {
+        for (const nlohmann::json& buffer : document["buffers"]) {
+            addFile(buffer, false);
         }
     }
+    if (document.contains("images") && document["images"].is_array()) {
+        for (const nlohmann::json& image : document["images"]) {
+            prefetched.m_imageFiles.push_back(addFile(image, true));
+        }
+    }
+    if (prefetched.m_files.empty()) {
+        return;
+    }
+
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    prefetched.m_decodedImages.resize(prefetched.m_files.size());
+    batched_file_reader::Read(prefetched.m_files, [&](batched_file_reader::File& file) {
+        const size_t index = &file - prefetched.m_files.data();
+        if (!prefetched.m_isImage[index] || file.m_data.empty() ||
+            file.m_data.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+            return;
+        }
+
+        PrefetchedFiles::DecodedImage& decoded = prefetched.m_decodedImages[index];
+        int components = 0;
+        stbi_uc *pixels = stbi_load_from_memory(file.m_data.data(),
+                                                static_cast<int>(file.m_data.size()),
+                                                &decoded.m_width, &decoded.m_height, &components,
+                                                4 /* force 4 channels */);
+        if (pixels) {
+            decoded.m_pixels.assign(pixels, pixels + static_cast<size_t>(decoded.m_width) *
+                                                         decoded.m_height * 4);
+            stbi_image_free(pixels);
+        }
+    });
+
+    uint64_t totalBytes = 0;
+    for (const batched_file_reader::File& file : prefetched.m_files) {
+        totalBytes += file.m_data.size();
+    }
+    const double durationMs = std::chrono::duration<double, std::milli>(
+                                  std::chrono::high_resolution_clock::now() - t0)
+                                  .count();
+    std::cout << "Read " << prefetched.m_files.size() << " external files ("
+              << totalBytes / (1024 * 1024) << " MB) in " << durationMs << "ms" << std::endl;
+}
+
+bool LoadPrefetchedImageData(tinygltf::Image *image, const int imageIndex, std::string *err,
+                             std::string *warn, int width, int height, const unsigned char *bytes,
+                             int size, void *userData) {
+    auto *prefetched = static_cast<PrefetchedFiles *>(userData);
+    if (image->bufferView >= 0 && prefetched->m_deferImageDecoding) {
+        return true; // Kept encoded, see KeepEncodedImage
+    }
+
+    if (imageIndex >= 0 && static_cast<size_t>(imageIndex) < prefetched->m_imageFiles.size()) {
+        const size_t file = prefetched->m_imageFiles[imageIndex];
+        if (file < prefetched->m_decodedImages.size() &&
+            !prefetched->m_decodedImages[file].m_pixels.empty()) {
+            PrefetchedFiles::DecodedImage& decoded = prefetched->m_decodedImages[file];
+            image->width = decoded.m_width;
+            image->height = decoded.m_height;
+            image->component = 4;
+            image->bits = 8;
+            image->pixel_type = TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+            image->image = std::move(decoded.m_pixels);
+            decoded.m_pixels.clear();
+            return true;
+        }
+    }
+
+    return tinygltf::LoadImageData(image, imageIndex, err, warn, width, height, bytes, size,
+                                   nullptr);
+}
+
+// Loads a .gltf file whose external buffers and images are read in one batch up front
+bool LoadAsciiWithPrefetch(tinygltf::TinyGLTF& loader, tinygltf::Model& model, std::string& err,
+                           std::string& warn, const std::string& filename,
+                           bool deferImageDecoding) {
+    std::vector<unsigned char> json;
+    if (!tinygltf::ReadWholeFile(&json, &err, filename, nullptr)) {
+        return false;
+    }
+    if (json.empty()) {
+        err = "Empty file.";
+        return false;
+    }
+
+    const std::string baseDir = filename.substr(0, filename.find_last_of("/\\") + 1);
+    PrefetchedFiles prefetched;
+    prefetched.m_deferImageDecoding = deferImageDecoding;
+    PrefetchExternalFiles(std::string(json.begin(), json.end()), baseDir, prefetched);
+
+    auto findFile = [](const std::string& path, void *userData) -> batched_file_reader::File * {
+        auto *prefetched = static_cast<PrefetchedFiles *>(userData);
+        auto it = prefetched->m_indices.find(path);
+        if (it == prefetched->m_indices.end() || !prefetched->m_files[it->second].m_loaded ||
+            prefetched->m_files[it->second].m_data.empty()) {
+            return nullptr;
+        }
+        return &prefetched->m_files[it->second];
+    };
+
+    tinygltf::FsCallbacks callbacks{};
+    callbacks.FileExists = [findFile](const std::string& path, void *userData) {
+        return findFile(path, userData) || tinygltf::FileExists(path, nullptr);
+    };
+    callbacks.ExpandFilePath = tinygltf::ExpandFilePath;
+    callbacks.ReadWholeFile = [findFile](std::vector<unsigned char> *out, std::string *readErr,
+                                         const std::string& path, void *userData) {
+        // Each prefetched file is handed over once without a copy
+        if (batched_file_reader::File *file = findFile(path, userData)) {
+            out->swap(file->m_data);
+            file->m_data.clear();
+            file->m_loaded = false;
+            return true;
+        }
+        return tinygltf::ReadWholeFile(out, readErr, path, nullptr);
+    };
+    callbacks.WriteWholeFile = tinygltf::WriteWholeFile;
+    callbacks.GetFileSizeInBytes = [findFile](size_t *size, std::string *sizeErr,
+                                              const std::string& path, void *userData) {
+        if (batched_file_reader::File *file = findFile(path, userData)) {
+            *size = file->m_data.size();
+            return true;
+        }
+        return tinygltf::GetFileSizeInBytes(size, sizeErr, path, nullptr);
+    };
+    callbacks.user_data = &prefetched;
+    loader.SetFsCallbacks(callbacks);
+    loader.SetImageLoader(LoadPrefetchedImageData, &prefetched);
+
+    return loader.LoadASCIIFromString(&model, &err, &warn,
+                                      reinterpret_cast<const char *>(json.data()),
+                                      static_cast<unsigned int>(json.size()), baseDir);
+}
+
+void ProcessModel(const tinygltf::Model& model, std::vector<Model::Vertex>& vertices,
+                  std::vector<uint32_t>& indices, std::vector<Model::Material>& materials,
+                  std::vector<Model::Texture>& textures, std::vector<Model::SubMesh>& subMeshes,
+                  Model::LoadStats& stats, Model::RawVertexData *rawVertexData,
+                  std::vector<glm::mat4>& geometryTransforms, bool deduplicateGeometry,
+                  bool deferImageDecoding) {
+    GeometryCache geometryCache;
+    for (const PrimitiveInstance& instance : CollectScenePrimitives(model)) {
+        ProcessPrimitive(model, *instance.m_primitive, vertices, indices, subMeshes,
+                         instance.m_transform, stats, rawVertexData, geometryTransforms,
+                         deduplicateGeometry ? &geometryCache : nullptr);
+    }
 
     for (const auto& material : model.materials) {
         ProcessMaterial(material, materials);
     }
 
     for (const auto& image : model.images) {
-        ProcessImage(image, "", textures);
+        textures.push_back(deferImageDecoding && image.bufferView >= 0 && image.image.empty()
+                               ? KeepEncodedImage(model, image)
+                               : ProcessImage(image, ""));
+    }
+}
+
+// Number of bytes of the given buffer that must have arrived before a buffer view is readable
+uint64_t GetRequiredBytes(const tinygltf::Model& model, int bufferViewIndex, int buffer) {
+    if (bufferViewIndex < 0 || bufferViewIndex >= static_cast<int>(model.bufferViews.size())) {
+        return 0;
+    }
+
+    const tinygltf::BufferView& bufferView = model.bufferViews[bufferViewIndex];
+    return bufferView.buffer == buffer ? bufferView.byteOffset + bufferView.byteLength : 0;
+}
+
+uint64_t GetRequiredBytes(const tinygltf::Model& model, const tinygltf::Primitive& primitive,
+                          int buffer) {
+    auto accessorBytes = [&](int accessorIndex) -> uint64_t {
+        if (accessorIndex < 0 || accessorIndex >= static_cast<int>(model.accessors.size())) {
+            return 0;
+        }
+        return GetRequiredBytes(model, model.accessors[accessorIndex].bufferView, buffer);
+    };
+
+    uint64_t required = accessorBytes(primitive.indices);
+    for (const auto& [name, accessorIndex] : primitive.attributes) {
+        required = std::max(required, accessorBytes(accessorIndex));
+    }
+    return required;
+}
+
+void LoadStreamed(Model& model, const std::string& filename) {
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open model file: " << filename << std::endl;
+        return;
+    }
+
+    Model::StreamLoader stream(model, filename);
+    std::vector<uint8_t> chunk(kStreamChunkSize);
+    while (file) {
+        file.read(reinterpret_cast<char *>(chunk.data()),
+                  static_cast<std::streamsize>(chunk.size()));
+        if (file.gcount() > 0 && !stream.Append(chunk.data(), static_cast<size_t>(file.gcount()))) {
+            break;
+        }
     }
+    stream.Finish();
 }
 
 } // namespace
@@ -410,7 +1043,7 @@ void ProcessModel(const tinygltf::Model& model, std::vector<Model::Vertex>& vert
 //----------------------------------------------------------------------
 // Model Class Implementation
 
-void Model::Load(const std::string& filename, const uint8_t *data, uint32_t size) {
+void Model::Load(const std::string& filename, const uint8_t *data, size_t size) {
     auto t0 = std::chrono::high_resolution_clock::now();
 
     tinygltf::Model model;
@@ -418,10 +1051,18 @@ void Model::Load(const std::string& filename, const uint8_t *data, uint32_t size
     std::string err;
     std::string warn;
     bool result = false;
+    if (m_loadOptions.m_deferImageDecoding) {
+        loader.SetImageLoader(LoadExternalImageData, nullptr);
+    }
 
-    if (data) {
+    if (data && size > UINT32_MAX) {
+        // The GLB header stores the file length in 32 bits
+        std::cerr << "Binary glTF data exceeds 4 GB: " << filename << std::endl;
+        return;
+    } else if (data) {
         // Load from memory, binary file
-        result = loader.LoadBinaryFromMemory(&model, &err, &warn, data, size);
+        result = loader.LoadBinaryFromMemory(&model, &err, &warn, data,
+                                             static_cast<unsigned int>(size));
     } else {
         // Load from file, either ASCII or binary
 
@@ -429,9 +1070,13 @@ void Model::Load(const std::string& filename, const uint8_t *data, uint32_t size
         std::string extension = filename.substr(filename.find_last_of(".") + 1);
 
         if (extension == "gltf") {
-            result = loader.LoadASCIIFromFile(&model, &err, &warn, filename);
+            // External buffers and images are read in one batch and decoded as they arrive
+            result = LoadAsciiWithPrefetch(loader, model, err, warn, filename,
+                                           m_loadOptions.m_deferImageDecoding);
         } else if (extension == "glb") {
-            result = loader.LoadBinaryFromFile(&model, &err, &warn, filename);
+            // Binary files are processed while they are read, overlapping processing with I/O
+            LoadStreamed(*this, filename);
+            return;
         } else {
             std::cerr << "Unsupported file format: " << extension << std::endl;
             return;
@@ -442,11 +1087,19 @@ void Model::Load(const std::string& filename, const uint8_t *data, uint32_t size
     if (result) {
         ClearData();
         auto t1 = std::chrono::high_resolution_clock::now();
-        ProcessModel(model, m_vertices, m_indices, m_materials, m_textures, m_subMeshes);
-        RecomputeBounds();
+        RawVertexData *rawVertexData =
+            m_loadOptions.m_gpuVertexProcessing ? &m_rawVertexData : nullptr;
+        ProcessModel(model, m_vertices, m_indices, m_materials, m_textures, m_subMeshes,
+                     m_loadStats, rawVertexData, m_geometryTransforms,
+                     m_loadOptions.m_deduplicateGeometry, m_loadOptions.m_deferImageDecoding);
+        m_loadStats.m_sourceMaterialCount = static_cast<uint32_t>(m_materials.size());
+        m_loadStats.m_sourceSubMeshCount = static_cast<uint32_t>(m_subMeshes.size());
+        ApplyLoadOptions();
         auto t2 = std::chrono::high_resolution_clock::now();
         double totalMs = std::chrono::duration<double, std::milli>(t2 - t0).count();
         double processMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        m_loadStats.m_parseTimeMs = processMs;
+        m_loadStats.m_processTimeMs = totalMs - processMs;
         std::cout << "Loaded model in " << totalMs << "ms (processing took: " << processMs << "ms)"
                   << std::endl;
     } else {
@@ -469,6 +1122,117 @@ void Model::ResetOrientation() noexcept {
     m_rotationAngle = 0.0f;
 }
 
+void Model::Replicate(const std::vector<glm::mat4>& instanceTransforms, uint32_t materialVariants) {
+    if (instanceTransforms.empty()) {
+        return;
+    }
+    materialVariants = std::max(materialVariants, 1u);
+
+    // The instances are baked on the CPU
+    ResolveRawPrimitives();
+
+    const std::vector<Vertex> srcVertices = std::move(m_vertices);
+    const std::vector<uint32_t> srcIndices = std::move(m_indices);
+    const std::vector<SubMesh> srcSubMeshes = std::move(m_subMeshes);
+    const std::vector<Material> srcMaterials = std::move(m_materials);
+    const std::vector<glm::mat4> srcGeometryTransforms = std::move(m_geometryTransforms);
+
+    // Create the material variants (variant 0 keeps the original materials)
+    m_materials.clear();
+    m_materials.reserve(srcMaterials.size() * materialVariants);
+    for (uint32_t variant = 0; variant < materialVariants; ++variant) {
+        for (const Material& material : srcMaterials) {
+            m_materials.push_back(MakeMaterialVariant(material, variant));
+        }
+    }
+
+    m_vertices.clear();
+    m_indices.clear();
+    m_subMeshes.clear();
+    m_instances.clear();
+    m_geometryTransforms.assign(1, glm::mat4(1.0f));
+    m_vertices.reserve(srcVertices.size() * instanceTransforms.size());
+    m_indices.reserve(srcIndices.size() * instanceTransforms.size());
+    m_subMeshes.reserve(srcSubMeshes.size() * instanceTransforms.size());
+    m_instances.reserve(instanceTransforms.size());
+
+    // Bake one copy of the geometry per instance
+    for (size_t instance = 0; instance < instanceTransforms.size(); ++instance) {
+        const glm::mat4& transform = instanceTransforms[instance];
+        const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+        const glm::mat3 tangentMatrix = glm::mat3(transform);
+
+        const uint32_t vertexOffset = static_cast<uint32_t>(m_vertices.size());
+        const uint32_t indexOffset = static_cast<uint32_t>(m_indices.size());
+        const uint32_t variant = static_cast<uint32_t>(instance % materialVariants);
+        const int materialOffset = static_cast<int>(variant * srcMaterials.size());
+
+        m_instances.push_back({.m_transform = transform,
+                               .m_firstSubMesh = static_cast<uint32_t>(m_subMeshes.size()),
+                               .m_subMeshCount = static_cast<uint32_t>(srcSubMeshes.size()),
+                               .m_tint = GetVariantTint(variant)});
+
+        for (Vertex vertex : srcVertices) {
+            vertex.m_position = glm::vec3(transform * glm::vec4(vertex.m_position, 1.0f));
+            vertex.m_normal = glm::normalize(normalMatrix * vertex.m_normal);
+            vertex.m_tangent = glm::vec4(
+                glm::normalize(tangentMatrix * glm::vec3(vertex.m_tangent)), vertex.m_tangent.w);
+            m_vertices.push_back(vertex);
+        }
+
+        for (uint32_t index : srcIndices) {
+            m_indices.push_back(index + vertexOffset);
+        }
+
+        // Geometry transforms act on the baked vertices, so conjugate them with the instance
+        // transform
+        const uint32_t transformOffset = static_cast<uint32_t>(m_geometryTransforms.size()) - 1;
+        const glm::mat4 inverseTransform = glm::inverse(transform);
+        for (size_t i = 1; i < srcGeometryTransforms.size(); ++i) {
+            m_geometryTransforms.push_back(transform * srcGeometryTransforms[i] * inverseTransform);
+        }
+
+        for (SubMesh subMesh : srcSubMeshes) {
+            subMesh.m_firstIndex += indexOffset;
+            subMesh.m_materialIndex += materialOffset;
+            if (subMesh.m_transformIndex != 0) {
+                subMesh.m_transformIndex += transformOffset;
+            }
+            TransformBounds(transform, subMesh.m_minBounds, subMesh.m_maxBounds);
+            m_subMeshes.push_back(subMesh);
+        }
+    }
+
+    RecomputeBounds();
+}
+
+void Model::SetLoadOptions(const LoadOptions& options) noexcept {
+    m_loadOptions = options;
+}
+
+void Model::ResolveRawPrimitives() {
+    for (const RawPrimitive& primitive : m_rawVertexData.m_primitives) {
+        ConvertRawPrimitive(primitive, m_vertices.data() + primitive.m_firstVertex);
+    }
+    m_rawVertexData = {};
+}
+
+void Model::ConvertRawPrimitive(const RawPrimitive& primitive, Vertex *vertices) const {
+    AttributeSources attributes;
+    for (size_t a = 0; a < RawPrimitive::kAttributeCount; ++a) {
+        const RawAttribute& raw = primitive.m_attributes[a];
+        if (raw.m_componentType != 0) {
+            attributes[a] = {.m_data = m_rawVertexData.m_bytes.data() + primitive.m_dataOffset +
+                                       raw.m_offset,
+                             .m_stride = raw.m_stride,
+                             .m_componentType = static_cast<int>(raw.m_componentType),
+                             .m_components = static_cast<int>(raw.m_components),
+                             .m_normalized = raw.m_normalized};
+        }
+    }
+    ConvertVertices(attributes, primitive.m_vertexCount, primitive.m_transform, vertices);
+}
+
 const glm::mat4& Model::GetTransform() const noexcept {
     return m_transform;
 }
@@ -501,10 +1265,65 @@ const Model::Texture *Model::GetTexture(int index) const noexcept {
     return nullptr;
 }
 
+bool Model::Texture::DecodeRows(uint8_t *destination, uint32_t bytesPerRow) const {
+    const size_t rowSize = static_cast<size_t>(m_width) * 4;
+    const uint8_t *pixels = m_data.data();
+    stbi_uc *decoded = nullptr;
+    if (m_data.empty()) {
+        int width = 0;
+        int height = 0;
+        int components = 0;
+        if (!m_encodedData.empty() &&
+            m_encodedData.size() <= static_cast<size_t>(std::numeric_limits<int>::max())) {
+            decoded = stbi_load_from_memory(m_encodedData.data(),
+                                            static_cast<int>(m_encodedData.size()), &width,
+                                            &height, &components, 4 /* force 4 channels */);
+        }
+        if (!decoded || static_cast<uint32_t>(width) != m_width ||
+            static_cast<uint32_t>(height) != m_height) {
+            std::cerr << "Failed to decode image: " << m_name << std::endl;
+            stbi_image_free(decoded);
+            return false;
+        }
+        pixels = decoded;
+    } else if (m_data.size() < rowSize * m_height) {
+        std::cerr << "Image data is incomplete: " << m_name << std::endl;
+        return false;
+    }
+
+    if (bytesPerRow == rowSize) {
+        std::memcpy(destination, pixels, rowSize * m_height);
+    } else {
+        for (uint32_t y = 0; y < m_height; ++y) {
+            std::memcpy(destination + static_cast<size_t>(y) * bytesPerRow, pixels + y * rowSize,
+                        rowSize);
+        }
+    }
+
+    stbi_image_free(decoded);
+    return true;
+}
+
 const std::vector<Model::SubMesh>& Model::GetSubMeshes() const noexcept {
     return m_subMeshes;
 }
 
+const Model::LoadStats& Model::GetLoadStats() const noexcept {
+    return m_loadStats;
+}
+
+const std::vector<Model::Instance>& Model::GetInstances() const noexcept {
+    return m_instances;
+}
+
+const Model::RawVertexData& Model::GetRawVertexData() const noexcept {
+    return m_rawVertexData;
+}
+
+const std::vector<glm::mat4>& Model::GetGeometryTransforms() const noexcept {
+    return m_geometryTransforms;
+}
+
 void Model::ClearData() {
     m_transform = glm::mat4(1.0f);
     m_rotationAngle = 0.0f;
@@ -515,15 +1334,399 @@ void Model::ClearData() {
     m_materials.clear();
     m_textures.clear();
     m_subMeshes.clear();
+    m_instances.clear();
+    m_rawVertexData = {};
+    m_geometryTransforms.assign(1, glm::mat4(1.0f));
+    m_loadStats = {};
+}
+
+void Model::ApplyLoadOptions() {
+    if (m_loadStats.m_duplicateGeometryCount > 0) {
+        std::cout << "Deduplicated geometry of " << m_loadStats.m_duplicateGeometryCount
+                  << " primitives" << std::endl;
+    }
+    if (m_loadOptions.m_deduplicateMaterials) {
+        DeduplicateMaterials();
+    }
+    if (m_loadOptions.m_mergeSubMeshes) {
+        MergeSubMeshes();
+    }
+    RecomputeBounds();
 }
 
 void Model::RecomputeBounds() {
     m_minBounds = glm::vec3(std::numeric_limits<float>::max());
     m_maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
 
-    // Calculate the bounding box of the model
-    for (const auto& vertex : m_vertices) {
-        m_minBounds = glm::min(m_minBounds, vertex.m_position);
-        m_maxBounds = glm::max(m_maxBounds, vertex.m_position);
+    // Every vertex belongs to a submesh, and vertices left to the GPU are not available here
+    for (const auto& subMesh : m_subMeshes) {
+        m_minBounds = glm::min(m_minBounds, subMesh.m_minBounds);
+        m_maxBounds = glm::max(m_maxBounds, subMesh.m_maxBounds);
+    }
+}
+
+void Model::DeduplicateMaterials() {
+    std::vector<Material> uniqueMaterials;
+    std::vector<int> remap(m_materials.size(), -1);
+
+    // Map every material to the first one with identical parameters and textures
+    for (size_t i = 0; i < m_materials.size(); ++i) {
+        auto it = std::find(uniqueMaterials.begin(), uniqueMaterials.end(), m_materials[i]);
+        if (it == uniqueMaterials.end()) {
+            remap[i] = static_cast<int>(uniqueMaterials.size());
+            uniqueMaterials.push_back(m_materials[i]);
+        } else {
+            remap[i] = static_cast<int>(it - uniqueMaterials.begin());
+        }
+    }
+
+    for (SubMesh& subMesh : m_subMeshes) {
+        if (subMesh.m_materialIndex >= 0) {
+            subMesh.m_materialIndex = remap[subMesh.m_materialIndex];
+        }
+    }
+
+    std::cout << "Deduplicated " << m_materials.size() << " materials into "
+              << uniqueMaterials.size() << std::endl;
+    m_materials = std::move(uniqueMaterials);
+}
+
+void Model::MergeSubMeshes() {
+    // Group the submeshes by material and geometry transform. Blended submeshes are kept
+    // separate since the renderer sorts them back-to-front per submesh.
+    std::vector<std::vector<size_t>> groups;
+    std::map<std::pair<int, uint32_t>, size_t> groupOfKey;
+    for (size_t i = 0; i < m_subMeshes.size(); ++i) {
+        const int materialIndex = m_subMeshes[i].m_materialIndex;
+        const bool blended = materialIndex >= 0 &&
+                             m_materials[materialIndex].m_alphaMode == AlphaMode::Blend;
+
+        if (materialIndex < 0 || blended) {
+            groups.push_back({i});
+            continue;
+        }
+
+        const auto [it, inserted] =
+            groupOfKey.try_emplace({materialIndex, m_subMeshes[i].m_transformIndex}, groups.size());
+        if (inserted) {
+            groups.push_back({i});
+        } else {
+            groups[it->second].push_back(i);
+        }
+    }
+
+    if (groups.size() == m_subMeshes.size()) {
+        return;
+    }
+
+    // Concatenate the index ranges of each group
+    std::vector<uint32_t> mergedIndices;
+    std::vector<SubMesh> mergedSubMeshes;
+    mergedIndices.reserve(m_indices.size());
+    mergedSubMeshes.reserve(groups.size());
+
+    for (const std::vector<size_t>& group : groups) {
+        SubMesh merged;
+        merged.m_firstIndex = static_cast<uint32_t>(mergedIndices.size());
+        merged.m_materialIndex = m_subMeshes[group.front()].m_materialIndex;
+        merged.m_transformIndex = m_subMeshes[group.front()].m_transformIndex;
+        merged.m_minBounds = glm::vec3(std::numeric_limits<float>::max());
+        merged.m_maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
+
+        for (size_t subMeshIndex : group) {
+            const SubMesh& subMesh = m_subMeshes[subMeshIndex];
+            mergedIndices.insert(mergedIndices.end(), m_indices.begin() + subMesh.m_firstIndex,
+                                 m_indices.begin() + subMesh.m_firstIndex + subMesh.m_indexCount);
+            merged.m_minBounds = glm::min(merged.m_minBounds, subMesh.m_minBounds);
+            merged.m_maxBounds = glm::max(merged.m_maxBounds, subMesh.m_maxBounds);
+        }
+
+        merged.m_indexCount = static_cast<uint32_t>(mergedIndices.size()) - merged.m_firstIndex;
+        mergedSubMeshes.push_back(merged);
+    }
+
+    std::cout << "Merged " << m_subMeshes.size() << " submeshes into " << mergedSubMeshes.size()
+              << std::endl;
+    m_indices = std::move(mergedIndices);
+    m_subMeshes = std::move(mergedSubMeshes);
+}
+//----------------------------------------------------------------------
+// Model::StreamLoader Implementation
+
+struct Model::StreamLoader::State {
+    using Clock = std::chrono::high_resolution_clock;
+
+    State(Model& model, const std::string& filename) : m_target(model), m_filename(filename) {}
+
+    bool Parse();
+    void CopyToBinBuffer(const uint8_t *data, size_t size);
+    void ProcessAvailable();
+    void DecodeImage(size_t index);
+    void Fail(const std::string& message);
+
+    Model& m_target;
+    std::string m_filename;
+    Clock::time_point m_startTime = Clock::now();
+    Clock::time_point m_lastByteTime;
+    bool m_failed = false;
+
+    // Stream position
+    std::vector<uint8_t> m_pending; // Bytes received before the JSON chunk could be parsed
+    uint64_t m_received = 0;
+    uint64_t m_totalLength = 0; // From the GLB header
+    uint64_t m_binOffset = 0;   // File offset of the BIN chunk data
+    int m_binBuffer = -1;       // Buffer backed by the BIN chunk (-1 if there is none)
+
+    // Parsed document and outstanding work
+    tinygltf::Model m_gltf;
+    bool m_parsed = false;
+    std::vector<PrimitiveInstance> m_primitives;
+    std::vector<uint64_t> m_primitiveEnds; // BIN bytes needed by each primitive
+    size_t m_nextPrimitive = 0;            // Primitives are processed in scene order
+    std::vector<uint64_t> m_imageEnds;     // BIN bytes needed by each image
+    std::vector<bool> m_imageDone;
+
+    // Processed data, moved into the target model by Finish()
+    std::vector<Model::Vertex> m_vertices;
+    std::vector<uint32_t> m_indices;
+    std::vector<Model::Material> m_materials;
+    std::vector<Model::Texture> m_textures;
+    std::vector<Model::SubMesh> m_subMeshes;
+    Model::RawVertexData m_rawVertexData;
+    std::vector<glm::mat4> m_geometryTransforms{glm::mat4(1.0f)};
+    GeometryCache m_geometryCache;
+    Model::LoadStats m_stats;
+};
+
+Model::StreamLoader::StreamLoader(Model& model, const std::string& filename)
+    : m_state(std::make_unique<State>(model, filename)) {}
+
+Model::StreamLoader::~StreamLoader() = default;
+
+bool Model::StreamLoader::Append(const uint8_t *data, size_t size) {
+    State& state = *m_state;
+    if (state.m_failed || size == 0) {
+        return !state.m_failed;
+    }
+
+    if (!state.m_parsed) {
+        state.m_pending.insert(state.m_pending.end(), data, data + size);
+        state.m_received += size;
+        if (!state.Parse()) {
+            return !state.m_failed;
+        }
+    } else {
+        state.CopyToBinBuffer(data, size);
+        state.m_received += size;
+    }
+
+    if (state.m_received >= state.m_totalLength) {
+        state.m_lastByteTime = State::Clock::now();
+    }
+
+    state.ProcessAvailable();
+    return !state.m_failed;
+}
+
+bool Model::StreamLoader::Finish() {
+    State& state = *m_state;
+    if (!state.m_failed && (!state.m_parsed || state.m_received < state.m_totalLength)) {
+        state.Fail("Incomplete GLB stream (received " + std::to_string(state.m_received) +
+                   " of " + std::to_string(state.m_totalLength) + " bytes)");
+    }
+    if (state.m_failed) {
+        return false;
+    }
+
+    // Everything has arrived, so this only picks up work skipped by malformed byte ranges
+    state.ProcessAvailable();
+
+    const auto t0 = State::Clock::now();
+    Model& model = state.m_target;
+    model.ClearData();
+    model.m_vertices = std::move(state.m_vertices);
+    model.m_indices = std::move(state.m_indices);
+    model.m_materials = std::move(state.m_materials);
+    model.m_textures = std::move(state.m_textures);
+    model.m_subMeshes = std::move(state.m_subMeshes);
+    model.m_rawVertexData = std::move(state.m_rawVertexData);
+    model.m_geometryTransforms = std::move(state.m_geometryTransforms);
+    model.m_loadStats = state.m_stats;
+    model.m_loadStats.m_sourceMaterialCount = static_cast<uint32_t>(model.m_materials.size());
+    model.m_loadStats.m_sourceSubMeshCount = static_cast<uint32_t>(model.m_subMeshes.size());
+    model.ApplyLoadOptions();
+    const auto t1 = State::Clock::now();
+    model.m_loadStats.m_processTimeMs +=
+        std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+    const double totalMs =
+        std::chrono::duration<double, std::milli>(t1 - state.m_startTime).count();
+    const double tailMs =
+        std::chrono::duration<double, std::milli>(t1 - state.m_lastByteTime).count();
+    std::cout << "Streamed model in " << totalMs << "ms (" << tailMs
+              << "ms after the last byte arrived)" << std::endl;
+    return true;
+}
+
+bool Model::StreamLoader::State::Parse() {
+    // Wait for the header and the JSON chunk header
+    if (m_pending.size() < kGlbHeaderSize + kGlbChunkHeaderSize) {
+        return false;
+    }
+
+    uint32_t header[5];
+    std::memcpy(header, m_pending.data(), sizeof(header));
+    if (std::memcmp(m_pending.data(), "glTF", 4) != 0 || header[1] != 2) {
+        Fail("Not a glTF 2.0 binary file");
+        return false;
     }
-}
\ No newline at end of file
+
+    m_totalLength = header[2];
+    const uint64_t jsonEnd = uint64_t{kGlbHeaderSize} + kGlbChunkHeaderSize + header[3];
+    const bool hasBinChunk = m_totalLength > jsonEnd;
+    const uint64_t parseSize = hasBinChunk ? jsonEnd + kGlbChunkHeaderSize : jsonEnd;
+    if (parseSize > m_totalLength) {
+        Fail("Invalid GLB chunk layout");
+        return false;
+    }
+    if (m_pending.capacity() < m_totalLength) {
+        m_pending.reserve(m_totalLength);
+    }
+    if (m_pending.size() < parseSize) {
+        return false;
+    }
+
+    // tinygltf copies the BIN chunk while parsing, so hand it a full-size buffer; the bytes that
+    // have not arrived yet are filled in as they do. Embedded images are decoded later, once
+    // their bytes are complete.
+    const auto t0 = Clock::now();
+    m_pending.resize(m_totalLength);
+    const std::string baseDir = m_filename.substr(0, m_filename.find_last_of("/\\") + 1);
+
+    tinygltf::TinyGLTF loader;
+    loader.SetImageLoader(LoadExternalImageData, nullptr);
+
+    std::string err;
+    std::string warn;
+    const bool result =
+        loader.LoadBinaryFromMemory(&m_gltf, &err, &warn, m_pending.data(),
+                                    static_cast<unsigned int>(m_totalLength), baseDir);
+    std::vector<uint8_t>().swap(m_pending);
+    if (!result) {
+        Fail(err);
+        return false;
+    }
+
+    // The BIN chunk backs the first buffer without a URI
+    m_binOffset = parseSize;
+    for (size_t i = 0; hasBinChunk && i < m_gltf.buffers.size(); ++i) {
+        if (m_gltf.buffers[i].uri.empty()) {
+            m_binBuffer = static_cast<int>(i);
+            break;
+        }
+    }
+
+    // Work list: primitives in scene order and images, each with the bytes it needs
+    m_primitives = CollectScenePrimitives(m_gltf);
+    for (const PrimitiveInstance& instance : m_primitives) {
+        m_primitiveEnds.push_back(GetRequiredBytes(m_gltf, *instance.m_primitive, m_binBuffer));
+    }
+
+    m_textures.resize(m_gltf.images.size());
+    m_imageDone.resize(m_gltf.images.size(), false);
+    for (size_t i = 0; i < m_gltf.images.size(); ++i) {
+        const tinygltf::Image& image = m_gltf.images[i];
+        m_imageEnds.push_back(GetRequiredBytes(m_gltf, image.bufferView, m_binBuffer));
+        if (image.bufferView < 0) {
+            // External or data URI images were decoded by the parser
+            m_textures[i] = ProcessImage(image, "");
+            m_imageDone[i] = true;
+        }
+    }
+
+    for (const auto& material : m_gltf.materials) {
+        ProcessMaterial(material, m_materials);
+    }
+
+    m_parsed = true;
+    m_stats.m_parseTimeMs +=
+        std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    return true;
+}
+
+void Model::StreamLoader::State::CopyToBinBuffer(const uint8_t *data, size_t size) {
+    if (m_binBuffer < 0) {
+        return;
+    }
+
+    // Clip the incoming file range to the part backing the BIN buffer
+    std::vector<unsigned char>& bin = m_gltf.buffers[m_binBuffer].data;
+    const uint64_t begin = std::max(m_received, m_binOffset);
+    const uint64_t end = std::min<uint64_t>(m_received + size, m_binOffset + bin.size());
+    if (begin < end) {
+        std::memcpy(bin.data() + (begin - m_binOffset), data + (begin - m_received),
+                    static_cast<size_t>(end - begin));
+    }
+}
+
+void Model::StreamLoader::State::ProcessAvailable() {
+    if (!m_parsed) {
+        return;
+    }
+
+    const uint64_t binReceived = m_received > m_binOffset ? m_received - m_binOffset : 0;
+
+    const auto t0 = Clock::now();
+    while (m_nextPrimitive < m_primitives.size() &&
+           m_primitiveEnds[m_nextPrimitive] <= binReceived) {
+        const PrimitiveInstance& instance = m_primitives[m_nextPrimitive++];
+        ProcessPrimitive(m_gltf, *instance.m_primitive, m_vertices, m_indices, m_subMeshes,
+                         instance.m_transform, m_stats,
+                         m_target.m_loadOptions.m_gpuVertexProcessing ? &m_rawVertexData : nullptr,
+                         m_geometryTransforms,
+                         m_target.m_loadOptions.m_deduplicateGeometry ? &m_geometryCache
+                                                                      : nullptr);
+    }
+
+    const auto t1 = Clock::now();
+    for (size_t i = 0; i < m_imageDone.size(); ++i) {
+        if (!m_imageDone[i] && m_imageEnds[i] <= binReceived) {
+            DecodeImage(i);
+        }
+    }
+
+    const auto t2 = Clock::now();
+    m_stats.m_processTimeMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+    m_stats.m_parseTimeMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+}
+
+void Model::StreamLoader::State::DecodeImage(size_t index) {
+    tinygltf::Image& image = m_gltf.images[index];
+    if (m_target.m_loadOptions.m_deferImageDecoding) {
+        m_textures[index] = KeepEncodedImage(m_gltf, image);
+        m_imageDone[index] = true;
+        return;
+    }
+
+    const tinygltf::BufferView& bufferView = m_gltf.bufferViews[image.bufferView];
+    const tinygltf::Buffer& buffer = m_gltf.buffers[bufferView.buffer];
+
+    std::string err;
+    std::string warn;
+    if (!tinygltf::LoadImageData(&image, static_cast<int>(index), &err, &warn, 0, 0,
+                                 buffer.data.data() + bufferView.byteOffset,
+                                 static_cast<int>(bufferView.byteLength), nullptr)) {
+        std::cerr << "Failed to decode image " << index << ": " << err << std::endl;
+    }
+
+    // The decoded pixels are copied into the texture; drop the parser's copy right away
+    m_textures[index] = ProcessImage(image, "");
+    std::vector<unsigned char>().swap(image.image);
+    m_imageDone[index] = true;
+}
+
+void Model::StreamLoader::State::Fail(const std::string& message) {
+    std::cerr << "Failed to load model " << m_filename << ": " << message << std::endl;
+    m_failed = true;
+    m_pending.clear();
+}
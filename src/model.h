@@ -2,6 +2,7 @@
 
 // Standard Library Headers
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,8 @@ class Model {
         int m_normalTexture = -1;                      // Index of normal texture
         int m_emissiveTexture = -1;                    // Index of emissive texture
         int m_occlusionTexture = -1;                   // Index of occlusion texture
+
+        bool operator==(const Material&) const = default;
     };
 
     struct Texture {
@@ -46,6 +49,10 @@ class Model {
         uint32_t m_height = 0;       // Height of the texture
         uint32_t m_components = 0;   // Components per pixel (e.g., 3 = RGB, 4 = RGBA)
         std::vector<uint8_t> m_data; // Raw pixel data
+        std::vector<uint8_t> m_encodedData; // Image file, see LoadOptions::m_deferImageDecoding
+
+        // Writes the RGBA8 pixels into rows bytesPerRow apart, decoding m_encodedData if needed
+        bool DecodeRows(uint8_t *destination, uint32_t bytesPerRow) const;
     };
 
     struct SubMesh {
@@ -54,6 +61,86 @@ class Model {
         int m_materialIndex = -1;  // Material index for the submesh
         glm::vec3 m_minBounds;
         glm::vec3 m_maxBounds;
+        uint32_t m_transformIndex = 0; // Geometry transform applied when drawing (0 = identity)
+    };
+
+    // Copy of the source geometry created by Replicate(); its vertices are baked with m_transform
+    struct Instance {
+        glm::mat4 m_transform{1.0f};        // Transform applied to the source geometry
+        uint32_t m_firstSubMesh = 0;        // First submesh of the instance
+        uint32_t m_subMeshCount = 0;        // Number of submeshes of the instance
+        glm::vec4 m_tint = glm::vec4(1.0f); // Base color tint of the instance's material variant
+    };
+
+    // Vertex attribute kept as raw accessor bytes (see LoadOptions::m_gpuVertexProcessing)
+    struct RawAttribute {
+        uint32_t m_offset = 0;        // Byte offset from the start of the primitive's raw block
+        uint32_t m_stride = 0;        // Byte stride between elements
+        uint32_t m_componentType = 0; // glTF component type (0 if the attribute is absent)
+        uint32_t m_components = 0;    // Components per element
+        bool m_normalized = false;    // Integer components are normalized to [0, 1] or [-1, 1]
+    };
+
+    // Primitive whose vertices are converted and transformed on the GPU. Its range of the vertex
+    // array is left uninitialized on the CPU.
+    struct RawPrimitive {
+        static constexpr size_t kAttributeCount = 6; // Same order as the Vertex members
+
+        glm::mat4 m_transform{1.0f};   // Node transform to bake into the vertices
+        uint32_t m_firstVertex = 0;    // First vertex written by the primitive
+        uint32_t m_vertexCount = 0;    // Number of vertices of the primitive
+        uint64_t m_dataOffset = 0;     // Start of the primitive's block in the raw vertex data
+        uint64_t m_dataSize = 0;       // Size of the block in bytes
+        RawAttribute m_attributes[kAttributeCount];
+    };
+
+    struct RawVertexData {
+        std::vector<RawPrimitive> m_primitives;
+        std::vector<uint8_t> m_bytes; // Blocks start at kRawBlockAlignment-aligned offsets
+    };
+
+    struct LoadOptions {
+        bool m_mergeSubMeshes = false;       // Merge submeshes sharing a material (static batching)
+        bool m_deduplicateMaterials = false; // Merge materials with identical parameters/textures
+        bool m_gpuVertexProcessing = false;  // Keep raw attributes for conversion on the GPU
+        bool m_deduplicateGeometry = false;  // Store byte-identical primitives once
+        bool m_deferImageDecoding = false;   // Keep embedded images encoded until their upload
+    };
+
+    // Alignment of the raw primitive blocks (minStorageBufferOffsetAlignment)
+    static constexpr uint64_t kRawBlockAlignment = 256;
+
+    struct LoadStats {
+        uint32_t m_primitiveCount = 0;         // Primitives processed (before merging)
+        uint32_t m_missingNormalCount = 0;     // Primitives without NORMAL
+        uint32_t m_missingTangentCount = 0;    // Primitives without TANGENT (MikkTSpace)
+        uint32_t m_duplicateGeometryCount = 0; // Primitives sharing earlier identical geometry
+        uint32_t m_sourceMaterialCount = 0;    // Materials in the file (before deduplication)
+        uint32_t m_sourceSubMeshCount = 0;     // Submeshes before merging
+        double m_parseTimeMs = 0.0;            // tinygltf parsing and image decoding
+        double m_processTimeMs = 0.0;          // Vertex processing, tangents and load options
+    };
+
+    // Progressive GLB loader. Bytes are fed as they arrive (from a slow disk, pipe, socket or
+    // browser file stream); the header and JSON chunk are parsed as soon as they are complete and
+    // every primitive and embedded image is processed once its byte range in the BIN chunk has
+    // arrived. The target model is only replaced when Finish() succeeds.
+    class StreamLoader {
+      public:
+        StreamLoader(Model& model, const std::string& filename);
+        ~StreamLoader();
+
+        StreamLoader(const StreamLoader&) = delete;
+        StreamLoader& operator=(const StreamLoader&) = delete;
+        StreamLoader(StreamLoader&&) = delete;
+        StreamLoader& operator=(StreamLoader&&) = delete;
+
+        bool Append(const uint8_t *data, size_t size); // False once the stream is invalid
+        bool Finish(); // False if the stream was invalid or incomplete
+
+      private:
+        struct State;
+        std::unique_ptr<State> m_state;
     };
 
     // Constructor
@@ -66,9 +153,13 @@ class Model {
     Model& operator=(Model&&) = default;
 
     // Public Interface
-    void Load(const std::string& filename, const uint8_t *data = 0, uint32_t size = 0);
+    void Load(const std::string& filename, const uint8_t *data = 0, size_t size = 0);
     void Update(float deltaTime, bool animate);
     void ResetOrientation() noexcept;
+    void Replicate(const std::vector<glm::mat4>& instanceTransforms, uint32_t materialVariants);
+    void SetLoadOptions(const LoadOptions& options) noexcept;
+    void ResolveRawPrimitives();
+    void ConvertRawPrimitive(const RawPrimitive& primitive, Vertex *vertices) const;
 
     // Accessors
     const glm::mat4& GetTransform() const noexcept;
@@ -79,11 +170,18 @@ class Model {
     const std::vector<Texture>& GetTextures() const noexcept;
     const Texture *GetTexture(int index) const noexcept;
     const std::vector<SubMesh>& GetSubMeshes() const noexcept;
+    const LoadStats& GetLoadStats() const noexcept;
+    const std::vector<Instance>& GetInstances() const noexcept;
+    const RawVertexData& GetRawVertexData() const noexcept;
+    const std::vector<glm::mat4>& GetGeometryTransforms() const noexcept;
 
   private:
     // Private Member Functions
     void ClearData();
+    void ApplyLoadOptions();
     void RecomputeBounds();
+    void DeduplicateMaterials();
+    void MergeSubMeshes();
 
     // Private Member Variables
     glm::mat4 m_transform{1.0f};  // Model transformation matrix
@@ -95,4 +193,9 @@ class Model {
     std::vector<Material> m_materials;
     std::vector<Texture> m_textures;
     std::vector<SubMesh> m_subMeshes;
+    std::vector<Instance> m_instances; // Empty unless replicated
+    RawVertexData m_rawVertexData;     // Primitives left to the GPU
+    std::vector<glm::mat4> m_geometryTransforms{glm::mat4(1.0f)}; // By SubMesh::m_transformIndex
+    LoadOptions m_loadOptions;
+    LoadStats m_loadStats;
 };
\ No newline at end of file
@@ -1,33 +1,11 @@
 // Standard Library Headers
-#include <fstream>
-#include <iostream>
-#include <sstream>
 #include <string>
 #include <vector>
 
 // Project Headers
+#include "asset_archive.h"
 #include "panorama_to_cubemap_converter.h"
 
-//----------------------------------------------------------------------
-// Internal Utility Functions
-
-namespace {
-
-// TODO: Move to helper class for managing resources
-std::string LoadShaderFile(const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::in | std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open shader file: " + filepath + "\n";
-        return "";
-    }
-
-    std::ostringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
-}
-
-} // namespace
-
 //----------------------------------------------------------------------
 // PanoramaToCubemapConverter Class implementation
 
@@ -44,7 +22,14 @@ void PanoramaToCubemapConverter::UploadAndConvert(const Environment::Texture& pa
                                                   wgpu::Texture& environmentCubemap) {
     uint32_t width = panoramaTextureInfo.m_width;
     uint32_t height = panoramaTextureInfo.m_height;
-    const float *data = panoramaTextureInfo.m_data.data();
+
+    // OpenEXR panoramas are uploaded as half floats without conversion
+    const bool halfFloat = !panoramaTextureInfo.m_halfData.empty();
+    const wgpu::TextureFormat format =
+        halfFloat ? wgpu::TextureFormat::RGBA16Float : wgpu::TextureFormat::RGBA32Float;
+    const void *data = halfFloat ? static_cast<const void *>(panoramaTextureInfo.m_halfData.data())
+                                 : static_cast<const void *>(panoramaTextureInfo.m_data.data());
+    const uint32_t bytesPerPixel = halfFloat ? 4 * sizeof(uint16_t) : 4 * sizeof(float);
 
     // Create WebGPU texture descriptor for the input panorama texture
     wgpu::TextureDescriptor textureDescriptor{};
@@ -52,7 +37,7 @@ void PanoramaToCubemapConverter::UploadAndConvert(const Environment::Texture& pa
                               wgpu::TextureUsage::StorageBinding | wgpu::TextureUsage::CopyDst |
                               wgpu::TextureUsage::CopySrc;
     textureDescriptor.size = {width, height, 1};
-    textureDescriptor.format = wgpu::TextureFormat::RGBA32Float;
+    textureDescriptor.format = format;
     textureDescriptor.mipLevelCount = 1;
     wgpu::Texture panoramaTexture = m_device.CreateTexture(&textureDescriptor);
 
@@ -66,15 +51,16 @@ void PanoramaToCubemapConverter::UploadAndConvert(const Environment::Texture& pa
 
     wgpu::TexelCopyBufferLayout source{};
     source.offset = 0;
-    source.bytesPerRow = static_cast<uint32_t>(4 * width * sizeof(float));
+    source.bytesPerRow = width * bytesPerPixel;
     source.rowsPerImage = height;
 
-    const size_t dataSize = static_cast<size_t>(4) * width * height * sizeof(float);
+    const size_t dataSize = static_cast<size_t>(width) * height * bytesPerPixel;
     m_device.GetQueue().WriteTexture(&destination, data, dataSize, &source, &textureSize);
 
-    // Create views for the input panorama and output cubemap.
+    // Create views for the input panorama and output cubemap (or octahedral map).
+    const uint32_t layerCount = environmentCubemap.GetDepthOrArrayLayers();
     wgpu::TextureViewDescriptor inputViewDesc{};
-    inputViewDesc.format = wgpu::TextureFormat::RGBA32Float;
+    inputViewDesc.format = format;
     inputViewDesc.dimension = wgpu::TextureViewDimension::e2D;
     inputViewDesc.baseArrayLayer = 0;
     inputViewDesc.arrayLayerCount = 1;
@@ -84,7 +70,7 @@ void PanoramaToCubemapConverter::UploadAndConvert(const Environment::Texture& pa
     outputCubeViewDesc.baseMipLevel = 0;
     outputCubeViewDesc.mipLevelCount = 1;
     outputCubeViewDesc.baseArrayLayer = 0;
-    outputCubeViewDesc.arrayLayerCount = 6;
+    outputCubeViewDesc.arrayLayerCount = layerCount;
 
     // Bind group 0 - common for all faces
     wgpu::BindGroupEntry bindGroup0Entries[3]{};
@@ -107,22 +93,22 @@ void PanoramaToCubemapConverter::UploadAndConvert(const Environment::Texture& pa
     wgpu::ComputePassEncoder computePass = encoder.BeginComputePass();
 
     // Set the compute pipeline for the conversion.
-    computePass.SetPipeline(m_pipelineConvert);
+    computePass.SetPipeline(layerCount == 1 ? m_pipelineConvertOctahedral : m_pipelineConvert);
 
     // Set bind groups common to all faces.
     computePass.SetBindGroup(0, bindGroup0, 0, nullptr);
 
-    // Dispatch a compute shader for each face of the cubemap.
-    constexpr uint32_t numFaces = 6;
+    // Dispatch a compute shader for each face of the cubemap (the octahedral map covers the
+    // whole sphere in one dispatch).
+    constexpr uint32_t workgroupSize = 8;
+    const uint32_t workgroupCountX =
+        (environmentCubemap.GetWidth() + workgroupSize - 1) / workgroupSize;
+    const uint32_t workgroupCountY =
+        (environmentCubemap.GetHeight() + workgroupSize - 1) / workgroupSize;
+    const uint32_t numFaces = layerCount == 1 ? 1 : 6;
     for (uint32_t face = 0; face < numFaces; ++face) {
         // For each face, update the per-face uniform (bind group 1).
         computePass.SetBindGroup(1, m_perFaceBindGroups[face], 0, nullptr);
-
-        constexpr uint32_t workgroupSize = 8;
-        uint32_t workgroupCountX =
-            (environmentCubemap.GetWidth() + workgroupSize - 1) / workgroupSize;
-        uint32_t workgroupCountY =
-            (environmentCubemap.GetHeight() + workgroupSize - 1) / workgroupSize;
         computePass.DispatchWorkgroups(workgroupCountX, workgroupCountY, 1);
     }
 
@@ -214,7 +200,7 @@ void PanoramaToCubemapConverter::InitBindGroups() {
 }
 
 void PanoramaToCubemapConverter::InitComputePipeline() {
-    std::string shaderCode = LoadShaderFile("./assets/shaders/panorama_to_cubemap.wgsl");
+    std::string shaderCode = LoadTextAsset("./assets/shaders/panorama_to_cubemap.wgsl");
 
     wgpu::ShaderSourceWGSL wgsl{{.nextInChain = nullptr, .code = shaderCode.c_str()}};
     wgpu::ShaderModuleDescriptor shaderModuleDescriptor{.nextInChain = &wgsl};
@@ -236,4 +222,7 @@ void PanoramaToCubemapConverter::InitComputePipeline() {
 
     descriptor.compute.entryPoint = "panoramaToCubemap";
     m_pipelineConvert = m_device.CreateComputePipeline(&descriptor);
+
+    descriptor.compute.entryPoint = "panoramaToOctahedral";
+    m_pipelineConvertOctahedral = m_device.CreateComputePipeline(&descriptor);
 }
@@ -30,7 +30,8 @@ class PanoramaToCubemapConverter {
 
     /// @brief Uploads the panorama texture and converts it into the provided cubemap texture.
     /// @param panoramaTextureInfo The source panorama texture data.
-    /// @param environmentCubemap The destination cubemap texture.
+    /// @param environmentCubemap The destination cubemap texture (6 layers), or a single layer
+    ///        texture that receives the octahedral encoding of the panorama.
     void UploadAndConvert(const Environment::Texture& panoramaTextureInfo,
                           wgpu::Texture& environmentCubemap);
 
@@ -54,8 +55,9 @@ class PanoramaToCubemapConverter {
     // Bind group layouts (index 0: common parameters, index 1: per-face uniforms)
     wgpu::BindGroupLayout m_bindGroupLayouts[2];
 
-    // Compute pipeline for converting panorama to cubemap.
+    // Compute pipelines for converting panorama to cubemap and to an octahedral map.
     wgpu::ComputePipeline m_pipelineConvert;
+    wgpu::ComputePipeline m_pipelineConvertOctahedral;
 
     // Uniform buffers for per-face parameters (one per cubemap face).
     wgpu::Buffer m_perFaceUniformBuffers[6];
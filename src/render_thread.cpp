@@ -0,0 +1,123 @@
+// Standard Library Headers
+#include <chrono>
+#include <utility>
+
+// Project Headers
+#include "frame_time_recorder.h"
+#include "render_thread.h"
+
+//----------------------------------------------------------------------
+// Internal Constants
+
+namespace {
+
+// Upper bound for frame times buffered while the main thread is busy (e.g. loading a model)
+constexpr size_t kMaxBufferedFrameTimes = 1024;
+
+// Wait time while no snapshot has been published yet
+constexpr auto kIdleWait = std::chrono::milliseconds(1);
+
+} // namespace
+
+//----------------------------------------------------------------------
+// RenderThread Class Implementation
+
+RenderThread::RenderThread(Renderer& renderer) : m_renderer(renderer) {}
+
+RenderThread::~RenderThread() {
+    Stop();
+}
+
+void RenderThread::Start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { ThreadMain(); });
+}
+
+void RenderThread::Stop() {
+    if (!m_running.exchange(false)) {
+        return;
+    }
+    m_thread.join();
+
+    // Run anything queued after the last frame so no caller is left waiting
+    ExecuteCommands();
+}
+
+void RenderThread::PublishSnapshot(const FrameSnapshot& snapshot) {
+    m_snapshots.Write(snapshot);
+}
+
+void RenderThread::Execute(std::function<void()> command) {
+    if (!m_running.load()) {
+        command();
+        return;
+    }
+
+    std::packaged_task<void()> task(std::move(command));
+    std::future<void> done = task.get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_commands.push_back(std::move(task));
+    }
+    done.wait();
+}
+
+void RenderThread::Post(std::function<void()> command) {
+    if (!m_running.load()) {
+        command();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_commands.emplace_back(std::move(command));
+}
+
+std::vector<float> RenderThread::TakeFrameTimes() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::exchange(m_frameTimes, {});
+}
+
+void RenderThread::ThreadMain() {
+    FrameSnapshot snapshot;
+    bool hasSnapshot = false;
+    auto lastTime = std::chrono::high_resolution_clock::now();
+
+    while (m_running.load()) {
+        ExecuteCommands();
+
+        // Render the most recent state; reuse the previous one if nothing new was published
+        hasSnapshot |= m_snapshots.Read(snapshot);
+        if (!hasSnapshot) {
+            std::this_thread::sleep_for(kIdleWait);
+            continue;
+        }
+
+        // Frame pacing comes from presenting the surface
+        m_renderer.Render(snapshot.m_modelMatrix, snapshot.m_camera);
+
+        const auto currentTime = std::chrono::high_resolution_clock::now();
+        const float frameTime =
+            std::chrono::duration<float, std::milli>(currentTime - lastTime).count();
+        lastTime = currentTime;
+        FrameTimeRecorder::GetInstance().RecordFrame(frameTime);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_frameTimes.size() < kMaxBufferedFrameTimes) {
+            m_frameTimes.push_back(frameTime);
+        }
+    }
+}
+
+void RenderThread::ExecuteCommands() {
+    std::vector<std::packaged_task<void()>> commands;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        commands.swap(m_commands);
+    }
+
+    for (auto& command : commands) {
+        command();
+    }
+}
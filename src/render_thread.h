@@ -0,0 +1,67 @@
+#pragma once
+
+// Standard Library Headers
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Third-Party Library Headers
+#include <glm/glm.hpp>
+
+// Project Headers
+#include "renderer.h"
+#include "triple_buffer.h"
+
+// RenderThread Class
+//
+// Submits frames from a dedicated thread so slow frames do not stall input processing. The main
+// thread publishes the camera and model state as a triple-buffered snapshot and the render
+// thread always renders the latest one. All other renderer calls are marshalled to the render
+// thread through a command queue and executed between frames.
+class RenderThread {
+  public:
+    // Types
+    struct FrameSnapshot {
+        glm::mat4 m_modelMatrix{1.0f};
+        Renderer::CameraUniformsInput m_camera{};
+    };
+
+    // Constructor
+    explicit RenderThread(Renderer& renderer);
+
+    // Destructor
+    ~RenderThread();
+
+    // Rule of 5
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+    RenderThread(RenderThread&&) = delete;
+    RenderThread& operator=(RenderThread&&) = delete;
+
+    // Public Interface
+    void Start();
+    void Stop();
+    void PublishSnapshot(const FrameSnapshot& snapshot);
+    void Execute(std::function<void()> command); // Runs on the render thread and waits
+    void Post(std::function<void()> command);    // Runs on the render thread asynchronously
+    std::vector<float> TakeFrameTimes();         // Frame times (ms) since the last call
+
+  private:
+    // Private Member Functions
+    void ThreadMain();
+    void ExecuteCommands();
+
+    // Private Member Variables
+    Renderer& m_renderer;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    TripleBuffer<FrameSnapshot> m_snapshots;
+
+    std::mutex m_mutex; // Guards the command queue and frame times
+    std::vector<std::packaged_task<void()>> m_commands;
+    std::vector<float> m_frameTimes;
+};
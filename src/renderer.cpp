@@ -1,13 +1,17 @@
 // Standard Library Headers
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <cmath>
-#include <fstream>
+#include <cstring>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <memory>
-#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 // Third-Party Library Headers
@@ -26,23 +30,105 @@
 
 // Project Headers
 #include "application.h"
+#include "asset_archive.h"
+#include "cpu_environment_preprocessor.h"
 #include "environment.h"
 #include "environment_preprocessor.h"
+#include "exr_loader.h"
+#include "frame_time_recorder.h"
+#include "gpu_resource_pool.h"
+#include "mesh_processor.h"
 #include "mipmap_generator.h"
 #include "model.h"
 #include "orbit_controls.h"
 #include "panorama_to_cubemap_converter.h"
 #include "renderer.h"
+#include "texture_feedback.h"
+#include "texture_utils.h"
 
 //----------------------------------------------------------------------
 // Internal Utility Functions
 
 namespace {
 
-constexpr uint32_t kIrradianceMapSize = 64;
-constexpr uint32_t kPrecomputedSpecularMapSize = 512;
 constexpr uint32_t kBRDFIntegrationLUTMapSize = 128;
 
+// Shading and IBL parameters per Renderer::QualityTier
+struct QualitySettings {
+    uint32_t m_maxEnvironmentCubeSize; // Upper bound for the environment cube size
+    uint32_t m_specularMapSize;        // Prefiltered specular cube size
+    uint32_t m_irradianceMapSize;      // Irradiance cube size (1x1 placeholder when using SH)
+    uint32_t m_sampleCount;            // Samples per texel when prefiltering the IBL maps
+    bool m_useBRDFLUT;                 // Split-sum LUT, or analytic approximation without fetch
+    bool m_useSphericalHarmonics;      // Diffuse IBL from SH instead of the irradiance cube
+    bool m_useOctahedralEnvironment;   // Octahedral 2D background and specular maps
+};
+
+constexpr QualitySettings kQualitySettings[] = {
+    {512, 128, 1, 256, false, true, true},     // Low
+    {1024, 256, 32, 512, true, false, true},   // Medium
+    {4096, 512, 64, 1024, true, false, false}, // High
+};
+
+// Octahedral map size per cube face size; the same angular resolution in 2/3 of the texels
+constexpr uint32_t kOctahedralSizeScale = 2;
+
+// Number of panorama samples per row when projecting onto spherical harmonics
+constexpr uint32_t kSphericalHarmonicsSampleWidth = 256;
+
+// Prepared environments kept resident for instant switching
+constexpr uint64_t kEnvironmentCacheBudget = 1024ull * 1024ull * 1024ull;
+constexpr size_t kMaxCachedEnvironments = 10;
+
+// Per-draw debug uniforms use dynamic offsets (minUniformBufferOffsetAlignment)
+constexpr uint32_t kDebugDrawUniformStride = 256;
+
+// Geometry transforms of deduplicated geometry are a per-instance mat4 in vertex buffer slot 1
+// (locations 6-9); every draw selects its transform with firstInstance
+const wgpu::VertexAttribute kGeometryTransformAttributes[] = {
+    {.format = wgpu::VertexFormat::Float32x4, .offset = 0, .shaderLocation = 6},
+    {.format = wgpu::VertexFormat::Float32x4, .offset = 16, .shaderLocation = 7},
+    {.format = wgpu::VertexFormat::Float32x4, .offset = 32, .shaderLocation = 8},
+    {.format = wgpu::VertexFormat::Float32x4, .offset = 48, .shaderLocation = 9},
+};
+
+// Impostors: kImpostorGridSize x kImpostorGridSize octahedral views of kImpostorTileSize pixels.
+// Instances whose bounding sphere projects smaller than kImpostorScreenSize pixels (diameter) are
+// drawn as impostors once a model has at least kMinImpostorInstances instances.
+constexpr uint32_t kImpostorGridSize = 8;
+constexpr uint32_t kImpostorTileSize = 128;
+constexpr float kImpostorScreenSize = 96.0f;
+constexpr size_t kMinImpostorInstances = 16;
+constexpr uint32_t kImpostorViewUniformStride = 256;
+
+// Impostor atlas targets: albedo/coverage, normal/depth, occlusion/roughness/metallic, emissive
+constexpr wgpu::TextureFormat kImpostorAtlasFormats[] = {
+    wgpu::TextureFormat::RGBA8UnormSrgb, wgpu::TextureFormat::RGBA16Float,
+    wgpu::TextureFormat::RGBA8Unorm, wgpu::TextureFormat::RGBA8UnormSrgb};
+constexpr wgpu::TextureFormat kImpostorBakeDepthFormat = wgpu::TextureFormat::Depth32Float;
+
+// Octahedral mapping of [-1, 1]^2 to unit directions (+Y at the center). Must match
+// octahedralDecode() in gltf_pbr.wgsl.
+glm::vec3 OctahedralDecode(glm::vec2 e) {
+    glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+    if (n.z < 0.0f) {
+        const float x = (1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+        const float y = (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+        n.x = x;
+        n.y = y;
+    }
+    return glm::normalize(glm::vec3(n.x, n.z, n.y));
+}
+
+wgpu::VertexBufferLayout GetGeometryTransformBufferLayout() {
+    wgpu::VertexBufferLayout layout{};
+    layout.arrayStride = sizeof(glm::mat4);
+    layout.stepMode = wgpu::VertexStepMode::Instance;
+    layout.attributeCount = 4;
+    layout.attributes = kGeometryTransformAttributes;
+    return layout;
+}
+
 int FloorPow2(int x) {
     int power = 1;
     while (power * 2 <= x) {
@@ -51,122 +137,106 @@ int FloorPow2(int x) {
     return power;
 }
 
-template <typename TextureInfo>
-void CreateTexture(const TextureInfo *textureInfo, wgpu::TextureFormat format,
-                   glm::vec4 defaultValue, wgpu::Device device, MipmapGenerator& mipmapGenerator,
-                   MipmapGenerator::MipKind kind, wgpu::Texture& texture) {
-    // Set default pixel value
-    const uint8_t defaultPixel[4] = {static_cast<uint8_t>(defaultValue.r * 255.0f),
-                                     static_cast<uint8_t>(defaultValue.g * 255.0f),
-                                     static_cast<uint8_t>(defaultValue.b * 255.0f),
-                                     static_cast<uint8_t>(defaultValue.a * 255.0f)};
-    const uint8_t *data = defaultPixel;
-    uint32_t width = 1;
-    uint32_t height = 1;
-
-    if (textureInfo) {
-        width = textureInfo->m_width;
-        height = textureInfo->m_height;
-        data = textureInfo->m_data.data();
-    }
-
-    // Compute the number of mip levels
-    uint32_t mipLevelCount =
-        static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
-
-    if (kind == MipmapGenerator::MipKind::SRGB2D) {
-        // Create final SRGB texture directly with render attachment usage
-        wgpu::TextureDescriptor finalDesc{};
-        finalDesc.size = {width, height, 1};
-        finalDesc.format = format; // expected RGBA8UnormSrgb
-        finalDesc.usage = wgpu::TextureUsage::TextureBinding |
-                          wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::CopyDst;
-        finalDesc.mipLevelCount = mipLevelCount;
-        texture = device.CreateTexture(&finalDesc);
-
-        // Upload level 0
-        wgpu::TexelCopyTextureInfo destination{};
-        destination.texture = texture;
-        destination.mipLevel = 0;
-        destination.origin = {0, 0, 0};
-        destination.aspect = wgpu::TextureAspect::All;
+const QualitySettings& GetQualitySettings(Renderer::QualityTier tier) {
+    return kQualitySettings[static_cast<int>(tier)];
+}
 
-        wgpu::TexelCopyBufferLayout source{};
-        source.offset = 0;
-        source.bytesPerRow = 4 * width * sizeof(uint8_t);
-        source.rowsPerImage = height;
+// Estimated size of an RGBA16Float environment texture, including its mip chain
+uint64_t EstimateEnvironmentTextureSize(const wgpu::Texture& texture) {
+    if (!texture) {
+        return 0;
+    }
 
-        const size_t dataSize = static_cast<size_t>(4) * width * height * sizeof(uint8_t);
-        device.GetQueue().WriteTexture(&destination, data, dataSize, &source, &finalDesc.size);
+    uint64_t size = 0;
+    for (uint32_t level = 0; level < texture.GetMipLevelCount(); ++level) {
+        const uint64_t width = std::max(texture.GetWidth() >> level, 1u);
+        const uint64_t height = std::max(texture.GetHeight() >> level, 1u);
+        size += width * height;
+    }
+    return size * texture.GetDepthOrArrayLayers() * 4 * sizeof(uint16_t);
+}
 
-        // Generate mips directly via render path
-        mipmapGenerator.GenerateMipmaps(texture, finalDesc.size, kind);
-    } else {
-        // Create an intermediate texture for compute-based mip generation (UNORM)
-        wgpu::TextureDescriptor textureDescriptor{};
-        textureDescriptor.size = {width, height, 1};
-        textureDescriptor.format = wgpu::TextureFormat::RGBA8Unorm;
-        textureDescriptor.usage = wgpu::TextureUsage::TextureBinding |
-                                  wgpu::TextureUsage::StorageBinding | wgpu::TextureUsage::CopyDst |
-                                  wgpu::TextureUsage::CopySrc;
-        textureDescriptor.mipLevelCount = mipLevelCount;
+// Projects the panorama onto 9 SH coefficients of the irradiance, convolved with the clamped
+// cosine lobe and divided by pi (matching the cosine-weighted irradiance cube)
+void ComputeIrradianceSH(const Environment::Texture& panorama, glm::vec4 (&coefficients)[9]) {
+    for (glm::vec4& coefficient : coefficients) {
+        coefficient = glm::vec4(0.0f);
+    }
+    if ((panorama.m_data.empty() && panorama.m_halfData.empty()) || panorama.m_components < 3) {
+        return;
+    }
 
-        wgpu::Texture intermediateTexture = device.CreateTexture(&textureDescriptor);
+    const uint32_t step = std::max(panorama.m_width / kSphericalHarmonicsSampleWidth, 1u);
+    const float pi = glm::pi<float>();
+    const float width = static_cast<float>(panorama.m_width);
+    const float height = static_cast<float>(panorama.m_height);
+    const float pixelSolidAngle =
+        (2.0f * pi / width) * (pi / height) * static_cast<float>(step * step);
+
+    for (uint32_t y = step / 2; y < panorama.m_height; y += step) {
+        // Inverse of dirToUV() in panorama_to_cubemap.wgsl
+        const float theta = (static_cast<float>(y) + 0.5f) / height * pi;
+        const float sinTheta = std::sin(theta);
+        const float weight = pixelSolidAngle * sinTheta;
+
+        for (uint32_t x = step / 2; x < panorama.m_width; x += step) {
+            const float phi = ((static_cast<float>(x) + 0.5f) / width - 0.5f) * 2.0f * pi;
+            const glm::vec3 n(sinTheta * std::cos(phi), std::cos(theta), sinTheta * std::sin(phi));
+
+            const size_t offset =
+                (static_cast<size_t>(y) * panorama.m_width + x) * panorama.m_components;
+            const glm::vec3 radiance =
+                panorama.m_halfData.empty()
+                    ? glm::vec3(panorama.m_data[offset], panorama.m_data[offset + 1],
+                                panorama.m_data[offset + 2])
+                    : glm::vec3(exr_loader::HalfToFloat(panorama.m_halfData[offset]),
+                                exr_loader::HalfToFloat(panorama.m_halfData[offset + 1]),
+                                exr_loader::HalfToFloat(panorama.m_halfData[offset + 2]));
+
+            const float basis[9] = {0.282095f,
+                                    0.488603f * n.y,
+                                    0.488603f * n.z,
+                                    0.488603f * n.x,
+                                    1.092548f * n.x * n.y,
+                                    1.092548f * n.y * n.z,
+                                    0.315392f * (3.0f * n.z * n.z - 1.0f),
+                                    1.092548f * n.x * n.z,
+                                    0.546274f * (n.x * n.x - n.y * n.y)};
+            for (int i = 0; i < 9; ++i) {
+                coefficients[i] += glm::vec4(radiance * (basis[i] * weight), 0.0f);
+            }
+        }
+    }
 
-        // Upload the texture data to intermediate
-        wgpu::TexelCopyTextureInfo destination{};
-        destination.texture = intermediateTexture;
-        destination.mipLevel = 0;
-        destination.origin = {0, 0, 0};
-        destination.aspect = wgpu::TextureAspect::All;
+    // Cosine lobe convolution per band (A0 = pi, A1 = 2pi/3, A2 = pi/4), divided by pi
+    const float bandScale[9] = {1.0f,  2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f,
+                                0.25f, 0.25f,       0.25f,       0.25f};
+    for (int i = 0; i < 9; ++i) {
+        coefficients[i] *= bandScale[i];
+    }
+}
 
-        wgpu::TexelCopyBufferLayout source{};
-        source.offset = 0;
-        source.bytesPerRow = 4 * width * sizeof(uint8_t);
-        source.rowsPerImage = height;
-
-        const size_t dataSize = static_cast<size_t>(4) * width * height * sizeof(uint8_t);
-        device.GetQueue().WriteTexture(&destination, data, dataSize, &source, &textureDescriptor.size);
-
-        // Generate mipmaps via compute (normal-aware or linear depending on kind)
-        mipmapGenerator.GenerateMipmaps(intermediateTexture, textureDescriptor.size,
-                                        kind == MipmapGenerator::MipKind::Normal2D
-                                            ? MipmapGenerator::MipKind::Normal2D
-                                            : MipmapGenerator::MipKind::LinearUNorm2D);
-
-        // Create the final texture (may be sRGB or UNORM depending on input format)
-        textureDescriptor.format = format;
-        textureDescriptor.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst;
-        wgpu::Texture finalTexture = device.CreateTexture(&textureDescriptor);
-
-        // Copy the intermediate texture to the final texture
-        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
-
-        for (uint32_t level = 0; level < mipLevelCount; ++level) {
-            uint32_t mipWidth = std::max(width >> level, 1u);
-            uint32_t mipHeight = std::max(height >> level, 1u);
-            wgpu::TexelCopyTextureInfo src{};
-            src.texture = intermediateTexture;
-            src.mipLevel = level;
-            src.origin = {0, 0, 0};
-            src.aspect = wgpu::TextureAspect::All;
-            wgpu::TexelCopyTextureInfo dst{};
-            dst.texture = finalTexture;
-            dst.mipLevel = level;
-            dst.origin = {0, 0, 0};
-            dst.aspect = wgpu::TextureAspect::All;
-            wgpu::Extent3D extent = {mipWidth, mipHeight, 1};
-            encoder.CopyTextureToTexture(&src, &dst, &extent);
+// Runs body(i) for every index on up to threadCount threads. Workers take the next index until
+// all are done, which balances items of different cost.
+void ParallelFor(size_t count, uint32_t threadCount, const std::function<void(size_t)>& body) {
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            body(i);
         }
+    };
 
-        wgpu::CommandBuffer commandBuffer = encoder.Finish();
-        device.GetQueue().Submit(1, &commandBuffer);
-
-        texture = finalTexture;
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < std::min<size_t>(threadCount, count); ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
     }
 }
 
-void CreateEnvironmentTexture(wgpu::Device device, wgpu::TextureViewDimension type,
+void CreateEnvironmentTexture(GpuResourcePool& resourcePool, wgpu::TextureViewDimension type,
                               wgpu::Extent3D size, bool mipmapping, wgpu::Texture& texture,
                               wgpu::TextureView& textureView) {
     // Compute the number of mip levels
@@ -182,7 +252,7 @@ void CreateEnvironmentTexture(wgpu::Device device, wgpu::TextureViewDimension ty
                               wgpu::TextureUsage::CopySrc;
     textureDescriptor.mipLevelCount = mipLevelCount;
 
-    texture = device.CreateTexture(&textureDescriptor);
+    texture = resourcePool.AcquireTexture(textureDescriptor);
 
     // Create a texture view covering all mip levels
     wgpu::TextureViewDescriptor viewDescriptor{};
@@ -194,11 +264,90 @@ void CreateEnvironmentTexture(wgpu::Device device, wgpu::TextureViewDimension ty
     textureView = texture.CreateView(&viewDescriptor);
 }
 
+// Contiguous part of the model's index array drawn from one vertex and index buffer pair
+struct GeometryRange {
+    uint32_t m_firstVertex = 0;
+    uint32_t m_vertexCount = 0;
+    uint32_t m_firstIndex = 0;
+    uint32_t m_indexCount = 0;
+};
+
+// Splits the geometry into ranges whose vertex and index data each fit into maxBufferSize. The
+// indices are walked triangle by triangle; a range ends when the vertices its triangles reference
+// no longer fit. Vertices are stored in draw order, so the ranges are close to disjoint.
+std::vector<GeometryRange> SplitGeometry(const std::vector<uint32_t>& indices,
+                                         uint32_t vertexCount, uint64_t maxBufferSize) {
+    const uint64_t maxVertices = maxBufferSize / sizeof(Model::Vertex);
+    const uint64_t maxIndices = maxBufferSize / sizeof(uint32_t) / 3 * 3;
+    const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+    if (vertexCount <= maxVertices && indexCount <= maxIndices) {
+        return {{0, vertexCount, 0, indexCount}};
+    }
+    if (indexCount == 0) {
+        return {{}}; // Nothing is drawn
+    }
+
+    std::vector<GeometryRange> ranges;
+    uint32_t firstIndex = 0;
+    uint32_t minVertex = UINT32_MAX;
+    uint32_t maxVertex = 0;
+    for (uint32_t i = 0; i < indexCount; i += 3) {
+        const uint32_t end = std::min(i + 3, indexCount);
+        const auto [triangleMin, triangleMax] =
+            std::minmax_element(indices.begin() + i, indices.begin() + end);
+        const uint32_t newMin = std::min(minVertex, *triangleMin);
+        const uint32_t newMax = std::max(maxVertex, *triangleMax);
+
+        if (i > firstIndex &&
+            (uint64_t{newMax} - newMin + 1 > maxVertices || end - firstIndex > maxIndices)) {
+            ranges.push_back({minVertex, maxVertex - minVertex + 1, firstIndex, i - firstIndex});
+            firstIndex = i;
+            minVertex = *triangleMin;
+            maxVertex = *triangleMax;
+        } else {
+            minVertex = newMin;
+            maxVertex = newMax;
+        }
+    }
+    if (indexCount > firstIndex) {
+        ranges.push_back(
+            {minVertex, maxVertex - minVertex + 1, firstIndex, indexCount - firstIndex});
+    }
+    return ranges;
+}
+
+// Uploads all mip levels and layers of a CPU generated image to an RGBA16Float texture
+void UploadEnvironmentImage(const wgpu::Device& device,
+                            const CpuEnvironmentPreprocessor::Image& image,
+                            const wgpu::Texture& texture) {
+    std::vector<uint16_t> halfTexels;
+    for (uint32_t level = 0; level < image.m_mipLevels.size(); ++level) {
+        const std::vector<float>& texels = image.m_mipLevels[level];
+        halfTexels.resize(texels.size());
+        std::transform(texels.begin(), texels.end(), halfTexels.begin(), exr_loader::FloatToHalf);
+
+        const uint32_t size = std::max(image.m_size >> level, 1u);
+        wgpu::TexelCopyTextureInfo destination{};
+        destination.texture = texture;
+        destination.mipLevel = level;
+        wgpu::TexelCopyBufferLayout source{};
+        source.bytesPerRow = size * 4 * sizeof(uint16_t);
+        source.rowsPerImage = size;
+        wgpu::Extent3D extent = {size, size, image.m_layerCount};
+        device.GetQueue().WriteTexture(&destination, halfTexels.data(),
+                                       halfTexels.size() * sizeof(uint16_t), &source, &extent);
+    }
+}
+
 } // namespace
 
 //----------------------------------------------------------------------
 // Renderer Class implementation
 
+Renderer::Renderer() = default;
+
+Renderer::~Renderer() = default;
+
 void Renderer::Initialize(GLFWwindow *window, const Environment& environment, const Model& model,
                           uint32_t width, uint32_t height, const std::function<void()>& callback) {
     m_instance = wgpu::CreateInstance();
@@ -241,61 +390,123 @@ void Renderer::Resize(uint32_t width, uint32_t height) {
 
     // Refresh depth attachment view
     m_depthAttachment.view = m_depthTextureView;
+
+    // Recreate the (reduced resolution) texture LOD feedback target
+    m_textureFeedback->Resize(width, height);
+
+    // Recreate the debug view accumulation target (if in use)
+    if (m_debugAccumulationTexture) {
+        CreateDebugAccumulationTexture(width, height);
+    }
 }
 
 void Renderer::Render(const glm::mat4& modelMatrix, const CameraUniformsInput& camera) {
+    using Phase = FrameTimeRecorder::Phase;
+
     // Update view dependent data
     UpdateUniforms(modelMatrix, camera);
-    SortTransparentMeshes(modelMatrix, camera.viewMatrix);
+    SelectImpostors(modelMatrix, camera);
+    {
+        FrameTimeRecorder::ScopedPhase phase(Phase::Sorting);
+        SortTransparentMeshes(modelMatrix, camera.viewMatrix);
+    }
 
     // Ge the current surface texture and update the color attachment view
     wgpu::SurfaceTexture surfaceTexture;
-    m_surface.GetCurrentTexture(&surfaceTexture);
+    {
+        FrameTimeRecorder::ScopedPhase phase(Phase::PresentWait);
+        m_surface.GetCurrentTexture(&surfaceTexture);
+    }
     if (!surfaceTexture.texture) {
         std::cerr << "Error: Failed to get current surface texture." << std::endl;
         return;
     }
     m_colorAttachment.view = surfaceTexture.texture.CreateView();
 
-    // Create command encoder and render pass
-    wgpu::CommandEncoder encoder = m_device.CreateCommandEncoder();
-    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&m_renderPassDescriptor);
+    // Encode and submit the frame
+    {
+        FrameTimeRecorder::ScopedPhase phase(Phase::Encoding);
 
-    // Set global bind group (group 0)
-    pass.SetBindGroup(0, m_globalBindGroup);
+        // Create command encoder
+        wgpu::CommandEncoder encoder = m_device.CreateCommandEncoder();
 
-    // Render environment background first
-    pass.SetPipeline(m_environmentPipeline);
-    pass.Draw(3, 1, 0, 0); // Fullscreen triangle
+        if (m_debugView != DebugView::None) {
+            RenderDebugView(encoder);
+        } else {
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&m_renderPassDescriptor);
+
+            // Set global bind group (group 0)
+            pass.SetBindGroup(0, m_globalBindGroup);
+
+            // Render environment background first
+            pass.SetPipeline(m_environmentPipeline);
+            pass.Draw(3, 1, 0, 0); // Fullscreen triangle
+
+            // Set up the instance buffer; vertex and index buffers are bound per submesh
+            pass.SetVertexBuffer(1, m_geometryTransformBuffer);
+            uint32_t boundGeometry = UINT32_MAX;
+
+            // Draw opaque submeshes (sorted by material, so only bind on material changes)
+            int boundMaterial = -1;
+            pass.SetPipeline(m_modelPipelineOpaque);
+            for (auto subMesh : m_opaqueMeshes) {
+                if (IsDrawnAsImpostor(subMesh.m_instanceIndex)) {
+                    continue;
+                }
+                if (subMesh.m_materialIndex != boundMaterial) {
+                    pass.SetBindGroup(1, m_materials[subMesh.m_materialIndex].m_bindGroup);
+                    boundMaterial = subMesh.m_materialIndex;
+                }
+                DrawSubMesh(pass, subMesh, boundGeometry);
+            }
+
+            // Draw distant instances as impostors (one quad each). Group 1 is unused by the
+            // impostor shaders but part of the pipeline layout, so any material satisfies it.
+            if (!m_impostorInstanceData.empty()) {
+                pass.SetPipeline(m_impostorPipeline);
+                pass.SetBindGroup(1, m_materials[0].m_bindGroup);
+                pass.SetBindGroup(2, m_impostorBindGroup);
+                pass.SetVertexBuffer(0, m_impostorInstanceBuffer);
+                pass.Draw(6, static_cast<uint32_t>(m_impostorInstanceData.size()), 0, 0);
+
+                boundMaterial = 0;
+                boundGeometry = UINT32_MAX;
+            }
 
-    // Set up vertex and index buffers
-    pass.SetVertexBuffer(0, m_vertexBuffer);
-    pass.SetIndexBuffer(m_indexBuffer, wgpu::IndexFormat::Uint32);
+            // Draw transparent submeshes back-to-front
+            pass.SetPipeline(m_modelPipelineTransparent);
+            for (auto depthInfo : m_transparentMeshesDepthSorted) {
+                const SubMesh& subMesh = m_transparentMeshes[depthInfo.m_meshIndex];
+                if (subMesh.m_materialIndex != boundMaterial) {
+                    pass.SetBindGroup(1, m_materials[subMesh.m_materialIndex].m_bindGroup);
+                    boundMaterial = subMesh.m_materialIndex;
+                }
+                DrawSubMesh(pass, subMesh, boundGeometry);
+            }
 
-    // Draw opaque submeshes
-    pass.SetPipeline(m_modelPipelineOpaque);
-    for (auto subMesh : m_opaqueMeshes) {
-        pass.SetBindGroup(1, m_materials[subMesh.m_materialIndex].m_bindGroup);
-        pass.DrawIndexed(subMesh.m_indexCount, 1u, subMesh.m_firstIndex);
-    }
+            // End the pass
+            pass.End();
 
-    // Draw transparent submeshes back-to-front
-    pass.SetPipeline(m_modelPipelineTransparent);
-    for (auto depthInfo : m_transparentMeshesDepthSorted) {
-        const SubMesh& subMesh = m_transparentMeshes[depthInfo.m_meshIndex];
-        pass.SetBindGroup(1, m_materials[subMesh.m_materialIndex].m_bindGroup);
-        pass.DrawIndexed(subMesh.m_indexCount, 1u, subMesh.m_firstIndex);
+            // Record the mip levels the visible textures need (every few frames)
+            if (m_textureFeedback->BeginFrame()) {
+                RenderTextureFeedback(encoder);
+            }
+        }
+
+        // Submit commands
+        wgpu::CommandBuffer commands = encoder.Finish();
+        m_device.GetQueue().Submit(1, &commands);
     }
 
-    // End the pass
-    pass.End();
+    // Resources released before this point can be recycled once the frame has completed
+    m_resourcePool->EndFrame();
 
-    // Submit commands
-    wgpu::CommandBuffer commands = encoder.Finish();
-    m_device.GetQueue().Submit(1, &commands);
+    // Read the texture LOD feedback back without waiting for it
+    m_textureFeedback->EndFrame();
 
     // Present the surface
 #if !defined(__EMSCRIPTEN__)
+    FrameTimeRecorder::ScopedPhase presentWait(Phase::PresentWait);
     m_surface.Present();
     m_instance.ProcessEvents();
 #endif
@@ -306,24 +517,46 @@ void Renderer::ReloadShaders() {
     m_environmentShaderModule = nullptr;
     m_modelPipelineOpaque = nullptr;
     m_modelPipelineTransparent = nullptr;
+    m_textureFeedbackPipeline = nullptr;
     m_modelShaderModule = nullptr;
-
+    m_debugOverdrawPipeline = nullptr;
+    m_debugTriangleDensityPipeline = nullptr;
+    m_debugSurfacePipeline = nullptr;
+    m_debugResolvePipeline = nullptr;
+    m_debugShaderModule = nullptr;
+    m_debugResolveShaderModule = nullptr;
+    m_impostorBakePipeline = nullptr;
+    m_impostorPipeline = nullptr;
+
+    // Reload from disk even when the shaders are also in the mounted archive
+    m_preferShaderFiles = true;
     CreateEnvironmentRenderPipeline();
     CreateModelRenderPipelines();
+    CreateDebugViewPipelines();
 }
 
 void Renderer::UpdateModel(const Model& model) {
+    FrameTimeRecorder::ScopedPhase phase(FrameTimeRecorder::Phase::Uploads);
     auto t0 = std::chrono::high_resolution_clock::now();
 
-    // Destroy the existing model resources
-    m_vertexBuffer = nullptr;
-    m_indexBuffer = nullptr;
+    // Return the existing model resources to the pool
+    for (GeometryBuffer& geometryBuffer : m_geometryBuffers) {
+        m_resourcePool->Release(geometryBuffer.m_vertexBuffer);
+        m_resourcePool->Release(geometryBuffer.m_indexBuffer);
+    }
+    m_geometryBuffers.clear();
+    m_resourcePool->Release(m_geometryTransformBuffer);
+    ReleaseMaterials();
+    ReleaseImpostors();
 
     // Create new model resources
-    CreateVertexBuffer(model);
-    CreateIndexBuffer(model);
+    CreateGeometryBuffers(model);
+    CreateGeometryTransformBuffer(model);
     CreateSubMeshes(model);
     CreateMaterials(model);
+    CreateDebugDrawUniforms();
+    m_textureFeedback->SetMaterialCount(static_cast<uint32_t>(m_materials.size()));
+    CreateImpostors(model);
 
     auto t1 = std::chrono::high_resolution_clock::now();
     double totalMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
@@ -333,29 +566,169 @@ void Renderer::UpdateModel(const Model& model) {
 void Renderer::UpdateEnvironment(const Environment& environment) {
     auto t0 = std::chrono::high_resolution_clock::now();
 
-    // Destroy the existing environment resources
-    m_environmentTexture = nullptr;
-    m_environmentTextureView = nullptr;
-    m_iblIrradianceTexture = nullptr;
-    m_iblIrradianceTextureView = nullptr;
-    m_iblSpecularTexture = nullptr;
-    m_iblSpecularTextureView = nullptr;
-    m_iblBrdfIntegrationLUT = nullptr;
-    m_iblBrdfIntegrationLUTView = nullptr;
+    // Previously prepared environments only need their bind group swapped in. They are matched
+    // by content, so an edited file with the same name is prepared again.
+    const std::string& name = environment.GetTexture().m_name;
+    const uint64_t contentHash = environment.GetTexture().m_contentHash;
+    for (PreparedEnvironment& prepared : m_environmentCache) {
+        if (prepared.m_contentHash == contentHash && prepared.m_qualityTier == m_qualityTier &&
+            prepared.m_cpuPreprocessed == m_cpuEnvironmentPreprocessing) {
+            prepared.m_lastUsed = ++m_environmentUseCounter;
+            m_globalBindGroup = prepared.m_globalBindGroup;
+            std::cout << "Switched to cached environment: " << name << std::endl;
+            return;
+        }
+    }
 
     // Create new environment resources
-    CreateEnvironmentTextures(environment);
-    CreateGlobalBindGroup();
+    FrameTimeRecorder::ScopedPhase phase(FrameTimeRecorder::Phase::Uploads);
+    PreparedEnvironment prepared;
+    prepared.m_name = name;
+    prepared.m_contentHash = contentHash;
+    prepared.m_qualityTier = m_qualityTier;
+    prepared.m_cpuPreprocessed = m_cpuEnvironmentPreprocessing;
+    CreateEnvironmentTextures(environment, prepared);
+    CreateGlobalBindGroup(prepared);
+    prepared.m_lastUsed = ++m_environmentUseCounter;
+
+    m_globalBindGroup = prepared.m_globalBindGroup;
+    m_environmentCache.push_back(std::move(prepared));
+    TrimEnvironmentCache();
 
     auto t1 = std::chrono::high_resolution_clock::now();
     double totalMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
     std::cout << "Updated Environment WebGPU resources in " << totalMs << "ms" << std::endl;
 }
 
+void Renderer::SetDebugView(DebugView debugView) noexcept {
+    m_debugView = debugView;
+}
+
+Renderer::DebugView Renderer::GetDebugView() const noexcept {
+    return m_debugView;
+}
+
+void Renderer::SetQualityTier(QualityTier tier, const Environment& environment) {
+    if (tier == m_qualityTier) {
+        return;
+    }
+    m_qualityTier = tier;
+
+    // Recreate the tier dependent pipelines and IBL maps
+    m_modelPipelineOpaque = nullptr;
+    m_modelPipelineTransparent = nullptr;
+    m_textureFeedbackPipeline = nullptr;
+    m_modelShaderModule = nullptr;
+    m_impostorBakePipeline = nullptr;
+    m_impostorPipeline = nullptr;
+    m_environmentPipeline = nullptr;
+    m_environmentShaderModule = nullptr;
+    CreateModelRenderPipelines();
+    CreateEnvironmentRenderPipeline();
+
+    UpdateEnvironment(environment);
+}
+
+Renderer::QualityTier Renderer::GetQualityTier() const noexcept {
+    return m_qualityTier;
+}
+
+void Renderer::SetCpuEnvironmentPreprocessing(bool enabled, const Environment& environment) {
+    if (enabled == m_cpuEnvironmentPreprocessing) {
+        return;
+    }
+    m_cpuEnvironmentPreprocessing = enabled;
+    UpdateEnvironment(environment);
+}
+
+bool Renderer::GetCpuEnvironmentPreprocessing() const noexcept {
+    return m_cpuEnvironmentPreprocessing;
+}
+
+void Renderer::SetImpostorsEnabled(bool enabled) noexcept {
+    m_impostorsEnabled = enabled;
+}
+
+bool Renderer::GetImpostorsEnabled() const noexcept {
+    return m_impostorsEnabled;
+}
+
+Renderer::TextureResidency Renderer::GetTextureResidency(uint64_t budgetBytes) const {
+    // Material textures can be shared between materials, so merge their feedback: a texture
+    // needs the finest mip level any of its uses needs
+    std::vector<wgpu::Texture> textures;
+    std::vector<TextureFeedback::TextureRequest> requests;
+    for (size_t i = 0; i < m_materials.size(); ++i) {
+        const Material& material = m_materials[i];
+        const wgpu::Texture *slots[TextureFeedback::kTextureSlotCount] = {
+            &material.m_baseColorTexture, &material.m_metallicRoughnessTexture,
+            &material.m_normalTexture, &material.m_occlusionTexture, &material.m_emissiveTexture};
+
+        for (uint32_t slot = 0; slot < TextureFeedback::kTextureSlotCount; ++slot) {
+            if ((material.m_uniforms.textureMask & (1u << slot)) == 0) {
+                continue; // Default texture
+            }
+            const wgpu::Texture& texture = *slots[slot];
+            auto it = std::find_if(textures.begin(), textures.end(), [&](const wgpu::Texture& t) {
+                return t.Get() == texture.Get();
+            });
+            if (it == textures.end()) {
+                TextureFeedback::TextureRequest request;
+                request.m_width = texture.GetWidth();
+                request.m_height = texture.GetHeight();
+                request.m_mipLevelCount = texture.GetMipLevelCount();
+                textures.push_back(texture);
+                requests.push_back(request);
+                it = textures.end() - 1;
+            }
+
+            uint32_t& requiredMipLevel = requests[it - textures.begin()].m_requiredMipLevel;
+            requiredMipLevel = std::min(requiredMipLevel, m_textureFeedback->GetRequiredMipLevel(
+                                                              static_cast<uint32_t>(i), slot));
+        }
+    }
+
+    TextureResidency residency;
+    residency.m_textureCount = requests.size();
+    residency.m_readbackCount = m_textureFeedback->GetReadbackCount();
+
+    const std::vector<uint32_t> plan = TextureFeedback::PlanResidency(requests, budgetBytes);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const TextureFeedback::TextureRequest& request = requests[i];
+        if (request.m_requiredMipLevel != TextureFeedback::kNotSampled) {
+            ++residency.m_sampledCount;
+            residency.m_requiredBytes +=
+                TextureFeedback::GetResidentBytes(request, request.m_requiredMipLevel);
+        }
+        residency.m_allMipsBytes += TextureFeedback::GetResidentBytes(request, 0);
+        residency.m_plannedBytes += TextureFeedback::GetResidentBytes(request, plan[i]);
+    }
+    return residency;
+}
+
+Renderer::ResourceStats Renderer::GetResourceStats() const {
+    const GpuResourcePool::Stats poolStats = m_resourcePool->GetStats();
+
+    ResourceStats stats;
+    stats.m_liveBytes = poolStats.m_liveBytes;
+    stats.m_pooledBytes = poolStats.m_pooledBytes;
+    stats.m_liveTextures = poolStats.m_liveTextures;
+    stats.m_liveBuffers = poolStats.m_liveBuffers;
+    stats.m_pooledTextures = poolStats.m_pooledTextures;
+    stats.m_pooledBuffers = poolStats.m_pooledBuffers;
+    stats.m_materialCount = m_materials.size();
+    stats.m_environmentCount = m_environmentCache.size();
+    return stats;
+}
+
 void Renderer::InitGraphics(const Environment& environment, const Model& model, uint32_t width,
                             uint32_t height) {
+    m_resourcePool = std::make_unique<GpuResourcePool>(m_device);
+    m_textureFeedback = std::make_unique<TextureFeedback>(m_device);
+
     ConfigureSurface(width, height);
     CreateDepthTexture(width, height);
+    m_textureFeedback->Resize(width, height);
 
     CreateBindGroupLayouts();
 
@@ -367,6 +740,7 @@ void Renderer::InitGraphics(const Environment& environment, const Model& model,
 
     CreateModelRenderPipelines();
     CreateEnvironmentRenderPipeline();
+    CreateDebugViewPipelines();
 
     CreateUniformBuffers();
 
@@ -485,7 +859,7 @@ void Renderer::CreateDepthTexture(uint32_t width, uint32_t height) {
 }
 
 void Renderer::CreateBindGroupLayouts() {
-    wgpu::BindGroupLayoutEntry globalLayoutEntries[7]{};
+    wgpu::BindGroupLayoutEntry globalLayoutEntries[10]{};
 
     // 0: Global uniforms
     globalLayoutEntries[0].binding = 0;
@@ -532,8 +906,23 @@ void Renderer::CreateBindGroupLayouts() {
     globalLayoutEntries[6].visibility = wgpu::ShaderStage::Fragment;
     globalLayoutEntries[6].sampler.type = wgpu::SamplerBindingType::Filtering;
 
+    // 7: IBL irradiance SH coefficients binding
+    globalLayoutEntries[7].binding = 7;
+    globalLayoutEntries[7].visibility = wgpu::ShaderStage::Fragment;
+    globalLayoutEntries[7].buffer.type = wgpu::BufferBindingType::Uniform;
+    globalLayoutEntries[7].buffer.minBindingSize = sizeof(glm::vec4) * 9;
+
+    // 8, 9: Octahedral environment and IBL specular textures (filtered in the shaders)
+    for (uint32_t binding = 8; binding < 10; ++binding) {
+        globalLayoutEntries[binding].binding = binding;
+        globalLayoutEntries[binding].visibility = wgpu::ShaderStage::Fragment;
+        globalLayoutEntries[binding].texture.sampleType = wgpu::TextureSampleType::Float;
+        globalLayoutEntries[binding].texture.viewDimension = wgpu::TextureViewDimension::e2D;
+        globalLayoutEntries[binding].texture.multisampled = false;
+    }
+
     wgpu::BindGroupLayoutDescriptor globalBindGroupLayoutDescriptor{};
-    globalBindGroupLayoutDescriptor.entryCount = 7;
+    globalBindGroupLayoutDescriptor.entryCount = 10;
     globalBindGroupLayoutDescriptor.entries = globalLayoutEntries;
 
     m_globalBindGroupLayout = m_device.CreateBindGroupLayout(&globalBindGroupLayoutDescriptor);
@@ -574,6 +963,79 @@ void Renderer::CreateBindGroupLayouts() {
     modelBindGroupLayoutDescriptor.entries = modelLayoutEntries;
 
     m_modelBindGroupLayout = m_device.CreateBindGroupLayout(&modelBindGroupLayoutDescriptor);
+
+    // Debug views: per-draw IDs (dynamic offset) and view settings
+    wgpu::BindGroupLayoutEntry debugDrawLayoutEntries[2]{};
+    debugDrawLayoutEntries[0].binding = 0;
+    debugDrawLayoutEntries[0].visibility = wgpu::ShaderStage::Fragment;
+    debugDrawLayoutEntries[0].buffer.type = wgpu::BufferBindingType::Uniform;
+    debugDrawLayoutEntries[0].buffer.hasDynamicOffset = true;
+    debugDrawLayoutEntries[0].buffer.minBindingSize = sizeof(DebugDrawUniforms);
+
+    debugDrawLayoutEntries[1].binding = 1;
+    debugDrawLayoutEntries[1].visibility = wgpu::ShaderStage::Fragment;
+    debugDrawLayoutEntries[1].buffer.type = wgpu::BufferBindingType::Uniform;
+    debugDrawLayoutEntries[1].buffer.minBindingSize = sizeof(DebugViewUniforms);
+
+    wgpu::BindGroupLayoutDescriptor debugDrawBindGroupLayoutDescriptor{};
+    debugDrawBindGroupLayoutDescriptor.entryCount = 2;
+    debugDrawBindGroupLayoutDescriptor.entries = debugDrawLayoutEntries;
+
+    m_debugDrawBindGroupLayout =
+        m_device.CreateBindGroupLayout(&debugDrawBindGroupLayoutDescriptor);
+
+    // Debug views: accumulation texture and view settings for the resolve pass
+    wgpu::BindGroupLayoutEntry debugResolveLayoutEntries[2]{};
+    debugResolveLayoutEntries[0].binding = 0;
+    debugResolveLayoutEntries[0].visibility = wgpu::ShaderStage::Fragment;
+    debugResolveLayoutEntries[0].texture.sampleType = wgpu::TextureSampleType::UnfilterableFloat;
+    debugResolveLayoutEntries[0].texture.viewDimension = wgpu::TextureViewDimension::e2D;
+
+    debugResolveLayoutEntries[1].binding = 1;
+    debugResolveLayoutEntries[1].visibility = wgpu::ShaderStage::Fragment;
+    debugResolveLayoutEntries[1].buffer.type = wgpu::BufferBindingType::Uniform;
+    debugResolveLayoutEntries[1].buffer.minBindingSize = sizeof(DebugViewUniforms);
+
+    wgpu::BindGroupLayoutDescriptor debugResolveBindGroupLayoutDescriptor{};
+    debugResolveBindGroupLayoutDescriptor.entryCount = 2;
+    debugResolveBindGroupLayoutDescriptor.entries = debugResolveLayoutEntries;
+
+    m_debugResolveBindGroupLayout =
+        m_device.CreateBindGroupLayout(&debugResolveBindGroupLayoutDescriptor);
+
+    // Impostor baking: per-view camera (dynamic offset)
+    wgpu::BindGroupLayoutEntry impostorBakeLayoutEntry{};
+    impostorBakeLayoutEntry.binding = 0;
+    impostorBakeLayoutEntry.visibility = wgpu::ShaderStage::Vertex;
+    impostorBakeLayoutEntry.buffer.type = wgpu::BufferBindingType::Uniform;
+    impostorBakeLayoutEntry.buffer.hasDynamicOffset = true;
+    impostorBakeLayoutEntry.buffer.minBindingSize = sizeof(ImpostorViewUniforms);
+
+    wgpu::BindGroupLayoutDescriptor impostorBakeBindGroupLayoutDescriptor{};
+    impostorBakeBindGroupLayoutDescriptor.entryCount = 1;
+    impostorBakeBindGroupLayoutDescriptor.entries = &impostorBakeLayoutEntry;
+
+    m_impostorBakeBindGroupLayout =
+        m_device.CreateBindGroupLayout(&impostorBakeBindGroupLayoutDescriptor);
+
+    // Impostor rendering: atlas sampler and textures
+    wgpu::BindGroupLayoutEntry impostorLayoutEntries[5]{};
+    impostorLayoutEntries[0].binding = 1;
+    impostorLayoutEntries[0].visibility = wgpu::ShaderStage::Fragment;
+    impostorLayoutEntries[0].sampler.type = wgpu::SamplerBindingType::Filtering;
+
+    for (uint32_t t = 0; t < 4; ++t) {
+        impostorLayoutEntries[1 + t].binding = 2 + t;
+        impostorLayoutEntries[1 + t].visibility = wgpu::ShaderStage::Fragment;
+        impostorLayoutEntries[1 + t].texture.sampleType = wgpu::TextureSampleType::Float;
+        impostorLayoutEntries[1 + t].texture.viewDimension = wgpu::TextureViewDimension::e2D;
+    }
+
+    wgpu::BindGroupLayoutDescriptor impostorBindGroupLayoutDescriptor{};
+    impostorBindGroupLayoutDescriptor.entryCount = 5;
+    impostorBindGroupLayoutDescriptor.entries = impostorLayoutEntries;
+
+    m_impostorBindGroupLayout = m_device.CreateBindGroupLayout(&impostorBindGroupLayoutDescriptor);
 }
 
 void Renderer::CreateSamplers() {
@@ -612,6 +1074,18 @@ void Renderer::CreateSamplers() {
         samplerDescriptor.mipmapFilter = wgpu::MipmapFilterMode::Nearest;
         m_iblBrdfIntegrationLUTSampler = m_device.CreateSampler(&samplerDescriptor);
     }
+
+    // Impostor atlas sampler (single level; views are kept apart by clamping in the shader)
+    if (!m_impostorSampler) {
+        wgpu::SamplerDescriptor samplerDescriptor{};
+        samplerDescriptor.addressModeU = wgpu::AddressMode::ClampToEdge;
+        samplerDescriptor.addressModeV = wgpu::AddressMode::ClampToEdge;
+        samplerDescriptor.addressModeW = wgpu::AddressMode::ClampToEdge;
+        samplerDescriptor.minFilter = wgpu::FilterMode::Linear;
+        samplerDescriptor.magFilter = wgpu::FilterMode::Linear;
+        samplerDescriptor.mipmapFilter = wgpu::MipmapFilterMode::Nearest;
+        m_impostorSampler = m_device.CreateSampler(&samplerDescriptor);
+    }
 }
 
 void Renderer::CreateRenderPassDescriptor() {
@@ -634,32 +1108,88 @@ void Renderer::CreateRenderPassDescriptor() {
     m_renderPassDescriptor.depthStencilAttachment = &m_depthAttachment;
 }
 
-void Renderer::CreateVertexBuffer(const Model& model) {
+void Renderer::CreateGeometryBuffers(const Model& model) {
     const std::vector<Model::Vertex>& vertexData = model.GetVertices();
+    const std::vector<uint32_t>& indexData = model.GetIndices();
+    const std::vector<Model::RawPrimitive>& rawPrimitives = model.GetRawVertexData().m_primitives;
+
+    // Large scans exceed maxBufferSize even with the adapter's limits, so their geometry is
+    // spread over several buffer pairs
+    wgpu::Limits limits{};
+    m_device.GetLimits(&limits);
+    const std::vector<GeometryRange> ranges = SplitGeometry(
+        indexData, static_cast<uint32_t>(vertexData.size()), limits.maxBufferSize);
+    if (ranges.size() > 1) {
+        std::cout << "Split geometry into " << ranges.size() << " vertex and index buffers"
+                  << std::endl;
+    }
+
+    std::vector<MeshProcessor::VertexRange> vertexRanges;
+    for (const GeometryRange& range : ranges) {
+        GeometryBuffer& geometryBuffer = m_geometryBuffers.emplace_back();
+        geometryBuffer.m_firstVertex = range.m_firstVertex;
+        geometryBuffer.m_firstIndex = range.m_firstIndex;
+        geometryBuffer.m_indexCount = range.m_indexCount;
+
+        wgpu::BufferDescriptor vertexBufferDesc{};
+        vertexBufferDesc.size = uint64_t{range.m_vertexCount} * sizeof(Model::Vertex);
+        vertexBufferDesc.usage = wgpu::BufferUsage::Vertex | wgpu::BufferUsage::CopyDst;
+        if (!rawPrimitives.empty()) {
+            vertexBufferDesc.usage |= wgpu::BufferUsage::Storage;
+        }
 
-    wgpu::BufferDescriptor vertexBufferDesc{};
-    vertexBufferDesc.size = vertexData.size() * sizeof(Model::Vertex);
-    vertexBufferDesc.usage = wgpu::BufferUsage::Vertex | wgpu::BufferUsage::CopyDst;
-    vertexBufferDesc.mappedAtCreation = true;
+        // Pooled buffers may be larger than requested and are filled through the queue
+        geometryBuffer.m_vertexBuffer = m_resourcePool->AcquireBuffer(vertexBufferDesc);
+        vertexRanges.push_back(
+            {geometryBuffer.m_vertexBuffer, range.m_firstVertex, range.m_vertexCount});
+
+        // Upload the vertices processed on the CPU; the ranges of the raw primitives (in vertex
+        // order) are written by the mesh processor
+        const size_t rangeEnd = size_t{range.m_firstVertex} + range.m_vertexCount;
+        auto writeVertices = [&](size_t first, size_t end) {
+            first = std::max<size_t>(first, range.m_firstVertex);
+            end = std::min(end, rangeEnd);
+            if (first < end) {
+                m_device.GetQueue().WriteBuffer(
+                    geometryBuffer.m_vertexBuffer,
+                    (first - range.m_firstVertex) * sizeof(Model::Vertex),
+                    vertexData.data() + first, (end - first) * sizeof(Model::Vertex));
+            }
+        };
 
-    m_vertexBuffer = m_device.CreateBuffer(&vertexBufferDesc);
-    std::memcpy(m_vertexBuffer.GetMappedRange(), vertexData.data(),
-                vertexData.size() * sizeof(Model::Vertex));
-    m_vertexBuffer.Unmap();
+        size_t cursor = 0;
+        for (const Model::RawPrimitive& primitive : rawPrimitives) {
+            writeVertices(cursor, primitive.m_firstVertex);
+            cursor = primitive.m_firstVertex + primitive.m_vertexCount;
+        }
+        writeVertices(cursor, vertexData.size());
+
+        wgpu::BufferDescriptor indexBufferDesc{};
+        indexBufferDesc.size = uint64_t{range.m_indexCount} * sizeof(uint32_t);
+        indexBufferDesc.usage = wgpu::BufferUsage::Index | wgpu::BufferUsage::CopyDst;
+
+        geometryBuffer.m_indexBuffer = m_resourcePool->AcquireBuffer(indexBufferDesc);
+        m_device.GetQueue().WriteBuffer(geometryBuffer.m_indexBuffer, 0,
+                                        indexData.data() + range.m_firstIndex,
+                                        indexBufferDesc.size);
+    }
+
+    if (!rawPrimitives.empty()) {
+        MeshProcessor meshProcessor(m_device);
+        meshProcessor.ProcessVertices(model, vertexRanges);
+    }
 }
 
-void Renderer::CreateIndexBuffer(const Model& model) {
-    const std::vector<uint32_t>& indexData = model.GetIndices();
+void Renderer::CreateGeometryTransformBuffer(const Model& model) {
+    const std::vector<glm::mat4>& transforms = model.GetGeometryTransforms();
 
-    wgpu::BufferDescriptor indexBufferDesc{};
-    indexBufferDesc.size = indexData.size() * sizeof(uint32_t);
-    indexBufferDesc.usage = wgpu::BufferUsage::Index | wgpu::BufferUsage::CopyDst;
-    indexBufferDesc.mappedAtCreation = true;
+    wgpu::BufferDescriptor bufferDesc{};
+    bufferDesc.size = transforms.size() * sizeof(glm::mat4);
+    bufferDesc.usage = wgpu::BufferUsage::Vertex | wgpu::BufferUsage::CopyDst;
 
-    m_indexBuffer = m_device.CreateBuffer(&indexBufferDesc);
-    std::memcpy(m_indexBuffer.GetMappedRange(), indexData.data(),
-                indexData.size() * sizeof(uint32_t));
-    m_indexBuffer.Unmap();
+    m_geometryTransformBuffer = m_resourcePool->AcquireBuffer(bufferDesc);
+    m_device.GetQueue().WriteBuffer(m_geometryTransformBuffer, 0, transforms.data(),
+                                    bufferDesc.size);
 }
 
 void Renderer::CreateUniformBuffers() {
@@ -690,44 +1220,197 @@ void Renderer::CreateUniformBuffers() {
     modelUniforms.normalMatrix = glm::mat4(1.0f); // Initialize as identity
 
     m_device.GetQueue().WriteBuffer(m_modelUniformBuffer, 0, &modelUniforms, sizeof(ModelUniforms));
+
+    // Create the debug view uniform buffer (written when rendering a debug view)
+    bufferDescriptor.size = sizeof(DebugViewUniforms);
+    m_debugViewUniformBuffer = m_device.CreateBuffer(&bufferDescriptor);
 }
 
-void Renderer::CreateEnvironmentTextures(const Environment& environment) {
+void Renderer::CreateEnvironmentTextures(const Environment& environment,
+                                         PreparedEnvironment& prepared) {
+    const QualitySettings& quality = GetQualitySettings(m_qualityTier);
     const Environment::Texture& panoramaTexture = environment.GetTexture();
-    uint32_t environmentCubeSize = FloorPow2(panoramaTexture.m_width);
+    const uint32_t environmentCubeSize = std::min<uint32_t>(
+        FloorPow2(static_cast<int>(panoramaTexture.m_width)), quality.m_maxEnvironmentCubeSize);
+    const uint32_t irradianceMapSize = quality.m_irradianceMapSize;
+    const uint32_t specularMapSize = quality.m_specularMapSize;
 
     // Create helpers
     MipmapGenerator mipmapGenerator(m_device);
     PanoramaToCubemapConverter panoramaToCubemapConverter(m_device);
     EnvironmentPreprocessor environmentPreprocessor(m_device);
 
-    // Create IBL textures
-    CreateEnvironmentTexture(m_device, wgpu::TextureViewDimension::Cube,
-                             {environmentCubeSize, environmentCubeSize, 6}, true,
-                             m_environmentTexture, m_environmentTextureView);
-    CreateEnvironmentTexture(m_device, wgpu::TextureViewDimension::Cube,
-                             {kIrradianceMapSize, kIrradianceMapSize, 6}, true,
-                             m_iblIrradianceTexture, m_iblIrradianceTextureView);
-    CreateEnvironmentTexture(m_device, wgpu::TextureViewDimension::Cube,
-                             {kPrecomputedSpecularMapSize, kPrecomputedSpecularMapSize, 6}, true,
-                             m_iblSpecularTexture, m_iblSpecularTextureView);
-    CreateEnvironmentTexture(m_device, wgpu::TextureViewDimension::e2D,
+    // Create IBL textures. The octahedral tiers replace the background and specular cubes with
+    // 2D maps, and the environment cube is only kept until the IBL maps have been prefiltered
+    // (the CPU backend prefilters its own copy, so there is no cube at all).
+    if (!quality.m_useOctahedralEnvironment || !m_cpuEnvironmentPreprocessing) {
+        CreateEnvironmentTexture(*m_resourcePool, wgpu::TextureViewDimension::Cube,
+                                 {environmentCubeSize, environmentCubeSize, 6}, true,
+                                 prepared.m_environmentTexture, prepared.m_environmentTextureView);
+    }
+    CreateEnvironmentTexture(*m_resourcePool, wgpu::TextureViewDimension::Cube,
+                             {irradianceMapSize, irradianceMapSize, 6}, true,
+                             prepared.m_iblIrradianceTexture, prepared.m_iblIrradianceTextureView);
+    wgpu::Texture *specularTexture = &prepared.m_iblSpecularTexture;
+    if (quality.m_useOctahedralEnvironment) {
+        const uint32_t environmentMapSize = environmentCubeSize * kOctahedralSizeScale;
+        const uint32_t specularOctahedralSize = specularMapSize * kOctahedralSizeScale;
+        CreateEnvironmentTexture(*m_resourcePool, wgpu::TextureViewDimension::e2D,
+                                 {environmentMapSize, environmentMapSize, 1}, true,
+                                 prepared.m_environmentOctahedralTexture,
+                                 prepared.m_environmentOctahedralTextureView);
+        CreateEnvironmentTexture(*m_resourcePool, wgpu::TextureViewDimension::e2D,
+                                 {specularOctahedralSize, specularOctahedralSize, 1}, true,
+                                 prepared.m_iblSpecularOctahedralTexture,
+                                 prepared.m_iblSpecularOctahedralTextureView);
+        specularTexture = &prepared.m_iblSpecularOctahedralTexture;
+    } else {
+        CreateEnvironmentTexture(*m_resourcePool, wgpu::TextureViewDimension::Cube,
+                                 {specularMapSize, specularMapSize, 6}, true,
+                                 prepared.m_iblSpecularTexture, prepared.m_iblSpecularTextureView);
+    }
+    CreateEnvironmentTexture(*m_resourcePool, wgpu::TextureViewDimension::e2D,
                              {kBRDFIntegrationLUTMapSize, kBRDFIntegrationLUTMapSize, 1}, false,
-                             m_iblBrdfIntegrationLUT, m_iblBrdfIntegrationLUTView);
+                             prepared.m_iblBrdfIntegrationLUT,
+                             prepared.m_iblBrdfIntegrationLUTView);
 
-    // Upload panorama texture and resample to cubemap
-    panoramaToCubemapConverter.UploadAndConvert(panoramaTexture, m_environmentTexture);
-    mipmapGenerator.GenerateMipmaps(m_environmentTexture,
-                                    {environmentCubeSize, environmentCubeSize, 6},
-                                    MipmapGenerator::MipKind::Float16Cube);
+    if (m_cpuEnvironmentPreprocessing) {
+        GenerateEnvironmentMapsOnCpu(environment, prepared, *specularTexture,
+                                     environmentCubeSize);
+    } else {
+        // Upload panorama texture and resample to cubemap
+        panoramaToCubemapConverter.UploadAndConvert(panoramaTexture,
+                                                    prepared.m_environmentTexture);
+        mipmapGenerator.GenerateMipmaps(prepared.m_environmentTexture,
+                                        {environmentCubeSize, environmentCubeSize, 6},
+                                        MipmapGenerator::MipKind::Float16Cube);
+
+        // Precompute IBL maps
+        environmentPreprocessor.GenerateMaps(
+            prepared.m_environmentTexture, prepared.m_iblIrradianceTexture, *specularTexture,
+            prepared.m_iblBrdfIntegrationLUT, quality.m_sampleCount);
+    }
 
-    // Precompute IBL maps
-    environmentPreprocessor.GenerateMaps(m_environmentTexture, m_iblIrradianceTexture,
-                                         m_iblSpecularTexture, m_iblBrdfIntegrationLUT);
+    // The octahedral background map is only displayed, so it is converted on the GPU either way
+    if (prepared.m_environmentOctahedralTexture) {
+        const uint32_t size = prepared.m_environmentOctahedralTexture.GetWidth();
+        panoramaToCubemapConverter.UploadAndConvert(panoramaTexture,
+                                                    prepared.m_environmentOctahedralTexture);
+        mipmapGenerator.GenerateMipmaps(prepared.m_environmentOctahedralTexture, {size, size, 1},
+                                        MipmapGenerator::MipKind::Float16Octahedral);
+    }
+
+    // The source cube is only read by the work submitted above
+    if (quality.m_useOctahedralEnvironment && prepared.m_environmentTexture) {
+        m_resourcePool->Release(prepared.m_environmentTexture,
+                                GpuResourcePool::ReleaseMode::QueueOrdered);
+        prepared.m_environmentTextureView = nullptr;
+    }
 
-    mipmapGenerator.GenerateMipmaps(m_iblIrradianceTexture,
-                                    {kIrradianceMapSize, kIrradianceMapSize, 6},
-                                    MipmapGenerator::MipKind::Float16Cube);
+    if (!m_cpuEnvironmentPreprocessing) {
+        mipmapGenerator.GenerateMipmaps(prepared.m_iblIrradianceTexture,
+                                        {irradianceMapSize, irradianceMapSize, 6},
+                                        MipmapGenerator::MipKind::Float16Cube);
+    }
+
+    // Project the panorama onto spherical harmonics for the diffuse IBL of the lower tiers
+    glm::vec4 shCoefficients[9] = {};
+    if (quality.m_useSphericalHarmonics) {
+        ComputeIrradianceSH(panoramaTexture, shCoefficients);
+    }
+    wgpu::BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = sizeof(shCoefficients);
+    bufferDescriptor.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+    prepared.m_iblIrradianceSHBuffer = m_resourcePool->AcquireBuffer(bufferDescriptor);
+    m_device.GetQueue().WriteBuffer(prepared.m_iblIrradianceSHBuffer, 0, shCoefficients,
+                                    sizeof(shCoefficients));
+
+    prepared.m_sizeInBytes =
+        EstimateEnvironmentTextureSize(prepared.m_environmentTexture) +
+        EstimateEnvironmentTextureSize(prepared.m_iblIrradianceTexture) +
+        EstimateEnvironmentTextureSize(prepared.m_iblSpecularTexture) +
+        EstimateEnvironmentTextureSize(prepared.m_iblBrdfIntegrationLUT) +
+        EstimateEnvironmentTextureSize(prepared.m_environmentOctahedralTexture) +
+        EstimateEnvironmentTextureSize(prepared.m_iblSpecularOctahedralTexture);
+}
+
+void Renderer::GenerateEnvironmentMapsOnCpu(const Environment& environment,
+                                            PreparedEnvironment& prepared,
+                                            const wgpu::Texture& specularTexture,
+                                            uint32_t environmentCubeSize) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    const QualitySettings& quality = GetQualitySettings(m_qualityTier);
+    CpuEnvironmentPreprocessor preprocessor;
+
+    // Same sizes and mip chains as the textures created for the GPU path
+    CpuEnvironmentPreprocessor::Image environmentCube =
+        CpuEnvironmentPreprocessor::CreateImage(environmentCubeSize, 6, true);
+    CpuEnvironmentPreprocessor::Image irradiance = CpuEnvironmentPreprocessor::CreateImage(
+        prepared.m_iblIrradianceTexture.GetWidth(), 6, true);
+    CpuEnvironmentPreprocessor::Image specular = CpuEnvironmentPreprocessor::CreateImage(
+        specularTexture.GetWidth(), specularTexture.GetDepthOrArrayLayers(), true);
+    CpuEnvironmentPreprocessor::Image brdfIntegrationLUT =
+        CpuEnvironmentPreprocessor::CreateImage(kBRDFIntegrationLUTMapSize, 1, false);
+
+    preprocessor.ConvertPanorama(environment.GetTexture(), environmentCube);
+    preprocessor.GenerateMipmaps(environmentCube);
+    preprocessor.GenerateMaps(environmentCube, irradiance, specular, brdfIntegrationLUT,
+                              quality.m_sampleCount);
+    preprocessor.GenerateMipmaps(irradiance);
+
+    // The octahedral tiers do not create an environment cube for the CPU backend
+    if (prepared.m_environmentTexture) {
+        UploadEnvironmentImage(m_device, environmentCube, prepared.m_environmentTexture);
+    }
+    UploadEnvironmentImage(m_device, irradiance, prepared.m_iblIrradianceTexture);
+    UploadEnvironmentImage(m_device, specular, specularTexture);
+    UploadEnvironmentImage(m_device, brdfIntegrationLUT, prepared.m_iblBrdfIntegrationLUT);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double totalMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    std::cout << "Generated IBL maps on the CPU (" << preprocessor.GetThreadCount()
+              << " threads) in " << totalMs << "ms" << std::endl;
+}
+
+void Renderer::ReleaseEnvironment(PreparedEnvironment& prepared) {
+    m_resourcePool->Release(prepared.m_environmentTexture);
+    m_resourcePool->Release(prepared.m_iblIrradianceTexture);
+    m_resourcePool->Release(prepared.m_iblSpecularTexture);
+    m_resourcePool->Release(prepared.m_iblBrdfIntegrationLUT);
+    m_resourcePool->Release(prepared.m_environmentOctahedralTexture);
+    m_resourcePool->Release(prepared.m_iblSpecularOctahedralTexture);
+    m_resourcePool->Release(prepared.m_iblIrradianceSHBuffer);
+    prepared.m_environmentTextureView = nullptr;
+    prepared.m_iblIrradianceTextureView = nullptr;
+    prepared.m_iblSpecularTextureView = nullptr;
+    prepared.m_iblBrdfIntegrationLUTView = nullptr;
+    prepared.m_environmentOctahedralTextureView = nullptr;
+    prepared.m_iblSpecularOctahedralTextureView = nullptr;
+    prepared.m_globalBindGroup = nullptr;
+}
+
+void Renderer::TrimEnvironmentCache() {
+    // Evict least recently used environments until the cache fits the budget. The active
+    // (most recently used) environment is always kept.
+    while (m_environmentCache.size() > 1) {
+        uint64_t totalSize = 0;
+        for (const PreparedEnvironment& prepared : m_environmentCache) {
+            totalSize += prepared.m_sizeInBytes;
+        }
+        if (totalSize <= kEnvironmentCacheBudget &&
+            m_environmentCache.size() <= kMaxCachedEnvironments) {
+            break;
+        }
+
+        auto oldest = std::min_element(m_environmentCache.begin(), m_environmentCache.end(),
+                                       [](const PreparedEnvironment& a,
+                                          const PreparedEnvironment& b) {
+                                           return a.m_lastUsed < b.m_lastUsed;
+                                       });
+        std::cout << "Evicting cached environment: " << oldest->m_name << std::endl;
+        ReleaseEnvironment(*oldest);
+        m_environmentCache.erase(oldest);
+    }
 }
 
 void Renderer::CreateSubMeshes(const Model& model) {
@@ -735,146 +1418,266 @@ void Renderer::CreateSubMeshes(const Model& model) {
     m_transparentMeshes.clear();
     m_opaqueMeshes.reserve(model.GetSubMeshes().size());
 
-    for (auto srcSubMesh : model.GetSubMeshes()) {
-        SubMesh dstSubMesh = {.m_firstIndex = srcSubMesh.m_firstIndex,
-                              .m_indexCount = srcSubMesh.m_indexCount,
-                              .m_materialIndex = srcSubMesh.m_materialIndex,
-                              .m_centroid =
-                                  (srcSubMesh.m_minBounds + srcSubMesh.m_maxBounds) * 0.5f};
-        if (model.GetMaterials()[srcSubMesh.m_materialIndex].m_alphaMode ==
-            Model::AlphaMode::Blend) {
-            m_transparentMeshes.push_back(dstSubMesh);
-        } else {
-            m_opaqueMeshes.push_back(dstSubMesh);
+    // Instance of every submesh (replicated models only)
+    std::vector<int> instanceIndices(model.GetSubMeshes().size(), -1);
+    for (size_t i = 0; i < model.GetInstances().size(); ++i) {
+        const Model::Instance& instance = model.GetInstances()[i];
+        std::fill_n(instanceIndices.begin() + instance.m_firstSubMesh, instance.m_subMeshCount,
+                    static_cast<int>(i));
+    }
+
+    for (size_t i = 0; i < model.GetSubMeshes().size(); ++i) {
+        const Model::SubMesh& srcSubMesh = model.GetSubMeshes()[i];
+        std::vector<SubMesh>& dstSubMeshes =
+            model.GetMaterials()[srcSubMesh.m_materialIndex].m_alphaMode ==
+                    Model::AlphaMode::Blend
+                ? m_transparentMeshes
+                : m_opaqueMeshes;
+
+        // One draw per geometry buffer the submesh's indices fall into (usually just one)
+        const uint32_t srcEnd = srcSubMesh.m_firstIndex + srcSubMesh.m_indexCount;
+        auto geometry = std::upper_bound(m_geometryBuffers.begin(), m_geometryBuffers.end(),
+                                         srcSubMesh.m_firstIndex,
+                                         [](uint32_t index, const GeometryBuffer& buffer) {
+                                             return index < buffer.m_firstIndex;
+                                         });
+        for (--geometry; geometry != m_geometryBuffers.end() && geometry->m_firstIndex < srcEnd;
+             ++geometry) {
+            const uint32_t first = std::max(srcSubMesh.m_firstIndex, geometry->m_firstIndex);
+            const uint32_t end = std::min(srcEnd, geometry->m_firstIndex + geometry->m_indexCount);
+            if (first >= end) {
+                continue;
+            }
+            dstSubMeshes.push_back(
+                {.m_firstIndex = first - geometry->m_firstIndex,
+                 .m_indexCount = end - first,
+                 .m_materialIndex = srcSubMesh.m_materialIndex,
+                 .m_centroid = (srcSubMesh.m_minBounds + srcSubMesh.m_maxBounds) * 0.5f,
+                 .m_instanceIndex = instanceIndices[i],
+                 .m_transformIndex = srcSubMesh.m_transformIndex,
+                 .m_geometryBuffer =
+                     static_cast<uint32_t>(geometry - m_geometryBuffers.begin())});
         }
     }
+
+    // Group opaque submeshes by material to minimize bind group changes, then by geometry buffer
+    std::stable_sort(m_opaqueMeshes.begin(), m_opaqueMeshes.end(),
+                     [](const SubMesh& a, const SubMesh& b) {
+                         if (a.m_materialIndex != b.m_materialIndex) {
+                             return a.m_materialIndex < b.m_materialIndex;
+                         }
+                         return a.m_geometryBuffer < b.m_geometryBuffer;
+                     });
 }
 
 void Renderer::CreateMaterials(const Model& model) {
+    if (model.GetMaterials().empty()) {
+        return;
+    }
+
     // Create mipmap generator helper
     MipmapGenerator mipmapGenerator(m_device);
 
-    m_materials.clear();
-
-    // Check if the model has any textures
-    if (!model.GetMaterials().empty()) {
-        m_materials.resize(model.GetMaterials().size());
-
-        for (size_t i = 0; i < model.GetMaterials().size(); ++i) {
-            const Model::Material& srcMat = model.GetMaterials()[i];
-            Material& dstMat = m_materials[i];
-
-            // Create uniform buffer
-            wgpu::BufferDescriptor bufferDescriptor{};
-            bufferDescriptor.size = sizeof(MaterialUniforms);
-            bufferDescriptor.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
-            dstMat.m_uniformBuffer = m_device.CreateBuffer(&bufferDescriptor);
-
-            // Initialize Material Uniforms
-            dstMat.m_uniforms.baseColorFactor = srcMat.m_baseColorFactor;
-            dstMat.m_uniforms.emissiveFactor = srcMat.m_emissiveFactor;
-            dstMat.m_uniforms.metallicFactor = srcMat.m_metallicFactor;
-            dstMat.m_uniforms.roughnessFactor = srcMat.m_roughnessFactor;
-            dstMat.m_uniforms.normalScale = srcMat.m_normalScale;
-            dstMat.m_uniforms.occlusionStrength = srcMat.m_occlusionStrength;
-            dstMat.m_uniforms.alphaCutoff = srcMat.m_alphaCutoff;
-            dstMat.m_uniforms.alphaMode = int(srcMat.m_alphaMode);
-
-            m_device.GetQueue().WriteBuffer(dstMat.m_uniformBuffer, 0, &dstMat.m_uniforms,
-                                            sizeof(MaterialUniforms));
-
-            // Base Color Texture
-            if (const Model::Texture *t = model.GetTexture(srcMat.m_baseColorTexture)) {
-                glm::vec4 defaultBaseColor(1.0f);
-                CreateTexture(t, wgpu::TextureFormat::RGBA8UnormSrgb, defaultBaseColor, m_device,
-                              mipmapGenerator, MipmapGenerator::MipKind::SRGB2D,
-                              dstMat.m_baseColorTexture);
-            } else {
-                dstMat.m_baseColorTexture = m_defaultSRGBTexture;
-            }
-
-            // Metallic-Roughness
-            if (const Model::Texture *t = model.GetTexture(srcMat.m_metallicRoughnessTexture)) {
-                glm::vec4 defaultMR(1.0f);
-                CreateTexture(t, wgpu::TextureFormat::RGBA8Unorm, defaultMR, m_device,
-                              mipmapGenerator, MipmapGenerator::MipKind::LinearUNorm2D,
-                              dstMat.m_metallicRoughnessTexture);
-            } else {
-                dstMat.m_metallicRoughnessTexture = m_defaultUNormTexture;
-            }
-
-            // Normal Texture
-            if (const Model::Texture *t = model.GetTexture(srcMat.m_normalTexture)) {
-                glm::vec4 defaultNormal(0.5f, 0.5f, 1.0f, 1.0f);
-                CreateTexture(t, wgpu::TextureFormat::RGBA8Unorm, defaultNormal, m_device,
-                              mipmapGenerator, MipmapGenerator::MipKind::Normal2D,
-                              dstMat.m_normalTexture);
-            } else {
-                dstMat.m_normalTexture = m_defaultNormalTexture;
-            }
-
-            // Occlusion Texture
-            if (const Model::Texture *t = model.GetTexture(srcMat.m_occlusionTexture)) {
-                glm::vec4 defaultOcc(1.0f);
-                CreateTexture(t, wgpu::TextureFormat::RGBA8Unorm, defaultOcc, m_device,
-                              mipmapGenerator, MipmapGenerator::MipKind::LinearUNorm2D,
-                              dstMat.m_occlusionTexture);
-            } else {
-                dstMat.m_occlusionTexture = m_defaultUNormTexture;
-            }
+    // Materials are built on worker threads when Dawn synchronizes the device internally
+#if defined(__EMSCRIPTEN__)
+    const uint32_t threadCount = 1;
+#else
+    const uint32_t threadCount =
+        m_device.HasFeature(wgpu::FeatureName::ImplicitDeviceSynchronization)
+            ? std::max(std::thread::hardware_concurrency(), 1u)
+            : 1;
+#endif
 
-            // Emissive Texture
-            if (const Model::Texture *t = model.GetTexture(srcMat.m_emissiveTexture)) {
-                glm::vec4 defaultEmissive(1.0f);
-                CreateTexture(t, wgpu::TextureFormat::RGBA8UnormSrgb, defaultEmissive, m_device,
-                              mipmapGenerator, MipmapGenerator::MipKind::SRGB2D,
-                              dstMat.m_emissiveTexture);
-            } else {
-                dstMat.m_emissiveTexture = m_defaultSRGBTexture;
-            }
+    // Materials frequently share images (e.g. replicated material variants), so upload each
+    // image only once per format and mip filter
+    struct TextureJob {
+        const Model::Texture *m_source = nullptr;
+        wgpu::TextureFormat m_format = wgpu::TextureFormat::Undefined;
+        MipmapGenerator::MipKind m_mipKind = MipmapGenerator::MipKind::LinearUNorm2D;
+        wgpu::Texture m_texture;
+        wgpu::Texture m_intermediateTexture;
+        wgpu::CommandBuffer m_commands;
+    };
+    constexpr size_t kNoTexture = std::numeric_limits<size_t>::max();
+    std::vector<TextureJob> textureJobs;
+    std::map<std::pair<int, MipmapGenerator::MipKind>, size_t> textureCache;
+    auto addTexture = [&](int index, wgpu::TextureFormat format,
+                          MipmapGenerator::MipKind mipKind) {
+        const Model::Texture *t = model.GetTexture(index);
+        if (!t) {
+            return kNoTexture;
+        }
 
-            // Create bind group
-            wgpu::BindGroupEntry bindGroupEntries[8]{};
-            bindGroupEntries[0].binding = 0;
-            bindGroupEntries[0].buffer = m_modelUniformBuffer;
-            bindGroupEntries[0].offset = 0;
-            bindGroupEntries[0].size = sizeof(ModelUniforms);
+        auto [it, inserted] = textureCache.try_emplace({index, mipKind}, textureJobs.size());
+        if (inserted) {
+            textureJobs.push_back({t, format, mipKind, {}, {}, {}});
+        }
+        return it->second;
+    };
 
-            bindGroupEntries[1].binding = 1;
-            bindGroupEntries[1].buffer = dstMat.m_uniformBuffer;
-            bindGroupEntries[1].offset = 0;
-            bindGroupEntries[1].size = sizeof(MaterialUniforms);
+    // Base color, metallic-roughness, normal, occlusion and emissive textures of each material
+    std::vector<std::array<size_t, 5>> materialTextures;
+    materialTextures.reserve(model.GetMaterials().size());
+    for (const Model::Material& srcMat : model.GetMaterials()) {
+        materialTextures.push_back(
+            {addTexture(srcMat.m_baseColorTexture, wgpu::TextureFormat::RGBA8UnormSrgb,
+                        MipmapGenerator::MipKind::SRGB2D),
+             addTexture(srcMat.m_metallicRoughnessTexture, wgpu::TextureFormat::RGBA8Unorm,
+                        MipmapGenerator::MipKind::LinearUNorm2D),
+             addTexture(srcMat.m_normalTexture, wgpu::TextureFormat::RGBA8Unorm,
+                        MipmapGenerator::MipKind::Normal2D),
+             addTexture(srcMat.m_occlusionTexture, wgpu::TextureFormat::RGBA8Unorm,
+                        MipmapGenerator::MipKind::LinearUNorm2D),
+             addTexture(srcMat.m_emissiveTexture, wgpu::TextureFormat::RGBA8UnormSrgb,
+                        MipmapGenerator::MipKind::SRGB2D)});
+    }
 
-            bindGroupEntries[2].binding = 2;
-            bindGroupEntries[2].sampler = m_modelTextureSampler;
+    // Each texture records its upload and mip generation into its own encoder. The pixels are
+    // decoded (or copied) by the worker straight into mapped staging memory.
+    ParallelFor(textureJobs.size(), threadCount, [&](size_t i) {
+        TextureJob& job = textureJobs[i];
+        const Model::Texture& source = *job.m_source;
+        auto writePixels = [&source](uint8_t *destination, uint32_t bytesPerRow) {
+            source.DecodeRows(destination, bytesPerRow);
+        };
+
+        wgpu::CommandEncoder encoder = m_device.CreateCommandEncoder();
+        texture_utils::CreateTexture(writePixels, source.m_width, source.m_height, job.m_format,
+                                     m_device, *m_resourcePool, mipmapGenerator, job.m_mipKind,
+                                     encoder, job.m_texture, job.m_intermediateTexture);
+        job.m_commands = encoder.Finish();
+    });
 
-            bindGroupEntries[3].binding = 3;
-            bindGroupEntries[3].textureView = dstMat.m_baseColorTexture.CreateView();
+    // Submit in texture order, so the queue sees the same work regardless of thread timing. The
+    // intermediate textures can only be recycled once their commands are submitted.
+    std::vector<wgpu::CommandBuffer> commandBuffers;
+    commandBuffers.reserve(textureJobs.size());
+    for (TextureJob& job : textureJobs) {
+        commandBuffers.push_back(std::move(job.m_commands));
+    }
+    if (!commandBuffers.empty()) {
+        m_device.GetQueue().Submit(commandBuffers.size(), commandBuffers.data());
+    }
+    for (TextureJob& job : textureJobs) {
+        m_resourcePool->Release(job.m_intermediateTexture,
+                                GpuResourcePool::ReleaseMode::QueueOrdered);
+    }
 
-            bindGroupEntries[4].binding = 4;
-            bindGroupEntries[4].textureView = dstMat.m_metallicRoughnessTexture.CreateView();
+    auto getTexture = [&](size_t job, const wgpu::Texture& fallback) {
+        return job == kNoTexture ? fallback : textureJobs[job].m_texture;
+    };
 
-            bindGroupEntries[5].binding = 5;
-            bindGroupEntries[5].textureView = dstMat.m_normalTexture.CreateView();
+    m_materials.resize(model.GetMaterials().size());
+    ParallelFor(m_materials.size(), threadCount, [&](size_t i) {
+        const Model::Material& srcMat = model.GetMaterials()[i];
+        const std::array<size_t, 5>& textures = materialTextures[i];
+        Material& dstMat = m_materials[i];
+
+        // Create uniform buffer
+        wgpu::BufferDescriptor bufferDescriptor{};
+        bufferDescriptor.size = sizeof(MaterialUniforms);
+        bufferDescriptor.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+        dstMat.m_uniformBuffer = m_resourcePool->AcquireBuffer(bufferDescriptor);
+
+        // Initialize Material Uniforms
+        dstMat.m_uniforms.baseColorFactor = srcMat.m_baseColorFactor;
+        dstMat.m_uniforms.emissiveFactor = srcMat.m_emissiveFactor;
+        dstMat.m_uniforms.metallicFactor = srcMat.m_metallicFactor;
+        dstMat.m_uniforms.roughnessFactor = srcMat.m_roughnessFactor;
+        dstMat.m_uniforms.normalScale = srcMat.m_normalScale;
+        dstMat.m_uniforms.occlusionStrength = srcMat.m_occlusionStrength;
+        dstMat.m_uniforms.alphaCutoff = srcMat.m_alphaCutoff;
+        dstMat.m_uniforms.alphaMode = int(srcMat.m_alphaMode);
+        dstMat.m_uniforms.textureMask =
+            (textures[0] != kNoTexture ? kTextureMaskBaseColor : 0u) |
+            (textures[1] != kNoTexture ? kTextureMaskMetallicRoughness : 0u) |
+            (textures[2] != kNoTexture ? kTextureMaskNormal : 0u) |
+            (textures[3] != kNoTexture ? kTextureMaskOcclusion : 0u) |
+            (textures[4] != kNoTexture ? kTextureMaskEmissive : 0u);
+        dstMat.m_uniforms.materialIndex = static_cast<uint32_t>(i);
+
+        m_device.GetQueue().WriteBuffer(dstMat.m_uniformBuffer, 0, &dstMat.m_uniforms,
+                                        sizeof(MaterialUniforms));
+
+        dstMat.m_baseColorTexture = getTexture(textures[0], m_defaultSRGBTexture);
+        dstMat.m_metallicRoughnessTexture = getTexture(textures[1], m_defaultUNormTexture);
+        dstMat.m_normalTexture = getTexture(textures[2], m_defaultNormalTexture);
+        dstMat.m_occlusionTexture = getTexture(textures[3], m_defaultUNormTexture);
+        dstMat.m_emissiveTexture = getTexture(textures[4], m_defaultSRGBTexture);
+
+        // Create bind group
+        wgpu::BindGroupEntry bindGroupEntries[8]{};
+        bindGroupEntries[0].binding = 0;
+        bindGroupEntries[0].buffer = m_modelUniformBuffer;
+        bindGroupEntries[0].offset = 0;
+        bindGroupEntries[0].size = sizeof(ModelUniforms);
+
+        bindGroupEntries[1].binding = 1;
+        bindGroupEntries[1].buffer = dstMat.m_uniformBuffer;
+        bindGroupEntries[1].offset = 0;
+        bindGroupEntries[1].size = sizeof(MaterialUniforms);
+
+        bindGroupEntries[2].binding = 2;
+        bindGroupEntries[2].sampler = m_modelTextureSampler;
+
+        bindGroupEntries[3].binding = 3;
+        bindGroupEntries[3].textureView = dstMat.m_baseColorTexture.CreateView();
+
+        bindGroupEntries[4].binding = 4;
+        bindGroupEntries[4].textureView = dstMat.m_metallicRoughnessTexture.CreateView();
+
+        bindGroupEntries[5].binding = 5;
+        bindGroupEntries[5].textureView = dstMat.m_normalTexture.CreateView();
+
+        bindGroupEntries[6].binding = 6;
+        bindGroupEntries[6].textureView = dstMat.m_occlusionTexture.CreateView();
+
+        bindGroupEntries[7].binding = 7;
+        bindGroupEntries[7].textureView = dstMat.m_emissiveTexture.CreateView();
+
+        wgpu::BindGroupDescriptor bindGroupDescriptor{};
+        bindGroupDescriptor.layout = m_modelBindGroupLayout;
+        bindGroupDescriptor.entryCount = 8;
+        bindGroupDescriptor.entries = bindGroupEntries;
+
+        dstMat.m_bindGroup = m_device.CreateBindGroup(&bindGroupDescriptor);
+    });
+}
 
-            bindGroupEntries[6].binding = 6;
-            bindGroupEntries[6].textureView = dstMat.m_occlusionTexture.CreateView();
+void Renderer::ReleaseMaterials() {
+    // Material textures can be shared between materials or be one of the default textures, so
+    // return each pooled texture only once
+    std::vector<wgpu::Texture> textures;
+    auto collect = [&](const wgpu::Texture& texture) {
+        if (texture.Get() == m_defaultSRGBTexture.Get() ||
+            texture.Get() == m_defaultUNormTexture.Get() ||
+            texture.Get() == m_defaultNormalTexture.Get()) {
+            return;
+        }
+        auto isSame = [&](const wgpu::Texture& other) { return other.Get() == texture.Get(); };
+        if (std::none_of(textures.begin(), textures.end(), isSame)) {
+            textures.push_back(texture);
+        }
+    };
 
-            bindGroupEntries[7].binding = 7;
-            bindGroupEntries[7].textureView = dstMat.m_emissiveTexture.CreateView();
+    for (Material& material : m_materials) {
+        collect(material.m_baseColorTexture);
+        collect(material.m_metallicRoughnessTexture);
+        collect(material.m_normalTexture);
+        collect(material.m_occlusionTexture);
+        collect(material.m_emissiveTexture);
+        m_resourcePool->Release(material.m_uniformBuffer);
+    }
 
-            wgpu::BindGroupDescriptor bindGroupDescriptor{};
-            bindGroupDescriptor.layout = m_modelBindGroupLayout;
-            bindGroupDescriptor.entryCount = 8;
-            bindGroupDescriptor.entries = bindGroupEntries;
+    m_materials.clear();
 
-            dstMat.m_bindGroup = m_device.CreateBindGroup(&bindGroupDescriptor);
-        }
+    for (wgpu::Texture& texture : textures) {
+        m_resourcePool->Release(texture);
     }
 }
 
-void Renderer::CreateGlobalBindGroup() {
-    wgpu::BindGroupEntry bindGroupEntries[7]{};
+void Renderer::CreateGlobalBindGroup(PreparedEnvironment& prepared) {
+    wgpu::BindGroupEntry bindGroupEntries[10]{};
     bindGroupEntries[0].binding = 0;
     bindGroupEntries[0].buffer = m_globalUniformBuffer;
     bindGroupEntries[0].offset = 0;
@@ -885,34 +1688,55 @@ void Renderer::CreateGlobalBindGroup() {
 
     // Use environment resources if available, otherwise use fallbacks
     bindGroupEntries[2].binding = 2;
-    bindGroupEntries[2].textureView =
-        m_environmentTextureView ? m_environmentTextureView : m_defaultCubeTextureView;
+    bindGroupEntries[2].textureView = prepared.m_environmentTextureView
+                                          ? prepared.m_environmentTextureView
+                                          : m_defaultCubeTextureView;
 
     bindGroupEntries[3].binding = 3;
-    bindGroupEntries[3].textureView =
-        m_iblIrradianceTextureView ? m_iblIrradianceTextureView : m_defaultCubeTextureView;
+    bindGroupEntries[3].textureView = prepared.m_iblIrradianceTextureView
+                                          ? prepared.m_iblIrradianceTextureView
+                                          : m_defaultCubeTextureView;
 
     bindGroupEntries[4].binding = 4;
-    bindGroupEntries[4].textureView =
-        m_iblSpecularTextureView ? m_iblSpecularTextureView : m_defaultCubeTextureView;
+    bindGroupEntries[4].textureView = prepared.m_iblSpecularTextureView
+                                          ? prepared.m_iblSpecularTextureView
+                                          : m_defaultCubeTextureView;
 
     bindGroupEntries[5].binding = 5;
-    bindGroupEntries[5].textureView =
-        m_iblBrdfIntegrationLUTView ? m_iblBrdfIntegrationLUTView : m_defaultUNormTextureView;
+    bindGroupEntries[5].textureView = prepared.m_iblBrdfIntegrationLUTView
+                                          ? prepared.m_iblBrdfIntegrationLUTView
+                                          : m_defaultUNormTextureView;
 
     bindGroupEntries[6].binding = 6;
     bindGroupEntries[6].sampler = m_iblBrdfIntegrationLUTSampler;
 
+    bindGroupEntries[7].binding = 7;
+    bindGroupEntries[7].buffer = prepared.m_iblIrradianceSHBuffer;
+    bindGroupEntries[7].offset = 0;
+    bindGroupEntries[7].size = sizeof(glm::vec4) * 9;
+
+    bindGroupEntries[8].binding = 8;
+    bindGroupEntries[8].textureView = prepared.m_environmentOctahedralTextureView
+                                          ? prepared.m_environmentOctahedralTextureView
+                                          : m_defaultUNormTextureView;
+
+    bindGroupEntries[9].binding = 9;
+    bindGroupEntries[9].textureView = prepared.m_iblSpecularOctahedralTextureView
+                                          ? prepared.m_iblSpecularOctahedralTextureView
+                                          : m_defaultUNormTextureView;
+
     wgpu::BindGroupDescriptor bindGroupDescriptor{};
     bindGroupDescriptor.layout = m_globalBindGroupLayout;
-    bindGroupDescriptor.entryCount = 7;
+    bindGroupDescriptor.entryCount = 10;
     bindGroupDescriptor.entries = bindGroupEntries;
 
-    m_globalBindGroup = m_device.CreateBindGroup(&bindGroupDescriptor);
+    prepared.m_globalBindGroup = m_device.CreateBindGroup(&bindGroupDescriptor);
 }
 
 void Renderer::CreateModelRenderPipelines() {
-    const std::string shader = LoadShaderFile("./assets/shaders/gltf_pbr.wgsl");
+    FrameTimeRecorder::ScopedPhase phase(FrameTimeRecorder::Phase::PipelineCreation);
+
+    const std::string shader = LoadTextAsset("./assets/shaders/gltf_pbr.wgsl", m_preferShaderFiles);
     wgpu::ShaderSourceWGSL wgsl{{.nextInChain = nullptr, .code = shader.c_str()}};
     wgpu::ShaderModuleDescriptor shaderModuleDescriptor{.nextInChain = &wgsl};
     m_modelShaderModule = m_device.CreateShaderModule(&shaderModuleDescriptor);
@@ -944,12 +1768,27 @@ void Renderer::CreateModelRenderPipelines() {
     vertexBufferLayout.attributeCount = 6;
     vertexBufferLayout.attributes = vertexAttributes;
 
+    wgpu::VertexBufferLayout vertexBufferLayouts[] = {vertexBufferLayout,
+                                                      GetGeometryTransformBufferLayout()};
+
     wgpu::ColorTargetState colorTargetState{};
     colorTargetState.format = m_surfaceFormat;
 
+    // Select the BRDF and diffuse IBL evaluation for the current quality tier
+    const QualitySettings& quality = GetQualitySettings(m_qualityTier);
+    wgpu::ConstantEntry constants[3]{};
+    constants[0].key = "useBRDFLUT";
+    constants[0].value = quality.m_useBRDFLUT ? 1.0 : 0.0;
+    constants[1].key = "useSphericalHarmonics";
+    constants[1].value = quality.m_useSphericalHarmonics ? 1.0 : 0.0;
+    constants[2].key = "useOctahedralEnvironment";
+    constants[2].value = quality.m_useOctahedralEnvironment ? 1.0 : 0.0;
+
     wgpu::FragmentState fragmentState{};
     fragmentState.module = m_modelShaderModule;
     fragmentState.entryPoint = "fs_main";
+    fragmentState.constantCount = 3;
+    fragmentState.constants = constants;
     fragmentState.targetCount = 1;
     fragmentState.targets = &colorTargetState;
 
@@ -970,8 +1809,8 @@ void Renderer::CreateModelRenderPipelines() {
     descriptor.layout = pipelineLayout;
     descriptor.vertex.module = m_modelShaderModule;
     descriptor.vertex.entryPoint = "vs_main";
-    descriptor.vertex.bufferCount = 1;
-    descriptor.vertex.buffers = &vertexBufferLayout;
+    descriptor.vertex.bufferCount = 2;
+    descriptor.vertex.buffers = vertexBufferLayouts;
     descriptor.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
     descriptor.depthStencil = &depthStencilState;
     descriptor.fragment = &fragmentState;
@@ -992,9 +1831,134 @@ void Renderer::CreateModelRenderPipelines() {
     depthStencilState.depthWriteEnabled = false; // Disable depth writes for transparent objects
 
     m_modelPipelineTransparent = m_device.CreateRenderPipeline(&descriptor);
+
+    // Texture LOD feedback: depth tested mip level writes into a storage buffer at a reduced
+    // resolution, without color targets
+    wgpu::ConstantEntry feedbackConstant{};
+    feedbackConstant.key = "textureFeedbackScale";
+    feedbackConstant.value = TextureFeedback::kResolutionScale;
+
+    wgpu::FragmentState feedbackFragmentState{};
+    feedbackFragmentState.module = m_modelShaderModule;
+    feedbackFragmentState.entryPoint = "fs_texture_feedback";
+    feedbackFragmentState.constantCount = 1;
+    feedbackFragmentState.constants = &feedbackConstant;
+    feedbackFragmentState.targetCount = 0;
+
+    wgpu::DepthStencilState feedbackDepthStencilState{};
+    feedbackDepthStencilState.format = TextureFeedback::kDepthFormat;
+    feedbackDepthStencilState.depthWriteEnabled = true;
+    feedbackDepthStencilState.depthCompare = wgpu::CompareFunction::LessEqual;
+
+    wgpu::BindGroupLayout feedbackBindGroupLayouts[] = {
+        m_globalBindGroupLayout, m_modelBindGroupLayout, m_textureFeedback->GetBindGroupLayout()};
+    wgpu::PipelineLayoutDescriptor feedbackLayoutDescriptor{};
+    feedbackLayoutDescriptor.bindGroupLayoutCount = 3;
+    feedbackLayoutDescriptor.bindGroupLayouts = feedbackBindGroupLayouts;
+
+    wgpu::RenderPipelineDescriptor feedbackDescriptor{};
+    feedbackDescriptor.layout = m_device.CreatePipelineLayout(&feedbackLayoutDescriptor);
+    feedbackDescriptor.vertex.module = m_modelShaderModule;
+    feedbackDescriptor.vertex.entryPoint = "vs_main";
+    feedbackDescriptor.vertex.bufferCount = 2;
+    feedbackDescriptor.vertex.buffers = vertexBufferLayouts;
+    feedbackDescriptor.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
+    feedbackDescriptor.depthStencil = &feedbackDepthStencilState;
+    feedbackDescriptor.fragment = &feedbackFragmentState;
+
+    m_textureFeedbackPipeline = m_device.CreateRenderPipeline(&feedbackDescriptor);
+
+    // Impostor baking: material attributes of one orthographic view into the atlas targets
+    wgpu::ColorTargetState bakeTargetStates[4]{};
+    for (uint32_t i = 0; i < 4; ++i) {
+        bakeTargetStates[i].format = kImpostorAtlasFormats[i];
+    }
+
+    wgpu::FragmentState bakeFragmentState{};
+    bakeFragmentState.module = m_modelShaderModule;
+    bakeFragmentState.entryPoint = "fs_impostor_bake";
+    bakeFragmentState.targetCount = 4;
+    bakeFragmentState.targets = bakeTargetStates;
+
+    wgpu::DepthStencilState bakeDepthStencilState{};
+    bakeDepthStencilState.format = kImpostorBakeDepthFormat;
+    bakeDepthStencilState.depthWriteEnabled = true;
+    bakeDepthStencilState.depthCompare = wgpu::CompareFunction::LessEqual;
+
+    wgpu::BindGroupLayout bakeBindGroupLayouts[] = {m_globalBindGroupLayout, m_modelBindGroupLayout,
+                                                    m_impostorBakeBindGroupLayout};
+    wgpu::PipelineLayoutDescriptor bakeLayoutDescriptor{};
+    bakeLayoutDescriptor.bindGroupLayoutCount = 3;
+    bakeLayoutDescriptor.bindGroupLayouts = bakeBindGroupLayouts;
+
+    wgpu::RenderPipelineDescriptor bakeDescriptor{};
+    bakeDescriptor.layout = m_device.CreatePipelineLayout(&bakeLayoutDescriptor);
+    bakeDescriptor.vertex.module = m_modelShaderModule;
+    bakeDescriptor.vertex.entryPoint = "vs_impostor_bake";
+    bakeDescriptor.vertex.bufferCount = 2;
+    bakeDescriptor.vertex.buffers = vertexBufferLayouts;
+    bakeDescriptor.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
+    bakeDescriptor.depthStencil = &bakeDepthStencilState;
+    bakeDescriptor.fragment = &bakeFragmentState;
+
+    m_impostorBakePipeline = m_device.CreateRenderPipeline(&bakeDescriptor);
+
+    // Impostor rendering: one camera-facing quad per instance, shaded like the meshes
+    wgpu::VertexAttribute instanceAttributes[5]{};
+    for (uint32_t i = 0; i < 5; ++i) {
+        instanceAttributes[i].format = wgpu::VertexFormat::Float32x4;
+        instanceAttributes[i].offset = i * sizeof(glm::vec4);
+        instanceAttributes[i].shaderLocation = i;
+    }
+
+    wgpu::VertexBufferLayout instanceBufferLayout{};
+    instanceBufferLayout.arrayStride = sizeof(ImpostorInstanceData);
+    instanceBufferLayout.stepMode = wgpu::VertexStepMode::Instance;
+    instanceBufferLayout.attributeCount = 5;
+    instanceBufferLayout.attributes = instanceAttributes;
+
+    wgpu::ConstantEntry impostorConstants[4]{};
+    impostorConstants[0] = constants[0];
+    impostorConstants[1] = constants[1];
+    impostorConstants[2] = constants[2];
+    impostorConstants[3].key = "impostorGridSize";
+    impostorConstants[3].value = kImpostorGridSize;
+
+    wgpu::ColorTargetState impostorTargetState{};
+    impostorTargetState.format = m_surfaceFormat;
+
+    wgpu::FragmentState impostorFragmentState{};
+    impostorFragmentState.module = m_modelShaderModule;
+    impostorFragmentState.entryPoint = "fs_impostor";
+    impostorFragmentState.constantCount = 4;
+    impostorFragmentState.constants = impostorConstants;
+    impostorFragmentState.targetCount = 1;
+    impostorFragmentState.targets = &impostorTargetState;
+
+    depthStencilState.depthWriteEnabled = true;
+
+    wgpu::BindGroupLayout impostorBindGroupLayouts[] = {
+        m_globalBindGroupLayout, m_modelBindGroupLayout, m_impostorBindGroupLayout};
+    wgpu::PipelineLayoutDescriptor impostorLayoutDescriptor{};
+    impostorLayoutDescriptor.bindGroupLayoutCount = 3;
+    impostorLayoutDescriptor.bindGroupLayouts = impostorBindGroupLayouts;
+
+    wgpu::RenderPipelineDescriptor impostorDescriptor{};
+    impostorDescriptor.layout = m_device.CreatePipelineLayout(&impostorLayoutDescriptor);
+    impostorDescriptor.vertex.module = m_modelShaderModule;
+    impostorDescriptor.vertex.entryPoint = "vs_impostor";
+    impostorDescriptor.vertex.bufferCount = 1;
+    impostorDescriptor.vertex.buffers = &instanceBufferLayout;
+    impostorDescriptor.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
+    impostorDescriptor.depthStencil = &depthStencilState;
+    impostorDescriptor.fragment = &impostorFragmentState;
+
+    m_impostorPipeline = m_device.CreateRenderPipeline(&impostorDescriptor);
 }
 
 void Renderer::CreateEnvironmentRenderPipeline() {
+    FrameTimeRecorder::ScopedPhase phase(FrameTimeRecorder::Phase::PipelineCreation);
+
     wgpu::ColorTargetState colorTargetState{};
     colorTargetState.format = m_surfaceFormat;
 
@@ -1010,14 +1974,23 @@ void Renderer::CreateEnvironmentRenderPipeline() {
     depthStencilState.depthCompare = wgpu::CompareFunction::LessEqual;
 
     // Create an environment pipeline
-    const std::string environmentShader = LoadShaderFile("./assets/shaders/environment.wgsl");
+    const std::string environmentShader =
+        LoadTextAsset("./assets/shaders/environment.wgsl", m_preferShaderFiles);
     wgpu::ShaderSourceWGSL environmentWgsl{{.nextInChain = nullptr, .code = environmentShader.c_str()}};
     wgpu::ShaderModuleDescriptor environmentShaderModuleDescriptor{.nextInChain = &environmentWgsl};
     m_environmentShaderModule = m_device.CreateShaderModule(&environmentShaderModuleDescriptor);
 
+    // Cube or octahedral background for the current quality tier
+    wgpu::ConstantEntry environmentConstant{};
+    environmentConstant.key = "useOctahedralEnvironment";
+    environmentConstant.value =
+        GetQualitySettings(m_qualityTier).m_useOctahedralEnvironment ? 1.0 : 0.0;
+
     wgpu::FragmentState environmentFragmentState{};
     environmentFragmentState.module = m_environmentShaderModule;
     environmentFragmentState.entryPoint = "fs_main";
+    environmentFragmentState.constantCount = 1;
+    environmentFragmentState.constants = &environmentConstant;
     environmentFragmentState.targetCount = 1;
     environmentFragmentState.targets = &colorTargetState;
 
@@ -1042,6 +2015,301 @@ void Renderer::CreateEnvironmentRenderPipeline() {
     m_environmentPipeline = m_device.CreateRenderPipeline(&environmentDescriptor);
 }
 
+void Renderer::CreateDebugViewPipelines() {
+    FrameTimeRecorder::ScopedPhase phase(FrameTimeRecorder::Phase::PipelineCreation);
+
+    const std::string shader =
+        LoadTextAsset("./assets/shaders/debug_views.wgsl", m_preferShaderFiles);
+    wgpu::ShaderSourceWGSL wgsl{{.nextInChain = nullptr, .code = shader.c_str()}};
+    wgpu::ShaderModuleDescriptor shaderModuleDescriptor{.nextInChain = &wgsl};
+    m_debugShaderModule = m_device.CreateShaderModule(&shaderModuleDescriptor);
+
+    // Only the position attribute (and the geometry transform) is needed
+    wgpu::VertexAttribute positionAttribute{.format = wgpu::VertexFormat::Float32x3,
+                                            .offset = offsetof(Model::Vertex, m_position),
+                                            .shaderLocation = 0};
+
+    wgpu::VertexBufferLayout vertexBufferLayouts[2]{};
+    vertexBufferLayouts[0].arrayStride = sizeof(Model::Vertex);
+    vertexBufferLayouts[0].stepMode = wgpu::VertexStepMode::Vertex;
+    vertexBufferLayouts[0].attributeCount = 1;
+    vertexBufferLayouts[0].attributes = &positionAttribute;
+    vertexBufferLayouts[1] = GetGeometryTransformBufferLayout();
+
+    wgpu::BindGroupLayout bindGroupLayouts[] = {m_globalBindGroupLayout, m_modelBindGroupLayout,
+                                                m_debugDrawBindGroupLayout};
+
+    wgpu::PipelineLayoutDescriptor layoutDescriptor{};
+    layoutDescriptor.bindGroupLayoutCount = 3;
+    layoutDescriptor.bindGroupLayouts = bindGroupLayouts;
+
+    wgpu::PipelineLayout pipelineLayout = m_device.CreatePipelineLayout(&layoutDescriptor);
+
+    // Accumulation pipelines: additive blending into R16Float without depth testing
+    wgpu::BlendComponent additiveBlend{};
+    additiveBlend.operation = wgpu::BlendOperation::Add;
+    additiveBlend.srcFactor = wgpu::BlendFactor::One;
+    additiveBlend.dstFactor = wgpu::BlendFactor::One;
+
+    wgpu::BlendState blendState{};
+    blendState.color = additiveBlend;
+    blendState.alpha = additiveBlend;
+
+    wgpu::ColorTargetState accumulationTargetState{};
+    accumulationTargetState.format = wgpu::TextureFormat::R16Float;
+    accumulationTargetState.blend = &blendState;
+
+    wgpu::FragmentState fragmentState{};
+    fragmentState.module = m_debugShaderModule;
+    fragmentState.entryPoint = "fs_overdraw";
+    fragmentState.targetCount = 1;
+    fragmentState.targets = &accumulationTargetState;
+
+    wgpu::RenderPipelineDescriptor descriptor{};
+    descriptor.layout = pipelineLayout;
+    descriptor.vertex.module = m_debugShaderModule;
+    descriptor.vertex.entryPoint = "vs_main";
+    descriptor.vertex.bufferCount = 2;
+    descriptor.vertex.buffers = vertexBufferLayouts;
+    descriptor.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
+    descriptor.fragment = &fragmentState;
+
+    m_debugOverdrawPipeline = m_device.CreateRenderPipeline(&descriptor);
+
+    // Triangle density: splat every index as a point
+    fragmentState.entryPoint = "fs_triangle_density";
+    descriptor.primitive.topology = wgpu::PrimitiveTopology::PointList;
+
+    m_debugTriangleDensityPipeline = m_device.CreateRenderPipeline(&descriptor);
+
+    // Surface pipeline (texture fetches and IDs): regular depth tested rendering
+    wgpu::ColorTargetState surfaceTargetState{};
+    surfaceTargetState.format = m_surfaceFormat;
+
+    wgpu::DepthStencilState depthStencilState{};
+    depthStencilState.format = wgpu::TextureFormat::Depth24PlusStencil8;
+    depthStencilState.depthWriteEnabled = true;
+    depthStencilState.depthCompare = wgpu::CompareFunction::LessEqual;
+
+    fragmentState.entryPoint = "fs_surface";
+    fragmentState.targets = &surfaceTargetState;
+    descriptor.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
+    descriptor.depthStencil = &depthStencilState;
+
+    m_debugSurfacePipeline = m_device.CreateRenderPipeline(&descriptor);
+
+    // Resolve pipeline: fullscreen heatmap of the accumulation target
+    const std::string resolveShader =
+        LoadTextAsset("./assets/shaders/debug_view_resolve.wgsl", m_preferShaderFiles);
+    wgpu::ShaderSourceWGSL resolveWgsl{{.nextInChain = nullptr, .code = resolveShader.c_str()}};
+    wgpu::ShaderModuleDescriptor resolveShaderModuleDescriptor{.nextInChain = &resolveWgsl};
+    m_debugResolveShaderModule = m_device.CreateShaderModule(&resolveShaderModuleDescriptor);
+
+    wgpu::PipelineLayoutDescriptor resolveLayoutDescriptor{};
+    resolveLayoutDescriptor.bindGroupLayoutCount = 1;
+    resolveLayoutDescriptor.bindGroupLayouts = &m_debugResolveBindGroupLayout;
+    wgpu::PipelineLayout resolvePipelineLayout =
+        m_device.CreatePipelineLayout(&resolveLayoutDescriptor);
+
+    wgpu::FragmentState resolveFragmentState{};
+    resolveFragmentState.module = m_debugResolveShaderModule;
+    resolveFragmentState.entryPoint = "fs_main";
+    resolveFragmentState.targetCount = 1;
+    resolveFragmentState.targets = &surfaceTargetState;
+
+    wgpu::RenderPipelineDescriptor resolveDescriptor{};
+    resolveDescriptor.layout = resolvePipelineLayout;
+    resolveDescriptor.vertex.module = m_debugResolveShaderModule;
+    resolveDescriptor.vertex.entryPoint = "vs_main";
+    resolveDescriptor.vertex.bufferCount = 0;
+    resolveDescriptor.vertex.buffers = nullptr; // Vertices encoded in shader
+    resolveDescriptor.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
+    resolveDescriptor.fragment = &resolveFragmentState;
+
+    m_debugResolvePipeline = m_device.CreateRenderPipeline(&resolveDescriptor);
+}
+
+void Renderer::CreateDebugAccumulationTexture(uint32_t width, uint32_t height) {
+    wgpu::TextureDescriptor textureDescriptor{};
+    textureDescriptor.size = {width, height, 1};
+    textureDescriptor.format = wgpu::TextureFormat::R16Float;
+    textureDescriptor.usage =
+        wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding;
+
+    m_debugAccumulationTexture = m_device.CreateTexture(&textureDescriptor);
+    m_debugAccumulationTextureView = m_debugAccumulationTexture.CreateView();
+
+    wgpu::BindGroupEntry bindGroupEntries[2]{};
+    bindGroupEntries[0].binding = 0;
+    bindGroupEntries[0].textureView = m_debugAccumulationTextureView;
+
+    bindGroupEntries[1].binding = 1;
+    bindGroupEntries[1].buffer = m_debugViewUniformBuffer;
+    bindGroupEntries[1].offset = 0;
+    bindGroupEntries[1].size = sizeof(DebugViewUniforms);
+
+    wgpu::BindGroupDescriptor bindGroupDescriptor{};
+    bindGroupDescriptor.layout = m_debugResolveBindGroupLayout;
+    bindGroupDescriptor.entryCount = 2;
+    bindGroupDescriptor.entries = bindGroupEntries;
+
+    m_debugResolveBindGroup = m_device.CreateBindGroup(&bindGroupDescriptor);
+}
+
+void Renderer::CreateDebugDrawUniforms() {
+    // One entry per draw, in the order DrawDebugSubMeshes() issues them
+    const size_t drawCount =
+        std::max<size_t>(m_opaqueMeshes.size() + m_transparentMeshes.size(), 1);
+    std::vector<uint8_t> data(drawCount * kDebugDrawUniformStride, 0);
+
+    size_t drawIndex = 0;
+    for (const std::vector<SubMesh> *subMeshes : {&m_opaqueMeshes, &m_transparentMeshes}) {
+        for (const SubMesh& subMesh : *subMeshes) {
+            DebugDrawUniforms uniforms{};
+            uniforms.subMeshIndex = static_cast<uint32_t>(drawIndex);
+            uniforms.materialIndex = static_cast<uint32_t>(subMesh.m_materialIndex);
+            std::memcpy(&data[drawIndex * kDebugDrawUniformStride], &uniforms, sizeof(uniforms));
+            ++drawIndex;
+        }
+    }
+
+    wgpu::BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = data.size();
+    bufferDescriptor.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+    m_debugDrawUniformBuffer = m_device.CreateBuffer(&bufferDescriptor);
+    m_device.GetQueue().WriteBuffer(m_debugDrawUniformBuffer, 0, data.data(), data.size());
+
+    wgpu::BindGroupEntry bindGroupEntries[2]{};
+    bindGroupEntries[0].binding = 0;
+    bindGroupEntries[0].buffer = m_debugDrawUniformBuffer;
+    bindGroupEntries[0].offset = 0;
+    bindGroupEntries[0].size = sizeof(DebugDrawUniforms);
+
+    bindGroupEntries[1].binding = 1;
+    bindGroupEntries[1].buffer = m_debugViewUniformBuffer;
+    bindGroupEntries[1].offset = 0;
+    bindGroupEntries[1].size = sizeof(DebugViewUniforms);
+
+    wgpu::BindGroupDescriptor bindGroupDescriptor{};
+    bindGroupDescriptor.layout = m_debugDrawBindGroupLayout;
+    bindGroupDescriptor.entryCount = 2;
+    bindGroupDescriptor.entries = bindGroupEntries;
+
+    m_debugDrawBindGroup = m_device.CreateBindGroup(&bindGroupDescriptor);
+}
+
+void Renderer::RenderDebugView(wgpu::CommandEncoder& encoder) {
+    const bool accumulate =
+        m_debugView == DebugView::Overdraw || m_debugView == DebugView::TriangleDensity;
+
+    // Overdraw maps 8 layers to red, triangle density 1 triangle per pixel (8x8 pixel tiles)
+    DebugViewUniforms uniforms{};
+    uniforms.mode = static_cast<uint32_t>(m_debugView);
+    uniforms.tileSize = m_debugView == DebugView::TriangleDensity ? 8u : 1u;
+    uniforms.maxValue = m_debugView == DebugView::TriangleDensity ? 1.0f : 8.0f;
+    m_device.GetQueue().WriteBuffer(m_debugViewUniformBuffer, 0, &uniforms, sizeof(uniforms));
+
+    if (!accumulate) {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&m_renderPassDescriptor);
+        pass.SetBindGroup(0, m_globalBindGroup);
+        pass.SetPipeline(m_debugSurfacePipeline);
+        DrawDebugSubMeshes(pass);
+        pass.End();
+        return;
+    }
+
+    if (!m_debugAccumulationTexture) {
+        CreateDebugAccumulationTexture(m_depthTexture.GetWidth(), m_depthTexture.GetHeight());
+    }
+
+    // Accumulate counts
+    {
+        wgpu::RenderPassColorAttachment colorAttachment{};
+        colorAttachment.view = m_debugAccumulationTextureView;
+        colorAttachment.loadOp = wgpu::LoadOp::Clear;
+        colorAttachment.storeOp = wgpu::StoreOp::Store;
+        colorAttachment.clearValue = {.r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 0.0f};
+
+        wgpu::RenderPassDescriptor renderPassDescriptor{};
+        renderPassDescriptor.colorAttachmentCount = 1;
+        renderPassDescriptor.colorAttachments = &colorAttachment;
+
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPassDescriptor);
+        pass.SetBindGroup(0, m_globalBindGroup);
+        pass.SetPipeline(m_debugView == DebugView::Overdraw ? m_debugOverdrawPipeline
+                                                            : m_debugTriangleDensityPipeline);
+        DrawDebugSubMeshes(pass);
+        pass.End();
+    }
+
+    // Resolve to the surface as a heatmap
+    {
+        wgpu::RenderPassDescriptor renderPassDescriptor{};
+        renderPassDescriptor.colorAttachmentCount = 1;
+        renderPassDescriptor.colorAttachments = &m_colorAttachment;
+
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPassDescriptor);
+        pass.SetBindGroup(0, m_debugResolveBindGroup);
+        pass.SetPipeline(m_debugResolvePipeline);
+        pass.Draw(3, 1, 0, 0); // Fullscreen triangle
+        pass.End();
+    }
+}
+
+void Renderer::DrawDebugSubMeshes(wgpu::RenderPassEncoder& pass) const {
+    pass.SetVertexBuffer(1, m_geometryTransformBuffer);
+    uint32_t boundGeometry = UINT32_MAX;
+
+    uint32_t drawIndex = 0;
+    for (const std::vector<SubMesh> *subMeshes : {&m_opaqueMeshes, &m_transparentMeshes}) {
+        for (const SubMesh& subMesh : *subMeshes) {
+            const uint32_t dynamicOffset = drawIndex++ * kDebugDrawUniformStride;
+            pass.SetBindGroup(1, m_materials[subMesh.m_materialIndex].m_bindGroup);
+            pass.SetBindGroup(2, m_debugDrawBindGroup, 1, &dynamicOffset);
+            DrawSubMesh(pass, subMesh, boundGeometry);
+        }
+    }
+}
+
+void Renderer::RenderTextureFeedback(wgpu::CommandEncoder& encoder) const {
+    wgpu::RenderPassEncoder pass = m_textureFeedback->BeginRenderPass(encoder);
+    pass.SetPipeline(m_textureFeedbackPipeline);
+    pass.SetBindGroup(0, m_globalBindGroup);
+    pass.SetBindGroup(2, m_textureFeedback->GetBindGroup());
+    pass.SetVertexBuffer(1, m_geometryTransformBuffer);
+    uint32_t boundGeometry = UINT32_MAX;
+
+    // Opaque submeshes first, so that they hide what is behind them. Impostors sample no
+    // material textures.
+    for (const std::vector<SubMesh> *subMeshes : {&m_opaqueMeshes, &m_transparentMeshes}) {
+        for (const SubMesh& subMesh : *subMeshes) {
+            if (IsDrawnAsImpostor(subMesh.m_instanceIndex)) {
+                continue;
+            }
+            pass.SetBindGroup(1, m_materials[subMesh.m_materialIndex].m_bindGroup);
+            DrawSubMesh(pass, subMesh, boundGeometry);
+        }
+    }
+
+    pass.End();
+    m_textureFeedback->EncodeReadback(encoder);
+}
+
+void Renderer::DrawSubMesh(wgpu::RenderPassEncoder& pass, const SubMesh& subMesh,
+                           uint32_t& boundGeometry) const {
+    const GeometryBuffer& geometryBuffer = m_geometryBuffers[subMesh.m_geometryBuffer];
+    if (subMesh.m_geometryBuffer != boundGeometry) {
+        pass.SetVertexBuffer(0, geometryBuffer.m_vertexBuffer);
+        pass.SetIndexBuffer(geometryBuffer.m_indexBuffer, wgpu::IndexFormat::Uint32);
+        boundGeometry = subMesh.m_geometryBuffer;
+    }
+
+    // The indices refer to the model's vertex array, the buffer starts at m_firstVertex
+    pass.DrawIndexed(subMesh.m_indexCount, 1u, subMesh.m_firstIndex,
+                     -static_cast<int32_t>(geometryBuffer.m_firstVertex),
+                     subMesh.m_transformIndex);
+}
+
 void Renderer::UpdateUniforms(const glm::mat4& modelMatrix,
                               const CameraUniformsInput& camera) const {
     // Update the global uniforms
@@ -1081,6 +2349,9 @@ void Renderer::SortTransparentMeshes(const glm::mat4& modelMatrix, const glm::ma
 
     for (uint32_t i = 0; i < m_transparentMeshes.size(); ++i) {
         SubMesh& subMesh = m_transparentMeshes[i];
+        if (IsDrawnAsImpostor(subMesh.m_instanceIndex)) {
+            continue;
+        }
 
         glm::vec4 centroid = modelView * glm::vec4(subMesh.m_centroid, 1.0f);
         float depth = centroid.z;
@@ -1099,6 +2370,243 @@ void Renderer::SortTransparentMeshes(const glm::mat4& modelMatrix, const glm::ma
         [](const SubMeshDepthInfo& a, const SubMeshDepthInfo& b) { return a.m_depth < b.m_depth; });
 }
 
+void Renderer::CreateImpostors(const Model& model) {
+    m_impostorSources.clear();
+    m_instanceUsesImpostor.clear();
+    m_impostorInstanceData.clear();
+
+    // Indexed by the submeshes' instance index, so sized even when impostors are not used
+    const std::vector<Model::Instance>& instances = model.GetInstances();
+    m_instanceUsesImpostor.assign(instances.size(), 0);
+    if (instances.size() < kMinImpostorInstances || m_materials.empty()) {
+        return;
+    }
+
+    // Bounding sphere of the first instance, whose geometry is baked into the atlas
+    const Model::Instance& baked = instances.front();
+    glm::vec3 minBounds(std::numeric_limits<float>::max());
+    glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+    for (uint32_t i = 0; i < baked.m_subMeshCount; ++i) {
+        const Model::SubMesh& subMesh = model.GetSubMeshes()[baked.m_firstSubMesh + i];
+        minBounds = glm::min(minBounds, subMesh.m_minBounds);
+        maxBounds = glm::max(maxBounds, subMesh.m_maxBounds);
+    }
+    m_impostorCenter = (minBounds + maxBounds) * 0.5f;
+    m_impostorRadius = std::max(glm::length(maxBounds - minBounds) * 0.5f, 1e-4f);
+
+    // Every instance is the baked one moved by its own transform relative to the first
+    const glm::mat4 inverseBakedTransform = glm::inverse(baked.m_transform);
+    m_impostorSources.reserve(instances.size());
+    for (const Model::Instance& instance : instances) {
+        m_impostorSources.push_back({.m_atlasToModel = instance.m_transform * inverseBakedTransform,
+                                     .m_tint = instance.m_tint});
+    }
+    m_impostorInstanceData.reserve(instances.size());
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    // Atlas targets
+    const uint32_t atlasSize = kImpostorGridSize * kImpostorTileSize;
+    for (uint32_t i = 0; i < 4; ++i) {
+        wgpu::TextureDescriptor textureDescriptor{};
+        textureDescriptor.size = {atlasSize, atlasSize, 1};
+        textureDescriptor.format = kImpostorAtlasFormats[i];
+        textureDescriptor.usage =
+            wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding;
+        m_impostorAtlas[i] = m_resourcePool->AcquireTexture(textureDescriptor);
+    }
+
+    BakeImpostorAtlas(m_impostorCenter, m_impostorRadius);
+
+    // Per-instance quad data, rewritten every frame for the instances drawn as impostors
+    wgpu::BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = instances.size() * sizeof(ImpostorInstanceData);
+    bufferDescriptor.usage = wgpu::BufferUsage::Vertex | wgpu::BufferUsage::CopyDst;
+    m_impostorInstanceBuffer = m_resourcePool->AcquireBuffer(bufferDescriptor);
+
+    wgpu::BindGroupEntry bindGroupEntries[5]{};
+    bindGroupEntries[0].binding = 1;
+    bindGroupEntries[0].sampler = m_impostorSampler;
+    for (uint32_t i = 0; i < 4; ++i) {
+        bindGroupEntries[1 + i].binding = 2 + i;
+        bindGroupEntries[1 + i].textureView = m_impostorAtlas[i].CreateView();
+    }
+
+    wgpu::BindGroupDescriptor bindGroupDescriptor{};
+    bindGroupDescriptor.layout = m_impostorBindGroupLayout;
+    bindGroupDescriptor.entryCount = 5;
+    bindGroupDescriptor.entries = bindGroupEntries;
+
+    m_impostorBindGroup = m_device.CreateBindGroup(&bindGroupDescriptor);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double totalMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    std::cout << "Baked impostor atlas (" << kImpostorGridSize * kImpostorGridSize << " views, "
+              << instances.size() << " instances) in " << totalMs << "ms" << std::endl;
+}
+
+void Renderer::BakeImpostorAtlas(const glm::vec3& center, float radius) {
+    // One orthographic camera per atlas view, looking at the center from the octahedral direction
+    // of the view's cell. The depth range covers the bounding sphere.
+    const uint32_t viewCount = kImpostorGridSize * kImpostorGridSize;
+    std::vector<uint8_t> viewData(viewCount * kImpostorViewUniformStride, 0);
+    const glm::mat4 projection =
+        glm::ortho(-radius, radius, -radius, radius, radius, 3.0f * radius);
+
+    for (uint32_t y = 0; y < kImpostorGridSize; ++y) {
+        for (uint32_t x = 0; x < kImpostorGridSize; ++x) {
+            const glm::vec2 cell =
+                (glm::vec2(float(x), float(y)) + 0.5f) / float(kImpostorGridSize);
+            const glm::vec3 direction = OctahedralDecode(cell * 2.0f - 1.0f);
+            const glm::vec3 up = std::abs(direction.y) > 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f)
+                                                                : glm::vec3(0.0f, 1.0f, 0.0f);
+
+            ImpostorViewUniforms uniforms;
+            uniforms.viewProjectionMatrix =
+                projection * glm::lookAt(center + direction * (2.0f * radius), center, up);
+            std::memcpy(&viewData[(y * kImpostorGridSize + x) * kImpostorViewUniformStride],
+                        &uniforms, sizeof(uniforms));
+        }
+    }
+
+    wgpu::BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = viewData.size();
+    bufferDescriptor.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer viewBuffer = m_device.CreateBuffer(&bufferDescriptor);
+    m_device.GetQueue().WriteBuffer(viewBuffer, 0, viewData.data(), viewData.size());
+
+    wgpu::BindGroupEntry bindGroupEntry{};
+    bindGroupEntry.binding = 0;
+    bindGroupEntry.buffer = viewBuffer;
+    bindGroupEntry.offset = 0;
+    bindGroupEntry.size = sizeof(ImpostorViewUniforms);
+
+    wgpu::BindGroupDescriptor bindGroupDescriptor{};
+    bindGroupDescriptor.layout = m_impostorBakeBindGroupLayout;
+    bindGroupDescriptor.entryCount = 1;
+    bindGroupDescriptor.entries = &bindGroupEntry;
+    wgpu::BindGroup viewBindGroup = m_device.CreateBindGroup(&bindGroupDescriptor);
+
+    // Depth buffer for the whole atlas (only needed while baking)
+    const uint32_t atlasSize = kImpostorGridSize * kImpostorTileSize;
+    wgpu::TextureDescriptor depthDescriptor{};
+    depthDescriptor.size = {atlasSize, atlasSize, 1};
+    depthDescriptor.format = kImpostorBakeDepthFormat;
+    depthDescriptor.usage = wgpu::TextureUsage::RenderAttachment;
+    wgpu::Texture depthTexture = m_device.CreateTexture(&depthDescriptor);
+
+    wgpu::RenderPassColorAttachment colorAttachments[4]{};
+    for (uint32_t i = 0; i < 4; ++i) {
+        colorAttachments[i].view = m_impostorAtlas[i].CreateView();
+        colorAttachments[i].loadOp = wgpu::LoadOp::Clear;
+        colorAttachments[i].storeOp = wgpu::StoreOp::Store;
+        colorAttachments[i].clearValue = {.r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 0.0f};
+    }
+
+    wgpu::RenderPassDepthStencilAttachment depthAttachment{};
+    depthAttachment.view = depthTexture.CreateView();
+    depthAttachment.depthLoadOp = wgpu::LoadOp::Clear;
+    depthAttachment.depthStoreOp = wgpu::StoreOp::Discard;
+    depthAttachment.depthClearValue = 1.0f;
+
+    wgpu::RenderPassDescriptor renderPassDescriptor{};
+    renderPassDescriptor.colorAttachmentCount = 4;
+    renderPassDescriptor.colorAttachments = colorAttachments;
+    renderPassDescriptor.depthStencilAttachment = &depthAttachment;
+
+    wgpu::CommandEncoder encoder = m_device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPassDescriptor);
+    pass.SetPipeline(m_impostorBakePipeline);
+    pass.SetBindGroup(0, m_globalBindGroup);
+    pass.SetVertexBuffer(1, m_geometryTransformBuffer);
+    uint32_t boundGeometry = UINT32_MAX;
+
+    // The first instance is baked
+    for (uint32_t view = 0; view < viewCount; ++view) {
+        const uint32_t dynamicOffset = view * kImpostorViewUniformStride;
+        pass.SetViewport(float((view % kImpostorGridSize) * kImpostorTileSize),
+                         float((view / kImpostorGridSize) * kImpostorTileSize),
+                         float(kImpostorTileSize), float(kImpostorTileSize), 0.0f, 1.0f);
+        pass.SetBindGroup(2, viewBindGroup, 1, &dynamicOffset);
+
+        for (const std::vector<SubMesh> *subMeshes : {&m_opaqueMeshes, &m_transparentMeshes}) {
+            for (const SubMesh& subMesh : *subMeshes) {
+                if (subMesh.m_instanceIndex != 0) {
+                    continue;
+                }
+                pass.SetBindGroup(1, m_materials[subMesh.m_materialIndex].m_bindGroup);
+                DrawSubMesh(pass, subMesh, boundGeometry);
+            }
+        }
+    }
+    pass.End();
+
+    wgpu::CommandBuffer commands = encoder.Finish();
+    m_device.GetQueue().Submit(1, &commands);
+}
+
+void Renderer::ReleaseImpostors() {
+    for (wgpu::Texture& texture : m_impostorAtlas) {
+        if (texture) {
+            m_resourcePool->Release(texture);
+        }
+    }
+    if (m_impostorInstanceBuffer) {
+        m_resourcePool->Release(m_impostorInstanceBuffer);
+    }
+    m_impostorBindGroup = nullptr;
+    m_impostorSources.clear();
+    m_instanceUsesImpostor.clear();
+    m_impostorInstanceData.clear();
+}
+
+void Renderer::SelectImpostors(const glm::mat4& modelMatrix, const CameraUniformsInput& camera) {
+    m_impostorInstanceData.clear();
+    std::fill(m_instanceUsesImpostor.begin(), m_instanceUsesImpostor.end(), 0);
+    if (!m_impostorsEnabled || m_impostorSources.empty()) {
+        return;
+    }
+
+    // Projected diameter in pixels is radius * pixelScale / distance
+    const float pixelScale =
+        camera.projectionMatrix[1][1] * static_cast<float>(m_depthTexture.GetHeight());
+
+    for (size_t i = 0; i < m_impostorSources.size(); ++i) {
+        const ImpostorSource& source = m_impostorSources[i];
+        const glm::mat4 transform = modelMatrix * source.m_atlasToModel;
+        const glm::vec3 center = glm::vec3(transform * glm::vec4(m_impostorCenter, 1.0f));
+
+        // Instance transforms are rigid with a uniform scale
+        const glm::mat3 rotationScale = glm::mat3(transform);
+        const float scale = glm::length(rotationScale[0]);
+        const float radius = m_impostorRadius * scale;
+
+        const float distance = glm::length(center - camera.cameraPosition);
+        if (distance <= radius || radius * pixelScale > kImpostorScreenSize * distance) {
+            continue;
+        }
+
+        ImpostorInstanceData data;
+        data.centerRadius = glm::vec4(center, radius);
+        data.tint = source.m_tint;
+        for (int column = 0; column < 3; ++column) {
+            data.rotation[column] = glm::vec4(rotationScale[column] / scale, 0.0f);
+        }
+        m_impostorInstanceData.push_back(data);
+        m_instanceUsesImpostor[i] = 1;
+    }
+
+    if (!m_impostorInstanceData.empty()) {
+        m_device.GetQueue().WriteBuffer(m_impostorInstanceBuffer, 0, m_impostorInstanceData.data(),
+                                        m_impostorInstanceData.size() *
+                                            sizeof(ImpostorInstanceData));
+    }
+}
+
+bool Renderer::IsDrawnAsImpostor(int instanceIndex) const {
+    return instanceIndex >= 0 && m_instanceUsesImpostor[instanceIndex] != 0;
+}
+
 void Renderer::GetAdapter(const std::function<void(wgpu::Adapter)>& callback) {
     wgpu::RequestAdapterOptions options{};
     options.compatibleSurface = m_surface;
@@ -1167,6 +2675,21 @@ void Renderer::GetDevice(const std::function<void(wgpu::Device)>& callback) {
             std::exit(EXIT_FAILURE);
         });
 
+    // Request the adapter's limits instead of the defaults, e.g. 256 MB maxBufferSize, which large
+    // scans exceed
+    wgpu::Limits supportedLimits{};
+    m_adapter.GetLimits(&supportedLimits);
+    deviceDesc.requiredLimits = &supportedLimits;
+
+#if !defined(__EMSCRIPTEN__)
+    // Dawn's thread-safe device mode lets materials be created on worker threads
+    const wgpu::FeatureName threadSafeDevice = wgpu::FeatureName::ImplicitDeviceSynchronization;
+    if (m_adapter.HasFeature(threadSafeDevice)) {
+        deviceDesc.requiredFeatureCount = 1;
+        deviceDesc.requiredFeatures = &threadSafeDevice;
+    }
+#endif
+
     m_adapter.RequestDevice(
         &deviceDesc, wgpu::CallbackMode::AllowSpontaneous,
         [callback](wgpu::RequestDeviceStatus status, wgpu::Device device, wgpu::StringView message) {
@@ -1181,15 +2704,3 @@ void Renderer::GetDevice(const std::function<void(wgpu::Device)>& callback) {
             callback(std::move(device));
         });
 }
-
-std::string Renderer::LoadShaderFile(const std::string& filepath) const {
-    std::ifstream file(filepath, std::ios::in | std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open shader file: " + filepath + "\n";
-        return "";
-    }
-
-    std::ostringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
-}
\ No newline at end of file
@@ -3,6 +3,7 @@
 // Standard Library Headers
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -12,7 +13,9 @@
 
 // Forward Declarations
 class Environment;
+class GpuResourcePool;
 class Model;
+class TextureFeedback;
 struct GLFWwindow;
 
 // Renderer Class
@@ -25,8 +28,47 @@ class Renderer {
         glm::vec3 cameraPosition;
     };
 
-    // Constructor
-    Renderer() = default;
+    enum class DebugView {
+        None = 0,
+        Overdraw,        // Fragments per pixel (all submeshes, no depth test)
+        TriangleDensity, // Triangles per pixel, averaged over screen tiles
+        TextureFetches,  // Material textures sampled per fragment
+        SubMeshIds,      // Hashed submesh IDs
+        MaterialIds      // Hashed material IDs
+    };
+
+    enum class QualityTier {
+        Low = 0, // Analytic BRDF, SH diffuse IBL, small IBL maps
+        Medium,  // BRDF LUT, irradiance cube, medium IBL maps
+        High     // BRDF LUT, irradiance cube, full resolution IBL maps
+    };
+
+    // Material texture memory according to the latest texture LOD feedback
+    struct TextureResidency {
+        size_t m_textureCount = 0;    // Unique material textures
+        size_t m_sampledCount = 0;    // Textures visible in the latest feedback pass
+        uint64_t m_allMipsBytes = 0;  // All mip levels resident
+        uint64_t m_requiredBytes = 0; // Mip levels from the finest one seen on screen
+        uint64_t m_plannedBytes = 0;  // Residency plan within the budget
+        uint64_t m_readbackCount = 0; // Feedback results received so far
+    };
+
+    // GPU objects held through the resource pool, to catch leaks across model and environment
+    // switches. Sizes are estimates; per-frame and pipeline objects are not included.
+    struct ResourceStats {
+        uint64_t m_liveBytes = 0;   // Acquired textures and buffers
+        uint64_t m_pooledBytes = 0; // Idle textures and buffers kept for reuse
+        size_t m_liveTextures = 0;
+        size_t m_liveBuffers = 0;
+        size_t m_pooledTextures = 0;
+        size_t m_pooledBuffers = 0;
+        size_t m_materialCount = 0;    // One bind group each
+        size_t m_environmentCount = 0; // Cached environments, one bind group each
+    };
+
+    // Constructor and Destructor
+    Renderer();
+    ~Renderer();
 
     // Rule of 5
     Renderer(const Renderer&) = delete;
@@ -42,8 +84,22 @@ class Renderer {
     void ReloadShaders();
     void UpdateModel(const Model& model);
     void UpdateEnvironment(const Environment& environment);
+    void SetDebugView(DebugView debugView) noexcept;
+    DebugView GetDebugView() const noexcept;
+    void SetQualityTier(QualityTier tier, const Environment& environment);
+    QualityTier GetQualityTier() const noexcept;
+    void SetCpuEnvironmentPreprocessing(bool enabled, const Environment& environment);
+    bool GetCpuEnvironmentPreprocessing() const noexcept;
+    void SetImpostorsEnabled(bool enabled) noexcept;
+    bool GetImpostorsEnabled() const noexcept;
+    TextureResidency GetTextureResidency(uint64_t budgetBytes) const;
+    ResourceStats GetResourceStats() const;
 
   private:
+    // Forward Declarations
+    struct PreparedEnvironment;
+    struct SubMesh;
+
     // Private utility methods
     void InitGraphics(const Environment& environment, const Model& model, uint32_t width,
                       uint32_t height);
@@ -51,22 +107,42 @@ class Renderer {
     void CreateDepthTexture(uint32_t width, uint32_t height);
     void CreateBindGroupLayouts();
     void CreateSamplers();
-    void CreateVertexBuffer(const Model& model);
-    void CreateIndexBuffer(const Model& model);
+    void CreateGeometryBuffers(const Model& model);
+    void CreateGeometryTransformBuffer(const Model& model);
     void CreateUniformBuffers();
-    void CreateEnvironmentTextures(const Environment& environment);
+    void CreateEnvironmentTextures(const Environment& environment,
+                                   PreparedEnvironment& prepared);
+    void GenerateEnvironmentMapsOnCpu(const Environment& environment,
+                                      PreparedEnvironment& prepared,
+                                      const wgpu::Texture& specularTexture,
+                                      uint32_t environmentCubeSize);
+    void ReleaseEnvironment(PreparedEnvironment& prepared);
+    void TrimEnvironmentCache();
     void CreateSubMeshes(const Model& model);
     void CreateMaterials(const Model& model);
-    void CreateGlobalBindGroup();
+    void ReleaseMaterials();
+    void CreateGlobalBindGroup(PreparedEnvironment& prepared);
     void CreateEnvironmentRenderPipeline();
     void CreateModelRenderPipelines();
     void CreateRenderPassDescriptor();
     void CreateDefaultTextures();
+    void CreateDebugViewPipelines();
+    void CreateDebugAccumulationTexture(uint32_t width, uint32_t height);
+    void CreateDebugDrawUniforms();
+    void RenderDebugView(wgpu::CommandEncoder& encoder);
+    void DrawDebugSubMeshes(wgpu::RenderPassEncoder& pass) const;
+    void DrawSubMesh(wgpu::RenderPassEncoder& pass, const SubMesh& subMesh,
+                     uint32_t& boundGeometry) const;
+    void RenderTextureFeedback(wgpu::CommandEncoder& encoder) const;
     void UpdateUniforms(const glm::mat4& modelMatrix, const CameraUniformsInput& camera) const;
     void SortTransparentMeshes(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix);
+    void CreateImpostors(const Model& model);
+    void BakeImpostorAtlas(const glm::vec3& center, float radius);
+    void ReleaseImpostors();
+    void SelectImpostors(const glm::mat4& modelMatrix, const CameraUniformsInput& camera);
+    bool IsDrawnAsImpostor(int instanceIndex) const;
     void GetAdapter(const std::function<void(wgpu::Adapter)>& callback);
     void GetDevice(const std::function<void(wgpu::Device)>& callback);
-    std::string LoadShaderFile(const std::string& filepath) const;
 
     // Types
     struct GlobalUniforms {
@@ -90,8 +166,47 @@ class Renderer {
         alignas(4) float roughnessFactor;
         alignas(4) float normalScale;
         alignas(4) float occlusionStrength;
-        alignas(4) float alphaCutoff; // Used for Mask mode
-        alignas(4) int alphaMode;     // 0 = Opaque, 1 = Mask, 2 = Blend
+        alignas(4) float alphaCutoff;      // Used for Mask mode
+        alignas(4) int alphaMode;          // 0 = Opaque, 1 = Mask, 2 = Blend
+        alignas(4) uint32_t textureMask;   // Bound material textures (kTextureMask* bits)
+        alignas(4) uint32_t materialIndex; // Texture LOD feedback entry
+    };
+
+    // Material texture bits used by the texture fetch debug view
+    static constexpr uint32_t kTextureMaskBaseColor = 1u << 0;
+    static constexpr uint32_t kTextureMaskMetallicRoughness = 1u << 1;
+    static constexpr uint32_t kTextureMaskNormal = 1u << 2;
+    static constexpr uint32_t kTextureMaskOcclusion = 1u << 3;
+    static constexpr uint32_t kTextureMaskEmissive = 1u << 4;
+
+    struct DebugDrawUniforms {
+        uint32_t subMeshIndex;
+        uint32_t materialIndex;
+        uint32_t _pad[2];
+    };
+
+    struct DebugViewUniforms {
+        uint32_t mode;     // DebugView
+        uint32_t tileSize; // Resolve averaging tile size in pixels
+        float maxValue;    // Resolve value mapped to the hot end of the heatmap
+        float _pad;
+    };
+
+    struct ImpostorViewUniforms {
+        alignas(16) glm::mat4 viewProjectionMatrix;
+    };
+
+    // Per-instance vertex data of an impostor quad
+    struct ImpostorInstanceData {
+        glm::vec4 centerRadius; // World-space bounding sphere
+        glm::vec4 tint;         // Base color tint of the instance
+        glm::vec4 rotation[3];  // Atlas space to world space rotation (columns)
+    };
+
+    // Model instance that can be replaced by an impostor
+    struct ImpostorSource {
+        glm::mat4 m_atlasToModel; // Atlas space (the baked instance) to model space
+        glm::vec4 m_tint;
     };
 
     struct Material {
@@ -110,6 +225,18 @@ class Renderer {
         uint32_t m_indexCount = 0; // Number of indices in the submesh
         int m_materialIndex = -1;  // Material index for the submesh
         glm::vec3 m_centroid;
+        int m_instanceIndex = -1;  // Model instance the submesh belongs to (-1 if none)
+        uint32_t m_transformIndex = 0; // Geometry transform (firstInstance of the draw)
+        uint32_t m_geometryBuffer = 0; // Vertex and index buffer pair (m_geometryBuffers)
+    };
+
+    // Vertex and index buffers of a contiguous part of the model's index array
+    struct GeometryBuffer {
+        wgpu::Buffer m_vertexBuffer;
+        wgpu::Buffer m_indexBuffer;
+        uint32_t m_firstVertex = 0; // Model vertex at the start of the vertex buffer
+        uint32_t m_firstIndex = 0;  // Model index at the start of the index buffer
+        uint32_t m_indexCount = 0;
     };
 
     struct SubMeshDepthInfo {
@@ -117,6 +244,29 @@ class Renderer {
         uint32_t m_meshIndex = 0;
     };
 
+    struct PreparedEnvironment {
+        std::string m_name;         // Environment texture name (source file)
+        uint64_t m_contentHash = 0; // Environment::Texture::m_contentHash, the cache key
+        QualityTier m_qualityTier = QualityTier::High;
+        bool m_cpuPreprocessed = false; // IBL maps generated by CpuEnvironmentPreprocessor
+        wgpu::Texture m_environmentTexture;
+        wgpu::TextureView m_environmentTextureView;
+        wgpu::Texture m_iblIrradianceTexture;
+        wgpu::TextureView m_iblIrradianceTextureView;
+        wgpu::Texture m_iblSpecularTexture;
+        wgpu::TextureView m_iblSpecularTextureView;
+        wgpu::Texture m_iblBrdfIntegrationLUT;
+        wgpu::TextureView m_iblBrdfIntegrationLUTView;
+        wgpu::Texture m_environmentOctahedralTexture; // Octahedral tiers (replace the cubes)
+        wgpu::TextureView m_environmentOctahedralTextureView;
+        wgpu::Texture m_iblSpecularOctahedralTexture;
+        wgpu::TextureView m_iblSpecularOctahedralTextureView;
+        wgpu::Buffer m_iblIrradianceSHBuffer;
+        wgpu::BindGroup m_globalBindGroup;
+        uint64_t m_sizeInBytes = 0; // Estimated GPU memory of the textures
+        uint64_t m_lastUsed = 0;    // Use counter value when last activated
+    };
+
     // WebGPU resources
     wgpu::Instance m_instance;
     wgpu::Adapter m_adapter;
@@ -128,23 +278,22 @@ class Renderer {
     wgpu::RenderPassDescriptor m_renderPassDescriptor{};
     wgpu::RenderPassColorAttachment m_colorAttachment{};
     wgpu::RenderPassDepthStencilAttachment m_depthAttachment{};
+    std::unique_ptr<GpuResourcePool> m_resourcePool;
+    bool m_preferShaderFiles = false; // Set by ReloadShaders, edits on disk win over the archive
 
     // Global data
     wgpu::Buffer m_globalUniformBuffer;
     wgpu::BindGroupLayout m_globalBindGroupLayout;
     wgpu::BindGroup m_globalBindGroup;
 
-    // Environment and IBL related data
-    wgpu::Texture m_environmentTexture;
-    wgpu::TextureView m_environmentTextureView;
-    wgpu::Texture m_iblIrradianceTexture;
-    wgpu::TextureView m_iblIrradianceTextureView;
-    wgpu::Texture m_iblSpecularTexture;
-    wgpu::TextureView m_iblSpecularTextureView;
-    wgpu::Texture m_iblBrdfIntegrationLUT;
-    wgpu::TextureView m_iblBrdfIntegrationLUTView;
+    // Environment and IBL related data (prepared environments are cached, the active one is
+    // selected by binding its global bind group)
+    std::vector<PreparedEnvironment> m_environmentCache;
+    uint64_t m_environmentUseCounter = 0;
     wgpu::Sampler m_environmentCubeSampler;
     wgpu::Sampler m_iblBrdfIntegrationLUTSampler;
+    QualityTier m_qualityTier = QualityTier::High;
+    bool m_cpuEnvironmentPreprocessing = false; // Bake the IBL maps on the CPU instead of the GPU
     wgpu::ShaderModule m_environmentShaderModule;
     wgpu::RenderPipeline m_environmentPipeline;
 
@@ -153,8 +302,9 @@ class Renderer {
     wgpu::BindGroupLayout m_modelBindGroupLayout;
     wgpu::RenderPipeline m_modelPipelineOpaque;
     wgpu::RenderPipeline m_modelPipelineTransparent;
-    wgpu::Buffer m_vertexBuffer;
-    wgpu::Buffer m_indexBuffer;
+    wgpu::RenderPipeline m_textureFeedbackPipeline;
+    std::vector<GeometryBuffer> m_geometryBuffers; // Split to stay within maxBufferSize
+    wgpu::Buffer m_geometryTransformBuffer; // Per-instance vertex buffer (slot 1)
     wgpu::Buffer m_modelUniformBuffer;
     wgpu::Sampler m_modelTextureSampler;
 
@@ -175,4 +325,41 @@ class Renderer {
 
     // Per-frame sorted transparent meshes
     std::vector<SubMeshDepthInfo> m_transparentMeshesDepthSorted;
+
+    // Debug views
+    DebugView m_debugView = DebugView::None;
+    wgpu::ShaderModule m_debugShaderModule;
+    wgpu::ShaderModule m_debugResolveShaderModule;
+    wgpu::BindGroupLayout m_debugDrawBindGroupLayout;
+    wgpu::BindGroupLayout m_debugResolveBindGroupLayout;
+    wgpu::RenderPipeline m_debugOverdrawPipeline;
+    wgpu::RenderPipeline m_debugTriangleDensityPipeline;
+    wgpu::RenderPipeline m_debugSurfacePipeline;
+    wgpu::RenderPipeline m_debugResolvePipeline;
+    wgpu::Texture m_debugAccumulationTexture;
+    wgpu::TextureView m_debugAccumulationTextureView;
+    wgpu::Buffer m_debugViewUniformBuffer;
+    wgpu::Buffer m_debugDrawUniformBuffer;
+    wgpu::BindGroup m_debugDrawBindGroup;
+    wgpu::BindGroup m_debugResolveBindGroup;
+
+    // Impostors for distant instances of replicated models. The atlas holds octahedral views of
+    // the first instance (albedo, normal/depth, material and emissive).
+    bool m_impostorsEnabled = true;
+    wgpu::BindGroupLayout m_impostorBakeBindGroupLayout;
+    wgpu::BindGroupLayout m_impostorBindGroupLayout;
+    wgpu::RenderPipeline m_impostorBakePipeline;
+    wgpu::RenderPipeline m_impostorPipeline;
+    wgpu::Sampler m_impostorSampler;
+    wgpu::Texture m_impostorAtlas[4];
+    wgpu::BindGroup m_impostorBindGroup;
+    wgpu::Buffer m_impostorInstanceBuffer;
+    glm::vec3 m_impostorCenter{0.0f}; // Bounding sphere of the baked instance (atlas space)
+    float m_impostorRadius = 0.0f;
+    std::vector<ImpostorSource> m_impostorSources;
+    std::vector<uint8_t> m_instanceUsesImpostor; // Per model instance, updated every frame
+    std::vector<ImpostorInstanceData> m_impostorInstanceData;
+
+    // Texture LOD feedback: finest mip level per material texture seen on screen
+    std::unique_ptr<TextureFeedback> m_textureFeedback;
 };
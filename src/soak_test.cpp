@@ -0,0 +1,189 @@
+// Standard Library Headers
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+// Platform Headers
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+// Project Headers
+#include "frame_time_recorder.h"
+#include "soak_test.h"
+
+//----------------------------------------------------------------------
+// Internal Constants and Utility Functions
+
+namespace {
+
+constexpr double kMB = 1024.0 * 1024.0;
+
+uint64_t GetResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info),
+                  &count) == KERN_SUCCESS) {
+        return info.resident_size;
+    }
+    return 0;
+#elif defined(__linux__)
+    // The second field of statm is the resident set size in pages
+    uint64_t residentBytes = 0;
+    if (FILE *file = std::fopen("/proc/self/statm", "r")) {
+        unsigned long long sizePages = 0, residentPages = 0;
+        if (std::fscanf(file, "%llu %llu", &sizePages, &residentPages) == 2) {
+            residentBytes = residentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        }
+        std::fclose(file);
+    }
+    return residentBytes;
+#else
+    return 0;
+#endif
+}
+
+// Textures and buffers in use plus the material and environment bind groups
+size_t CountLiveObjects(const Renderer::ResourceStats& resources) {
+    return resources.m_liveTextures + resources.m_liveBuffers + resources.m_materialCount +
+           resources.m_environmentCount;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// SoakTest Class Implementation
+
+SoakTest::SoakTest(const Config& config) : m_config(config) {
+    m_latencies.reserve(m_config.m_windowCycles);
+}
+
+SoakTest::Action SoakTest::Advance() {
+    if (m_switchPending) {
+        // This frame is the first one showing the new asset
+        const float latency = std::chrono::duration<float, std::milli>(
+                                  std::chrono::steady_clock::now() - m_switchStart)
+                                  .count();
+        if (m_cycleIndex > m_config.m_warmupCycles) {
+            m_latencies.push_back(latency);
+        }
+        m_switchPending = false;
+        m_frameIndex = 0;
+    }
+
+    if (++m_frameIndex < m_config.m_framesPerCycle) {
+        return Action::None;
+    }
+    return m_cycleIndex < m_config.m_cycleCount ? Action::SwitchAsset : Action::Finished;
+}
+
+void SoakTest::RecordCycle(const Renderer::ResourceStats& resources) {
+    // The end of the warm-up is the baseline, measured windows follow
+    const uint32_t warmupCycles = m_config.m_warmupCycles;
+    const uint32_t windowCycles = std::max(m_config.m_windowCycles, 1u);
+    const bool windowEnd =
+        m_cycleIndex == warmupCycles ||
+        (m_cycleIndex > warmupCycles && (m_cycleIndex - warmupCycles) % windowCycles == 0);
+
+    if (windowEnd || m_cycleIndex >= m_config.m_cycleCount) {
+        FinishWindow(resources);
+    }
+}
+
+const std::string& SoakTest::BeginSwitch() {
+    const std::string& file = m_config.m_files[m_cycleIndex % m_config.m_files.size()];
+    m_cycleIndex++;
+    m_switchPending = true;
+    m_switchStart = std::chrono::steady_clock::now();
+    return file;
+}
+
+void SoakTest::PrintSummary() const {
+    std::cout << "Soak test results (" << m_cycleIndex << " switches between "
+              << m_config.m_files.size() << " files, " << m_config.m_framesPerCycle
+              << " frames per switch)" << std::endl;
+    std::cout << std::setw(8) << "cycle" << std::setw(10) << "p50 ms" << std::setw(10) << "p95 ms"
+              << std::setw(10) << "p99 ms" << std::setw(10) << "max ms" << std::setw(10)
+              << "RSS MB" << std::setw(10) << "GPU MB" << std::setw(10) << "pool MB"
+              << std::setw(10) << "objects" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (const WindowResult& result : m_results) {
+        std::cout << std::setw(8) << result.m_cycle << std::setw(10) << result.m_p50
+                  << std::setw(10) << result.m_p95 << std::setw(10) << result.m_p99
+                  << std::setw(10) << result.m_max << std::setw(10)
+                  << result.m_residentBytes / kMB << std::setw(10)
+                  << result.m_resources.m_liveBytes / kMB << std::setw(10)
+                  << result.m_resources.m_pooledBytes / kMB << std::setw(10)
+                  << CountLiveObjects(result.m_resources) << std::endl;
+    }
+
+    // Compare the last window with the baseline (memory) and the first measured window (latency)
+    if (m_results.size() >= 2) {
+        const WindowResult& baseline = m_results.front();
+        const WindowResult& first = m_results[1];
+        const WindowResult& last = m_results.back();
+        const double residentDrift =
+            (static_cast<double>(last.m_residentBytes) - baseline.m_residentBytes) / kMB;
+        const double gpuDrift = (static_cast<double>(last.m_resources.m_liveBytes) -
+                                 baseline.m_resources.m_liveBytes) /
+                                kMB;
+        const long long objectDrift =
+            static_cast<long long>(CountLiveObjects(last.m_resources)) -
+            static_cast<long long>(CountLiveObjects(baseline.m_resources));
+
+        std::cout << std::showpos << "Drift since cycle " << baseline.m_cycle << ": RSS "
+                  << residentDrift << " MB, GPU " << gpuDrift << " MB, objects " << objectDrift
+                  << ", p95 latency " << last.m_p95 - first.m_p95 << " ms since cycle "
+                  << std::noshowpos << first.m_cycle << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+const std::vector<SoakTest::WindowResult>& SoakTest::GetResults() const noexcept {
+    return m_results;
+}
+
+void SoakTest::FinishWindow(const Renderer::ResourceStats& resources) {
+    std::vector<float> sorted = m_latencies;
+    std::sort(sorted.begin(), sorted.end());
+
+    WindowResult result;
+    result.m_cycle = m_cycleIndex;
+    result.m_p50 = FrameTimeRecorder::GetSortedPercentile(sorted, 0.50f);
+    result.m_p95 = FrameTimeRecorder::GetSortedPercentile(sorted, 0.95f);
+    result.m_p99 = FrameTimeRecorder::GetSortedPercentile(sorted, 0.99f);
+    result.m_max = sorted.empty() ? 0.0f : sorted.back();
+    result.m_residentBytes = GetResidentBytes();
+    result.m_resources = resources;
+    m_results.push_back(result);
+    m_latencies.clear();
+
+    PrintWindow(result);
+}
+
+void SoakTest::PrintWindow(const WindowResult& result) const {
+    std::cout << std::fixed << std::setprecision(2) << "Soak test cycle " << result.m_cycle
+              << "/" << m_config.m_cycleCount << ": switch p50 " << result.m_p50 << " ms, p95 "
+              << result.m_p95 << " ms, RSS " << result.m_residentBytes / kMB << " MB, GPU "
+              << result.m_resources.m_liveBytes / kMB << " MB (+"
+              << result.m_resources.m_pooledBytes / kMB << " MB pooled), "
+              << CountLiveObjects(result.m_resources) << " objects" << std::defaultfloat
+              << std::endl;
+}
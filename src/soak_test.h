@@ -0,0 +1,78 @@
+#pragma once
+
+// Standard Library Headers
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Project Headers
+#include "renderer.h"
+
+// SoakTest Class
+//
+// Switches between models and environments for thousands of cycles, the way a long-running
+// kiosk viewer does, and reports whether switching gets slower or leaks memory over time. Each
+// cycle loads the next file through the regular file drop path and displays it for a few frames.
+// Switch latency (from the start of the load to the end of the first frame showing the new
+// asset) is summarized per window of cycles, together with the resident memory of the process and
+// the GPU memory and objects held by the renderer at the end of the window.
+class SoakTest {
+  public:
+    // Types
+    enum class Action {
+        None,        // Keep displaying the current asset
+        SwitchAsset, // Call RecordCycle(), then load BeginSwitch()'s file
+        Finished     // All cycles done; call RecordCycle() and print the summary
+    };
+
+    struct Config {
+        std::vector<std::string> m_files; // Models and environments, loaded in turn
+        uint32_t m_cycleCount = 2000;
+        uint32_t m_warmupCycles = 50;  // Not measured; fills the environment cache and the pool
+        uint32_t m_windowCycles = 100; // Cycles summarized per reported window
+        uint32_t m_framesPerCycle = 5; // Frames displayed after each switch
+    };
+
+    struct WindowResult {
+        uint32_t m_cycle = 0; // Switches done at the end of the window
+        float m_p50 = 0.0f;   // Switch latency percentiles (ms)
+        float m_p95 = 0.0f;
+        float m_p99 = 0.0f;
+        float m_max = 0.0f;
+        uint64_t m_residentBytes = 0; // Process RSS; 0 where it cannot be queried
+        Renderer::ResourceStats m_resources;
+    };
+
+    // Constructor
+    explicit SoakTest(const Config& config);
+
+    // Rule of 5
+    SoakTest(const SoakTest&) = delete;
+    SoakTest& operator=(const SoakTest&) = delete;
+    SoakTest(SoakTest&&) = default;
+    SoakTest& operator=(SoakTest&&) = default;
+
+    // Public Interface
+    Action Advance(); // Once per rendered frame
+    void RecordCycle(const Renderer::ResourceStats& resources);
+    const std::string& BeginSwitch();
+    void PrintSummary() const;
+
+    // Accessors
+    const std::vector<WindowResult>& GetResults() const noexcept;
+
+  private:
+    // Private Member Functions
+    void FinishWindow(const Renderer::ResourceStats& resources);
+    void PrintWindow(const WindowResult& result) const;
+
+    // Private Member Variables
+    Config m_config;
+    uint32_t m_cycleIndex = 0; // Switches started so far
+    uint32_t m_frameIndex = 0; // Frames displayed since the last switch
+    bool m_switchPending = false;
+    std::chrono::steady_clock::time_point m_switchStart;
+    std::vector<float> m_latencies; // Current window
+    std::vector<WindowResult> m_results;
+};
@@ -0,0 +1,200 @@
+// Standard Library Headers
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+// Third-Party Library Headers
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#define GLM_FORCE_RIGHT_HANDED
+#include <glm/ext.hpp>
+#include <glm/glm.hpp>
+
+// Project Headers
+#include "frame_time_recorder.h"
+#include "stress_test.h"
+
+//----------------------------------------------------------------------
+// Internal Constants and Utility Functions
+
+namespace {
+
+// Model indices are 32-bit, so a scene can hold at most this many vertices. Larger geometry is
+// split over several buffers by the renderer; the index range is the remaining limit.
+constexpr uint64_t kMaxSceneVertices = uint64_t{UINT32_MAX} + 1;
+
+} // namespace
+
+//----------------------------------------------------------------------
+// StressTest Class Implementation
+
+StressTest::StressTest(const Model& sourceModel, const Config& config)
+    : m_sourceModel(sourceModel), m_config(config) {
+    m_frameTimes.reserve(m_config.m_measureFrames);
+}
+
+StressTest::Action StressTest::Advance(float frameTimeMs) {
+    if (m_stepIndex >= m_config.m_steps.size()) {
+        return Action::Finished;
+    }
+
+    if (!m_sceneBuilt) {
+        // Make sure the vertices of the next scene can be addressed by the model's indices
+        const uint32_t stepCount = m_config.m_steps[m_stepIndex];
+        const uint64_t instanceCount =
+            static_cast<uint64_t>(stepCount) * m_config.m_rows * m_config.m_layers;
+        const uint64_t vertexCount = instanceCount * m_sourceModel.GetVertices().size();
+        if (vertexCount > kMaxSceneVertices) {
+            std::cout << "Stress test: stopping before " << DescribeStep(stepCount) << " ("
+                      << vertexCount << " vertices exceed the 32-bit index range)" << std::endl;
+            m_stepIndex = m_config.m_steps.size();
+            return Action::Finished;
+        }
+
+        m_sceneBuilt = true;
+        m_frameIndex = 0;
+        m_frameTimes.clear();
+        return Action::RebuildScene;
+    }
+
+    // Skip the warmup frames (these include the upload of the new scene)
+    if (++m_frameIndex <= m_config.m_warmupFrames) {
+        return Action::None;
+    }
+
+    m_frameTimes.push_back(frameTimeMs);
+    if (m_frameTimes.size() < m_config.m_measureFrames) {
+        return Action::None;
+    }
+
+    FinishStep();
+    m_sceneBuilt = false;
+    if (++m_stepIndex >= m_config.m_steps.size()) {
+        return Action::Finished;
+    }
+
+    return Advance(frameTimeMs);
+}
+
+void StressTest::BuildScene(Model& model) const {
+    const uint32_t stepCount = m_config.m_steps[std::min(m_stepIndex, m_config.m_steps.size() - 1)];
+
+    model = m_sourceModel;
+    model.Replicate(ComputeInstanceTransforms(stepCount), m_config.m_materialVariants);
+
+    std::cout << "Stress test: " << DescribeStep(stepCount) << " with "
+              << model.GetSubMeshes().size() << " submeshes and "
+              << model.GetIndices().size() / 3 << " triangles" << std::endl;
+}
+
+void StressTest::RestartStep() {
+    // Warm up again, the rebuild itself must not be measured either
+    m_frameIndex = 0;
+    m_frameTimes.clear();
+}
+
+void StressTest::PrintSummary() const {
+    std::cout << "Stress test results (" << m_config.m_measureFrames << " frames per step, "
+              << (m_config.m_layout == Layout::Grid ? "grid" : "scatter") << " layout)"
+              << std::endl;
+    std::cout << std::setw(10) << "instances" << std::setw(11) << "submeshes" << std::setw(12)
+              << "triangles" << std::setw(10) << "p50 ms" << std::setw(10) << "p95 ms"
+              << std::setw(10) << "p99 ms" << std::setw(10) << "max ms" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (const StepResult& result : m_results) {
+        std::cout << std::setw(10) << result.m_instanceCount << std::setw(11)
+                  << result.m_subMeshCount << std::setw(12) << result.m_triangleCount
+                  << std::setw(10) << result.m_p50 << std::setw(10) << result.m_p95
+                  << std::setw(10) << result.m_p99 << std::setw(10) << result.m_max << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+const Model& StressTest::GetSourceModel() const noexcept {
+    return m_sourceModel;
+}
+
+const std::vector<StressTest::StepResult>& StressTest::GetResults() const noexcept {
+    return m_results;
+}
+
+std::vector<glm::mat4> StressTest::ComputeInstanceTransforms(uint32_t stepCount) const {
+    glm::vec3 minBounds, maxBounds;
+    m_sourceModel.GetBounds(minBounds, maxBounds);
+
+    const glm::vec3 center = (minBounds + maxBounds) * 0.5f;
+    const glm::vec3 extent = maxBounds - minBounds;
+    const float cellSize =
+        std::max({extent.x, extent.y, extent.z, 1e-3f}) * std::max(m_config.m_spacing, 1.0f);
+
+    const uint32_t countX = stepCount;
+    const uint32_t countY = m_config.m_layers;
+    const uint32_t countZ = m_config.m_rows;
+    const glm::vec3 halfSize =
+        glm::vec3(float(countX - 1), float(countY - 1), float(countZ - 1)) * (0.5f * cellSize);
+
+    // Center each instance in its cell
+    const glm::mat4 recenter = glm::translate(glm::mat4(1.0f), -center);
+
+    std::vector<glm::mat4> transforms;
+    transforms.reserve(static_cast<size_t>(countX) * countY * countZ);
+
+    if (m_config.m_layout == Layout::Grid) {
+        for (uint32_t y = 0; y < countY; ++y) {
+            for (uint32_t z = 0; z < countZ; ++z) {
+                for (uint32_t x = 0; x < countX; ++x) {
+                    glm::vec3 position = glm::vec3(float(x), float(y), float(z)) * cellSize;
+                    transforms.push_back(glm::translate(glm::mat4(1.0f), position - halfSize) *
+                                         recenter);
+                }
+            }
+        }
+    } else {
+        // Scatter the same number of instances over the grid volume with random orientations
+        std::mt19937 rng(m_config.m_seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        const glm::vec3 volume = halfSize * 2.0f;
+        const size_t count = static_cast<size_t>(countX) * countY * countZ;
+
+        for (size_t i = 0; i < count; ++i) {
+            glm::vec3 position(unit(rng) * volume.x, unit(rng) * volume.y, unit(rng) * volume.z);
+            float yaw = unit(rng) * 6.2831853f;
+            transforms.push_back(glm::translate(glm::mat4(1.0f), position - halfSize) *
+                                 glm::rotate(glm::mat4(1.0f), yaw, glm::vec3(0.0f, 1.0f, 0.0f)) *
+                                 recenter);
+        }
+    }
+
+    return transforms;
+}
+
+void StressTest::FinishStep() {
+    const uint32_t stepCount = m_config.m_steps[m_stepIndex];
+
+    std::vector<float> sorted = m_frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+
+    StepResult result;
+    result.m_instanceCount = stepCount * m_config.m_rows * m_config.m_layers;
+    result.m_subMeshCount = m_sourceModel.GetSubMeshes().size() * result.m_instanceCount;
+    result.m_triangleCount = m_sourceModel.GetIndices().size() / 3 * result.m_instanceCount;
+    result.m_p50 = FrameTimeRecorder::GetSortedPercentile(sorted, 0.50f);
+    result.m_p95 = FrameTimeRecorder::GetSortedPercentile(sorted, 0.95f);
+    result.m_p99 = FrameTimeRecorder::GetSortedPercentile(sorted, 0.99f);
+    result.m_max = sorted.empty() ? 0.0f : sorted.back();
+    m_results.push_back(result);
+
+    std::cout << "Stress test: " << DescribeStep(stepCount) << " p50 " << result.m_p50
+              << "ms, p95 " << result.m_p95 << "ms, p99 " << result.m_p99 << "ms, max "
+              << result.m_max << "ms" << std::endl;
+}
+
+std::string StressTest::DescribeStep(uint32_t stepCount) const {
+    std::ostringstream description;
+    description << stepCount << "x" << m_config.m_rows << "x" << m_config.m_layers << " "
+                << (m_config.m_layout == Layout::Grid ? "grid" : "scatter") << " ("
+                << stepCount * m_config.m_rows * m_config.m_layers << " instances)";
+    return description.str();
+}
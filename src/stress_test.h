@@ -0,0 +1,85 @@
+#pragma once
+
+// Standard Library Headers
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Third-Party Library Headers
+#include <glm/glm.hpp>
+
+// Project Headers
+#include "model.h"
+
+// StressTest Class
+//
+// Replicates a source model into progressively larger synthetic scenes (a grid or a random
+// scatter), measures frame times over a fixed camera orbit for each scene size and reports
+// frame-time percentiles as the instance count grows.
+class StressTest {
+  public:
+    // Types
+    enum class Layout { Grid, Scatter };
+
+    enum class Action {
+        None,         // Keep rendering the current scene
+        RebuildScene, // Call BuildScene() and upload the new model
+        Finished      // All steps measured; restore the source model
+    };
+
+    struct Config {
+        Layout m_layout = Layout::Grid;
+        std::vector<uint32_t> m_steps = {1, 2, 4, 6, 8, 12, 16}; // Instances along X (N)
+        uint32_t m_rows = 4;                                     // Instances along Z (M)
+        uint32_t m_layers = 1;                                   // Instances along Y (K)
+        uint32_t m_materialVariants = 4;                         // Tinted copies per material
+        float m_spacing = 1.25f;     // Distance between instances relative to model size
+        uint32_t m_seed = 1234;      // Seed for the scatter layout
+        uint32_t m_warmupFrames = 30;
+        uint32_t m_measureFrames = 240;
+    };
+
+    struct StepResult {
+        uint32_t m_instanceCount = 0;
+        size_t m_subMeshCount = 0;
+        size_t m_triangleCount = 0;
+        float m_p50 = 0.0f;
+        float m_p95 = 0.0f;
+        float m_p99 = 0.0f;
+        float m_max = 0.0f;
+    };
+
+    // Constructor
+    StressTest(const Model& sourceModel, const Config& config);
+
+    // Rule of 5
+    StressTest(const StressTest&) = delete;
+    StressTest& operator=(const StressTest&) = delete;
+    StressTest(StressTest&&) = default;
+    StressTest& operator=(StressTest&&) = default;
+
+    // Public Interface
+    Action Advance(float frameTimeMs);
+    void BuildScene(Model& model) const;
+    void RestartStep(); // Measure the current scene again, e.g. after a quality tier change
+    void PrintSummary() const;
+
+    // Accessors
+    const Model& GetSourceModel() const noexcept;
+    const std::vector<StepResult>& GetResults() const noexcept;
+
+  private:
+    // Private Member Functions
+    std::vector<glm::mat4> ComputeInstanceTransforms(uint32_t stepCount) const;
+    void FinishStep();
+    std::string DescribeStep(uint32_t stepCount) const;
+
+    // Private Member Variables
+    Model m_sourceModel;
+    Config m_config;
+    size_t m_stepIndex = 0;
+    uint32_t m_frameIndex = 0;
+    bool m_sceneBuilt = false;
+    std::vector<float> m_frameTimes;
+    std::vector<StepResult> m_results;
+};
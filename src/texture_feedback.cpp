@@ -0,0 +1,204 @@
+// Standard Library Headers
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Project Headers
+#include "texture_feedback.h"
+
+//----------------------------------------------------------------------
+// Internal Constants
+
+namespace {
+
+// The shader writes kMaxMipLevels - mip with atomicMax, so a cleared buffer means "not sampled".
+// Must match kFeedbackMaxMipLevels in gltf_pbr.wgsl.
+constexpr uint32_t kMaxMipLevels = 16;
+
+// Material textures are RGBA8
+constexpr uint64_t kBytesPerTexel = 4;
+
+} // namespace
+
+//----------------------------------------------------------------------
+// TextureFeedback Class implementation
+
+TextureFeedback::TextureFeedback(const wgpu::Device& device) {
+    m_device = device;
+
+    wgpu::BindGroupLayoutEntry entry{};
+    entry.binding = 6; // Group 2 of gltf_pbr.wgsl; bindings 0-5 are used by the impostors
+    entry.visibility = wgpu::ShaderStage::Fragment;
+    entry.buffer.type = wgpu::BufferBindingType::Storage;
+
+    wgpu::BindGroupLayoutDescriptor layoutDescriptor{};
+    layoutDescriptor.entryCount = 1;
+    layoutDescriptor.entries = &entry;
+    m_bindGroupLayout = m_device.CreateBindGroupLayout(&layoutDescriptor);
+
+    SetMaterialCount(0);
+}
+
+void TextureFeedback::SetMaterialCount(uint32_t materialCount) {
+    const uint32_t entryCount = std::max(materialCount, 1u) * kTextureSlotCount;
+    m_bufferSize = uint64_t{entryCount} * sizeof(uint32_t);
+
+    // New buffers are zero initialized, i.e. nothing sampled
+    wgpu::BufferDescriptor feedbackDescriptor{};
+    feedbackDescriptor.size = m_bufferSize;
+    feedbackDescriptor.usage =
+        wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+    m_feedbackBuffer = m_device.CreateBuffer(&feedbackDescriptor);
+
+    wgpu::BufferDescriptor readbackDescriptor{};
+    readbackDescriptor.size = m_bufferSize;
+    readbackDescriptor.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst;
+    m_readbackBuffer = m_device.CreateBuffer(&readbackDescriptor);
+
+    wgpu::BindGroupEntry bindGroupEntry{};
+    bindGroupEntry.binding = 6;
+    bindGroupEntry.buffer = m_feedbackBuffer;
+    bindGroupEntry.offset = 0;
+    bindGroupEntry.size = m_bufferSize;
+
+    wgpu::BindGroupDescriptor bindGroupDescriptor{};
+    bindGroupDescriptor.layout = m_bindGroupLayout;
+    bindGroupDescriptor.entryCount = 1;
+    bindGroupDescriptor.entries = &bindGroupEntry;
+    m_bindGroup = m_device.CreateBindGroup(&bindGroupDescriptor);
+
+    // A map still in flight belongs to the previous materials and completes into the old state
+    m_readbackState = std::make_shared<ReadbackState>();
+    m_readbackState->m_mipLevels.assign(entryCount, kNotSampled);
+}
+
+void TextureFeedback::Resize(uint32_t width, uint32_t height) {
+    wgpu::TextureDescriptor descriptor{};
+    descriptor.size = {std::max(width / kResolutionScale, 1u),
+                       std::max(height / kResolutionScale, 1u), 1};
+    descriptor.format = kDepthFormat;
+    descriptor.usage = wgpu::TextureUsage::RenderAttachment;
+    m_depthTexture = m_device.CreateTexture(&descriptor);
+    m_depthTextureView = m_depthTexture.CreateView();
+}
+
+bool TextureFeedback::BeginFrame() {
+    // Skip the pass while the previous results are still being read back
+    m_recording = m_depthTexture && m_frameIndex++ % kFrameInterval == 0 &&
+                  !m_readbackState->m_pending.load();
+    return m_recording;
+}
+
+wgpu::RenderPassEncoder TextureFeedback::BeginRenderPass(wgpu::CommandEncoder& encoder) const {
+    wgpu::RenderPassDepthStencilAttachment depthAttachment{};
+    depthAttachment.view = m_depthTextureView;
+    depthAttachment.depthLoadOp = wgpu::LoadOp::Clear;
+    depthAttachment.depthStoreOp = wgpu::StoreOp::Discard;
+    depthAttachment.depthClearValue = 1.0f;
+
+    wgpu::RenderPassDescriptor descriptor{};
+    descriptor.colorAttachmentCount = 0;
+    descriptor.depthStencilAttachment = &depthAttachment;
+    return encoder.BeginRenderPass(&descriptor);
+}
+
+void TextureFeedback::EncodeReadback(wgpu::CommandEncoder& encoder) const {
+    encoder.CopyBufferToBuffer(m_feedbackBuffer, 0, m_readbackBuffer, 0, m_bufferSize);
+    encoder.ClearBuffer(m_feedbackBuffer, 0, m_bufferSize);
+}
+
+void TextureFeedback::EndFrame() {
+    if (!m_recording) {
+        return;
+    }
+    m_recording = false;
+
+    std::shared_ptr<ReadbackState> state = m_readbackState;
+    wgpu::Buffer buffer = m_readbackBuffer;
+    const uint64_t size = m_bufferSize;
+    state->m_pending = true;
+
+    buffer.MapAsync(
+        wgpu::MapMode::Read, 0, size, wgpu::CallbackMode::AllowSpontaneous,
+        [state, buffer, size](wgpu::MapAsyncStatus status, wgpu::StringView) {
+            if (status == wgpu::MapAsyncStatus::Success) {
+                const auto *values =
+                    static_cast<const uint32_t *>(buffer.GetConstMappedRange(0, size));
+                std::lock_guard<std::mutex> lock(state->m_mutex);
+                for (size_t i = 0; i < state->m_mipLevels.size(); ++i) {
+                    state->m_mipLevels[i] =
+                        values[i] != 0 ? kMaxMipLevels - values[i] : kNotSampled;
+                }
+                ++state->m_readbackCount;
+                buffer.Unmap();
+            }
+            state->m_pending = false;
+        });
+}
+
+std::vector<uint32_t> TextureFeedback::PlanResidency(const std::vector<TextureRequest>& textures,
+                                                     uint64_t budgetBytes) {
+    // Start from the levels seen on screen (textures that were not seen keep their last mip)
+    std::vector<uint32_t> mipLevels(textures.size());
+    uint64_t totalBytes = 0;
+    for (size_t i = 0; i < textures.size(); ++i) {
+        const uint32_t coarsestMipLevel = std::max(textures[i].m_mipLevelCount, 1u) - 1;
+        mipLevels[i] = std::min(textures[i].m_requiredMipLevel, coarsestMipLevel);
+        totalBytes += GetResidentBytes(textures[i], mipLevels[i]);
+    }
+
+    // Over budget: repeatedly drop the finest resident level that frees the most memory
+    while (totalBytes > budgetBytes) {
+        size_t best = textures.size();
+        uint64_t bestSaving = 0;
+        for (size_t i = 0; i < textures.size(); ++i) {
+            if (mipLevels[i] + 1 >= textures[i].m_mipLevelCount) {
+                continue;
+            }
+            const uint64_t saving = GetResidentBytes(textures[i], mipLevels[i]) -
+                                    GetResidentBytes(textures[i], mipLevels[i] + 1);
+            if (saving > bestSaving) {
+                best = i;
+                bestSaving = saving;
+            }
+        }
+        if (best == textures.size()) {
+            break; // Only the coarsest mips left
+        }
+        ++mipLevels[best];
+        totalBytes -= bestSaving;
+    }
+
+    return mipLevels;
+}
+
+uint64_t TextureFeedback::GetResidentBytes(const TextureRequest& texture,
+                                           uint32_t finestMipLevel) {
+    uint64_t bytes = 0;
+    for (uint32_t level = finestMipLevel; level < texture.m_mipLevelCount; ++level) {
+        bytes += uint64_t{std::max(texture.m_width >> level, 1u)} *
+                 std::max(texture.m_height >> level, 1u) * kBytesPerTexel;
+    }
+    return bytes;
+}
+
+const wgpu::BindGroupLayout& TextureFeedback::GetBindGroupLayout() const noexcept {
+    return m_bindGroupLayout;
+}
+
+const wgpu::BindGroup& TextureFeedback::GetBindGroup() const noexcept {
+    return m_bindGroup;
+}
+
+uint32_t TextureFeedback::GetRequiredMipLevel(uint32_t materialIndex, uint32_t slot) const {
+    std::lock_guard<std::mutex> lock(m_readbackState->m_mutex);
+    const size_t index = size_t{materialIndex} * kTextureSlotCount + slot;
+    return index < m_readbackState->m_mipLevels.size() ? m_readbackState->m_mipLevels[index]
+                                                       : kNotSampled;
+}
+
+uint64_t TextureFeedback::GetReadbackCount() const {
+    std::lock_guard<std::mutex> lock(m_readbackState->m_mutex);
+    return m_readbackState->m_readbackCount;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+// Standard Library Headers
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Third-Party Library Headers
+#include <webgpu/webgpu_cpp.h>
+
+// TextureFeedback Class
+//
+// Records the finest mip level each material texture needs on screen. Every kFrameInterval frames
+// the renderer draws the visible meshes into a low resolution depth target with a fragment shader
+// (fs_texture_feedback in gltf_pbr.wgsl) that writes the mip level of every material texture slot
+// into a storage buffer. The buffer is read back asynchronously, so the results lag a few frames
+// behind the view and never stall the render thread. PlanResidency() turns them into the mip
+// levels to keep resident within a memory budget.
+class TextureFeedback {
+  public:
+    // Types
+    struct TextureRequest {
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+        uint32_t m_mipLevelCount = 1;
+        uint32_t m_requiredMipLevel = kNotSampled; // Finest mip level seen on screen
+    };
+
+    // Constants
+    static constexpr uint32_t kTextureSlotCount = 5;    // Material textures (kTextureMask* order)
+    static constexpr uint32_t kResolutionScale = 4;     // Feedback target size divisor
+    static constexpr uint32_t kFrameInterval = 8;       // Frames between feedback passes
+    static constexpr uint32_t kNotSampled = UINT32_MAX; // Texture not visible in the last pass
+    static constexpr wgpu::TextureFormat kDepthFormat = wgpu::TextureFormat::Depth32Float;
+
+    // Constructor
+    explicit TextureFeedback(const wgpu::Device& device);
+
+    // Rule of 5
+    TextureFeedback(const TextureFeedback&) = delete;
+    TextureFeedback& operator=(const TextureFeedback&) = delete;
+    TextureFeedback(TextureFeedback&&) = delete;
+    TextureFeedback& operator=(TextureFeedback&&) = delete;
+
+    // Public Interface
+    void SetMaterialCount(uint32_t materialCount);
+    void Resize(uint32_t width, uint32_t height);
+    bool BeginFrame();
+    wgpu::RenderPassEncoder BeginRenderPass(wgpu::CommandEncoder& encoder) const;
+    void EncodeReadback(wgpu::CommandEncoder& encoder) const;
+    void EndFrame();
+
+    static std::vector<uint32_t> PlanResidency(const std::vector<TextureRequest>& textures,
+                                               uint64_t budgetBytes);
+    static uint64_t GetResidentBytes(const TextureRequest& texture, uint32_t finestMipLevel);
+
+    // Accessors
+    const wgpu::BindGroupLayout& GetBindGroupLayout() const noexcept;
+    const wgpu::BindGroup& GetBindGroup() const noexcept;
+    uint32_t GetRequiredMipLevel(uint32_t materialIndex, uint32_t slot) const;
+    uint64_t GetReadbackCount() const;
+
+  private:
+    // Types
+    struct ReadbackState {
+        std::atomic<bool> m_pending{false}; // A readback buffer map is in flight
+        std::mutex m_mutex;                 // Guards the results below (written by callbacks)
+        std::vector<uint32_t> m_mipLevels;  // Per material and slot, kNotSampled if not seen
+        uint64_t m_readbackCount = 0;
+    };
+
+    // Private Member Variables
+    wgpu::Device m_device;
+    wgpu::BindGroupLayout m_bindGroupLayout;
+    wgpu::BindGroup m_bindGroup;
+    wgpu::Buffer m_feedbackBuffer; // Written by fs_texture_feedback, cleared after each pass
+    wgpu::Buffer m_readbackBuffer;
+    wgpu::Texture m_depthTexture;
+    wgpu::TextureView m_depthTextureView;
+    uint64_t m_bufferSize = 0;
+    uint64_t m_frameIndex = 0;
+    bool m_recording = false; // The current frame encodes a feedback pass
+    std::shared_ptr<ReadbackState> m_readbackState; // Shared with map callbacks
+};
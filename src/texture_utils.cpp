@@ -0,0 +1,183 @@
+// Standard Library Headers
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+// Project Headers
+#include "texture_utils.h"
+
+//----------------------------------------------------------------------
+// Internal Constants and Utility Functions
+
+namespace {
+
+// CopyBufferToTexture requires rows to start at multiples of 256 bytes
+constexpr uint32_t kBytesPerRowAlignment = 256;
+
+// Fills mip level 0 of the given texture
+using UploadLevel0 = std::function<void(const wgpu::Texture& texture, const wgpu::Extent3D& size)>;
+
+void CreateMipmappedTexture(const UploadLevel0& uploadLevel0, uint32_t width, uint32_t height,
+                            wgpu::TextureFormat format, GpuResourcePool& resourcePool,
+                            const MipmapGenerator& mipmapGenerator,
+                            MipmapGenerator::MipKind kind, const wgpu::CommandEncoder& encoder,
+                            wgpu::Texture& texture, wgpu::Texture& intermediateTexture) {
+    // Compute the number of mip levels
+    uint32_t mipLevelCount =
+        static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+
+    if (kind == MipmapGenerator::MipKind::SRGB2D) {
+        // Create final SRGB texture directly with render attachment usage
+        wgpu::TextureDescriptor finalDesc{};
+        finalDesc.size = {width, height, 1};
+        finalDesc.format = format; // expected RGBA8UnormSrgb
+        finalDesc.usage = wgpu::TextureUsage::TextureBinding |
+                          wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::CopyDst;
+        finalDesc.mipLevelCount = mipLevelCount;
+        texture = resourcePool.AcquireTexture(finalDesc);
+
+        // Upload level 0
+        uploadLevel0(texture, finalDesc.size);
+
+        // Generate mips directly via render path
+        mipmapGenerator.GenerateMipmaps(encoder, texture, finalDesc.size, kind);
+    } else {
+        // Create an intermediate texture for compute-based mip generation (UNORM)
+        wgpu::TextureDescriptor textureDescriptor{};
+        textureDescriptor.size = {width, height, 1};
+        textureDescriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+        textureDescriptor.usage = wgpu::TextureUsage::TextureBinding |
+                                  wgpu::TextureUsage::StorageBinding | wgpu::TextureUsage::CopyDst |
+                                  wgpu::TextureUsage::CopySrc;
+        textureDescriptor.mipLevelCount = mipLevelCount;
+
+        intermediateTexture = resourcePool.AcquireTexture(textureDescriptor);
+
+        // Upload the texture data to intermediate
+        uploadLevel0(intermediateTexture, textureDescriptor.size);
+
+        // Generate mipmaps via compute (normal-aware or linear depending on kind)
+        mipmapGenerator.GenerateMipmaps(encoder, intermediateTexture, textureDescriptor.size,
+                                        kind == MipmapGenerator::MipKind::Normal2D
+                                            ? MipmapGenerator::MipKind::Normal2D
+                                            : MipmapGenerator::MipKind::LinearUNorm2D);
+
+        // Create the final texture (may be sRGB or UNORM depending on input format)
+        textureDescriptor.format = format;
+        textureDescriptor.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst;
+        wgpu::Texture finalTexture = resourcePool.AcquireTexture(textureDescriptor);
+
+        // Copy the intermediate texture to the final texture
+        for (uint32_t level = 0; level < mipLevelCount; ++level) {
+            uint32_t mipWidth = std::max(width >> level, 1u);
+            uint32_t mipHeight = std::max(height >> level, 1u);
+            wgpu::TexelCopyTextureInfo src{};
+            src.texture = intermediateTexture;
+            src.mipLevel = level;
+            src.origin = {0, 0, 0};
+            src.aspect = wgpu::TextureAspect::All;
+            wgpu::TexelCopyTextureInfo dst{};
+            dst.texture = finalTexture;
+            dst.mipLevel = level;
+            dst.origin = {0, 0, 0};
+            dst.aspect = wgpu::TextureAspect::All;
+            wgpu::Extent3D extent = {mipWidth, mipHeight, 1};
+            encoder.CopyTextureToTexture(&src, &dst, &extent);
+        }
+
+        texture = finalTexture;
+    }
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// Texture Utility Functions
+
+namespace texture_utils {
+
+void CreateTexture(const uint8_t *data, uint32_t width, uint32_t height,
+                   wgpu::TextureFormat format, const wgpu::Device& device,
+                   GpuResourcePool& resourcePool, MipmapGenerator& mipmapGenerator,
+                   MipmapGenerator::MipKind kind, wgpu::Texture& texture) {
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::Texture intermediateTexture;
+    CreateTexture(data, width, height, format, device, resourcePool, mipmapGenerator, kind, encoder,
+                  texture, intermediateTexture);
+
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+    device.GetQueue().Submit(1, &commandBuffer);
+
+    // The intermediate texture is only accessed by queue operations, so the next texture
+    // upload can reuse it right away
+    if (intermediateTexture) {
+        resourcePool.Release(intermediateTexture, GpuResourcePool::ReleaseMode::QueueOrdered);
+    }
+}
+
+void CreateTexture(const uint8_t *data, uint32_t width, uint32_t height,
+                   wgpu::TextureFormat format, const wgpu::Device& device,
+                   GpuResourcePool& resourcePool, const MipmapGenerator& mipmapGenerator,
+                   MipmapGenerator::MipKind kind, const wgpu::CommandEncoder& encoder,
+                   wgpu::Texture& texture, wgpu::Texture& intermediateTexture) {
+    auto writeTexture = [&](const wgpu::Texture& target, const wgpu::Extent3D& size) {
+        wgpu::TexelCopyTextureInfo destination{};
+        destination.texture = target;
+        destination.mipLevel = 0;
+        destination.origin = {0, 0, 0};
+        destination.aspect = wgpu::TextureAspect::All;
+
+        wgpu::TexelCopyBufferLayout source{};
+        source.offset = 0;
+        source.bytesPerRow = 4 * width * sizeof(uint8_t);
+        source.rowsPerImage = height;
+
+        const size_t dataSize = static_cast<size_t>(4) * width * height * sizeof(uint8_t);
+        device.GetQueue().WriteTexture(&destination, data, dataSize, &source, &size);
+    };
+
+    CreateMipmappedTexture(writeTexture, width, height, format, resourcePool, mipmapGenerator,
+                           kind, encoder, texture, intermediateTexture);
+}
+
+void CreateTexture(const PixelWriter& writePixels, uint32_t width, uint32_t height,
+                   wgpu::TextureFormat format, const wgpu::Device& device,
+                   GpuResourcePool& resourcePool, const MipmapGenerator& mipmapGenerator,
+                   MipmapGenerator::MipKind kind, const wgpu::CommandEncoder& encoder,
+                   wgpu::Texture& texture, wgpu::Texture& intermediateTexture) {
+    auto copyFromStaging = [&](const wgpu::Texture& target, const wgpu::Extent3D& size) {
+        // Buffers mapped at creation cannot be recycled by the pool, so each upload gets its own
+        const uint32_t bytesPerRow = (4 * width + kBytesPerRowAlignment - 1) /
+                                     kBytesPerRowAlignment * kBytesPerRowAlignment;
+        wgpu::BufferDescriptor stagingDescriptor{};
+        stagingDescriptor.size = static_cast<uint64_t>(bytesPerRow) * height;
+        stagingDescriptor.usage = wgpu::BufferUsage::CopySrc;
+        stagingDescriptor.mappedAtCreation = true;
+        wgpu::Buffer staging = device.CreateBuffer(&stagingDescriptor);
+
+        if (void *mapped = staging.GetMappedRange()) {
+            writePixels(static_cast<uint8_t *>(mapped), bytesPerRow);
+        }
+        staging.Unmap();
+
+        wgpu::TexelCopyBufferInfo source{};
+        source.buffer = staging;
+        source.layout.offset = 0;
+        source.layout.bytesPerRow = bytesPerRow;
+        source.layout.rowsPerImage = height;
+
+        wgpu::TexelCopyTextureInfo destination{};
+        destination.texture = target;
+        destination.mipLevel = 0;
+        destination.origin = {0, 0, 0};
+        destination.aspect = wgpu::TextureAspect::All;
+
+        // The encoder keeps the staging buffer alive until the copy has executed
+        encoder.CopyBufferToTexture(&source, &destination, &size);
+    };
+
+    CreateMipmappedTexture(copyFromStaging, width, height, format, resourcePool, mipmapGenerator,
+                           kind, encoder, texture, intermediateTexture);
+}
+
+} // namespace texture_utils
@@ -0,0 +1,45 @@
+#pragma once
+
+// Standard Library Headers
+#include <cstdint>
+#include <functional>
+
+// Third-Party Library Headers
+#include <webgpu/webgpu_cpp.h>
+
+// Project Headers
+#include "gpu_resource_pool.h"
+#include "mipmap_generator.h"
+
+namespace texture_utils {
+
+// Uploads RGBA8 pixels and generates the full mip chain. Non-sRGB data is mipmapped in an
+// intermediate RGBA8Unorm storage texture and copied into the final texture of the given format.
+void CreateTexture(const uint8_t *data, uint32_t width, uint32_t height,
+                   wgpu::TextureFormat format, const wgpu::Device& device,
+                   GpuResourcePool& resourcePool, MipmapGenerator& mipmapGenerator,
+                   MipmapGenerator::MipKind kind, wgpu::Texture& texture);
+
+// Same as above, but records the mip generation and copies into the given encoder instead of
+// submitting them, so textures can be created on several threads. The intermediate texture (null
+// for sRGB data) is in use until the encoder's commands are submitted; the caller returns it to
+// the pool afterwards.
+void CreateTexture(const uint8_t *data, uint32_t width, uint32_t height,
+                   wgpu::TextureFormat format, const wgpu::Device& device,
+                   GpuResourcePool& resourcePool, const MipmapGenerator& mipmapGenerator,
+                   MipmapGenerator::MipKind kind, const wgpu::CommandEncoder& encoder,
+                   wgpu::Texture& texture, wgpu::Texture& intermediateTexture);
+
+// Writes RGBA8 rows of mip level 0 into mapped staging memory, bytesPerRow apart
+using PixelWriter = std::function<void(uint8_t *destination, uint32_t bytesPerRow)>;
+
+// Same as above, but the pixels are written by the caller (e.g. an image decoder) straight into a
+// staging buffer mapped at creation, which is then copied with CopyBufferToTexture. This avoids
+// the copy of the pixels WriteTexture makes, and the caller needs no buffer of its own.
+void CreateTexture(const PixelWriter& writePixels, uint32_t width, uint32_t height,
+                   wgpu::TextureFormat format, const wgpu::Device& device,
+                   GpuResourcePool& resourcePool, const MipmapGenerator& mipmapGenerator,
+                   MipmapGenerator::MipKind kind, const wgpu::CommandEncoder& encoder,
+                   wgpu::Texture& texture, wgpu::Texture& intermediateTexture);
+
+} // namespace texture_utils
@@ -0,0 +1,54 @@
+#pragma once
+
+// Standard Library Headers
+#include <atomic>
+#include <cstdint>
+
+// TripleBuffer Class
+//
+// Lock-free single-producer/single-consumer exchange of the latest value. The producer writes
+// into a back slot and publishes it by swapping it with the middle slot; the consumer picks up
+// the middle slot only when it holds a newer value. Neither side ever blocks or sees a
+// partially written value, and intermediate values are dropped when the producer is faster.
+template <typename T> class TripleBuffer {
+  public:
+    // Constructor
+    TripleBuffer() = default;
+
+    // Rule of 5
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+    TripleBuffer(TripleBuffer&&) = delete;
+    TripleBuffer& operator=(TripleBuffer&&) = delete;
+
+    // Public Interface (producer)
+    void Write(const T& value) {
+        m_slots[m_backIndex] = value;
+        const auto published = static_cast<uint8_t>(m_backIndex | kDirtyBit);
+        const uint8_t previous = m_middle.exchange(published, std::memory_order_acq_rel);
+        m_backIndex = previous & kIndexMask;
+    }
+
+    // Public Interface (consumer). Returns true if a newer value was published since the last
+    // call.
+    bool Read(T& value) {
+        if ((m_middle.load(std::memory_order_relaxed) & kDirtyBit) == 0) {
+            return false;
+        }
+        const uint8_t previous = m_middle.exchange(m_frontIndex, std::memory_order_acq_rel);
+        m_frontIndex = previous & kIndexMask;
+        value = m_slots[m_frontIndex];
+        return true;
+    }
+
+  private:
+    // Private Constants
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kDirtyBit = 0x4;
+
+    // Private Member Variables
+    T m_slots[3]{};
+    std::atomic<uint8_t> m_middle{1}; // Middle slot index, plus kDirtyBit when unread
+    uint8_t m_backIndex = 0;          // Owned by the producer
+    uint8_t m_frontIndex = 2;         // Owned by the consumer
+};
@@ -0,0 +1,262 @@
+// Asset Packer
+//
+// Packs shaders, default assets and baked caches into a single archive that the viewer
+// memory-maps at startup (see src/asset_archive.h for the format). Paths are stored relative to
+// the base directory, so "assets/shaders/gltf_pbr.wgsl" resolves the same way as the loose file.
+// Entries are stored uncompressed (zero-copy at runtime) unless their extension is listed with
+// --compress and compression actually saves space.
+//
+// Usage: asset_packer <output.pak> <base dir> <file or directory>... [options]
+
+// Standard Library Headers
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Third-Party Library Headers
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+// Project Headers
+#include "asset_archive.h"
+
+//----------------------------------------------------------------------
+// Internal Types and Utility Functions
+
+namespace {
+
+namespace fs = std::filesystem;
+
+struct Options {
+    std::string m_output;
+    fs::path m_baseDirectory;
+    std::vector<std::string> m_inputs;
+    std::set<std::string> m_compressedExtensions;
+    int m_compressionLevel = 8;
+};
+
+struct PackedEntry {
+    std::string m_name;
+    std::vector<uint8_t> m_data; // Stored (possibly compressed) data
+    uint64_t m_size = 0;
+    AssetArchive::Compression m_compression = AssetArchive::Compression::None;
+};
+
+void PrintUsage() {
+    std::cout
+        << "Usage: asset_packer <output.pak> <base dir> <file or directory>... [options]\n"
+        << "  --compress <ext,...>   Extensions to zlib-compress (e.g. wgsl,gltf; default none)\n"
+        << "  --level <n>            Compression level 1-9 (default 8)\n";
+}
+
+std::string ToLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+bool ParseOptions(int argc, char **argv, Options& options) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--compress" && hasValue) {
+            std::stringstream extensions(argv[++i]);
+            std::string extension;
+            while (std::getline(extensions, extension, ',')) {
+                if (!extension.empty()) {
+                    options.m_compressedExtensions.insert("." + ToLower(extension));
+                }
+            }
+        } else if (arg == "--level" && hasValue) {
+            options.m_compressionLevel = std::clamp(std::atoi(argv[++i]), 1, 9);
+        } else if (arg.starts_with("--")) {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        } else {
+            positional.emplace_back(arg);
+        }
+    }
+
+    if (positional.size() < 3) {
+        return false;
+    }
+
+    options.m_output = positional[0];
+    options.m_baseDirectory = positional[1];
+    options.m_inputs.assign(positional.begin() + 2, positional.end());
+    return true;
+}
+
+bool ReadFile(const fs::path& path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    return static_cast<bool>(file.read(reinterpret_cast<char *>(data.data()),
+                                       static_cast<std::streamsize>(data.size())));
+}
+
+// Expands files and directories (recursively) to a sorted list of files relative to the base
+bool CollectFiles(const Options& options, std::vector<fs::path>& files) {
+    for (const std::string& input : options.m_inputs) {
+        const fs::path path = options.m_baseDirectory / input;
+        std::error_code error;
+        if (fs::is_directory(path, error)) {
+            for (const auto& item : fs::recursive_directory_iterator(path)) {
+                if (item.is_regular_file()) {
+                    files.push_back(fs::relative(item.path(), options.m_baseDirectory));
+                }
+            }
+        } else if (fs::is_regular_file(path, error)) {
+            files.push_back(fs::relative(path, options.m_baseDirectory));
+        } else {
+            std::cerr << "Input not found: " << path.string() << std::endl;
+            return false;
+        }
+    }
+
+    // Deterministic output regardless of directory iteration order
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    return true;
+}
+
+bool PackEntry(const Options& options, const fs::path& file, PackedEntry& entry) {
+    entry.m_name = file.generic_string();
+    if (!ReadFile(options.m_baseDirectory / file, entry.m_data)) {
+        std::cerr << "Failed to read " << file.string() << std::endl;
+        return false;
+    }
+    entry.m_size = entry.m_data.size();
+
+    const std::string extension = ToLower(file.extension().string());
+    if (!options.m_compressedExtensions.contains(extension) || entry.m_data.empty() ||
+        entry.m_data.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        return true;
+    }
+
+    int compressedSize = 0;
+    unsigned char *compressed =
+        stbi_zlib_compress(entry.m_data.data(), static_cast<int>(entry.m_data.size()),
+                           &compressedSize, options.m_compressionLevel);
+    if (compressed && static_cast<size_t>(compressedSize) < entry.m_data.size()) {
+        entry.m_data.assign(compressed, compressed + compressedSize);
+        entry.m_compression = AssetArchive::Compression::Zlib;
+    }
+    STBIW_FREE(compressed);
+    return true;
+}
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+void WritePadding(std::ofstream& file, uint64_t alignment) {
+    const uint64_t position = static_cast<uint64_t>(file.tellp());
+    const std::vector<char> zeros(AlignUp(position, alignment) - position, 0);
+    file.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+}
+
+bool WriteArchive(const std::string& filename, const std::vector<PackedEntry>& entries) {
+    std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Placeholder header, rewritten once the table of contents offset is known
+    AssetArchive::Header header{};
+    std::memcpy(header.m_magic, AssetArchive::kMagic, sizeof(header.m_magic));
+    header.m_version = AssetArchive::kVersion;
+    header.m_entryCount = static_cast<uint32_t>(entries.size());
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::vector<uint64_t> offsets;
+    offsets.reserve(entries.size());
+    for (const PackedEntry& entry : entries) {
+        WritePadding(file, AssetArchive::kEntryAlignment);
+        offsets.push_back(static_cast<uint64_t>(file.tellp()));
+        file.write(reinterpret_cast<const char *>(entry.m_data.data()),
+                   static_cast<std::streamsize>(entry.m_data.size()));
+    }
+
+    WritePadding(file, AssetArchive::kTocAlignment);
+    header.m_tocOffset = static_cast<uint64_t>(file.tellp());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const PackedEntry& entry = entries[i];
+        const AssetArchive::TocEntry tocEntry{offsets[i], entry.m_data.size(), entry.m_size,
+                                              static_cast<uint32_t>(entry.m_compression),
+                                              static_cast<uint32_t>(entry.m_name.size())};
+        file.write(reinterpret_cast<const char *>(&tocEntry), sizeof(tocEntry));
+        file.write(entry.m_name.data(), static_cast<std::streamsize>(entry.m_name.size()));
+        WritePadding(file, AssetArchive::kTocAlignment);
+    }
+    header.m_tocSize = static_cast<uint64_t>(file.tellp()) - header.m_tocOffset;
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    return static_cast<bool>(file);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// Main Function
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    std::vector<fs::path> files;
+    if (!CollectFiles(options, files)) {
+        return EXIT_FAILURE;
+    }
+
+    std::vector<PackedEntry> entries(files.size());
+    uint64_t totalSize = 0;
+    uint64_t storedSize = 0;
+    size_t compressedCount = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!PackEntry(options, files[i], entries[i])) {
+            return EXIT_FAILURE;
+        }
+        totalSize += entries[i].m_size;
+        storedSize += entries[i].m_data.size();
+        compressedCount += entries[i].m_compression != AssetArchive::Compression::None;
+    }
+
+    if (!WriteArchive(options.m_output, entries)) {
+        std::cerr << "Failed to write " << options.m_output << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double totalMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+    std::cout << "Wrote " << options.m_output << " in " << totalMs << "ms" << std::endl;
+    std::cout << "  Entries: " << entries.size() << " (" << compressedCount << " compressed)"
+              << std::endl;
+    std::cout << "  Size: " << totalSize << " bytes (" << storedSize << " stored)" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,439 @@
+// Asset Report
+//
+// Loads glTF/GLB assets through Model::Load and reports the statistics that decide how fast they
+// load and render in the viewer: geometry size and vertex cache efficiency, submeshes and the
+// resulting draw calls, duplicate or unused materials and images, texture memory and primitives
+// that fall back to MikkTSpace tangent generation. Each report ends with a list of suggested
+// optimizations, so slow assets can be triaged before they reach the viewer.
+//
+// Usage: asset_report <model.glb|model.gltf>... [options]
+
+// Standard Library Headers
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Project Headers
+#include "mesh_utils.h"
+#include "model.h"
+
+//----------------------------------------------------------------------
+// Internal Types and Utility Functions
+
+namespace {
+
+// Thresholds for the suggestions
+constexpr float kAtvrWarning = 1.5f;           // Transforms per vertex; 1.0 is optimal
+constexpr float kVertexReuseWarning = 1.5f;    // Indices per vertex of an unwelded mesh is ~1
+constexpr size_t kDrawCallWarning = 500;       // Draw calls per frame
+constexpr uint32_t kTextureSizeWarning = 4096; // Largest texture dimension
+constexpr uint64_t kTextureMemoryWarning = 256ull * 1024 * 1024;
+
+struct Options {
+    std::vector<std::string> m_inputs;
+    uint32_t m_cacheSize = 32;
+    bool m_verbose = false;
+};
+
+// The renderer uploads every image as RGBA8, once per mip filter it is sampled with
+enum class TextureUsage { Color, Linear, Normal };
+
+struct TextureStats {
+    size_t m_duplicateImageCount = 0;
+    size_t m_unusedImageCount = 0;
+    uint64_t m_unusedImageBytes = 0; // Decoded at load time, never uploaded
+    size_t m_uploadCount = 0;
+    uint64_t m_gpuBytes = 0;
+    uint64_t m_gpuBytesWithMips = 0;
+    size_t m_oversizedCount = 0;
+    const Model::Texture *m_largest = nullptr;
+};
+
+struct MaterialStats {
+    size_t m_duplicateCount = 0;
+    size_t m_unusedCount = 0;
+};
+
+void PrintUsage() {
+    std::cout << "Usage: asset_report <model.glb|model.gltf>... [options]\n"
+              << "  --cache-size <n>   Vertex cache size used for the ACMR (default 32)\n"
+              << "  --verbose          Keep the model loader output\n";
+}
+
+bool ParseOptions(int argc, char **argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--cache-size" && hasValue) {
+            options.m_cacheSize = static_cast<uint32_t>(std::max(std::atoi(argv[++i]), 1));
+        } else if (arg == "--verbose") {
+            options.m_verbose = true;
+        } else if (arg.starts_with("--")) {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        } else {
+            options.m_inputs.emplace_back(arg);
+        }
+    }
+    return !options.m_inputs.empty();
+}
+
+double ToMegabytes(uint64_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+uint64_t HashTexture(const Model::Texture& texture) {
+    // FNV-1a over the dimensions and pixels
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](uint8_t byte) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    };
+    for (uint32_t value : {texture.m_width, texture.m_height, texture.m_components}) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            add(static_cast<uint8_t>(value >> shift));
+        }
+    }
+    for (uint8_t byte : texture.m_data) {
+        add(byte);
+    }
+    return hash;
+}
+
+// Maps every image to the first image with identical dimensions and pixels
+std::vector<int> FindCanonicalImages(const std::vector<Model::Texture>& textures) {
+    std::vector<int> canonical(textures.size());
+    std::vector<uint64_t> hashes(textures.size());
+    for (size_t i = 0; i < textures.size(); ++i) {
+        hashes[i] = HashTexture(textures[i]);
+        canonical[i] = static_cast<int>(i);
+
+        for (size_t j = 0; j < i; ++j) {
+            if (canonical[j] == static_cast<int>(j) && hashes[j] == hashes[i] &&
+                textures[j].m_width == textures[i].m_width &&
+                textures[j].m_height == textures[i].m_height &&
+                textures[j].m_data == textures[i].m_data) {
+                canonical[i] = static_cast<int>(j);
+                break;
+            }
+        }
+    }
+    return canonical;
+}
+
+// Material with its texture references replaced by their canonical images, so materials that
+// only differ by duplicated images compare equal
+Model::Material CanonicalizeMaterial(const Model::Material& material,
+                                     const std::vector<int>& canonicalImages) {
+    Model::Material result = material;
+    for (int *texture : {&result.m_baseColorTexture, &result.m_metallicRoughnessTexture,
+                         &result.m_normalTexture, &result.m_emissiveTexture,
+                         &result.m_occlusionTexture}) {
+        if (*texture >= 0 && *texture < static_cast<int>(canonicalImages.size())) {
+            *texture = canonicalImages[*texture];
+        }
+    }
+    return result;
+}
+
+MaterialStats AnalyzeMaterials(const Model& model, const std::vector<int>& canonicalImages,
+                               std::vector<int>& canonicalMaterials) {
+    MaterialStats stats;
+    const std::vector<Model::Material>& materials = model.GetMaterials();
+
+    std::vector<Model::Material> canonicalized;
+    canonicalized.reserve(materials.size());
+    canonicalMaterials.resize(materials.size());
+    for (size_t i = 0; i < materials.size(); ++i) {
+        canonicalized.push_back(CanonicalizeMaterial(materials[i], canonicalImages));
+        const auto first =
+            std::find(canonicalized.begin(), canonicalized.end(), canonicalized.back());
+        canonicalMaterials[i] = static_cast<int>(first - canonicalized.begin());
+        stats.m_duplicateCount += canonicalMaterials[i] != static_cast<int>(i);
+    }
+
+    std::vector<bool> used(materials.size(), false);
+    for (const Model::SubMesh& subMesh : model.GetSubMeshes()) {
+        if (subMesh.m_materialIndex >= 0) {
+            used[subMesh.m_materialIndex] = true;
+        }
+    }
+    stats.m_unusedCount = static_cast<size_t>(std::count(used.begin(), used.end(), false));
+    return stats;
+}
+
+TextureStats AnalyzeTextures(const Model& model, const std::vector<int>& canonicalImages) {
+    TextureStats stats;
+    const std::vector<Model::Texture>& textures = model.GetTextures();
+
+    // Uploads the renderer performs: one per image and mip filter
+    std::vector<std::vector<TextureUsage>> usages(textures.size());
+    auto addUsage = [&](int index, TextureUsage usage) {
+        if (index >= 0 && index < static_cast<int>(textures.size()) &&
+            std::find(usages[index].begin(), usages[index].end(), usage) == usages[index].end()) {
+            usages[index].push_back(usage);
+        }
+    };
+    for (const Model::Material& material : model.GetMaterials()) {
+        addUsage(material.m_baseColorTexture, TextureUsage::Color);
+        addUsage(material.m_emissiveTexture, TextureUsage::Color);
+        addUsage(material.m_metallicRoughnessTexture, TextureUsage::Linear);
+        addUsage(material.m_occlusionTexture, TextureUsage::Linear);
+        addUsage(material.m_normalTexture, TextureUsage::Normal);
+    }
+
+    for (size_t i = 0; i < textures.size(); ++i) {
+        const Model::Texture& texture = textures[i];
+        stats.m_duplicateImageCount += canonicalImages[i] != static_cast<int>(i);
+
+        if (usages[i].empty()) {
+            ++stats.m_unusedImageCount;
+            stats.m_unusedImageBytes += texture.m_data.size();
+            continue;
+        }
+
+        uint64_t bytes = 0;
+        uint64_t bytesWithMips = 0;
+        for (uint32_t width = texture.m_width, height = texture.m_height;;
+             width = std::max(width / 2, 1u), height = std::max(height / 2, 1u)) {
+            const uint64_t levelBytes = uint64_t{width} * height * 4;
+            bytes = bytes == 0 ? levelBytes : bytes;
+            bytesWithMips += levelBytes;
+            if (width == 1 && height == 1) {
+                break;
+            }
+        }
+
+        stats.m_uploadCount += usages[i].size();
+        stats.m_gpuBytes += bytes * usages[i].size();
+        stats.m_gpuBytesWithMips += bytesWithMips * usages[i].size();
+
+        if (std::max(texture.m_width, texture.m_height) > kTextureSizeWarning) {
+            ++stats.m_oversizedCount;
+        }
+        const uint64_t pixels = uint64_t{texture.m_width} * texture.m_height;
+        if (!stats.m_largest ||
+            pixels > uint64_t{stats.m_largest->m_width} * stats.m_largest->m_height) {
+            stats.m_largest = &texture;
+        }
+    }
+    return stats;
+}
+
+// Draw calls the renderer issues as loaded, and with the viewer's load options (materials
+// deduplicated, opaque and masked submeshes merged per material). Both include the background.
+void EstimateDrawCalls(const Model& model, const std::vector<int>& canonicalMaterials,
+                       size_t& drawCalls, size_t& mergedDrawCalls) {
+    const std::vector<Model::Material>& materials = model.GetMaterials();
+    std::vector<bool> drawn(materials.size(), false);
+
+    drawCalls = model.GetSubMeshes().size() + 1;
+    mergedDrawCalls = 1;
+    for (const Model::SubMesh& subMesh : model.GetSubMeshes()) {
+        const int material = subMesh.m_materialIndex;
+        if (material < 0 || materials[material].m_alphaMode == Model::AlphaMode::Blend) {
+            ++mergedDrawCalls;
+        } else if (!drawn[canonicalMaterials[material]]) {
+            drawn[canonicalMaterials[material]] = true;
+            ++mergedDrawCalls;
+        }
+    }
+}
+
+bool ReportAsset(const std::string& filename, const Options& options) {
+    // The loader logs every material; keep the report readable unless asked otherwise
+    Model model;
+    {
+        std::ostringstream discarded;
+        std::streambuf *output = options.m_verbose ? nullptr : std::cout.rdbuf(discarded.rdbuf());
+        model.Load(filename);
+        if (output) {
+            std::cout.rdbuf(output);
+        }
+    }
+
+    const Model::LoadStats& loadStats = model.GetLoadStats();
+    if (model.GetVertices().empty()) {
+        std::cerr << "Failed to load " << filename << " (or it contains no geometry)" << std::endl;
+        return false;
+    }
+
+    // Geometry
+    const size_t vertexCount = model.GetVertices().size();
+    const size_t triangleCount = model.GetIndices().size() / 3;
+    const float vertexReuse =
+        static_cast<float>(model.GetIndices().size()) / static_cast<float>(vertexCount);
+
+    double cacheMisses = 0.0;
+    for (const Model::SubMesh& subMesh : model.GetSubMeshes()) {
+        cacheMisses += mesh_utils::ComputeACMR(model.GetIndices(), subMesh.m_firstIndex,
+                                               subMesh.m_indexCount, options.m_cacheSize) *
+                       (subMesh.m_indexCount / 3);
+    }
+    const float acmr = triangleCount ? static_cast<float>(cacheMisses / triangleCount) : 0.0f;
+    const float atvr = static_cast<float>(cacheMisses / vertexCount);
+
+    // Materials, textures and draw calls
+    const std::vector<int> canonicalImages = FindCanonicalImages(model.GetTextures());
+    std::vector<int> canonicalMaterials;
+    const MaterialStats materialStats =
+        AnalyzeMaterials(model, canonicalImages, canonicalMaterials);
+    const TextureStats textureStats = AnalyzeTextures(model, canonicalImages);
+    size_t drawCalls = 0;
+    size_t mergedDrawCalls = 0;
+    EstimateDrawCalls(model, canonicalMaterials, drawCalls, mergedDrawCalls);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Asset report: " << filename << std::endl;
+    std::cout << "  Load time:        " << loadStats.m_parseTimeMs << "ms parsing, "
+              << loadStats.m_processTimeMs << "ms processing" << std::endl;
+    std::cout << "Geometry" << std::endl;
+    std::cout << "  Vertices:         " << vertexCount << std::endl;
+    std::cout << "  Triangles:        " << triangleCount << std::endl;
+    std::cout << "  Vertex reuse:     " << vertexReuse << " indices per vertex" << std::endl;
+    std::cout << "  ACMR:             " << acmr << " (ATVR " << atvr << ", FIFO cache of "
+              << options.m_cacheSize << ")" << std::endl;
+    std::cout << "  Primitives:       " << loadStats.m_primitiveCount << " ("
+              << loadStats.m_missingTangentCount << " without tangents, "
+              << loadStats.m_missingNormalCount << " without normals)" << std::endl;
+    std::cout << "Draw calls" << std::endl;
+    std::cout << "  Submeshes:        " << model.GetSubMeshes().size() << std::endl;
+    std::cout << "  Draw calls:       " << drawCalls << " (" << mergedDrawCalls
+              << " with the viewer's merge and deduplication load options)" << std::endl;
+    std::cout << "Materials" << std::endl;
+    std::cout << "  Materials:        " << model.GetMaterials().size() << " ("
+              << materialStats.m_duplicateCount << " duplicates, " << materialStats.m_unusedCount
+              << " unused)" << std::endl;
+    std::cout << "Textures" << std::endl;
+    std::cout << "  Images:           " << model.GetTextures().size() << " ("
+              << textureStats.m_duplicateImageCount << " duplicates, "
+              << textureStats.m_unusedImageCount << " unused)" << std::endl;
+    std::cout << "  GPU memory:       " << ToMegabytes(textureStats.m_gpuBytes)
+              << " MB without mips, " << ToMegabytes(textureStats.m_gpuBytesWithMips)
+              << " MB with mips (" << textureStats.m_uploadCount << " RGBA8 uploads)"
+              << std::endl;
+    if (textureStats.m_largest) {
+        const std::string& name = textureStats.m_largest->m_name;
+        std::cout << "  Largest image:    " << textureStats.m_largest->m_width << "x"
+                  << textureStats.m_largest->m_height << " " << (name.empty() ? "(unnamed)" : name)
+                  << std::endl;
+    }
+
+    // Suggestions, roughly ordered by impact
+    std::vector<std::string> suggestions;
+    auto suggest = [&suggestions](const std::ostringstream& text) {
+        suggestions.push_back(text.str());
+    };
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(2);
+
+    if (loadStats.m_missingTangentCount > 0) {
+        text.str("");
+        text << "Export tangents: " << loadStats.m_missingTangentCount
+             << " primitives are run through MikkTSpace at load time";
+        suggest(text);
+    }
+    if (textureStats.m_gpuBytesWithMips > kTextureMemoryWarning) {
+        text.str("");
+        text << "Reduce texture memory (" << ToMegabytes(textureStats.m_gpuBytesWithMips)
+             << " MB): downscale textures or use a GPU compressed format";
+        suggest(text);
+    }
+    if (textureStats.m_oversizedCount > 0) {
+        text.str("");
+        text << "Downscale " << textureStats.m_oversizedCount << " images larger than "
+             << kTextureSizeWarning << " pixels";
+        suggest(text);
+    }
+    if (mergedDrawCalls > kDrawCallWarning) {
+        text.str("");
+        text << "Reduce draw calls (" << mergedDrawCalls
+             << " even after merging): combine materials into texture atlases";
+        suggest(text);
+    } else if (drawCalls > kDrawCallWarning) {
+        text.str("");
+        text << "Merge meshes sharing a material (" << drawCalls << " draw calls, "
+             << mergedDrawCalls << " merged)";
+        suggest(text);
+    }
+    // ACMR depends on the topology (a regular grid cannot go much below 1.0), so warn on the
+    // transforms per unique vertex instead
+    if (triangleCount > 0 && atvr > kAtvrWarning) {
+        text.str("");
+        text << "Optimize the index order for the vertex cache (ATVR " << atvr << ", ACMR " << acmr
+             << ", e.g. meshoptimizer's optimizeVertexCache)";
+        suggest(text);
+    }
+    if (vertexReuse < kVertexReuseWarning) {
+        text.str("");
+        text << "Weld duplicate vertices (only " << vertexReuse << " indices per vertex)";
+        suggest(text);
+    }
+    if (textureStats.m_duplicateImageCount > 0) {
+        text.str("");
+        text << "Remove " << textureStats.m_duplicateImageCount
+             << " duplicate images and reference a single copy";
+        suggest(text);
+    }
+    if (materialStats.m_duplicateCount > 0) {
+        text.str("");
+        text << "Merge " << materialStats.m_duplicateCount << " duplicate materials";
+        suggest(text);
+    }
+    if (textureStats.m_unusedImageCount > 0) {
+        text.str("");
+        text << "Remove " << textureStats.m_unusedImageCount << " unused images ("
+             << ToMegabytes(textureStats.m_unusedImageBytes) << " MB decoded for nothing)";
+        suggest(text);
+    }
+    if (materialStats.m_unusedCount > 0) {
+        text.str("");
+        text << "Remove " << materialStats.m_unusedCount << " unused materials";
+        suggest(text);
+    }
+    if (loadStats.m_missingNormalCount > 0) {
+        text.str("");
+        text << "Export normals: " << loadStats.m_missingNormalCount
+             << " primitives fall back to a constant normal";
+        suggest(text);
+    }
+
+    std::cout << "Suggestions" << std::endl;
+    if (suggestions.empty()) {
+        std::cout << "  None, the asset looks good" << std::endl;
+    }
+    for (const std::string& suggestion : suggestions) {
+        std::cout << "  - " << suggestion << std::endl;
+    }
+    std::cout << std::defaultfloat;
+    return true;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// Main Function
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    bool success = true;
+    for (size_t i = 0; i < options.m_inputs.size(); ++i) {
+        if (i > 0) {
+            std::cout << std::endl;
+        }
+        success &= ReportAsset(options.m_inputs[i], options);
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
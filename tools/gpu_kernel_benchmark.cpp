@@ -0,0 +1,1075 @@
+// GPU Kernel Benchmark
+//
+// Runs the viewer's GPU kernels headlessly over a sweep of sizes and formats and writes the
+// results as JSON. Each run is bracketed by two empty compute passes that write timestamps, so
+// the GPU time covers exactly the command buffers submitted by the kernel; the CPU time covers
+// encoding, submission and waiting for the queue to drain. When the adapter does not support
+// timestamp queries only CPU times are reported.
+//
+// Works on Dawn's software adapter (--fallback, SwiftShader) for relative comparisons on machines
+// without a GPU. Shaders are loaded from ./assets/shaders, so run it from the repository root.
+//
+// The opt-in ibl-cpu kernel times CpuEnvironmentPreprocessor on the same inputs as the ibl kernel
+// and reports the largest relative difference of its maps to the GPU maps.
+//
+// The opt-in mesh kernel converts the raw vertex data of --mesh-model with MeshProcessor into
+// vertex buffers split at maxBufferSize and compares the result with the CPU conversion. The
+// device runs on the default limits, so a model with more than 256 MB of raw vertex data checks
+// the split upload path, e.g. stress_asset_generator big.glb --triangles 3m --unindexed
+// --primitives 8. A mismatch makes the benchmark fail.
+//
+// Usage: gpu_kernel_benchmark [options]
+
+// Standard Library Headers
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Third-Party Library Headers
+#include <webgpu/webgpu_cpp.h>
+
+// Project Headers
+#include "cpu_environment_preprocessor.h"
+#include "environment.h"
+#include "environment_preprocessor.h"
+#include "exr_loader.h"
+#include "gpu_resource_pool.h"
+#include "mesh_processor.h"
+#include "mipmap_generator.h"
+#include "model.h"
+#include "panorama_to_cubemap_converter.h"
+#include "texture_utils.h"
+
+//----------------------------------------------------------------------
+// Internal Types and Utility Functions
+
+namespace {
+
+// Timestamp query slots written before and after each kernel
+constexpr uint32_t kTimestampCount = 2;
+constexpr uint64_t kTimestampBufferSize = kTimestampCount * sizeof(uint64_t);
+
+struct Options {
+    std::string m_output = "gpu_kernel_benchmark.json";
+    std::vector<uint32_t> m_sizes = {256, 512, 1024, 2048};
+    std::vector<std::string> m_kernels = {"mipmap", "panorama", "ibl", "upload"};
+    uint32_t m_iterations = 10;
+    uint32_t m_warmup = 2;
+    uint32_t m_sampleCount = 256;     // Samples per texel for the IBL stages
+    uint32_t m_environmentSize = 512; // Input cube size for the IBL stages
+    std::string m_meshModel;          // Model for the mesh kernel
+    bool m_fallbackAdapter = false;
+    wgpu::BackendType m_backend = wgpu::BackendType::Undefined;
+};
+
+struct Context {
+    wgpu::Instance m_instance;
+    wgpu::Adapter m_adapter;
+    wgpu::Device m_device;
+    bool m_timestamps = false;
+    wgpu::QuerySet m_querySet;
+    wgpu::Buffer m_resolveBuffer;
+    wgpu::Buffer m_readbackBuffer;
+};
+
+struct Result {
+    std::string m_kernel;
+    std::string m_variant;
+    std::string m_format;
+    uint32_t m_size = 0;
+    std::vector<double> m_gpuMs;
+    std::vector<double> m_cpuMs;
+    double m_gpuDifference = -1.0; // Largest relative difference to the GPU result (-1: n/a)
+};
+
+struct Summary {
+    double m_min = 0.0;
+    double m_median = 0.0;
+    double m_mean = 0.0;
+    double m_max = 0.0;
+};
+
+void PrintUsage() {
+    std::cout
+        << "Usage: gpu_kernel_benchmark [options]\n"
+        << "  --output <file>          JSON output (default gpu_kernel_benchmark.json)\n"
+        << "  --sizes <n,...>          Texture sizes to sweep (default 256,512,1024,2048)\n"
+        << "  --kernels <name,...>     Subset of mipmap,panorama,ibl,ibl-cpu,upload,mesh\n"
+        << "                           (default all except ibl-cpu and mesh)\n"
+        << "  --iterations <n>         Measured runs per case (default 10)\n"
+        << "  --warmup <n>             Unmeasured runs per case (default 2)\n"
+        << "  --samples <n>            Samples per texel for the IBL stages (default 256)\n"
+        << "  --environment-size <n>   Input cube size for the IBL stages (default 512)\n"
+        << "  --mesh-model <file>      .glb/.gltf converted by the mesh kernel\n"
+        << "  --backend <name>         d3d11, d3d12, metal, vulkan, opengl, opengles or null\n"
+        << "  --fallback               Use the software adapter (SwiftShader)\n";
+}
+
+std::vector<std::string> SplitList(std::string_view text) {
+    std::vector<std::string> items;
+    std::stringstream stream{std::string(text)};
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+bool ParseUInt(std::string_view text, uint32_t& value, bool allowZero = false) {
+    // strtoul accepts a sign, so require a leading digit
+    const std::string digits(text);
+    if (digits.empty() || !std::isdigit(static_cast<unsigned char>(digits.front()))) {
+        return false;
+    }
+    char *end = nullptr;
+    const unsigned long parsed = std::strtoul(digits.c_str(), &end, 10);
+    if (*end != '\0' || (parsed == 0 && !allowZero) || parsed > UINT32_MAX) {
+        return false;
+    }
+    value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+bool ParseBackend(std::string_view name, wgpu::BackendType& backend) {
+    const std::pair<std::string_view, wgpu::BackendType> backends[] = {
+        {"d3d11", wgpu::BackendType::D3D11},   {"d3d12", wgpu::BackendType::D3D12},
+        {"metal", wgpu::BackendType::Metal},   {"vulkan", wgpu::BackendType::Vulkan},
+        {"opengl", wgpu::BackendType::OpenGL}, {"opengles", wgpu::BackendType::OpenGLES},
+        {"null", wgpu::BackendType::Null},
+    };
+    for (const auto& [backendName, type] : backends) {
+        if (name == backendName) {
+            backend = type;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseOptions(int argc, char **argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+
+        // Options without values
+        if (arg == "--fallback") {
+            options.m_fallbackAdapter = true;
+            continue;
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        const std::string_view value = argv[++i];
+
+        bool valid = true;
+        if (arg == "--output") {
+            options.m_output = value;
+        } else if (arg == "--sizes") {
+            options.m_sizes.clear();
+            for (const std::string& item : SplitList(value)) {
+                uint32_t size = 0;
+                valid &= ParseUInt(item, size);
+                options.m_sizes.push_back(size);
+            }
+            valid &= !options.m_sizes.empty();
+        } else if (arg == "--kernels") {
+            options.m_kernels = SplitList(value);
+        } else if (arg == "--iterations") {
+            valid = ParseUInt(value, options.m_iterations);
+        } else if (arg == "--warmup") {
+            valid = ParseUInt(value, options.m_warmup, true);
+        } else if (arg == "--samples") {
+            valid = ParseUInt(value, options.m_sampleCount);
+        } else if (arg == "--environment-size") {
+            valid = ParseUInt(value, options.m_environmentSize);
+        } else if (arg == "--mesh-model") {
+            options.m_meshModel = value;
+        } else if (arg == "--backend") {
+            valid = ParseBackend(value, options.m_backend);
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+
+        if (!valid) {
+            std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IsKernelEnabled(const Options& options, std::string_view kernel) {
+    return std::find(options.m_kernels.begin(), options.m_kernels.end(), kernel) !=
+           options.m_kernels.end();
+}
+
+uint32_t MipLevelCount(uint32_t size) {
+    uint32_t levels = 1;
+    while (size > 1) {
+        size >>= 1;
+        ++levels;
+    }
+    return levels;
+}
+
+const char *FormatName(wgpu::TextureFormat format) {
+    switch (format) {
+    case wgpu::TextureFormat::RGBA8Unorm:
+        return "RGBA8Unorm";
+    case wgpu::TextureFormat::RGBA8UnormSrgb:
+        return "RGBA8UnormSrgb";
+    case wgpu::TextureFormat::RGBA16Float:
+        return "RGBA16Float";
+    case wgpu::TextureFormat::RGBA32Float:
+        return "RGBA32Float";
+    default:
+        return "Unknown";
+    }
+}
+
+const char *BackendName(wgpu::BackendType backend) {
+    switch (backend) {
+    case wgpu::BackendType::Null:
+        return "null";
+    case wgpu::BackendType::D3D11:
+        return "d3d11";
+    case wgpu::BackendType::D3D12:
+        return "d3d12";
+    case wgpu::BackendType::Metal:
+        return "metal";
+    case wgpu::BackendType::Vulkan:
+        return "vulkan";
+    case wgpu::BackendType::OpenGL:
+        return "opengl";
+    case wgpu::BackendType::OpenGLES:
+        return "opengles";
+    default:
+        return "unknown";
+    }
+}
+
+std::string EscapeJson(std::string_view text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+    }
+    return escaped;
+}
+
+Summary Summarize(std::vector<double> values) {
+    Summary summary;
+    if (values.empty()) {
+        return summary;
+    }
+
+    std::sort(values.begin(), values.end());
+    summary.m_min = values.front();
+    summary.m_max = values.back();
+    summary.m_median = values[values.size() / 2];
+    summary.m_mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    return summary;
+}
+
+//----------------------------------------------------------------------
+// Device Setup
+
+bool CreateDevice(const Options& options, Context& context) {
+    // Futures are waited on synchronously; the benchmark has no event loop
+    const wgpu::InstanceFeatureName timedWaitAny = wgpu::InstanceFeatureName::TimedWaitAny;
+    wgpu::InstanceDescriptor instanceDescriptor{};
+    instanceDescriptor.requiredFeatureCount = 1;
+    instanceDescriptor.requiredFeatures = &timedWaitAny;
+    context.m_instance = wgpu::CreateInstance(&instanceDescriptor);
+
+    wgpu::RequestAdapterOptions adapterOptions{};
+    adapterOptions.powerPreference = wgpu::PowerPreference::HighPerformance;
+    adapterOptions.forceFallbackAdapter = options.m_fallbackAdapter;
+    adapterOptions.backendType = options.m_backend;
+
+    context.m_instance.WaitAny(
+        context.m_instance.RequestAdapter(
+            &adapterOptions, wgpu::CallbackMode::WaitAnyOnly,
+            [&context](wgpu::RequestAdapterStatus status, wgpu::Adapter adapter,
+                       wgpu::StringView message) {
+                if (status != wgpu::RequestAdapterStatus::Success) {
+                    std::cerr << "RequestAdapter: " << std::string_view(message) << std::endl;
+                    return;
+                }
+                context.m_adapter = std::move(adapter);
+            }),
+        UINT64_MAX);
+    if (!context.m_adapter) {
+        return false;
+    }
+
+    // Unquantized timestamps when supported; all kernels run on the default limits
+    context.m_timestamps = context.m_adapter.HasFeature(wgpu::FeatureName::TimestampQuery);
+    const wgpu::FeatureName timestampQuery = wgpu::FeatureName::TimestampQuery;
+    const char *const disabledToggles[] = {"timestamp_quantization"};
+    wgpu::DawnTogglesDescriptor toggles{};
+    toggles.disabledToggleCount = 1;
+    toggles.disabledToggles = disabledToggles;
+
+    wgpu::DeviceDescriptor deviceDescriptor{};
+    deviceDescriptor.nextInChain = &toggles;
+    deviceDescriptor.requiredFeatureCount = context.m_timestamps ? 1 : 0;
+    deviceDescriptor.requiredFeatures = &timestampQuery;
+    deviceDescriptor.SetUncapturedErrorCallback(
+        []([[maybe_unused]] const wgpu::Device&, [[maybe_unused]] wgpu::ErrorType,
+           wgpu::StringView message) {
+            std::cerr << "Uncaptured error: " << std::string_view(message) << std::endl;
+            std::exit(EXIT_FAILURE);
+        });
+
+    context.m_instance.WaitAny(
+        context.m_adapter.RequestDevice(
+            &deviceDescriptor, wgpu::CallbackMode::WaitAnyOnly,
+            [&context](wgpu::RequestDeviceStatus status, wgpu::Device device,
+                       wgpu::StringView message) {
+                if (status != wgpu::RequestDeviceStatus::Success) {
+                    std::cerr << "RequestDevice: " << std::string_view(message) << std::endl;
+                    return;
+                }
+                context.m_device = std::move(device);
+            }),
+        UINT64_MAX);
+    if (!context.m_device) {
+        return false;
+    }
+
+    if (context.m_timestamps) {
+        wgpu::QuerySetDescriptor querySetDescriptor{};
+        querySetDescriptor.type = wgpu::QueryType::Timestamp;
+        querySetDescriptor.count = kTimestampCount;
+        context.m_querySet = context.m_device.CreateQuerySet(&querySetDescriptor);
+
+        wgpu::BufferDescriptor bufferDescriptor{};
+        bufferDescriptor.size = kTimestampBufferSize;
+        bufferDescriptor.usage = wgpu::BufferUsage::QueryResolve | wgpu::BufferUsage::CopySrc;
+        context.m_resolveBuffer = context.m_device.CreateBuffer(&bufferDescriptor);
+
+        bufferDescriptor.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst;
+        context.m_readbackBuffer = context.m_device.CreateBuffer(&bufferDescriptor);
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------
+// Timing
+
+// Submits an empty compute pass that writes a timestamp at its beginning or end
+void WriteTimestamp(const Context& context, uint32_t queryIndex, bool endOfPass) {
+    wgpu::PassTimestampWrites timestampWrites{};
+    timestampWrites.querySet = context.m_querySet;
+    if (endOfPass) {
+        timestampWrites.endOfPassWriteIndex = queryIndex;
+    } else {
+        timestampWrites.beginningOfPassWriteIndex = queryIndex;
+    }
+
+    wgpu::ComputePassDescriptor passDescriptor{};
+    passDescriptor.timestampWrites = &timestampWrites;
+
+    wgpu::CommandEncoder encoder = context.m_device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass(&passDescriptor);
+    pass.End();
+
+    if (endOfPass) {
+        encoder.ResolveQuerySet(context.m_querySet, 0, kTimestampCount, context.m_resolveBuffer,
+                                0);
+        encoder.CopyBufferToBuffer(context.m_resolveBuffer, 0, context.m_readbackBuffer, 0,
+                                   kTimestampBufferSize);
+    }
+
+    wgpu::CommandBuffer commands = encoder.Finish();
+    context.m_device.GetQueue().Submit(1, &commands);
+}
+
+void WaitForQueue(const Context& context) {
+    context.m_instance.WaitAny(context.m_device.GetQueue().OnSubmittedWorkDone(
+                                   wgpu::CallbackMode::WaitAnyOnly,
+                                   [](wgpu::QueueWorkDoneStatus, wgpu::StringView) {}),
+                               UINT64_MAX);
+}
+
+double ReadTimestampsMs(const Context& context) {
+    context.m_instance.WaitAny(
+        context.m_readbackBuffer.MapAsync(wgpu::MapMode::Read, 0, kTimestampBufferSize,
+                                          wgpu::CallbackMode::WaitAnyOnly,
+                                          [](wgpu::MapAsyncStatus, wgpu::StringView) {}),
+        UINT64_MAX);
+
+    uint64_t timestamps[kTimestampCount] = {};
+    if (const void *mapped =
+            context.m_readbackBuffer.GetConstMappedRange(0, kTimestampBufferSize)) {
+        std::memcpy(timestamps, mapped, sizeof(timestamps));
+    }
+    context.m_readbackBuffer.Unmap();
+
+    // Timestamps are in nanoseconds; guard against reordering on some backends
+    return timestamps[1] > timestamps[0] ? static_cast<double>(timestamps[1] - timestamps[0]) * 1e-6
+                                         : 0.0;
+}
+
+// Runs the kernel warmup + iterations times and records the measured runs
+void Measure(const Context& context, const Options& options, Result& result,
+             const std::function<void()>& kernel) {
+    for (uint32_t run = 0; run < options.m_warmup + options.m_iterations; ++run) {
+        // Start from an idle queue so earlier work does not leak into this run
+        WaitForQueue(context);
+
+        const auto t0 = std::chrono::high_resolution_clock::now();
+        if (context.m_timestamps) {
+            WriteTimestamp(context, 0, false);
+        }
+        kernel();
+        if (context.m_timestamps) {
+            WriteTimestamp(context, 1, true);
+        }
+        WaitForQueue(context);
+        const auto t1 = std::chrono::high_resolution_clock::now();
+
+        const double gpuMs = context.m_timestamps ? ReadTimestampsMs(context) : 0.0;
+        if (run >= options.m_warmup) {
+            result.m_cpuMs.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+            if (context.m_timestamps) {
+                result.m_gpuMs.push_back(gpuMs);
+            }
+        }
+    }
+
+    const Summary gpu = Summarize(result.m_gpuMs);
+    const Summary cpu = Summarize(result.m_cpuMs);
+    std::cout << std::left << std::setw(28) << (result.m_kernel + "/" + result.m_variant)
+              << std::setw(16) << result.m_format << std::right << std::setw(6) << result.m_size
+              << std::fixed << std::setprecision(3) << "  gpu " << std::setw(9) << gpu.m_median
+              << " ms  cpu " << std::setw(9) << cpu.m_median << " ms" << std::endl;
+}
+
+//----------------------------------------------------------------------
+// Kernels
+
+Result& AddResult(std::vector<Result>& results, const char *kernel, const char *variant,
+                  const char *format, uint32_t size) {
+    Result& result = results.emplace_back();
+    result.m_kernel = kernel;
+    result.m_variant = variant;
+    result.m_format = format;
+    result.m_size = size;
+    return result;
+}
+
+wgpu::Texture CreateTexture(const wgpu::Device& device, uint32_t size, uint32_t layers,
+                            wgpu::TextureFormat format, wgpu::TextureUsage usage, bool mipmapped) {
+    wgpu::TextureDescriptor descriptor{};
+    descriptor.size = {size, size, layers};
+    descriptor.format = format;
+    descriptor.usage = usage;
+    descriptor.mipLevelCount = mipmapped ? MipLevelCount(size) : 1;
+    return device.CreateTexture(&descriptor);
+}
+
+constexpr wgpu::TextureUsage kStorageUsage =
+    wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::StorageBinding |
+    wgpu::TextureUsage::CopyDst | wgpu::TextureUsage::CopySrc;
+
+void BenchmarkMipmaps(const Context& context, const Options& options,
+                      std::vector<Result>& results) {
+    struct Variant {
+        const char *m_name;
+        MipmapGenerator::MipKind m_kind;
+        wgpu::TextureFormat m_format;
+        uint32_t m_layers;
+    };
+    const Variant variants[] = {
+        {"LinearUNorm2D", MipmapGenerator::MipKind::LinearUNorm2D,
+         wgpu::TextureFormat::RGBA8Unorm, 1},
+        {"Normal2D", MipmapGenerator::MipKind::Normal2D, wgpu::TextureFormat::RGBA8Unorm, 1},
+        {"SRGB2D", MipmapGenerator::MipKind::SRGB2D, wgpu::TextureFormat::RGBA8UnormSrgb, 1},
+        {"Float16Cube", MipmapGenerator::MipKind::Float16Cube, wgpu::TextureFormat::RGBA16Float,
+         6},
+    };
+
+    MipmapGenerator mipmapGenerator(context.m_device);
+    for (const Variant& variant : variants) {
+        // sRGB textures are mipmapped by rendering, everything else through storage textures
+        const wgpu::TextureUsage usage =
+            variant.m_kind == MipmapGenerator::MipKind::SRGB2D
+                ? wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::RenderAttachment |
+                      wgpu::TextureUsage::CopyDst
+                : kStorageUsage;
+
+        for (uint32_t size : options.m_sizes) {
+            wgpu::Texture texture = CreateTexture(context.m_device, size, variant.m_layers,
+                                                  variant.m_format, usage, true);
+            Result& result = AddResult(results, "GenerateMipmaps", variant.m_name,
+                                       FormatName(variant.m_format), size);
+            Measure(context, options, result, [&]() {
+                mipmapGenerator.GenerateMipmaps(texture, {size, size, variant.m_layers},
+                                                variant.m_kind);
+            });
+            texture.Destroy();
+        }
+    }
+}
+
+void BenchmarkPanoramaToCubemap(const Context& context, const Options& options,
+                                std::vector<Result>& results) {
+    PanoramaToCubemapConverter converter(context.m_device);
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> radiance(0.0f, 4.0f);
+
+    for (uint32_t size : options.m_sizes) {
+        // Equirectangular panorama with four times the cube face width
+        Environment::Texture panorama;
+        panorama.m_width = size * 4;
+        panorama.m_height = size * 2;
+        panorama.m_components = 4;
+        panorama.m_data.resize(static_cast<size_t>(panorama.m_width) * panorama.m_height * 4);
+        std::generate(panorama.m_data.begin(), panorama.m_data.end(),
+                      [&]() { return radiance(rng); });
+
+        wgpu::Texture cubemap = CreateTexture(context.m_device, size, 6,
+                                              wgpu::TextureFormat::RGBA16Float, kStorageUsage,
+                                              true);
+        Result& result = AddResult(results, "UploadAndConvert", "Panorama",
+                                   FormatName(wgpu::TextureFormat::RGBA32Float), size);
+        Measure(context, options, result,
+                [&]() { converter.UploadAndConvert(panorama, cubemap); });
+        cubemap.Destroy();
+    }
+}
+
+void BenchmarkEnvironmentPreprocessor(const Context& context, const Options& options,
+                                      std::vector<Result>& results) {
+    EnvironmentPreprocessor preprocessor(context.m_device);
+    MipmapGenerator mipmapGenerator(context.m_device);
+
+    // Shared input cube; its contents do not affect the sample count
+    const uint32_t environmentSize = options.m_environmentSize;
+    wgpu::Texture environment =
+        CreateTexture(context.m_device, environmentSize, 6, wgpu::TextureFormat::RGBA16Float,
+                      kStorageUsage, true);
+    mipmapGenerator.GenerateMipmaps(environment, {environmentSize, environmentSize, 6},
+                                    MipmapGenerator::MipKind::Float16Cube);
+
+    struct Variant {
+        const char *m_name;
+        EnvironmentPreprocessor::Stage m_stage;
+    };
+    const Variant variants[] = {
+        {"Irradiance", EnvironmentPreprocessor::Stage::Irradiance},
+        {"PrefilteredSpecular", EnvironmentPreprocessor::Stage::PrefilteredSpecular},
+        {"BRDFIntegrationLUT", EnvironmentPreprocessor::Stage::BRDFIntegrationLUT},
+    };
+
+    for (uint32_t size : options.m_sizes) {
+        // Every stage writes a map of the swept size; the others stay minimal
+        for (const Variant& variant : variants) {
+            using Stage = EnvironmentPreprocessor::Stage;
+            const auto stageSize = [&](Stage stage) {
+                return variant.m_stage == stage ? size : 1u;
+            };
+
+            wgpu::Texture irradiance =
+                CreateTexture(context.m_device, stageSize(Stage::Irradiance), 6,
+                              wgpu::TextureFormat::RGBA16Float, kStorageUsage, false);
+            wgpu::Texture specular =
+                CreateTexture(context.m_device, stageSize(Stage::PrefilteredSpecular), 6,
+                              wgpu::TextureFormat::RGBA16Float, kStorageUsage, true);
+            wgpu::Texture lut =
+                CreateTexture(context.m_device, stageSize(Stage::BRDFIntegrationLUT), 1,
+                              wgpu::TextureFormat::RGBA16Float, kStorageUsage, false);
+
+            Result& result = AddResult(results, "EnvironmentPreprocessor", variant.m_name,
+                                       FormatName(wgpu::TextureFormat::RGBA16Float), size);
+            Measure(context, options, result, [&]() {
+                preprocessor.GenerateStage(variant.m_stage, environment, irradiance, specular, lut,
+                                           options.m_sampleCount);
+            });
+
+            irradiance.Destroy();
+            specular.Destroy();
+            lut.Destroy();
+        }
+    }
+    environment.Destroy();
+}
+
+// Smooth sky with a soft sun, so the comparison measures the integration and not texel aliasing
+Environment::Texture CreateSyntheticPanorama(uint32_t width, uint32_t height) {
+    constexpr float kPi = 3.14159265359f;
+    Environment::Texture panorama;
+    panorama.m_width = width;
+    panorama.m_height = height;
+    panorama.m_components = 4;
+    panorama.m_data.resize(static_cast<size_t>(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        const float elevation = 0.5f - (static_cast<float>(y) + 0.5f) / static_cast<float>(height);
+        for (uint32_t x = 0; x < width; ++x) {
+            const float azimuth = (static_cast<float>(x) + 0.5f) / static_cast<float>(width);
+            const float sun = std::exp(-40.0f * ((azimuth - 0.3f) * (azimuth - 0.3f) +
+                                                 (elevation - 0.2f) * (elevation - 0.2f)));
+            const float sky = 0.5f + 0.5f * std::sin(elevation * kPi);
+            float *texel = &panorama.m_data[(static_cast<size_t>(y) * width + x) * 4];
+            texel[0] = 0.4f * sky + 8.0f * sun;
+            texel[1] = 0.6f * sky + 7.0f * sun;
+            texel[2] = 1.0f * sky + 5.0f * sun;
+            texel[3] = 1.0f;
+        }
+    }
+    return panorama;
+}
+
+void UploadImage(const wgpu::Device& device, const CpuEnvironmentPreprocessor::Image& image,
+                 const wgpu::Texture& texture) {
+    for (uint32_t level = 0; level < image.m_mipLevels.size(); ++level) {
+        const std::vector<float>& texels = image.m_mipLevels[level];
+        std::vector<uint16_t> halfTexels(texels.size());
+        std::transform(texels.begin(), texels.end(), halfTexels.begin(), exr_loader::FloatToHalf);
+
+        const uint32_t size = std::max(image.m_size >> level, 1u);
+        wgpu::TexelCopyTextureInfo destination{};
+        destination.texture = texture;
+        destination.mipLevel = level;
+        wgpu::TexelCopyBufferLayout layout{};
+        layout.bytesPerRow = size * 4 * sizeof(uint16_t);
+        layout.rowsPerImage = size;
+        wgpu::Extent3D extent = {size, size, image.m_layerCount};
+        device.GetQueue().WriteTexture(&destination, halfTexels.data(),
+                                       halfTexels.size() * sizeof(uint16_t), &layout, &extent);
+    }
+}
+
+// Reads back one mip level of an RGBA16Float texture as floats (layers one after another)
+std::vector<float> ReadTexture(const Context& context, const wgpu::Texture& texture,
+                               uint32_t mipLevel) {
+    const uint32_t size = std::max(texture.GetWidth() >> mipLevel, 1u);
+    const uint32_t layers = texture.GetDepthOrArrayLayers();
+    const uint32_t rowBytes = size * 4 * sizeof(uint16_t);
+    const uint32_t paddedRowBytes = (rowBytes + 255) / 256 * 256;
+    const uint64_t bufferSize = static_cast<uint64_t>(paddedRowBytes) * size * layers;
+
+    wgpu::BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = bufferSize;
+    bufferDescriptor.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
+    wgpu::Buffer buffer = context.m_device.CreateBuffer(&bufferDescriptor);
+
+    wgpu::TexelCopyTextureInfo source{};
+    source.texture = texture;
+    source.mipLevel = mipLevel;
+    wgpu::TexelCopyBufferInfo destination{};
+    destination.buffer = buffer;
+    destination.layout.bytesPerRow = paddedRowBytes;
+    destination.layout.rowsPerImage = size;
+    wgpu::Extent3D extent = {size, size, layers};
+    wgpu::CommandEncoder encoder = context.m_device.CreateCommandEncoder();
+    encoder.CopyTextureToBuffer(&source, &destination, &extent);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    context.m_device.GetQueue().Submit(1, &commands);
+
+    context.m_instance.WaitAny(buffer.MapAsync(wgpu::MapMode::Read, 0, bufferSize,
+                                               wgpu::CallbackMode::WaitAnyOnly,
+                                               [](wgpu::MapAsyncStatus, wgpu::StringView) {}),
+                               UINT64_MAX);
+
+    std::vector<float> texels(static_cast<size_t>(size) * size * layers * 4);
+    const auto *mapped = static_cast<const uint8_t *>(buffer.GetConstMappedRange(0, bufferSize));
+    if (mapped) {
+        for (uint32_t row = 0; row < size * layers; ++row) {
+            const auto *halfTexels = reinterpret_cast<const uint16_t *>(
+                mapped + static_cast<size_t>(row) * paddedRowBytes);
+            std::transform(halfTexels, halfTexels + size * 4,
+                           texels.begin() + static_cast<ptrdiff_t>(row) * size * 4,
+                           exr_loader::HalfToFloat);
+        }
+    }
+    buffer.Unmap();
+    buffer.Destroy();
+    return texels;
+}
+
+// Largest difference over all mip levels, relative to the GPU value (absolute below 1)
+double CompareWithGpu(const Context& context, const CpuEnvironmentPreprocessor::Image& image,
+                      const wgpu::Texture& texture) {
+    double difference = 0.0;
+    for (uint32_t level = 0; level < image.m_mipLevels.size(); ++level) {
+        const std::vector<float> gpuTexels = ReadTexture(context, texture, level);
+        const std::vector<float>& cpuTexels = image.m_mipLevels[level];
+        for (size_t i = 0; i < cpuTexels.size() && i < gpuTexels.size(); ++i) {
+            const double scale = std::max(1.0, std::abs(static_cast<double>(gpuTexels[i])));
+            difference = std::max(difference, std::abs(cpuTexels[i] - gpuTexels[i]) / scale);
+        }
+    }
+    return difference;
+}
+
+void BenchmarkCpuEnvironmentPreprocessor(const Context& context, const Options& options,
+                                         std::vector<Result>& results) {
+    CpuEnvironmentPreprocessor cpuPreprocessor;
+    EnvironmentPreprocessor gpuPreprocessor(context.m_device);
+    std::cout << "CPU preprocessor threads: " << cpuPreprocessor.GetThreadCount() << std::endl;
+
+    // The same input cube for both paths, converted and mipmapped on the CPU
+    const uint32_t environmentSize = options.m_environmentSize;
+    const Environment::Texture panorama =
+        CreateSyntheticPanorama(environmentSize * 4, environmentSize * 2);
+    CpuEnvironmentPreprocessor::Image environment =
+        CpuEnvironmentPreprocessor::CreateImage(environmentSize, 6, true);
+    cpuPreprocessor.ConvertPanorama(panorama, environment);
+    cpuPreprocessor.GenerateMipmaps(environment);
+    wgpu::Texture environmentTexture =
+        CreateTexture(context.m_device, environmentSize, 6, wgpu::TextureFormat::RGBA16Float,
+                      kStorageUsage, true);
+    UploadImage(context.m_device, environment, environmentTexture);
+
+    struct Variant {
+        const char *m_name;
+        CpuEnvironmentPreprocessor::Stage m_stage;
+        EnvironmentPreprocessor::Stage m_gpuStage;
+    };
+    const Variant variants[] = {
+        {"Irradiance", CpuEnvironmentPreprocessor::Stage::Irradiance,
+         EnvironmentPreprocessor::Stage::Irradiance},
+        {"PrefilteredSpecular", CpuEnvironmentPreprocessor::Stage::PrefilteredSpecular,
+         EnvironmentPreprocessor::Stage::PrefilteredSpecular},
+        {"BRDFIntegrationLUT", CpuEnvironmentPreprocessor::Stage::BRDFIntegrationLUT,
+         EnvironmentPreprocessor::Stage::BRDFIntegrationLUT},
+    };
+
+    for (uint32_t size : options.m_sizes) {
+        // Same map sizes as the ibl kernel
+        for (const Variant& variant : variants) {
+            using Stage = CpuEnvironmentPreprocessor::Stage;
+            const auto stageSize = [&](Stage stage) {
+                return variant.m_stage == stage ? size : 1u;
+            };
+
+            CpuEnvironmentPreprocessor::Image irradiance =
+                CpuEnvironmentPreprocessor::CreateImage(stageSize(Stage::Irradiance), 6, false);
+            CpuEnvironmentPreprocessor::Image specular = CpuEnvironmentPreprocessor::CreateImage(
+                stageSize(Stage::PrefilteredSpecular), 6, true);
+            CpuEnvironmentPreprocessor::Image lut = CpuEnvironmentPreprocessor::CreateImage(
+                stageSize(Stage::BRDFIntegrationLUT), 1, false);
+
+            Result& result = AddResult(results, "CpuEnvironmentPreprocessor", variant.m_name,
+                                       "RGBA32Float", size);
+            Measure(context, options, result, [&]() {
+                cpuPreprocessor.GenerateStage(variant.m_stage, environment, irradiance, specular,
+                                              lut, options.m_sampleCount);
+            });
+
+            // Reference maps from the GPU preprocessor
+            wgpu::Texture gpuIrradiance =
+                CreateTexture(context.m_device, irradiance.m_size, 6,
+                              wgpu::TextureFormat::RGBA16Float, kStorageUsage, false);
+            wgpu::Texture gpuSpecular =
+                CreateTexture(context.m_device, specular.m_size, 6,
+                              wgpu::TextureFormat::RGBA16Float, kStorageUsage, true);
+            wgpu::Texture gpuLut = CreateTexture(context.m_device, lut.m_size, 1,
+                                                 wgpu::TextureFormat::RGBA16Float, kStorageUsage,
+                                                 false);
+            gpuPreprocessor.GenerateStage(variant.m_gpuStage, environmentTexture, gpuIrradiance,
+                                          gpuSpecular, gpuLut, options.m_sampleCount);
+
+            if (variant.m_stage == Stage::Irradiance) {
+                result.m_gpuDifference = CompareWithGpu(context, irradiance, gpuIrradiance);
+            } else if (variant.m_stage == Stage::PrefilteredSpecular) {
+                result.m_gpuDifference = CompareWithGpu(context, specular, gpuSpecular);
+            } else {
+                result.m_gpuDifference = CompareWithGpu(context, lut, gpuLut);
+            }
+            std::cout << "  max relative difference to GPU: " << result.m_gpuDifference
+                      << std::endl;
+
+            gpuIrradiance.Destroy();
+            gpuSpecular.Destroy();
+            gpuLut.Destroy();
+        }
+    }
+    environmentTexture.Destroy();
+}
+
+void BenchmarkTextureUpload(const Context& context, const Options& options,
+                            std::vector<Result>& results) {
+    struct Variant {
+        const char *m_name;
+        MipmapGenerator::MipKind m_kind;
+        wgpu::TextureFormat m_format;
+    };
+    const Variant variants[] = {
+        {"LinearUNorm2D", MipmapGenerator::MipKind::LinearUNorm2D,
+         wgpu::TextureFormat::RGBA8Unorm},
+        {"Normal2D", MipmapGenerator::MipKind::Normal2D, wgpu::TextureFormat::RGBA8Unorm},
+        {"SRGB2D", MipmapGenerator::MipKind::SRGB2D, wgpu::TextureFormat::RGBA8UnormSrgb},
+    };
+
+    GpuResourcePool resourcePool(context.m_device);
+    MipmapGenerator mipmapGenerator(context.m_device);
+    std::mt19937 rng(1234);
+
+    for (uint32_t size : options.m_sizes) {
+        std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 4);
+        std::generate(pixels.begin(), pixels.end(),
+                      [&]() { return static_cast<uint8_t>(rng()); });
+
+        for (const Variant& variant : variants) {
+            Result& result = AddResult(results, "CreateTexture", variant.m_name,
+                                       FormatName(variant.m_format), size);
+            Measure(context, options, result, [&]() {
+                wgpu::Texture texture;
+                texture_utils::CreateTexture(pixels.data(), size, size, variant.m_format,
+                                             context.m_device, resourcePool, mipmapGenerator,
+                                             variant.m_kind, texture);
+
+                // Steady state of a model load: the pooled textures are reused by the next run
+                resourcePool.Release(texture, GpuResourcePool::ReleaseMode::QueueOrdered);
+            });
+        }
+        resourcePool.Trim(0);
+    }
+}
+
+// Reads back the first size bytes of a buffer with CopySrc usage
+std::vector<uint8_t> ReadBuffer(const Context& context, const wgpu::Buffer& buffer,
+                                uint64_t size) {
+    wgpu::BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = size;
+    bufferDescriptor.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
+    wgpu::Buffer readback = context.m_device.CreateBuffer(&bufferDescriptor);
+
+    wgpu::CommandEncoder encoder = context.m_device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(buffer, 0, readback, 0, size);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    context.m_device.GetQueue().Submit(1, &commands);
+
+    context.m_instance.WaitAny(readback.MapAsync(wgpu::MapMode::Read, 0, size,
+                                                 wgpu::CallbackMode::WaitAnyOnly,
+                                                 [](wgpu::MapAsyncStatus, wgpu::StringView) {}),
+                               UINT64_MAX);
+
+    std::vector<uint8_t> bytes(size);
+    if (const void *mapped = readback.GetConstMappedRange(0, size)) {
+        std::memcpy(bytes.data(), mapped, size);
+    }
+    readback.Unmap();
+    readback.Destroy();
+    return bytes;
+}
+
+// Returns false if the GPU conversion does not match the CPU conversion
+bool BenchmarkMeshProcessor(const Context& context, const Options& options,
+                            std::vector<Result>& results) {
+    Model model;
+    model.SetLoadOptions({.m_gpuVertexProcessing = true});
+    model.Load(options.m_meshModel);
+    const Model::RawVertexData& rawVertexData = model.GetRawVertexData();
+    const std::vector<Model::Vertex>& vertices = model.GetVertices();
+    if (rawVertexData.m_primitives.empty()) {
+        std::cerr << "No raw vertex data in " << options.m_meshModel << std::endl;
+        return false;
+    }
+
+    // Split the output at maxBufferSize, like Renderer::CreateGeometryBuffers
+    wgpu::Limits limits{};
+    context.m_device.GetLimits(&limits);
+    const uint64_t verticesPerBuffer = limits.maxBufferSize / sizeof(Model::Vertex);
+    std::vector<MeshProcessor::VertexRange> vertexRanges;
+    for (uint64_t first = 0; first < vertices.size(); first += verticesPerBuffer) {
+        const uint64_t count = std::min<uint64_t>(verticesPerBuffer, vertices.size() - first);
+        wgpu::BufferDescriptor bufferDescriptor{};
+        bufferDescriptor.size = count * sizeof(Model::Vertex);
+        bufferDescriptor.usage = wgpu::BufferUsage::Vertex | wgpu::BufferUsage::Storage |
+                                 wgpu::BufferUsage::CopySrc;
+        vertexRanges.push_back({context.m_device.CreateBuffer(&bufferDescriptor),
+                                static_cast<uint32_t>(first), static_cast<uint32_t>(count)});
+    }
+    std::cout << "Mesh model: " << vertices.size() << " vertices, "
+              << rawVertexData.m_bytes.size() / (1024 * 1024) << " MB raw vertex data, "
+              << vertexRanges.size() << " vertex buffers (maxBufferSize "
+              << limits.maxBufferSize / (1024 * 1024) << " MB)" << std::endl;
+
+    MeshProcessor meshProcessor(context.m_device);
+    Result& result = AddResult(results, "ProcessVertices", "RawPrimitives", "Vertex",
+                               static_cast<uint32_t>(vertices.size()));
+    Measure(context, options, result,
+            [&]() { meshProcessor.ProcessVertices(model, vertexRanges); });
+
+    // Compare the raw primitives' vertices with the CPU conversion
+    constexpr size_t kFloatsPerVertex = sizeof(Model::Vertex) / sizeof(float);
+    std::vector<Model::Vertex> expected(vertices.size());
+    for (const Model::RawPrimitive& primitive : rawVertexData.m_primitives) {
+        model.ConvertRawPrimitive(primitive, expected.data() + primitive.m_firstVertex);
+    }
+
+    double difference = 0.0;
+    for (const MeshProcessor::VertexRange& range : vertexRanges) {
+        const std::vector<uint8_t> bytes = ReadBuffer(
+            context, range.m_buffer, uint64_t{range.m_vertexCount} * sizeof(Model::Vertex));
+        const auto *gpuFloats = reinterpret_cast<const float *>(bytes.data());
+
+        for (const Model::RawPrimitive& primitive : rawVertexData.m_primitives) {
+            const uint64_t rangeEnd = uint64_t{range.m_firstVertex} + range.m_vertexCount;
+            const uint64_t first = std::max(primitive.m_firstVertex, range.m_firstVertex);
+            const uint64_t end =
+                std::min(uint64_t{primitive.m_firstVertex} + primitive.m_vertexCount, rangeEnd);
+            for (uint64_t vertex = first; vertex < end; ++vertex) {
+                const auto *cpuVertex = reinterpret_cast<const float *>(&expected[vertex]);
+                const float *gpuVertex =
+                    gpuFloats + (vertex - range.m_firstVertex) * kFloatsPerVertex;
+                for (size_t i = 0; i < kFloatsPerVertex; ++i) {
+                    const double scale = std::max(1.0, std::abs(static_cast<double>(cpuVertex[i])));
+                    difference =
+                        std::max(difference, std::abs(cpuVertex[i] - gpuVertex[i]) / scale);
+                }
+            }
+        }
+        range.m_buffer.Destroy();
+    }
+
+    // The shader and the CPU conversion only differ in rounding
+    constexpr double kMaxDifference = 1e-4;
+    result.m_gpuDifference = difference;
+    std::cout << "  max relative difference to CPU: " << difference << std::endl;
+    if (difference > kMaxDifference) {
+        std::cerr << "GPU vertex processing does not match the CPU conversion" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------
+// Output
+
+void WriteSummary(std::ostream& out, const char *name, const std::vector<double>& values) {
+    const Summary summary = Summarize(values);
+    out << "\"" << name << "\": {\"min\": " << summary.m_min << ", \"median\": " << summary.m_median
+        << ", \"mean\": " << summary.m_mean << ", \"max\": " << summary.m_max << "}";
+}
+
+bool WriteJson(const std::string& filename, const Context& context, const Options& options,
+               const std::vector<Result>& results) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    wgpu::AdapterInfo info{};
+    context.m_adapter.GetInfo(&info);
+
+    out << std::setprecision(6);
+    out << "{\n";
+    out << "  \"adapter\": {\"device\": \"" << EscapeJson(std::string_view(info.device))
+        << "\", \"description\": \"" << EscapeJson(std::string_view(info.description))
+        << "\", \"backend\": \"" << BackendName(info.backendType) << "\", \"fallback\": "
+        << (options.m_fallbackAdapter ? "true" : "false") << "},\n";
+    out << "  \"timestampQuery\": " << (context.m_timestamps ? "true" : "false") << ",\n";
+    out << "  \"iterations\": " << options.m_iterations << ",\n";
+    out << "  \"warmup\": " << options.m_warmup << ",\n";
+    out << "  \"sampleCount\": " << options.m_sampleCount << ",\n";
+    out << "  \"environmentSize\": " << options.m_environmentSize << ",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        out << "    {\"kernel\": \"" << result.m_kernel << "\", \"variant\": \""
+            << result.m_variant << "\", \"format\": \"" << result.m_format
+            << "\", \"size\": " << result.m_size << ", ";
+        if (context.m_timestamps) {
+            WriteSummary(out, "gpuMs", result.m_gpuMs);
+        } else {
+            out << "\"gpuMs\": null";
+        }
+        out << ", ";
+        WriteSummary(out, "cpuMs", result.m_cpuMs);
+        if (result.m_gpuDifference >= 0.0) {
+            out << ", \"gpuDifference\": " << result.m_gpuDifference;
+        }
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// Main Function
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+    if (IsKernelEnabled(options, "mesh") && options.m_meshModel.empty()) {
+        std::cerr << "The mesh kernel needs --mesh-model" << std::endl;
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    Context context;
+    if (!CreateDevice(options, context)) {
+        std::cerr << "Failed to create a WebGPU device" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    wgpu::AdapterInfo info{};
+    context.m_adapter.GetInfo(&info);
+    std::cout << "Adapter: " << std::string_view(info.device) << " ("
+              << BackendName(info.backendType) << ")" << std::endl;
+    if (!context.m_timestamps) {
+        std::cout << "Timestamp queries not supported; reporting CPU times only" << std::endl;
+    }
+
+    std::vector<Result> results;
+    if (IsKernelEnabled(options, "mipmap")) {
+        BenchmarkMipmaps(context, options, results);
+    }
+    if (IsKernelEnabled(options, "panorama")) {
+        BenchmarkPanoramaToCubemap(context, options, results);
+    }
+    if (IsKernelEnabled(options, "ibl")) {
+        BenchmarkEnvironmentPreprocessor(context, options, results);
+    }
+    if (IsKernelEnabled(options, "ibl-cpu")) {
+        BenchmarkCpuEnvironmentPreprocessor(context, options, results);
+    }
+    if (IsKernelEnabled(options, "upload")) {
+        BenchmarkTextureUpload(context, options, results);
+    }
+    bool passed = true;
+    if (IsKernelEnabled(options, "mesh")) {
+        passed = BenchmarkMeshProcessor(context, options, results);
+    }
+
+    if (!WriteJson(options.m_output, context, options, results)) {
+        std::cerr << "Failed to write " << options.m_output << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Wrote " << options.m_output << std::endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,565 @@
+// Stress Asset Generator
+//
+// Writes synthetic, reproducible .gltf/.glb files for benchmarking Model::Load. Every knob
+// targets one loader phase: triangle and node counts stress ProcessMesh, material counts the
+// JSON parser, omitted tangents MikkTSpace, texture counts image decode and base64 buffers the
+// data URI decoder.
+//
+// Usage: stress_asset_generator <output.gltf|output.glb> [options]
+
+// Standard Library Headers
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Third-Party Library Headers
+#define TINYGLTF_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <tiny_gltf.h>
+
+//----------------------------------------------------------------------
+// Internal Types and Utility Functions
+
+namespace {
+
+// Constants
+constexpr float PI = 3.14159265358979323846f;
+
+enum class ImageFormat { PNG, JPEG };
+
+struct Options {
+    std::string m_output;
+    uint64_t m_triangles = 1000000;  // Total triangles over all unique meshes
+    uint32_t m_nodes = 1;            // Nodes instancing the meshes (at least one per mesh)
+    uint32_t m_meshes = 1;           // Unique meshes
+    uint32_t m_materials = 1;        // Materials (assigned round-robin to primitives)
+    uint32_t m_primitives = 1;       // Primitives per mesh
+    uint32_t m_textures = 0;         // Unique images/textures
+    uint32_t m_textureSize = 512;    // Texture width and height
+    bool m_indexed = true;           // Indexed vs. unindexed triangles
+    bool m_tangents = true;          // Write TANGENT (false forces MikkTSpace generation)
+    bool m_externalTextures = false; // Write images as separate files instead of the buffer
+    bool m_base64Buffers = false;    // .gltf only: embed the buffer as a base64 data URI
+    ImageFormat m_imageFormat = ImageFormat::PNG;
+    uint32_t m_seed = 1234;
+};
+
+void PrintUsage() {
+    std::cout
+        << "Usage: stress_asset_generator <output.gltf|output.glb> [options]\n"
+        << "  --triangles <n>        Total triangles over all unique meshes (default 1000000)\n"
+        << "  --meshes <n>           Unique meshes (default 1)\n"
+        << "  --primitives <n>       Primitives per mesh (default 1)\n"
+        << "  --nodes <n>            Nodes instancing the meshes (default: one per mesh)\n"
+        << "  --materials <n>        Materials assigned round-robin (default 1)\n"
+        << "  --textures <n>         Unique textures assigned round-robin (default 0)\n"
+        << "  --texture-size <n>     Texture width and height (default 512)\n"
+        << "  --jpeg                 Encode textures as JPEG instead of PNG\n"
+        << "  --external-textures    Write textures as separate image files\n"
+        << "  --unindexed            Write unindexed triangle lists\n"
+        << "  --no-tangents          Omit TANGENT so the loader has to generate them\n"
+        << "  --base64               Embed the buffer as a base64 data URI (.gltf only)\n"
+        << "  --seed <n>             Seed for the procedural content (default 1234)\n";
+}
+
+bool ParseUInt(std::string_view text, uint64_t& value) {
+    if (text.empty()) {
+        return false;
+    }
+
+    // Accept an optional k/m suffix (e.g. 5m triangles)
+    uint64_t multiplier = 1;
+    char suffix = static_cast<char>(std::tolower(static_cast<unsigned char>(text.back())));
+    if (suffix == 'k' || suffix == 'm') {
+        multiplier = suffix == 'k' ? 1000 : 1000000;
+        text.remove_suffix(1);
+    }
+
+    char *end = nullptr;
+    std::string digits(text);
+    unsigned long long parsed = std::strtoull(digits.c_str(), &end, 10);
+    if (digits.empty() || *end != '\0') {
+        return false;
+    }
+
+    value = parsed * multiplier;
+    return true;
+}
+
+bool ParseOptions(int argc, char **argv, Options& options) {
+    bool nodesSet = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+
+        // Options without values
+        if (arg == "--unindexed") {
+            options.m_indexed = false;
+            continue;
+        } else if (arg == "--no-tangents") {
+            options.m_tangents = false;
+            continue;
+        } else if (arg == "--external-textures") {
+            options.m_externalTextures = true;
+            continue;
+        } else if (arg == "--base64") {
+            options.m_base64Buffers = true;
+            continue;
+        } else if (arg == "--jpeg") {
+            options.m_imageFormat = ImageFormat::JPEG;
+            continue;
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg.rfind("--", 0) != 0) {
+            options.m_output = arg;
+            continue;
+        }
+
+        // Options with a numeric value
+        uint64_t value = 0;
+        if (i + 1 >= argc || !ParseUInt(argv[i + 1], value)) {
+            std::cerr << "Missing or invalid value for " << arg << std::endl;
+            return false;
+        }
+        ++i;
+
+        const uint32_t value32 = static_cast<uint32_t>(std::min<uint64_t>(value, UINT32_MAX));
+        if (arg == "--triangles") {
+            options.m_triangles = value;
+        } else if (arg == "--meshes") {
+            options.m_meshes = std::max(value32, 1u);
+        } else if (arg == "--primitives") {
+            options.m_primitives = std::max(value32, 1u);
+        } else if (arg == "--nodes") {
+            options.m_nodes = value32;
+            nodesSet = true;
+        } else if (arg == "--materials") {
+            options.m_materials = std::max(value32, 1u);
+        } else if (arg == "--textures") {
+            options.m_textures = value32;
+        } else if (arg == "--texture-size") {
+            options.m_textureSize = std::clamp(value32, 1u, 8192u);
+        } else if (arg == "--seed") {
+            options.m_seed = value32;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (options.m_output.empty()) {
+        return false;
+    }
+
+    // Every mesh is referenced by at least one node
+    if (!nodesSet || options.m_nodes < options.m_meshes) {
+        options.m_nodes = options.m_meshes;
+    }
+
+    return true;
+}
+
+// Appends raw data to the buffer (4-byte aligned) and returns the new buffer view index
+int AddBufferView(tinygltf::Model& model, const void *data, size_t size, int target) {
+    std::vector<unsigned char>& buffer = model.buffers[0].data;
+    buffer.resize((buffer.size() + 3) & ~size_t(3));
+
+    tinygltf::BufferView bufferView;
+    bufferView.buffer = 0;
+    bufferView.byteOffset = buffer.size();
+    bufferView.byteLength = size;
+    bufferView.target = target;
+
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+
+    model.bufferViews.push_back(bufferView);
+    return static_cast<int>(model.bufferViews.size() - 1);
+}
+
+template <typename T>
+int AddAccessor(tinygltf::Model& model, const std::vector<T>& data, int componentType, int type,
+                size_t count, int target) {
+    tinygltf::Accessor accessor;
+    accessor.bufferView = AddBufferView(model, data.data(), data.size() * sizeof(T), target);
+    accessor.componentType = componentType;
+    accessor.type = type;
+    accessor.count = count;
+    model.accessors.push_back(accessor);
+    return static_cast<int>(model.accessors.size() - 1);
+}
+
+// Adds a tessellated height field primitive with roughly the requested number of triangles
+tinygltf::Primitive AddHeightFieldPrimitive(tinygltf::Model& model, const Options& options,
+                                            uint64_t triangleCount, float phase,
+                                            int materialIndex) {
+    // Grid resolution (two triangles per quad)
+    const uint64_t quadCount = std::max<uint64_t>((triangleCount + 1) / 2, 1);
+    const uint32_t columns =
+        static_cast<uint32_t>(std::max<double>(std::ceil(std::sqrt(double(quadCount))), 1.0));
+    const uint32_t rows = static_cast<uint32_t>((quadCount + columns - 1) / columns);
+
+    // Evaluate the height field and its analytic derivatives
+    const float amplitude = 0.05f;
+    const float frequency = 6.0f * PI;
+    auto evaluate = [&](float u, float v, std::vector<float>& positions,
+                        std::vector<float>& normals, std::vector<float>& tangents,
+                        std::vector<float>& texCoords) {
+        const float x = u - 0.5f;
+        const float z = v - 0.5f;
+        const float h = amplitude * std::sin(frequency * u + phase) * std::cos(frequency * v);
+        const float hx = amplitude * frequency * std::cos(frequency * u + phase) *
+                         std::cos(frequency * v);
+        const float hz = -amplitude * frequency * std::sin(frequency * u + phase) *
+                         std::sin(frequency * v);
+
+        const float normalLength = std::sqrt(hx * hx + 1.0f + hz * hz);
+        const float tangentLength = std::sqrt(1.0f + hx * hx);
+
+        positions.insert(positions.end(), {x, h, z});
+        normals.insert(normals.end(),
+                       {-hx / normalLength, 1.0f / normalLength, -hz / normalLength});
+        tangents.insert(tangents.end(), {1.0f / tangentLength, hx / tangentLength, 0.0f, 1.0f});
+        texCoords.insert(texCoords.end(), {u, v});
+    };
+
+    std::vector<float> positions, normals, tangents, texCoords;
+    std::vector<uint32_t> indices;
+
+    if (options.m_indexed) {
+        const size_t vertexCount = size_t(columns + 1) * (rows + 1);
+        positions.reserve(vertexCount * 3);
+        normals.reserve(vertexCount * 3);
+        tangents.reserve(vertexCount * 4);
+        texCoords.reserve(vertexCount * 2);
+
+        for (uint32_t y = 0; y <= rows; ++y) {
+            for (uint32_t x = 0; x <= columns; ++x) {
+                evaluate(float(x) / columns, float(y) / rows, positions, normals, tangents,
+                         texCoords);
+            }
+        }
+
+        indices.reserve(quadCount * 6);
+        for (uint64_t quad = 0; quad < quadCount; ++quad) {
+            const uint32_t x = static_cast<uint32_t>(quad % columns);
+            const uint32_t y = static_cast<uint32_t>(quad / columns);
+            const uint32_t i0 = y * (columns + 1) + x;
+            const uint32_t i1 = i0 + 1;
+            const uint32_t i2 = i0 + columns + 1;
+            const uint32_t i3 = i2 + 1;
+            indices.insert(indices.end(), {i0, i2, i1, i1, i2, i3});
+        }
+    } else {
+        positions.reserve(quadCount * 18);
+        normals.reserve(quadCount * 18);
+        tangents.reserve(quadCount * 24);
+        texCoords.reserve(quadCount * 12);
+
+        for (uint64_t quad = 0; quad < quadCount; ++quad) {
+            const uint32_t x = static_cast<uint32_t>(quad % columns);
+            const uint32_t y = static_cast<uint32_t>(quad / columns);
+            const uint32_t corners[6][2] = {{x, y},     {x, y + 1}, {x + 1, y},
+                                            {x + 1, y}, {x, y + 1}, {x + 1, y + 1}};
+            for (const auto& corner : corners) {
+                evaluate(float(corner[0]) / columns, float(corner[1]) / rows, positions, normals,
+                         tangents, texCoords);
+            }
+        }
+    }
+
+    const size_t vertexCount = positions.size() / 3;
+
+    tinygltf::Primitive primitive;
+    primitive.mode = TINYGLTF_MODE_TRIANGLES;
+    primitive.material = materialIndex;
+
+    // POSITION requires min/max
+    const int positionAccessor =
+        AddAccessor(model, positions, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3,
+                    vertexCount, TINYGLTF_TARGET_ARRAY_BUFFER);
+    model.accessors[positionAccessor].minValues = {-0.5, -amplitude, -0.5};
+    model.accessors[positionAccessor].maxValues = {0.5, amplitude, 0.5};
+    primitive.attributes["POSITION"] = positionAccessor;
+
+    primitive.attributes["NORMAL"] =
+        AddAccessor(model, normals, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, vertexCount,
+                    TINYGLTF_TARGET_ARRAY_BUFFER);
+    primitive.attributes["TEXCOORD_0"] =
+        AddAccessor(model, texCoords, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC2,
+                    vertexCount, TINYGLTF_TARGET_ARRAY_BUFFER);
+    if (options.m_tangents) {
+        primitive.attributes["TANGENT"] =
+            AddAccessor(model, tangents, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC4,
+                        vertexCount, TINYGLTF_TARGET_ARRAY_BUFFER);
+    }
+
+    // Use the smallest index type that fits
+    if (options.m_indexed) {
+        if (vertexCount <= UINT16_MAX) {
+            std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+            primitive.indices =
+                AddAccessor(model, shortIndices, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT,
+                            TINYGLTF_TYPE_SCALAR, indices.size(),
+                            TINYGLTF_TARGET_ELEMENT_ARRAY_BUFFER);
+        } else {
+            primitive.indices = AddAccessor(model, indices, TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT,
+                                            TINYGLTF_TYPE_SCALAR, indices.size(),
+                                            TINYGLTF_TARGET_ELEMENT_ARRAY_BUFFER);
+        }
+    }
+
+    return primitive;
+}
+
+// Generates a noisy checkerboard so that compressed sizes are realistic
+std::vector<unsigned char> GenerateImagePixels(uint32_t size, std::mt19937& rng) {
+    std::uniform_int_distribution<int> colorDist(64, 255);
+    std::uniform_int_distribution<int> noiseDist(-24, 24);
+    const int colorA[3] = {colorDist(rng), colorDist(rng), colorDist(rng)};
+    const int colorB[3] = {colorDist(rng) / 4, colorDist(rng) / 4, colorDist(rng) / 4};
+    const uint32_t checkerSize = std::max(size / 8, 1u);
+
+    std::vector<unsigned char> pixels(size_t(size) * size * 4);
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            const int *color = ((x / checkerSize + y / checkerSize) & 1) ? colorA : colorB;
+            unsigned char *pixel = &pixels[(size_t(y) * size + x) * 4];
+            for (int c = 0; c < 3; ++c) {
+                pixel[c] = static_cast<unsigned char>(std::clamp(color[c] + noiseDist(rng), 0, 255));
+            }
+            pixel[3] = 255;
+        }
+    }
+    return pixels;
+}
+
+std::vector<unsigned char> EncodeImage(const std::vector<unsigned char>& pixels, uint32_t size,
+                                       ImageFormat format) {
+    std::vector<unsigned char> encoded;
+    auto write = [](void *context, void *data, int length) {
+        auto *out = static_cast<std::vector<unsigned char> *>(context);
+        out->insert(out->end(), static_cast<unsigned char *>(data),
+                    static_cast<unsigned char *>(data) + length);
+    };
+
+    const int dimension = static_cast<int>(size);
+    if (format == ImageFormat::JPEG) {
+        stbi_write_jpg_to_func(write, &encoded, dimension, dimension, 4, pixels.data(), 90);
+    } else {
+        stbi_write_png_to_func(write, &encoded, dimension, dimension, 4, pixels.data(),
+                               dimension * 4);
+    }
+    return encoded;
+}
+
+std::string GetDirectory(const std::string& path) {
+    const size_t separator = path.find_last_of("/\\");
+    return separator == std::string::npos ? std::string() : path.substr(0, separator + 1);
+}
+
+std::string GetStem(const std::string& path) {
+    const size_t separator = path.find_last_of("/\\");
+    std::string name = separator == std::string::npos ? path : path.substr(separator + 1);
+    return name.substr(0, name.find_last_of("."));
+}
+
+void AddTextures(tinygltf::Model& model, const Options& options, std::mt19937& rng) {
+    const char *extension = options.m_imageFormat == ImageFormat::JPEG ? "jpg" : "png";
+    const char *mimeType = options.m_imageFormat == ImageFormat::JPEG ? "image/jpeg" : "image/png";
+
+    if (options.m_textures > 0) {
+        tinygltf::Sampler sampler;
+        sampler.minFilter = TINYGLTF_TEXTURE_FILTER_LINEAR_MIPMAP_LINEAR;
+        sampler.magFilter = TINYGLTF_TEXTURE_FILTER_LINEAR;
+        model.samplers.push_back(sampler);
+    }
+
+    for (uint32_t i = 0; i < options.m_textures; ++i) {
+        std::vector<unsigned char> encoded =
+            EncodeImage(GenerateImagePixels(options.m_textureSize, rng), options.m_textureSize,
+                        options.m_imageFormat);
+
+        // Note: The viewer treats material texture indices as image indices, so keep them equal
+        tinygltf::Image image;
+        image.name = "texture_" + std::to_string(i);
+        image.mimeType = mimeType;
+
+        if (options.m_externalTextures) {
+            image.uri = GetStem(options.m_output) + "_" + image.name + "." + extension;
+            std::ofstream file(GetDirectory(options.m_output) + image.uri, std::ios::binary);
+            file.write(reinterpret_cast<const char *>(encoded.data()),
+                       static_cast<std::streamsize>(encoded.size()));
+        } else {
+            image.bufferView = AddBufferView(model, encoded.data(), encoded.size(), 0);
+        }
+        model.images.push_back(image);
+
+        tinygltf::Texture texture;
+        texture.source = static_cast<int>(i);
+        texture.sampler = 0;
+        model.textures.push_back(texture);
+    }
+}
+
+void AddMaterials(tinygltf::Model& model, const Options& options, std::mt19937& rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const int textureCount = static_cast<int>(options.m_textures);
+
+    for (uint32_t i = 0; i < options.m_materials; ++i) {
+        tinygltf::Material material;
+        material.name = "material_" + std::to_string(i);
+        material.pbrMetallicRoughness.baseColorFactor = {0.5 + 0.5 * unit(rng),
+                                                         0.5 + 0.5 * unit(rng),
+                                                         0.5 + 0.5 * unit(rng), 1.0};
+        material.pbrMetallicRoughness.metallicFactor = unit(rng);
+        material.pbrMetallicRoughness.roughnessFactor = 0.2 + 0.8 * unit(rng);
+
+        // Spread the textures over the base color, metallic-roughness and normal slots
+        if (textureCount > 0) {
+            const int first = static_cast<int>((i * 3) % textureCount);
+            material.pbrMetallicRoughness.baseColorTexture.index = first;
+            if (textureCount > 1) {
+                material.pbrMetallicRoughness.metallicRoughnessTexture.index =
+                    (first + 1) % textureCount;
+            }
+            if (textureCount > 2) {
+                material.normalTexture.index = (first + 2) % textureCount;
+            }
+        }
+
+        model.materials.push_back(material);
+    }
+}
+
+void AddMeshesAndNodes(tinygltf::Model& model, const Options& options) {
+    const uint64_t primitiveCount = uint64_t(options.m_meshes) * options.m_primitives;
+    const uint64_t trianglesPerPrimitive =
+        std::max<uint64_t>(options.m_triangles / primitiveCount, 1);
+
+    uint32_t materialIndex = 0;
+    for (uint32_t m = 0; m < options.m_meshes; ++m) {
+        tinygltf::Mesh mesh;
+        mesh.name = "mesh_" + std::to_string(m);
+        for (uint32_t p = 0; p < options.m_primitives; ++p) {
+            // Vary the phase so that every primitive has unique content
+            const float phase = float(m * options.m_primitives + p) * 0.37f;
+            mesh.primitives.push_back(AddHeightFieldPrimitive(
+                model, options, trianglesPerPrimitive, phase, static_cast<int>(materialIndex)));
+            materialIndex = (materialIndex + 1) % options.m_materials;
+        }
+        model.meshes.push_back(mesh);
+    }
+
+    // Lay the nodes out on a square grid of unit cells below a single root
+    tinygltf::Node root;
+    root.name = "root";
+
+    const uint32_t gridSize =
+        static_cast<uint32_t>(std::ceil(std::sqrt(double(std::max(options.m_nodes, 1u)))));
+    const double scale = 1.0 / gridSize;
+    for (uint32_t n = 0; n < options.m_nodes; ++n) {
+        tinygltf::Node node;
+        node.name = "node_" + std::to_string(n);
+        node.mesh = static_cast<int>(n % options.m_meshes);
+        node.translation = {((n % gridSize) + 0.5) * scale - 0.5, 0.0,
+                            ((n / gridSize) + 0.5) * scale - 0.5};
+        node.scale = {scale * 0.9, scale * 0.9, scale * 0.9};
+
+        model.nodes.push_back(node);
+        root.children.push_back(static_cast<int>(model.nodes.size() - 1));
+    }
+
+    model.nodes.push_back(root);
+
+    tinygltf::Scene scene;
+    scene.nodes.push_back(static_cast<int>(model.nodes.size() - 1));
+    model.scenes.push_back(scene);
+    model.defaultScene = 0;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// Main Function
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string extension = options.m_output.substr(options.m_output.find_last_of(".") + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension != "gltf" && extension != "glb") {
+        std::cerr << "Unsupported output format: " << extension << std::endl;
+        return EXIT_FAILURE;
+    }
+    const bool writeBinary = extension == "glb";
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    std::mt19937 rng(options.m_seed);
+
+    tinygltf::Model model;
+    model.asset.version = "2.0";
+    model.asset.generator = "stress_asset_generator";
+    model.buffers.resize(1);
+
+    AddTextures(model, options, rng);
+    AddMaterials(model, options, rng);
+    AddMeshesAndNodes(model, options);
+
+    // External buffers are named after the output file
+    if (!writeBinary && !options.m_base64Buffers) {
+        model.buffers[0].uri = GetStem(options.m_output) + ".bin";
+    }
+
+    tinygltf::TinyGLTF writer;
+    if (!writer.WriteGltfSceneToFile(&model, options.m_output, false /* embedImages */,
+                                     options.m_base64Buffers, false /* prettyPrint */,
+                                     writeBinary)) {
+        std::cerr << "Failed to write " << options.m_output << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double totalMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+    size_t triangleCount = 0;
+    for (const tinygltf::Mesh& mesh : model.meshes) {
+        for (const tinygltf::Primitive& primitive : mesh.primitives) {
+            const int countAccessor = primitive.indices >= 0
+                                          ? primitive.indices
+                                          : primitive.attributes.at("POSITION");
+            triangleCount += model.accessors[countAccessor].count / 3;
+        }
+    }
+
+    std::cout << "Wrote " << options.m_output << " in " << totalMs << "ms" << std::endl;
+    std::cout << "  Meshes: " << model.meshes.size() << " (" << triangleCount
+              << " unique triangles, " << (options.m_indexed ? "indexed" : "unindexed")
+              << (options.m_tangents ? "" : ", no tangents") << ")" << std::endl;
+    std::cout << "  Nodes: " << options.m_nodes << std::endl;
+    std::cout << "  Materials: " << model.materials.size() << std::endl;
+    std::cout << "  Textures: " << model.images.size() << " ("
+              << (options.m_externalTextures ? "external" : "embedded") << ")" << std::endl;
+    std::cout << "  Buffer: " << model.buffers[0].data.size() << " bytes ("
+              << (writeBinary ? "GLB chunk" : (options.m_base64Buffers ? "base64" : "external"))
+              << ")" << std::endl;
+
+    return EXIT_SUCCESS;
+}